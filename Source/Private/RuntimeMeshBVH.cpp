@@ -0,0 +1,785 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshBVH.h"
+#include "Async/ParallelFor.h"
+
+
+namespace RuntimeMeshBVHInternal
+{
+	/* Half the surface area of a box, enough for comparing SAH costs */
+	static float GetHalfArea(const FBox& Box)
+	{
+		const FVector Size = Box.Max - Box.Min;
+		return Size.X * Size.Y + Size.Y * Size.Z + Size.Z * Size.X;
+	}
+
+	static float GetDistanceSquaredToBox(const FVector& Point, const FVector& Min, const FVector& Max)
+	{
+		const FVector Closest = Point.ComponentMax(Min).ComponentMin(Max);
+		return FVector::DistSquared(Point, Closest);
+	}
+
+	/* Slab test of a ray against a box, limited to [0, MaxT] */
+	static bool RayIntersectsBox(const FVector& Origin, const FVector& InvDirection, const FVector& Min, const FVector& Max, float MaxT, float& OutNearT)
+	{
+		const FVector T1 = (Min - Origin) * InvDirection;
+		const FVector T2 = (Max - Origin) * InvDirection;
+		const FVector TMin = T1.ComponentMin(T2);
+		const FVector TMax = T1.ComponentMax(T2);
+
+		OutNearT = FMath::Max(FMath::Max(TMin.X, TMin.Y), FMath::Max(TMin.Z, 0.0f));
+		const float FarT = FMath::Min(FMath::Min(TMax.X, TMax.Y), FMath::Min(TMax.Z, MaxT));
+		return OutNearT <= FarT;
+	}
+
+	/* Two sided Moller-Trumbore ray triangle intersection */
+	static bool RayIntersectsTriangle(const FVector& Origin, const FVector& Direction, const FVector& A, const FVector& B, const FVector& C, float MaxT, float& OutT, float& OutU, float& OutV)
+	{
+		const FVector Edge1 = B - A;
+		const FVector Edge2 = C - A;
+		const FVector PVec = Direction ^ Edge2;
+		const float Det = Edge1 | PVec;
+		if (FMath::Abs(Det) < SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const float InvDet = 1.0f / Det;
+		const FVector TVec = Origin - A;
+		OutU = (TVec | PVec) * InvDet;
+		if (OutU < 0.0f || OutU > 1.0f)
+		{
+			return false;
+		}
+
+		const FVector QVec = TVec ^ Edge1;
+		OutV = (Direction | QVec) * InvDet;
+		if (OutV < 0.0f || OutU + OutV > 1.0f)
+		{
+			return false;
+		}
+
+		OutT = (Edge2 | QVec) * InvDet;
+		return OutT >= 0.0f && OutT <= MaxT;
+	}
+
+	/* Closest point on a triangle, from Real-Time Collision Detection by Christer Ericson */
+	static FVector GetClosestPointOnTriangle(const FVector& Point, const FVector& A, const FVector& B, const FVector& C, FVector& OutBarycentrics)
+	{
+		const FVector AB = B - A;
+		const FVector AC = C - A;
+		const FVector AP = Point - A;
+		const float D1 = AB | AP;
+		const float D2 = AC | AP;
+		if (D1 <= 0.0f && D2 <= 0.0f)
+		{
+			OutBarycentrics = FVector(1, 0, 0);
+			return A;
+		}
+
+		const FVector BP = Point - B;
+		const float D3 = AB | BP;
+		const float D4 = AC | BP;
+		if (D3 >= 0.0f && D4 <= D3)
+		{
+			OutBarycentrics = FVector(0, 1, 0);
+			return B;
+		}
+
+		const float VC = D1 * D4 - D3 * D2;
+		if (VC <= 0.0f && D1 >= 0.0f && D3 <= 0.0f)
+		{
+			const float V = D1 / (D1 - D3);
+			OutBarycentrics = FVector(1 - V, V, 0);
+			return A + AB * V;
+		}
+
+		const FVector CP = Point - C;
+		const float D5 = AB | CP;
+		const float D6 = AC | CP;
+		if (D6 >= 0.0f && D5 <= D6)
+		{
+			OutBarycentrics = FVector(0, 0, 1);
+			return C;
+		}
+
+		const float VB = D5 * D2 - D1 * D6;
+		if (VB <= 0.0f && D2 >= 0.0f && D6 <= 0.0f)
+		{
+			const float W = D2 / (D2 - D6);
+			OutBarycentrics = FVector(1 - W, 0, W);
+			return A + AC * W;
+		}
+
+		const float VA = D3 * D6 - D5 * D4;
+		if (VA <= 0.0f && (D4 - D3) >= 0.0f && (D5 - D6) >= 0.0f)
+		{
+			const float W = (D4 - D3) / ((D4 - D3) + (D5 - D6));
+			OutBarycentrics = FVector(0, 1 - W, W);
+			return B + (C - B) * W;
+		}
+
+		const float Sum = VA + VB + VC;
+		if (Sum <= SMALL_NUMBER)
+		{
+			// Degenerate triangle
+			OutBarycentrics = FVector(1, 0, 0);
+			return A;
+		}
+
+		const float V = VB / Sum;
+		const float W = VC / Sum;
+		OutBarycentrics = FVector(1 - V - W, V, W);
+		return A + AB * V + AC * W;
+	}
+
+	/* Is the triangle separated from the box along Axis? Triangle is relative to the box center. */
+	static bool IsSeparatingAxis(const FVector& Axis, const FVector& A, const FVector& B, const FVector& C, const FVector& Extent)
+	{
+		if (Axis.SizeSquared() < SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const float PA = A | Axis;
+		const float PB = B | Axis;
+		const float PC = C | Axis;
+		const float Radius = Extent.X * FMath::Abs(Axis.X) + Extent.Y * FMath::Abs(Axis.Y) + Extent.Z * FMath::Abs(Axis.Z);
+		return FMath::Min3(PA, PB, PC) > Radius || FMath::Max3(PA, PB, PC) < -Radius;
+	}
+
+	/* Separating axis test of a triangle against a box, by Tomas Akenine-Moller */
+	static bool TriangleIntersectsBox(const FVector& InA, const FVector& InB, const FVector& InC, const FVector& Center, const FVector& Extent)
+	{
+		const FVector A = InA - Center;
+		const FVector B = InB - Center;
+		const FVector C = InC - Center;
+		const FVector Edges[3] = { B - A, C - B, A - C };
+		const FVector BoxAxes[3] = { FVector(1, 0, 0), FVector(0, 1, 0), FVector(0, 0, 1) };
+
+		for (int32 BoxAxis = 0; BoxAxis < 3; BoxAxis++)
+		{
+			if (IsSeparatingAxis(BoxAxes[BoxAxis], A, B, C, Extent))
+			{
+				return false;
+			}
+
+			for (int32 Edge = 0; Edge < 3; Edge++)
+			{
+				if (IsSeparatingAxis(BoxAxes[BoxAxis] ^ Edges[Edge], A, B, C, Extent))
+				{
+					return false;
+				}
+			}
+		}
+
+		return !IsSeparatingAxis(Edges[0] ^ Edges[1], A, B, C, Extent);
+	}
+
+	/* Node index and the distance to it, used to visit the closest nodes first */
+	struct FStackEntry
+	{
+		int32 NodeIndex;
+		float Distance;
+
+		FStackEntry() { }
+		FStackEntry(int32 InNodeIndex, float InDistance) : NodeIndex(InNodeIndex), Distance(InDistance) { }
+	};
+
+	using FTraversalStack = TArray<FStackEntry, TInlineAllocator<64>>;
+}
+
+
+FRuntimeMeshBVH::FRuntimeMeshBVH(int32 InSectionIndex, TArray<FVector>&& InPositions, const TArray<int32>& InIndices, TArray<FVector2D>&& InUVs)
+	: SectionIndex(InSectionIndex), Positions(MoveTemp(InPositions)), Indices(InIndices), UVs(MoveTemp(InUVs))
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+	Indices.SetNum(NumTriangles * 3);
+
+	for (int32 Index : Indices)
+	{
+		check(Positions.IsValidIndex(Index) && "Index out of range of the vertex buffer.");
+	}
+
+	if (NumTriangles == 0)
+	{
+		return;
+	}
+
+	TriangleOrder.SetNumUninitialized(NumTriangles);
+	TArray<FBox> TriangleBounds;
+	TArray<FVector> Centroids;
+	TriangleBounds.SetNumUninitialized(NumTriangles);
+	Centroids.SetNumUninitialized(NumTriangles);
+
+	ParallelFor(NumTriangles, [&](int32 Triangle)
+	{
+		FVector A, B, C;
+		GetTriangle(Triangle, A, B, C);
+		TriangleBounds[Triangle] = FBox(A.ComponentMin(B).ComponentMin(C), A.ComponentMax(B).ComponentMax(C));
+		Centroids[Triangle] = TriangleBounds[Triangle].GetCenter();
+		TriangleOrder[Triangle] = Triangle;
+	});
+
+	Nodes.SetNumUninitialized(NumTriangles * 2 - 1);
+	for (FNode& Node : Nodes)
+	{
+		Node.Count = INDEX_NONE;
+	}
+
+	BuildNode(0, 0, NumTriangles, TriangleBounds, Centroids);
+}
+
+FRuntimeMeshBVH::FRuntimeMeshBVH(const FRuntimeMeshBVH& Source, TArray<FVector>&& InPositions, TArray<FVector2D>&& InUVs)
+	: SectionIndex(Source.SectionIndex), Positions(MoveTemp(InPositions)), Indices(Source.Indices), UVs(MoveTemp(InUVs))
+	, TriangleOrder(Source.TriangleOrder), Nodes(Source.Nodes)
+{
+	check(Positions.Num() == Source.Positions.Num() && "Refitting requires the same vertices.");
+	Refit();
+}
+
+FBox FRuntimeMeshBVH::GetBounds() const
+{
+	return Nodes.Num() > 0 ? FBox(Nodes[0].Min, Nodes[0].Max) : FBox(0);
+}
+
+void FRuntimeMeshBVH::BuildNode(int32 NodeIndex, int32 Start, int32 Count, const TArray<FBox>& TriangleBounds, const TArray<FVector>& Centroids)
+{
+	FNode& Node = Nodes[NodeIndex];
+
+	FBox Bounds(0);
+	FBox CentroidBounds(0);
+	for (int32 Index = Start; Index < Start + Count; Index++)
+	{
+		Bounds += TriangleBounds[TriangleOrder[Index]];
+		CentroidBounds += Centroids[TriangleOrder[Index]];
+	}
+	Node.Min = Bounds.Min;
+	Node.Max = Bounds.Max;
+
+	if (Count <= MaxLeafTriangles)
+	{
+		Node.Start = Start;
+		Node.Count = Count;
+		return;
+	}
+
+	// Find the cheapest split between bins along any axis
+	const FVector CentroidExtent = CentroidBounds.Max - CentroidBounds.Min;
+	int32 BestAxis = INDEX_NONE;
+	int32 BestBin = 0;
+	float BestCost = MAX_flt;
+
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		if (CentroidExtent[Axis] <= KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		FBox BinBounds[NumBins];
+		int32 BinCounts[NumBins];
+		for (int32 Bin = 0; Bin < NumBins; Bin++)
+		{
+			BinBounds[Bin] = FBox(0);
+			BinCounts[Bin] = 0;
+		}
+
+		const float BinScale = NumBins / CentroidExtent[Axis];
+		for (int32 Index = Start; Index < Start + Count; Index++)
+		{
+			const int32 Triangle = TriangleOrder[Index];
+			const int32 Bin = FMath::Clamp((int32)((Centroids[Triangle][Axis] - CentroidBounds.Min[Axis]) * BinScale), 0, NumBins - 1);
+			BinBounds[Bin] += TriangleBounds[Triangle];
+			BinCounts[Bin]++;
+		}
+
+		// Sweep from the left to get the cost of everything left of each split, then from the right to finish it
+		float LeftCosts[NumBins - 1];
+		FBox LeftBounds(0);
+		int32 LeftCount = 0;
+		for (int32 Bin = 0; Bin < NumBins - 1; Bin++)
+		{
+			LeftBounds += BinBounds[Bin];
+			LeftCount += BinCounts[Bin];
+			LeftCosts[Bin] = LeftCount > 0 ? LeftCount * RuntimeMeshBVHInternal::GetHalfArea(LeftBounds) : 0.0f;
+		}
+
+		FBox RightBounds(0);
+		int32 RightCount = 0;
+		for (int32 Bin = NumBins - 1; Bin > 0; Bin--)
+		{
+			RightBounds += BinBounds[Bin];
+			RightCount += BinCounts[Bin];
+			if (RightCount == 0 || RightCount == Count)
+			{
+				continue;
+			}
+
+			const float Cost = LeftCosts[Bin - 1] + RightCount * RuntimeMeshBVHInternal::GetHalfArea(RightBounds);
+			if (Cost < BestCost)
+			{
+				BestCost = Cost;
+				BestAxis = Axis;
+				BestBin = Bin - 1;
+			}
+		}
+	}
+
+	int32 LeftCount = Count / 2;
+	if (BestAxis != INDEX_NONE)
+	{
+		// Partition the triangles around the split
+		const float BinScale = NumBins / CentroidExtent[BestAxis];
+		const float AxisMin = CentroidBounds.Min[BestAxis];
+		int32 Left = Start;
+		int32 Right = Start + Count - 1;
+		while (Left <= Right)
+		{
+			const int32 Bin = FMath::Clamp((int32)((Centroids[TriangleOrder[Left]][BestAxis] - AxisMin) * BinScale), 0, NumBins - 1);
+			if (Bin <= BestBin)
+			{
+				Left++;
+			}
+			else
+			{
+				Swap(TriangleOrder[Left], TriangleOrder[Right]);
+				Right--;
+			}
+		}
+
+		if (Left > Start && Left < Start + Count)
+		{
+			LeftCount = Left - Start;
+		}
+	}
+	// Otherwise every centroid is in the same place, so any split is as good as another
+
+	const int32 LeftChild = NodeIndex + 1;
+	const int32 RightChild = NodeIndex + 2 * LeftCount;
+	Node.Start = RightChild;
+	Node.Count = 0;
+
+	if (Count >= ParallelBuildThreshold)
+	{
+		ParallelFor(2, [&](int32 Child)
+		{
+			if (Child == 0)
+			{
+				BuildNode(LeftChild, Start, LeftCount, TriangleBounds, Centroids);
+			}
+			else
+			{
+				BuildNode(RightChild, Start + LeftCount, Count - LeftCount, TriangleBounds, Centroids);
+			}
+		});
+	}
+	else
+	{
+		BuildNode(LeftChild, Start, LeftCount, TriangleBounds, Centroids);
+		BuildNode(RightChild, Start + LeftCount, Count - LeftCount, TriangleBounds, Centroids);
+	}
+}
+
+void FRuntimeMeshBVH::Refit()
+{
+	// Children always come after their parent, so walking backwards finishes them first
+	for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; NodeIndex--)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		if (Node.Count == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (Node.Count > 0)
+		{
+			FBox Bounds(0);
+			for (int32 Index = Node.Start; Index < Node.Start + Node.Count; Index++)
+			{
+				FVector A, B, C;
+				GetTriangle(TriangleOrder[Index], A, B, C);
+				Bounds += A;
+				Bounds += B;
+				Bounds += C;
+			}
+			Node.Min = Bounds.Min;
+			Node.Max = Bounds.Max;
+		}
+		else
+		{
+			const FNode& LeftChild = Nodes[NodeIndex + 1];
+			const FNode& RightChild = Nodes[Node.Start];
+			Node.Min = LeftChild.Min.ComponentMin(RightChild.Min);
+			Node.Max = LeftChild.Max.ComponentMax(RightChild.Max);
+		}
+	}
+}
+
+void FRuntimeMeshBVH::GetTriangle(int32 Triangle, FVector& OutA, FVector& OutB, FVector& OutC) const
+{
+	OutA = Positions[Indices[Triangle * 3 + 0]];
+	OutB = Positions[Indices[Triangle * 3 + 1]];
+	OutC = Positions[Indices[Triangle * 3 + 2]];
+}
+
+void FRuntimeMeshBVH::FillHit(int32 Triangle, const FVector& Position, const FVector& Barycentrics, float Distance, FRuntimeMeshQueryHit& OutHit) const
+{
+	FVector A, B, C;
+	GetTriangle(Triangle, A, B, C);
+
+	OutHit.SectionIndex = SectionIndex;
+	OutHit.TriangleIndex = Triangle;
+	OutHit.Position = Position;
+	OutHit.Barycentrics = Barycentrics;
+	OutHit.Normal = ((B - A) ^ (C - A)).GetSafeNormal();
+	OutHit.Distance = Distance;
+
+	if (UVs.Num() == Positions.Num())
+	{
+		OutHit.UV = UVs[Indices[Triangle * 3 + 0]] * Barycentrics.X + UVs[Indices[Triangle * 3 + 1]] * Barycentrics.Y + UVs[Indices[Triangle * 3 + 2]] * Barycentrics.Z;
+	}
+	else
+	{
+		OutHit.UV = FVector2D(0, 0);
+	}
+}
+
+bool FRuntimeMeshBVH::RayCast(const FVector& Start, const FVector& End, FRuntimeMeshQueryHit& OutHit) const
+{
+	using namespace RuntimeMeshBVHInternal;
+
+	const FVector Delta = End - Start;
+	const float Length = Delta.Size();
+	if (Nodes.Num() == 0 || Length <= SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FVector Direction = Delta / Length;
+	const FVector InvDirection(
+		Direction.X != 0.0f ? 1.0f / Direction.X : BIG_NUMBER,
+		Direction.Y != 0.0f ? 1.0f / Direction.Y : BIG_NUMBER,
+		Direction.Z != 0.0f ? 1.0f / Direction.Z : BIG_NUMBER);
+
+	float BestT = Length;
+	float BestU = 0.0f;
+	float BestV = 0.0f;
+	int32 BestTriangle = INDEX_NONE;
+
+	FTraversalStack Stack;
+	float RootT;
+	if (RayIntersectsBox(Start, InvDirection, Nodes[0].Min, Nodes[0].Max, BestT, RootT))
+	{
+		Stack.Add(FStackEntry(0, RootT));
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const FStackEntry Entry = Stack.Pop(false);
+		if (Entry.Distance > BestT)
+		{
+			continue;
+		}
+
+		const FNode& Node = Nodes[Entry.NodeIndex];
+		if (Node.Count > 0)
+		{
+			for (int32 Index = Node.Start; Index < Node.Start + Node.Count; Index++)
+			{
+				const int32 Triangle = TriangleOrder[Index];
+				FVector A, B, C;
+				GetTriangle(Triangle, A, B, C);
+
+				float T, U, V;
+				if (RayIntersectsTriangle(Start, Direction, A, B, C, BestT, T, U, V))
+				{
+					BestT = T;
+					BestU = U;
+					BestV = V;
+					BestTriangle = Triangle;
+				}
+			}
+			continue;
+		}
+
+		// Push the farther child first so the nearer one is visited next
+		const int32 LeftChild = Entry.NodeIndex + 1;
+		const int32 RightChild = Node.Start;
+		float LeftT, RightT;
+		const bool bHitLeft = RayIntersectsBox(Start, InvDirection, Nodes[LeftChild].Min, Nodes[LeftChild].Max, BestT, LeftT);
+		const bool bHitRight = RayIntersectsBox(Start, InvDirection, Nodes[RightChild].Min, Nodes[RightChild].Max, BestT, RightT);
+		if (bHitLeft && bHitRight)
+		{
+			const bool bLeftFirst = LeftT <= RightT;
+			Stack.Add(bLeftFirst ? FStackEntry(RightChild, RightT) : FStackEntry(LeftChild, LeftT));
+			Stack.Add(bLeftFirst ? FStackEntry(LeftChild, LeftT) : FStackEntry(RightChild, RightT));
+		}
+		else if (bHitLeft)
+		{
+			Stack.Add(FStackEntry(LeftChild, LeftT));
+		}
+		else if (bHitRight)
+		{
+			Stack.Add(FStackEntry(RightChild, RightT));
+		}
+	}
+
+	if (BestTriangle == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FillHit(BestTriangle, Start + Direction * BestT, FVector(1.0f - BestU - BestV, BestU, BestV), BestT, OutHit);
+	return true;
+}
+
+void FRuntimeMeshBVH::ForEachTriangleInBox(const FBox& Box, TFunctionRef<void(int32)> Func) const
+{
+	if (Nodes.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop(false);
+		const FNode& Node = Nodes[NodeIndex];
+
+		if (Node.Min.X > Box.Max.X || Node.Min.Y > Box.Max.Y || Node.Min.Z > Box.Max.Z ||
+			Node.Max.X < Box.Min.X || Node.Max.Y < Box.Min.Y || Node.Max.Z < Box.Min.Z)
+		{
+			continue;
+		}
+
+		if (Node.Count > 0)
+		{
+			for (int32 Index = Node.Start; Index < Node.Start + Node.Count; Index++)
+			{
+				Func(TriangleOrder[Index]);
+			}
+		}
+		else
+		{
+			Stack.Add(Node.Start);
+			Stack.Add(NodeIndex + 1);
+		}
+	}
+}
+
+bool FRuntimeMeshBVH::OverlapSphere(const FVector& Center, float Radius, TArray<FRuntimeMeshQueryHit>& OutHits) const
+{
+	const int32 NumHitsBefore = OutHits.Num();
+	if (Radius < 0.0f)
+	{
+		return false;
+	}
+	const float RadiusSquared = Radius * Radius;
+
+	ForEachTriangleInBox(FBox(Center - FVector(Radius), Center + FVector(Radius)), [&](int32 Triangle)
+	{
+		FVector A, B, C, Barycentrics;
+		GetTriangle(Triangle, A, B, C);
+		const FVector Closest = RuntimeMeshBVHInternal::GetClosestPointOnTriangle(Center, A, B, C, Barycentrics);
+
+		const float DistanceSquared = FVector::DistSquared(Center, Closest);
+		if (DistanceSquared <= RadiusSquared)
+		{
+			FillHit(Triangle, Closest, Barycentrics, FMath::Sqrt(DistanceSquared), OutHits[OutHits.AddDefaulted()]);
+		}
+	});
+
+	return OutHits.Num() > NumHitsBefore;
+}
+
+bool FRuntimeMeshBVH::OverlapBox(const FBox& Box, TArray<FRuntimeMeshQueryHit>& OutHits) const
+{
+	const int32 NumHitsBefore = OutHits.Num();
+	const FVector Center = Box.GetCenter();
+	const FVector Extent = Box.GetExtent();
+
+	ForEachTriangleInBox(Box, [&](int32 Triangle)
+	{
+		FVector A, B, C;
+		GetTriangle(Triangle, A, B, C);
+		if (RuntimeMeshBVHInternal::TriangleIntersectsBox(A, B, C, Center, Extent))
+		{
+			FVector Barycentrics;
+			const FVector Closest = RuntimeMeshBVHInternal::GetClosestPointOnTriangle(Center, A, B, C, Barycentrics);
+			FillHit(Triangle, Closest, Barycentrics, FVector::Dist(Center, Closest), OutHits[OutHits.AddDefaulted()]);
+		}
+	});
+
+	return OutHits.Num() > NumHitsBefore;
+}
+
+bool FRuntimeMeshBVH::GetClosestPoint(const FVector& Point, float MaxDistance, FRuntimeMeshQueryHit& OutHit) const
+{
+	using namespace RuntimeMeshBVHInternal;
+
+	if (Nodes.Num() == 0)
+	{
+		return false;
+	}
+
+	float BestDistanceSquared = MaxDistance * MaxDistance;
+	int32 BestTriangle = INDEX_NONE;
+	FVector BestPosition(0, 0, 0);
+	FVector BestBarycentrics(0, 0, 0);
+
+	FTraversalStack Stack;
+	Stack.Add(FStackEntry(0, GetDistanceSquaredToBox(Point, Nodes[0].Min, Nodes[0].Max)));
+
+	while (Stack.Num() > 0)
+	{
+		const FStackEntry Entry = Stack.Pop(false);
+		if (Entry.Distance > BestDistanceSquared)
+		{
+			continue;
+		}
+
+		const FNode& Node = Nodes[Entry.NodeIndex];
+		if (Node.Count > 0)
+		{
+			for (int32 Index = Node.Start; Index < Node.Start + Node.Count; Index++)
+			{
+				const int32 Triangle = TriangleOrder[Index];
+				FVector A, B, C, Barycentrics;
+				GetTriangle(Triangle, A, B, C);
+
+				const FVector Closest = GetClosestPointOnTriangle(Point, A, B, C, Barycentrics);
+				const float DistanceSquared = FVector::DistSquared(Point, Closest);
+				if (DistanceSquared <= BestDistanceSquared)
+				{
+					BestDistanceSquared = DistanceSquared;
+					BestTriangle = Triangle;
+					BestPosition = Closest;
+					BestBarycentrics = Barycentrics;
+				}
+			}
+			continue;
+		}
+
+		// Push the farther child first so the nearer one is visited next
+		const int32 LeftChild = Entry.NodeIndex + 1;
+		const int32 RightChild = Node.Start;
+		const float LeftDistance = GetDistanceSquaredToBox(Point, Nodes[LeftChild].Min, Nodes[LeftChild].Max);
+		const float RightDistance = GetDistanceSquaredToBox(Point, Nodes[RightChild].Min, Nodes[RightChild].Max);
+		const bool bLeftFirst = LeftDistance <= RightDistance;
+		Stack.Add(bLeftFirst ? FStackEntry(RightChild, RightDistance) : FStackEntry(LeftChild, LeftDistance));
+		Stack.Add(bLeftFirst ? FStackEntry(LeftChild, LeftDistance) : FStackEntry(RightChild, RightDistance));
+	}
+
+	if (BestTriangle == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FillHit(BestTriangle, BestPosition, BestBarycentrics, FMath::Sqrt(BestDistanceSquared), OutHit);
+	return true;
+}
+
+void FRuntimeMeshBVH::GetTrianglesInBox(const FBox& Box, TArray<int32>& OutTriangles) const
+{
+	ForEachTriangleInBox(Box, [&](int32 Triangle)
+	{
+		FVector A, B, C;
+		GetTriangle(Triangle, A, B, C);
+
+		const FVector Min = A.ComponentMin(B).ComponentMin(C);
+		const FVector Max = A.ComponentMax(B).ComponentMax(C);
+		if (Min.X <= Box.Max.X && Min.Y <= Box.Max.Y && Min.Z <= Box.Max.Z &&
+			Max.X >= Box.Min.X && Max.Y >= Box.Min.Y && Max.Z >= Box.Min.Z)
+		{
+			OutTriangles.Add(Triangle);
+		}
+	});
+}
+
+bool FRuntimeMeshBVH::IsPointInside(const FVector& Point) const
+{
+	if (Nodes.Num() == 0 || !GetBounds().IsInsideOrOn(Point))
+	{
+		return false;
+	}
+
+	// Directions that don't line up with the axes, so rays rarely graze the edges of authored meshes
+	static const FVector Directions[] =
+	{
+		FVector(0.5381f, 0.6228f, 0.5679f),
+		FVector(-0.7071f, 0.3015f, -0.6396f),
+		FVector(0.2673f, -0.8018f, 0.5345f),
+	};
+
+	int32 Crossings = 0;
+	for (const FVector& Direction : Directions)
+	{
+		if (CountRayCrossings(Point, Direction, Crossings))
+		{
+			break;
+		}
+	}
+
+	// If every ray grazed an edge the last count is still the best guess
+	return (Crossings & 1) != 0;
+}
+
+bool FRuntimeMeshBVH::CountRayCrossings(const FVector& Start, const FVector& Direction, int32& OutCrossings) const
+{
+	using namespace RuntimeMeshBVHInternal;
+
+	// Hits this close to an edge could be counted by both triangles sharing it, or by neither
+	static const float EdgeTolerance = 1.e-5f;
+
+	const FVector InvDirection(
+		Direction.X != 0.0f ? 1.0f / Direction.X : BIG_NUMBER,
+		Direction.Y != 0.0f ? 1.0f / Direction.Y : BIG_NUMBER,
+		Direction.Z != 0.0f ? 1.0f / Direction.Z : BIG_NUMBER);
+	const float MaxT = (Nodes[0].Max - Nodes[0].Min).Size() + FVector::Dist(Start, Nodes[0].Min);
+
+	OutCrossings = 0;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop(false);
+		const FNode& Node = Nodes[NodeIndex];
+
+		float NearT;
+		if (!RayIntersectsBox(Start, InvDirection, Node.Min, Node.Max, MaxT, NearT))
+		{
+			continue;
+		}
+
+		if (Node.Count == 0)
+		{
+			Stack.Add(Node.Start);
+			Stack.Add(NodeIndex + 1);
+			continue;
+		}
+
+		for (int32 Index = Node.Start; Index < Node.Start + Node.Count; Index++)
+		{
+			FVector A, B, C;
+			GetTriangle(TriangleOrder[Index], A, B, C);
+
+			float T, U, V;
+			if (RayIntersectsTriangle(Start, Direction, A, B, C, MaxT, T, U, V))
+			{
+				if (U < EdgeTolerance || V < EdgeTolerance || 1.0f - U - V < EdgeTolerance)
+				{
+					return false;
+				}
+				OutCrossings++;
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,581 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshBenchmark.h"
+#include "RuntimeMeshLibrary.h"
+
+#if WITH_RUNTIMEMESH_PMC_BENCHMARK
+#include "ProceduralMeshComponent.h"
+#endif
+
+
+namespace RuntimeMeshBenchmark
+{
+	/* Distance between grid vertices */
+	static const float GridSpacing = 10.0f;
+
+	/* Height of the wave animated across the grid */
+	static const float WaveHeight = 25.0f;
+
+	static const TCHAR* GetScenarioName(ERuntimeMeshBenchmarkScenario Scenario)
+	{
+		switch (Scenario)
+		{
+		case ERuntimeMeshBenchmarkScenario::MixedFrequency: return TEXT("MixedFrequency");
+		case ERuntimeMeshBenchmarkScenario::PositionAnimation: return TEXT("PositionAnimation");
+		case ERuntimeMeshBenchmarkScenario::StreamingChurn: return TEXT("StreamingChurn");
+		case ERuntimeMeshBenchmarkScenario::BatchUpdates: return TEXT("BatchUpdates");
+		case ERuntimeMeshBenchmarkScenario::MeshBoolean: return TEXT("MeshBoolean");
+		case ERuntimeMeshBenchmarkScenario::PooledStreamingChurn: return TEXT("PooledStreamingChurn");
+		}
+		return TEXT("Unknown");
+	}
+
+	static const TCHAR* GetTargetName(ERuntimeMeshBenchmarkTarget Target)
+	{
+		return Target == ERuntimeMeshBenchmarkTarget::RuntimeMesh ? TEXT("RuntimeMeshComponent") : TEXT("ProceduralMeshComponent");
+	}
+
+	/* Update frequency used for a section in the mixed frequency scenario */
+	static EUpdateFrequency GetMixedUpdateFrequency(int32 ComponentIndex, int32 SectionIndex)
+	{
+		switch ((ComponentIndex + SectionIndex) % 3)
+		{
+		case 0: return EUpdateFrequency::Frequent;
+		case 1: return EUpdateFrequency::Average;
+		default: return EUpdateFrequency::Infrequent;
+		}
+	}
+
+	static float ToMegabytes(int64 Bytes)
+	{
+		return Bytes / (1024.0f * 1024.0f);
+	}
+
+	/* Closed UV sphere with roughly NumTriangles triangles */
+	static void CreateSphere(const FVector& Center, float Radius, int32 NumTriangles, TArray<FRuntimeMeshVertexSimple>& OutVertices, TArray<int32>& OutTriangles)
+	{
+		// Rings * 2 segments * (Rings - 1) * 2 triangles, leaving out the degenerate ones at the poles
+		const int32 NumRings = FMath::Max(2, FMath::RoundToInt(FMath::Sqrt(NumTriangles / 4.0f)));
+		const int32 NumSegments = NumRings * 2;
+
+		OutVertices.Reset((NumRings + 1) * NumSegments);
+		OutTriangles.Reset(NumSegments * (NumRings - 1) * 6);
+
+		for (int32 Ring = 0; Ring <= NumRings; Ring++)
+		{
+			const float Theta = PI * Ring / NumRings;
+			for (int32 Segment = 0; Segment < NumSegments; Segment++)
+			{
+				const float Phi = 2.0f * PI * Segment / NumSegments;
+				const FVector Normal(FMath::Sin(Theta) * FMath::Cos(Phi), FMath::Sin(Theta) * FMath::Sin(Phi), FMath::Cos(Theta));
+				const FRuntimeMeshTangent Tangent(-FMath::Sin(Phi), FMath::Cos(Phi), 0.0f);
+				OutVertices.Add(FRuntimeMeshVertexSimple(Center + Normal * Radius, Normal, Tangent, FColor::White,
+					FVector2D(Segment / float(NumSegments), Ring / float(NumRings))));
+			}
+		}
+
+		for (int32 Ring = 0; Ring < NumRings; Ring++)
+		{
+			for (int32 Segment = 0; Segment < NumSegments; Segment++)
+			{
+				const int32 A = Ring * NumSegments + Segment;
+				const int32 B = Ring * NumSegments + (Segment + 1) % NumSegments;
+				const int32 C = A + NumSegments;
+				const int32 D = B + NumSegments;
+
+				if (Ring > 0)
+				{
+					OutTriangles.Add(A);
+					OutTriangles.Add(C);
+					OutTriangles.Add(B);
+				}
+				if (Ring < NumRings - 1)
+				{
+					OutTriangles.Add(B);
+					OutTriangles.Add(C);
+					OutTriangles.Add(D);
+				}
+			}
+		}
+	}
+}
+
+
+FString FRuntimeMeshBenchmarkResult::GetCSVHeader()
+{
+	return TEXT("Scenario,Target,Frames,GameThreadMs,GameThreadMaxMs,RenderThreadMs,RenderThreadMaxMs,SetupMemoryMB,PeakMemoryMB");
+}
+
+FString FRuntimeMeshBenchmarkResult::ToCSV() const
+{
+	return FString::Printf(TEXT("%s,%s,%d,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f"),
+		RuntimeMeshBenchmark::GetScenarioName(Scenario), RuntimeMeshBenchmark::GetTargetName(Target), NumFrames,
+		GameThreadMs, GameThreadMaxMs, RenderThreadMs, RenderThreadMaxMs, SetupMemoryMB, PeakMemoryMB);
+}
+
+
+
+ARuntimeMeshBenchmarkActor::ARuntimeMeshBenchmarkActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer), NumComponents(64), NumSectionsPerComponent(4), GridSize(32), BooleanTriangles(100000), NumFrames(120),
+	bCompareWithProceduralMesh(WITH_RUNTIMEMESH_PMC_BENCHMARK != 0), bRunOnBeginPlay(true), ComponentPool(nullptr), NextComponentIndex(0)
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	Scenarios.Add(ERuntimeMeshBenchmarkScenario::MixedFrequency);
+	Scenarios.Add(ERuntimeMeshBenchmarkScenario::PositionAnimation);
+	Scenarios.Add(ERuntimeMeshBenchmarkScenario::StreamingChurn);
+	Scenarios.Add(ERuntimeMeshBenchmarkScenario::BatchUpdates);
+}
+
+void ARuntimeMeshBenchmarkActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bRunOnBeginPlay)
+	{
+		RunAllScenarios();
+		SaveResults();
+	}
+}
+
+void ARuntimeMeshBenchmarkActor::RunAllScenarios()
+{
+	Results.Empty();
+
+	for (ERuntimeMeshBenchmarkScenario Scenario : Scenarios)
+	{
+		for (ERuntimeMeshBenchmarkTarget Target : { ERuntimeMeshBenchmarkTarget::RuntimeMesh, ERuntimeMeshBenchmarkTarget::ProceduralMesh })
+		{
+			if (Target == ERuntimeMeshBenchmarkTarget::ProceduralMesh && !bCompareWithProceduralMesh)
+			{
+				continue;
+			}
+
+			// Skipped targets have nothing measured, so they don't get a row
+			if (const TCHAR* SkipReason = GetSkipReason(Scenario, Target))
+			{
+				UE_LOG(RuntimeMeshLog, Log, TEXT("RuntimeMesh Benchmark: %s, skipping %s."), SkipReason, RuntimeMeshBenchmark::GetScenarioName(Scenario));
+				continue;
+			}
+
+			Results.Add(RunScenario(Scenario, Target));
+		}
+	}
+
+	UE_LOG(RuntimeMeshLog, Log, TEXT("RuntimeMesh Benchmark: %d components x %d sections, %dx%d grid, %d frames"),
+		NumComponents, NumSectionsPerComponent, GridSize, GridSize, NumFrames);
+	UE_LOG(RuntimeMeshLog, Log, TEXT("%s"), *FRuntimeMeshBenchmarkResult::GetCSVHeader());
+	for (const FRuntimeMeshBenchmarkResult& Result : Results)
+	{
+		UE_LOG(RuntimeMeshLog, Log, TEXT("%s"), *Result.ToCSV());
+	}
+}
+
+bool ARuntimeMeshBenchmarkActor::SaveResults(const FString& FilePath)
+{
+	FString OutputPath = FilePath;
+	if (OutputPath.IsEmpty())
+	{
+		OutputPath = FPaths::GameSavedDir() / TEXT("RuntimeMeshBenchmark") /
+			FString::Printf(TEXT("RuntimeMeshBenchmark-%s.csv"), *FDateTime::Now().ToString());
+	}
+
+	FString Output = FRuntimeMeshBenchmarkResult::GetCSVHeader() + LINE_TERMINATOR;
+	for (const FRuntimeMeshBenchmarkResult& Result : Results)
+	{
+		Output += Result.ToCSV() + LINE_TERMINATOR;
+	}
+
+	bool bSaved = FFileHelper::SaveStringToFile(Output, *OutputPath);
+	if (bSaved)
+	{
+		UE_LOG(RuntimeMeshLog, Log, TEXT("RuntimeMesh Benchmark: Results written to %s"), *OutputPath);
+	}
+	else
+	{
+		UE_LOG(RuntimeMeshLog, Error, TEXT("RuntimeMesh Benchmark: Unable to write results to %s"), *OutputPath);
+	}
+	return bSaved;
+}
+
+const TCHAR* ARuntimeMeshBenchmarkActor::GetSkipReason(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target)
+{
+	if (Target != ERuntimeMeshBenchmarkTarget::ProceduralMesh)
+	{
+		return nullptr;
+	}
+
+#if !WITH_RUNTIMEMESH_PMC_BENCHMARK
+	return TEXT("Built without ProceduralMeshComponent support");
+#else
+	switch (Scenario)
+	{
+	case ERuntimeMeshBenchmarkScenario::MeshBoolean:
+		return TEXT("The ProceduralMeshComponent has no mesh booleans");
+	case ERuntimeMeshBenchmarkScenario::PooledStreamingChurn:
+		return TEXT("The ProceduralMeshComponent has no component pool");
+	default:
+		return nullptr;
+	}
+#endif
+}
+
+FRuntimeMeshBenchmarkResult ARuntimeMeshBenchmarkActor::RunScenario(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target)
+{
+	FRuntimeMeshBenchmarkResult Result;
+	Result.Scenario = Scenario;
+	Result.Target = Target;
+
+	if (const TCHAR* SkipReason = GetSkipReason(Scenario, Target))
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("RuntimeMesh Benchmark: %s, skipping %s."), SkipReason, RuntimeMeshBenchmark::GetScenarioName(Scenario));
+		return Result;
+	}
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	// Start from an idle render thread so setup isn't charged for earlier work
+	World->SendAllEndOfFrameUpdates();
+	FlushRenderingCommands();
+
+	const int64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	int64 PeakMemory = MemoryBefore;
+
+	// Setup
+	URuntimeMeshLibrary::CreateGridMeshTriangles(GridSize, GridSize, true, Triangles);
+	PrepareFrameData(0);
+
+	// One large mesh is enough to measure a boolean
+	const int32 NumScenarioComponents = Scenario == ERuntimeMeshBenchmarkScenario::MeshBoolean ? 1 : NumComponents;
+	if (Scenario == ERuntimeMeshBenchmarkScenario::MeshBoolean)
+	{
+		const float Radius = GridSize * RuntimeMeshBenchmark::GridSpacing * 0.5f;
+		RuntimeMeshBenchmark::CreateSphere(FVector::ZeroVector, Radius, BooleanTriangles, BooleanVertices, BooleanIndices);
+		RuntimeMeshBenchmark::CreateSphere(FVector(Radius * 0.7f, Radius * 0.3f, Radius * 0.1f), Radius * 0.6f, BooleanTriangles / 4, BrushVertices, BrushIndices);
+	}
+
+	if (Scenario == ERuntimeMeshBenchmarkScenario::PooledStreamingChurn)
+	{
+		ComponentPool = NewObject<URuntimeMeshComponentPool>(this);
+		ComponentPool->MaxPooledComponents = NumComponents;
+	}
+
+	NextComponentIndex = 0;
+	for (int32 Index = 0; Index < NumScenarioComponents; Index++)
+	{
+		ActiveComponents.Add(CreateBenchmarkComponent(Scenario, Target, NextComponentIndex++));
+	}
+	World->SendAllEndOfFrameUpdates();
+	FlushRenderingCommands();
+
+	Result.SetupMemoryMB = RuntimeMeshBenchmark::ToMegabytes(FPlatformMemory::GetStats().UsedPhysical - MemoryBefore);
+
+	// Measured frames
+	double GameThreadTotal = 0.0;
+	double RenderThreadTotal = 0.0;
+	for (int32 Frame = 1; Frame <= NumFrames; Frame++)
+	{
+		PrepareFrameData(Frame);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		StepScenario(Scenario, Target, Frame);
+		World->SendAllEndOfFrameUpdates();
+
+		const double GameThreadEnd = FPlatformTime::Seconds();
+
+		FlushRenderingCommands();
+
+		const double RenderThreadEnd = FPlatformTime::Seconds();
+
+		const float GameThreadMs = (GameThreadEnd - StartTime) * 1000.0;
+		const float RenderThreadMs = (RenderThreadEnd - GameThreadEnd) * 1000.0;
+		GameThreadTotal += GameThreadMs;
+		RenderThreadTotal += RenderThreadMs;
+		Result.GameThreadMaxMs = FMath::Max(Result.GameThreadMaxMs, GameThreadMs);
+		Result.RenderThreadMaxMs = FMath::Max(Result.RenderThreadMaxMs, RenderThreadMs);
+
+		PeakMemory = FMath::Max<int64>(PeakMemory, FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	Result.NumFrames = NumFrames;
+	Result.GameThreadMs = GameThreadTotal / NumFrames;
+	Result.RenderThreadMs = RenderThreadTotal / NumFrames;
+	Result.PeakMemoryMB = RuntimeMeshBenchmark::ToMegabytes(PeakMemory - MemoryBefore);
+
+	// Teardown
+	for (UPrimitiveComponent* Component : ActiveComponents)
+	{
+		DestroyBenchmarkComponent(Component);
+	}
+	ActiveComponents.Empty();
+
+	if (ComponentPool)
+	{
+		ComponentPool->LogStats();
+		ComponentPool->Trim();
+		ComponentPool = nullptr;
+	}
+
+	World->SendAllEndOfFrameUpdates();
+	FlushRenderingCommands();
+
+	return Result;
+}
+
+void ARuntimeMeshBenchmarkActor::PrepareFrameData(int32 Frame)
+{
+	const int32 NumVertices = GridSize * GridSize;
+	const float Time = Frame * 0.1f;
+
+	Positions.SetNumUninitialized(NumVertices);
+	Normals.SetNumUninitialized(NumVertices);
+	UVs.SetNumUninitialized(NumVertices);
+	Colors.SetNumUninitialized(NumVertices);
+	Vertices.SetNumUninitialized(NumVertices);
+	VertexData.SetNumUninitialized(NumVertices);
+
+	for (int32 XIdx = 0; XIdx < GridSize; XIdx++)
+	{
+		for (int32 YIdx = 0; YIdx < GridSize; YIdx++)
+		{
+			const int32 Index = XIdx * GridSize + YIdx;
+
+			const float Phase = (XIdx + YIdx) * 0.3f + Time;
+			Positions[Index] = FVector(XIdx * RuntimeMeshBenchmark::GridSpacing, YIdx * RuntimeMeshBenchmark::GridSpacing,
+				FMath::Sin(Phase) * RuntimeMeshBenchmark::WaveHeight);
+			Normals[Index] = FVector(-FMath::Cos(Phase), -FMath::Cos(Phase), 1.0f).GetSafeNormal();
+			UVs[Index] = FVector2D(XIdx / float(GridSize - 1), YIdx / float(GridSize - 1));
+			Colors[Index] = FColor::White;
+
+			Vertices[Index] = FRuntimeMeshVertexSimple(Positions[Index], Normals[Index], FRuntimeMeshTangent(), Colors[Index], UVs[Index]);
+			VertexData[Index] = FRuntimeMeshVertexNoPosition(Normals[Index], FRuntimeMeshTangent(), Colors[Index], UVs[Index]);
+		}
+	}
+}
+
+UPrimitiveComponent* ARuntimeMeshBenchmarkActor::CreateBenchmarkComponent(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target, int32 ComponentIndex)
+{
+	UPrimitiveComponent* NewComponent = nullptr;
+
+	if (Target == ERuntimeMeshBenchmarkTarget::RuntimeMesh)
+	{
+		// Pooled components come back registered and attached
+		URuntimeMeshComponent* RuntimeMesh = ComponentPool ? ComponentPool->AcquireComponent(this, RootComponent) : NewObject<URuntimeMeshComponent>(this);
+
+		const int32 NumSections = Scenario == ERuntimeMeshBenchmarkScenario::MeshBoolean ? 0 : NumSectionsPerComponent;
+		for (int32 SectionIdx = 0; SectionIdx < NumSections; SectionIdx++)
+		{
+			switch (Scenario)
+			{
+			case ERuntimeMeshBenchmarkScenario::MixedFrequency:
+				RuntimeMesh->CreateMeshSection(SectionIdx, Vertices, Triangles, false, RuntimeMeshBenchmark::GetMixedUpdateFrequency(ComponentIndex, SectionIdx));
+				break;
+			case ERuntimeMeshBenchmarkScenario::PositionAnimation:
+				RuntimeMesh->CreateMeshSectionDualBuffer(SectionIdx, Positions, VertexData, Triangles, false, EUpdateFrequency::Frequent);
+				break;
+			case ERuntimeMeshBenchmarkScenario::StreamingChurn:
+			case ERuntimeMeshBenchmarkScenario::PooledStreamingChurn:
+				RuntimeMesh->CreateMeshSection(SectionIdx, Vertices, Triangles, false, EUpdateFrequency::Average);
+				break;
+			case ERuntimeMeshBenchmarkScenario::BatchUpdates:
+				RuntimeMesh->CreateMeshSection(SectionIdx, Vertices, Triangles, false, EUpdateFrequency::Frequent);
+				break;
+			default:
+				break;
+			}
+		}
+
+		NewComponent = RuntimeMesh;
+	}
+#if WITH_RUNTIMEMESH_PMC_BENCHMARK
+	else
+	{
+		UProceduralMeshComponent* ProceduralMesh = NewObject<UProceduralMeshComponent>(this);
+
+		for (int32 SectionIdx = 0; SectionIdx < NumSectionsPerComponent; SectionIdx++)
+		{
+			ProceduralMesh->CreateMeshSection(SectionIdx, Positions, Triangles, Normals, UVs, Colors, TArray<FProcMeshTangent>(), false);
+		}
+
+		NewComponent = ProceduralMesh;
+	}
+#endif
+
+	check(NewComponent);
+
+	// Lay the components out in a square so they don't all overlap
+	const int32 ComponentsPerRow = FMath::CeilToInt(FMath::Sqrt(NumComponents));
+	const float ComponentExtent = GridSize * RuntimeMeshBenchmark::GridSpacing;
+	NewComponent->SetRelativeLocation(FVector((ComponentIndex % ComponentsPerRow) * ComponentExtent, ((ComponentIndex / ComponentsPerRow) % ComponentsPerRow) * ComponentExtent, 0.0f));
+	if (!NewComponent->IsRegistered())
+	{
+		NewComponent->SetupAttachment(RootComponent);
+		NewComponent->RegisterComponent();
+	}
+
+	return NewComponent;
+}
+
+void ARuntimeMeshBenchmarkActor::DestroyBenchmarkComponent(UPrimitiveComponent* Component)
+{
+	if (ComponentPool)
+	{
+		ComponentPool->ReleaseComponent(CastChecked<URuntimeMeshComponent>(Component));
+	}
+	else if (Component)
+	{
+		Component->DestroyComponent();
+	}
+}
+
+void ARuntimeMeshBenchmarkActor::StepScenario(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target, int32 Frame)
+{
+	if (Scenario == ERuntimeMeshBenchmarkScenario::StreamingChurn || Scenario == ERuntimeMeshBenchmarkScenario::PooledStreamingChurn)
+	{
+		// Replace the oldest eighth of the components every frame
+		const int32 NumToReplace = FMath::Max(1, NumComponents / 8);
+		for (int32 Index = 0; Index < NumToReplace && ActiveComponents.Num() > 0; Index++)
+		{
+			DestroyBenchmarkComponent(ActiveComponents[0]);
+			ActiveComponents.RemoveAt(0, 1, false);
+			ActiveComponents.Add(CreateBenchmarkComponent(Scenario, Target, NextComponentIndex++));
+		}
+		return;
+	}
+
+	for (int32 ComponentIdx = 0; ComponentIdx < ActiveComponents.Num(); ComponentIdx++)
+	{
+		if (Target == ERuntimeMeshBenchmarkTarget::RuntimeMesh)
+		{
+			URuntimeMeshComponent* RuntimeMesh = CastChecked<URuntimeMeshComponent>(ActiveComponents[ComponentIdx]);
+
+			switch (Scenario)
+			{
+			case ERuntimeMeshBenchmarkScenario::MixedFrequency:
+				for (int32 SectionIdx = 0; SectionIdx < NumSectionsPerComponent; SectionIdx++)
+				{
+					if (RuntimeMeshBenchmark::GetMixedUpdateFrequency(ComponentIdx, SectionIdx) == EUpdateFrequency::Frequent)
+					{
+						RuntimeMesh->UpdateMeshSection(SectionIdx, Vertices);
+					}
+				}
+				break;
+
+			case ERuntimeMeshBenchmarkScenario::PositionAnimation:
+				for (int32 SectionIdx = 0; SectionIdx < NumSectionsPerComponent; SectionIdx++)
+				{
+					RuntimeMesh->UpdateMeshSectionPositionsImmediate(SectionIdx, Positions);
+				}
+				break;
+
+			case ERuntimeMeshBenchmarkScenario::BatchUpdates:
+				RuntimeMesh->BeginBatchUpdates();
+				for (int32 SectionIdx = 0; SectionIdx < NumSectionsPerComponent; SectionIdx++)
+				{
+					RuntimeMesh->UpdateMeshSection(SectionIdx, Vertices);
+				}
+				RuntimeMesh->EndBatchUpdates();
+				break;
+
+			case ERuntimeMeshBenchmarkScenario::MeshBoolean:
+				// Start from the original spheres each frame so every frame does the same work
+				RuntimeMesh->BeginBatchUpdates();
+				RuntimeMesh->CreateMeshSection(0, BooleanVertices, BooleanIndices, false, EUpdateFrequency::Average);
+				RuntimeMesh->CreateMeshSection(1, BrushVertices, BrushIndices, false, EUpdateFrequency::Average);
+				RuntimeMesh->BooleanMeshSections(0, 1, ERuntimeMeshBooleanOperation::Subtract);
+				RuntimeMesh->EndBatchUpdates();
+				break;
+
+			default:
+				break;
+			}
+		}
+#if WITH_RUNTIMEMESH_PMC_BENCHMARK
+		else
+		{
+			UProceduralMeshComponent* ProceduralMesh = CastChecked<UProceduralMeshComponent>(ActiveComponents[ComponentIdx]);
+
+			for (int32 SectionIdx = 0; SectionIdx < NumSectionsPerComponent; SectionIdx++)
+			{
+				// The PMC has no notion of update frequency, so only update the same sections the RMC does
+				if (Scenario == ERuntimeMeshBenchmarkScenario::MixedFrequency &&
+					RuntimeMeshBenchmark::GetMixedUpdateFrequency(ComponentIdx, SectionIdx) != EUpdateFrequency::Frequent)
+				{
+					continue;
+				}
+
+				ProceduralMesh->UpdateMeshSection(SectionIdx, Positions, Normals, UVs, Colors, TArray<FProcMeshTangent>());
+			}
+		}
+#endif
+	}
+}
+
+
+
+URuntimeMeshBenchmarkCommandlet::URuntimeMeshBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 URuntimeMeshBenchmarkCommandlet::Main(const FString& Params)
+{
+	// Transient game world to hold the benchmark
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("RuntimeMeshBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	ARuntimeMeshBenchmarkActor* Benchmark = World->SpawnActor<ARuntimeMeshBenchmarkActor>();
+	check(Benchmark);
+
+	FParse::Value(*Params, TEXT("Components="), Benchmark->NumComponents);
+	FParse::Value(*Params, TEXT("Sections="), Benchmark->NumSectionsPerComponent);
+	FParse::Value(*Params, TEXT("Grid="), Benchmark->GridSize);
+	FParse::Value(*Params, TEXT("Frames="), Benchmark->NumFrames);
+	FParse::Value(*Params, TEXT("BooleanTriangles="), Benchmark->BooleanTriangles);
+
+	Benchmark->NumComponents = FMath::Max(1, Benchmark->NumComponents);
+	Benchmark->NumSectionsPerComponent = FMath::Max(1, Benchmark->NumSectionsPerComponent);
+	Benchmark->GridSize = FMath::Max(2, Benchmark->GridSize);
+	Benchmark->NumFrames = FMath::Max(1, Benchmark->NumFrames);
+	Benchmark->BooleanTriangles = FMath::Max(8, Benchmark->BooleanTriangles);
+	Benchmark->bCompareWithProceduralMesh = (WITH_RUNTIMEMESH_PMC_BENCHMARK != 0) && !FParse::Param(*Params, TEXT("NoPMC"));
+
+	FString ScenarioName;
+	if (FParse::Value(*Params, TEXT("Scenario="), ScenarioName))
+	{
+		Benchmark->Scenarios.Empty();
+		for (ERuntimeMeshBenchmarkScenario Scenario : { ERuntimeMeshBenchmarkScenario::MixedFrequency, ERuntimeMeshBenchmarkScenario::PositionAnimation,
+			ERuntimeMeshBenchmarkScenario::StreamingChurn, ERuntimeMeshBenchmarkScenario::BatchUpdates, ERuntimeMeshBenchmarkScenario::MeshBoolean,
+			ERuntimeMeshBenchmarkScenario::PooledStreamingChurn })
+		{
+			if (ScenarioName == RuntimeMeshBenchmark::GetScenarioName(Scenario))
+			{
+				Benchmark->Scenarios.Add(Scenario);
+			}
+		}
+
+		if (Benchmark->Scenarios.Num() == 0)
+		{
+			UE_LOG(RuntimeMeshLog, Error, TEXT("RuntimeMesh Benchmark: Unknown scenario '%s'"), *ScenarioName);
+		}
+	}
+
+	FString OutputPath;
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	Benchmark->RunAllScenarios();
+	bool bSaved = Benchmark->SaveResults(OutputPath);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return (bSaved && Benchmark->Scenarios.Num() > 0) ? 0 : 1;
+}
@@ -0,0 +1,1046 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshBoolean.h"
+#include "RuntimeMeshWelding.h"
+
+
+const float FRuntimeMeshBoolean::PlaneTolerance = 0.001f;
+const float FRuntimeMeshBoolean::CoplanarTolerance = 0.01f;
+
+
+namespace RuntimeMeshBooleanInternal
+{
+	/* Which side of the other mesh a piece of surface is on */
+	enum class ESide : uint8
+	{
+		Outside,
+		Inside,
+		/* On the other surface, facing the same way */
+		CoplanarSame,
+		/* On the other surface, facing the other way */
+		CoplanarOpposite,
+	};
+
+	/* Corner of a piece of a triangle, with its weights in the source triangle and where on the triangle it lies */
+	struct FPieceVertex
+	{
+		FVector Position;
+		FVector Barycentrics;
+
+		/* Corner of the source triangle this is, or INDEX_NONE */
+		int32 Corner;
+
+		/* Edge of the source triangle this lies on, from corner Edge to the next one, or INDEX_NONE */
+		int32 Edge;
+
+		FPieceVertex() { }
+		FPieceVertex(const FVector& InPosition, const FVector& InBarycentrics, int32 InCorner, int32 InEdge)
+			: Position(InPosition), Barycentrics(InBarycentrics), Corner(InCorner), Edge(InEdge) { }
+
+		bool IsOnEdge(int32 InEdge) const
+		{
+			return Edge == InEdge || Corner == InEdge || Corner == (InEdge + 1) % 3;
+		}
+	};
+
+	/* Convex piece of a triangle, wound the same way as the triangle */
+	typedef TArray<FPieceVertex, TInlineAllocator<8>> FPiece;
+
+	/* Triangle of the other mesh crossing a triangle, and the range both triangles cover along the line where their planes meet */
+	struct FCutter
+	{
+		FPlane Plane;
+		FVector Axis;
+		float Min;
+		float Max;
+	};
+
+	/* Vertex of a cut, with where it lies on the source mesh so neighboring triangles can share it */
+	struct FCutVertex
+	{
+		FVector Position;
+		FVector Barycentrics;
+		int32 SourceTriangle;
+
+		/* Vertex of the source mesh this is, for corners of the source triangle, or INDEX_NONE */
+		int32 SourceVertex;
+
+		/* Source mesh vertices at the ends of the source edge this lies on, lowest first, or INDEX_NONE */
+		int32 EdgeStart;
+		int32 EdgeEnd;
+	};
+
+	/* What a range of triangles keeps. Cut triangles stay convex polygons until the T-junctions between them are filled in. */
+	struct FPolygonCut
+	{
+		TArray<int32> WholeTriangles;
+		TArray<FCutVertex> Vertices;
+
+		/* Vertices of every polygon in order, and how many each polygon has */
+		TArray<int32> PolygonVertices;
+		TArray<int32> PolygonSizes;
+		TArray<int32> PolygonSourceTriangles;
+	};
+
+	bool ShouldKeep(ESide Side, ERuntimeMeshBooleanOperation Operation, bool bIsFirstOperand)
+	{
+		// Shared surfaces are only kept from the first operand so they don't end up in the result twice
+		switch (Operation)
+		{
+		case ERuntimeMeshBooleanOperation::Union:
+			return Side == ESide::Outside || (bIsFirstOperand && Side == ESide::CoplanarSame);
+		case ERuntimeMeshBooleanOperation::Intersect:
+			return Side == ESide::Inside || (bIsFirstOperand && Side == ESide::CoplanarSame);
+		case ERuntimeMeshBooleanOperation::Subtract:
+			return bIsFirstOperand ? (Side == ESide::Outside || Side == ESide::CoplanarOpposite) : Side == ESide::Inside;
+		}
+		return false;
+	}
+
+	/* Range covered along Axis by the part of a convex polygon lying on a plane, given the distances of its corners to the plane */
+	bool GetRangeOnPlane(const FVector* Corners, const float* Distances, int32 NumCorners, const FVector& Axis, float& OutMin, float& OutMax)
+	{
+		OutMin = BIG_NUMBER;
+		OutMax = -BIG_NUMBER;
+
+		for (int32 Index = 0; Index < NumCorners; Index++)
+		{
+			const int32 Next = (Index + 1) % NumCorners;
+			const float Distance = Distances[Index];
+			const float NextDistance = Distances[Next];
+
+			if (FMath::Abs(Distance) <= FRuntimeMeshBoolean::PlaneTolerance)
+			{
+				const float Projected = Corners[Index] | Axis;
+				OutMin = FMath::Min(OutMin, Projected);
+				OutMax = FMath::Max(OutMax, Projected);
+			}
+			else if ((Distance > FRuntimeMeshBoolean::PlaneTolerance && NextDistance < -FRuntimeMeshBoolean::PlaneTolerance) ||
+				(Distance < -FRuntimeMeshBoolean::PlaneTolerance && NextDistance > FRuntimeMeshBoolean::PlaneTolerance))
+			{
+				const FVector Crossing = FMath::Lerp(Corners[Index], Corners[Next], Distance / (Distance - NextDistance));
+				const float Projected = Crossing | Axis;
+				OutMin = FMath::Min(OutMin, Projected);
+				OutMax = FMath::Max(OutMax, Projected);
+			}
+		}
+
+		return OutMin <= OutMax;
+	}
+
+	bool IsOnOneSide(const float (&Distances)[3])
+	{
+		return (Distances[0] > FRuntimeMeshBoolean::PlaneTolerance && Distances[1] > FRuntimeMeshBoolean::PlaneTolerance && Distances[2] > FRuntimeMeshBoolean::PlaneTolerance) ||
+			(Distances[0] < -FRuntimeMeshBoolean::PlaneTolerance && Distances[1] < -FRuntimeMeshBoolean::PlaneTolerance && Distances[2] < -FRuntimeMeshBoolean::PlaneTolerance);
+	}
+
+	/**
+	*	Does triangle A cross triangle B, so A has to be cut by B's plane. Coplanar triangles don't count, the triangles
+	*	around them do. Both the planes and the ranges the triangles cover along the line where the planes meet are checked,
+	*	and the overlap of those ranges is where B actually cuts A.
+	*/
+	bool ShouldCut(const FVector (&A)[3], const FVector& NormalA, const FVector (&B)[3], const FPlane& PlaneB, FCutter& OutCutter)
+	{
+		float DistancesA[3];
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			DistancesA[Index] = PlaneB.PlaneDot(A[Index]);
+		}
+		if (IsOnOneSide(DistancesA))
+		{
+			return false;
+		}
+
+		const FPlane PlaneA(A[0], NormalA);
+		float DistancesB[3];
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			DistancesB[Index] = PlaneA.PlaneDot(B[Index]);
+		}
+		if (IsOnOneSide(DistancesB))
+		{
+			return false;
+		}
+
+		const FVector Axis = (NormalA ^ FVector(PlaneB)).GetSafeNormal();
+		if (Axis.IsZero())
+		{
+			return false;
+		}
+
+		float MinA, MaxA, MinB, MaxB;
+		if (!GetRangeOnPlane(A, DistancesA, 3, Axis, MinA, MaxA) || !GetRangeOnPlane(B, DistancesB, 3, Axis, MinB, MaxB) ||
+			MinA > MaxB + FRuntimeMeshBoolean::PlaneTolerance || MinB > MaxA + FRuntimeMeshBoolean::PlaneTolerance)
+		{
+			return false;
+		}
+
+		OutCutter.Plane = PlaneB;
+		OutCutter.Axis = Axis;
+		OutCutter.Min = FMath::Max(MinA, MinB);
+		OutCutter.Max = FMath::Min(MaxA, MaxB);
+		return true;
+	}
+
+	/* Lexicographic order of positions */
+	bool IsBefore(const FVector& A, const FVector& B)
+	{
+		return A.X != B.X ? A.X < B.X : (A.Y != B.Y ? A.Y < B.Y : A.Z < B.Z);
+	}
+
+	/* Where a plane crosses the segment between two vertices, computed the same way whichever direction the segment is walked */
+	FPieceVertex GetCrossing(const FPieceVertex& A, const FPieceVertex& B, const FPlane& Plane, int32 Edge)
+	{
+		const bool bInOrder = IsBefore(A.Position, B.Position);
+		const FPieceVertex& Start = bInOrder ? A : B;
+		const FPieceVertex& End = bInOrder ? B : A;
+
+		const float StartDistance = Plane.PlaneDot(Start.Position);
+		const float EndDistance = Plane.PlaneDot(End.Position);
+		const float Alpha = StartDistance / (StartDistance - EndDistance);
+		return FPieceVertex(FMath::Lerp(Start.Position, End.Position, Alpha), FMath::Lerp(Start.Barycentrics, End.Barycentrics, Alpha), INDEX_NONE, Edge);
+	}
+
+	/* Edge of the source triangle both vertices lie on, or INDEX_NONE if the segment between them crosses the inside */
+	int32 GetSharedEdge(const FPieceVertex& A, const FPieceVertex& B)
+	{
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			if (A.IsOnEdge(Edge) && B.IsOnEdge(Edge))
+			{
+				return Edge;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	*	Splits a convex piece along a cutter's plane, if the cutting triangle reaches the part of the plane inside the piece.
+	*	Pieces it doesn't reach are left whole so each cut only spreads across the pieces it passes through.
+	*	Returns false, leaving the outputs empty, if the piece isn't split.
+	*/
+	bool SplitPiece(const FPiece& Piece, const FPiece& Triangle, const FCutter& Cutter, FPiece& OutFront, FPiece& OutBack)
+	{
+		TArray<FVector, TInlineAllocator<8>> PiecePositions;
+		TArray<float, TInlineAllocator<8>> PieceDistances;
+		PiecePositions.SetNumUninitialized(Piece.Num());
+		PieceDistances.SetNumUninitialized(Piece.Num());
+
+		bool bHasFront = false;
+		bool bHasBack = false;
+		for (int32 Index = 0; Index < Piece.Num(); Index++)
+		{
+			PiecePositions[Index] = Piece[Index].Position;
+			PieceDistances[Index] = Cutter.Plane.PlaneDot(Piece[Index].Position);
+			bHasFront |= PieceDistances[Index] > FRuntimeMeshBoolean::PlaneTolerance;
+			bHasBack |= PieceDistances[Index] < -FRuntimeMeshBoolean::PlaneTolerance;
+		}
+
+		if (!bHasFront || !bHasBack)
+		{
+			return false;
+		}
+
+		float PieceMin, PieceMax;
+		if (!GetRangeOnPlane(PiecePositions.GetData(), PieceDistances.GetData(), Piece.Num(), Cutter.Axis, PieceMin, PieceMax) ||
+			PieceMin >= Cutter.Max - FRuntimeMeshBoolean::PlaneTolerance || Cutter.Min >= PieceMax - FRuntimeMeshBoolean::PlaneTolerance)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Piece.Num(); Index++)
+		{
+			const int32 Next = (Index + 1) % Piece.Num();
+			const float Distance = PieceDistances[Index];
+			const float NextDistance = PieceDistances[Next];
+
+			if (Distance >= -FRuntimeMeshBoolean::PlaneTolerance)
+			{
+				OutFront.Add(Piece[Index]);
+			}
+			if (Distance <= FRuntimeMeshBoolean::PlaneTolerance)
+			{
+				OutBack.Add(Piece[Index]);
+			}
+
+			if ((Distance > FRuntimeMeshBoolean::PlaneTolerance && NextDistance < -FRuntimeMeshBoolean::PlaneTolerance) ||
+				(Distance < -FRuntimeMeshBoolean::PlaneTolerance && NextDistance > FRuntimeMeshBoolean::PlaneTolerance))
+			{
+				// Crossings on the triangle's edges are taken from its corners, so the triangle across the edge makes exactly the same vertex
+				const int32 Edge = GetSharedEdge(Piece[Index], Piece[Next]);
+				const FPieceVertex Crossing = Edge != INDEX_NONE
+					? GetCrossing(Triangle[Edge], Triangle[(Edge + 1) % 3], Cutter.Plane, Edge)
+					: GetCrossing(Piece[Index], Piece[Next], Cutter.Plane, INDEX_NONE);
+				OutFront.Add(Crossing);
+				OutBack.Add(Crossing);
+			}
+		}
+
+		return true;
+	}
+
+	ESide Classify(const FRuntimeMeshBVH& Other, const FVector& Point, const FVector& Normal)
+	{
+		FRuntimeMeshQueryHit Hit;
+		if (Other.GetClosestPoint(Point, FRuntimeMeshBoolean::CoplanarTolerance, Hit))
+		{
+			const float Facing = Hit.Normal | Normal;
+			if (FMath::Abs(Facing) > 0.999f)
+			{
+				return Facing > 0.0f ? ESide::CoplanarSame : ESide::CoplanarOpposite;
+			}
+		}
+
+		return Other.IsPointInside(Point) ? ESide::Inside : ESide::Outside;
+	}
+
+
+	/* Adds a corner of a kept piece, reusing the vertex another piece of the same triangle already has there */
+	int32 AddPieceVertex(const FPieceVertex& Vertex, int32 SourceTriangle, const int32 (&SourceVertices)[3], int32 FirstVertexOfTriangle, FPolygonCut& OutCut)
+	{
+		const int32 SourceVertex = Vertex.Corner != INDEX_NONE ? SourceVertices[Vertex.Corner] : INDEX_NONE;
+		const int32 EdgeStart = Vertex.Edge != INDEX_NONE ? FMath::Min(SourceVertices[Vertex.Edge], SourceVertices[(Vertex.Edge + 1) % 3]) : INDEX_NONE;
+		const int32 EdgeEnd = Vertex.Edge != INDEX_NONE ? FMath::Max(SourceVertices[Vertex.Edge], SourceVertices[(Vertex.Edge + 1) % 3]) : INDEX_NONE;
+
+		for (int32 Index = FirstVertexOfTriangle; Index < OutCut.Vertices.Num(); Index++)
+		{
+			FCutVertex& Existing = OutCut.Vertices[Index];
+			if (SourceVertex != INDEX_NONE ? Existing.SourceVertex == SourceVertex
+				: (Existing.SourceVertex == INDEX_NONE && Existing.Position.Equals(Vertex.Position, FRuntimeMeshBoolean::PlaneTolerance)))
+			{
+				if (Existing.EdgeStart == INDEX_NONE)
+				{
+					Existing.EdgeStart = EdgeStart;
+					Existing.EdgeEnd = EdgeEnd;
+				}
+				return Index;
+			}
+		}
+
+		FCutVertex NewVertex;
+		NewVertex.Position = Vertex.Position;
+		NewVertex.Barycentrics = Vertex.Barycentrics;
+		NewVertex.SourceTriangle = SourceTriangle;
+		NewVertex.SourceVertex = SourceVertex;
+		NewVertex.EdgeStart = EdgeStart;
+		NewVertex.EdgeEnd = EdgeEnd;
+		return OutCut.Vertices.Add(NewVertex);
+	}
+
+	void CutRange(const FRuntimeMeshBVH& Mesh, const FRuntimeMeshBVH& Other, const FBox& OtherBounds, ERuntimeMeshBooleanOperation Operation, bool bIsFirstOperand,
+		int32 FirstTriangle, int32 LastTriangle, FPolygonCut& OutCut)
+	{
+		const TArray<FVector>& Positions = Mesh.GetPositions();
+		const TArray<int32>& Indices = Mesh.GetIndices();
+		const TArray<FVector>& OtherPositions = Other.GetPositions();
+		const TArray<int32>& OtherIndices = Other.GetIndices();
+
+		TArray<int32> Candidates;
+		TArray<FCutter, TInlineAllocator<16>> Cutters;
+		TArray<FPiece, TInlineAllocator<16>> Pieces;
+		TArray<FPiece, TInlineAllocator<16>> NextPieces;
+
+		for (int32 Triangle = FirstTriangle; Triangle < LastTriangle; Triangle++)
+		{
+			const int32 SourceVertices[3] = { Indices[Triangle * 3 + 0], Indices[Triangle * 3 + 1], Indices[Triangle * 3 + 2] };
+			const FVector Corners[3] = { Positions[SourceVertices[0]], Positions[SourceVertices[1]], Positions[SourceVertices[2]] };
+			const FVector Normal = ((Corners[1] - Corners[0]) ^ (Corners[2] - Corners[0])).GetSafeNormal();
+			if (Normal.IsZero())
+			{
+				continue;
+			}
+
+			FBox TriangleBounds(Corners, 3);
+			TriangleBounds = TriangleBounds.ExpandBy(FRuntimeMeshBoolean::PlaneTolerance);
+
+			// Find the triangles of the other mesh that cross this one
+			Cutters.Reset();
+			if (OtherBounds.IsValid && TriangleBounds.Intersect(OtherBounds))
+			{
+				Candidates.Reset();
+				Other.GetTrianglesInBox(TriangleBounds, Candidates);
+
+				for (int32 Candidate : Candidates)
+				{
+					const FVector OtherCorners[3] = { OtherPositions[OtherIndices[Candidate * 3 + 0]], OtherPositions[OtherIndices[Candidate * 3 + 1]], OtherPositions[OtherIndices[Candidate * 3 + 2]] };
+					const FVector OtherNormal = ((OtherCorners[1] - OtherCorners[0]) ^ (OtherCorners[2] - OtherCorners[0])).GetSafeNormal();
+					if (OtherNormal.IsZero())
+					{
+						continue;
+					}
+
+					FCutter Cutter;
+					if (ShouldCut(Corners, Normal, OtherCorners, FPlane(OtherCorners[0], OtherNormal), Cutter))
+					{
+						Cutters.Add(Cutter);
+					}
+				}
+			}
+
+			if (Cutters.Num() == 0)
+			{
+				const FVector Centroid = (Corners[0] + Corners[1] + Corners[2]) / 3.0f;
+				if (ShouldKeep(Classify(Other, Centroid, Normal), Operation, bIsFirstOperand))
+				{
+					OutCut.WholeTriangles.Add(Triangle);
+				}
+				continue;
+			}
+
+			// Split the triangle into convex pieces that are each entirely on one side of the other surface
+			FPiece Whole;
+			Whole.Add(FPieceVertex(Corners[0], FVector(1, 0, 0), 0, INDEX_NONE));
+			Whole.Add(FPieceVertex(Corners[1], FVector(0, 1, 0), 1, INDEX_NONE));
+			Whole.Add(FPieceVertex(Corners[2], FVector(0, 0, 1), 2, INDEX_NONE));
+
+			Pieces.Reset();
+			Pieces.Add(Whole);
+
+			for (const FCutter& Cutter : Cutters)
+			{
+				NextPieces.Reset();
+				for (const FPiece& Piece : Pieces)
+				{
+					FPiece Front, Back;
+					if (SplitPiece(Piece, Whole, Cutter, Front, Back))
+					{
+						if (Front.Num() >= 3)
+						{
+							NextPieces.Add(MoveTemp(Front));
+						}
+						if (Back.Num() >= 3)
+						{
+							NextPieces.Add(MoveTemp(Back));
+						}
+					}
+					else
+					{
+						NextPieces.Add(Piece);
+					}
+				}
+				Swap(Pieces, NextPieces);
+			}
+
+			const int32 FirstVertexOfTriangle = OutCut.Vertices.Num();
+			for (const FPiece& Piece : Pieces)
+			{
+				FVector Centroid(0, 0, 0);
+				for (const FPieceVertex& Vertex : Piece)
+				{
+					Centroid += Vertex.Position;
+				}
+				Centroid /= Piece.Num();
+
+				if (!ShouldKeep(Classify(Other, Centroid, Normal), Operation, bIsFirstOperand))
+				{
+					continue;
+				}
+
+				for (const FPieceVertex& Vertex : Piece)
+				{
+					OutCut.PolygonVertices.Add(AddPieceVertex(Vertex, Triangle, SourceVertices, FirstVertexOfTriangle, OutCut));
+				}
+				OutCut.PolygonSizes.Add(Piece.Num());
+				OutCut.PolygonSourceTriangles.Add(Triangle);
+			}
+		}
+	}
+
+	uint64 GetEdgeKey(int32 EdgeStart, int32 EdgeEnd)
+	{
+		return ((uint64)(uint32)EdgeStart << 32) | (uint64)(uint32)EdgeEnd;
+	}
+
+	/* Vertices a merged cut made on each source edge, by GetEdgeKey() */
+	typedef TMap<uint64, TArray<int32, TInlineAllocator<4>>> FEdgeVertexMap;
+
+	/**
+	*	Adds a vertex to the merged cut. Corners of cut triangles are shared by source vertex, and vertices on a source edge
+	*	are shared with the triangle on the other side of the edge, which makes the same vertex wherever the same triangle cuts it.
+	*/
+	int32 WeldVertex(const FCutVertex& Vertex, FPolygonCut& Merged, TMap<int32, int32>& CornerVertices, FEdgeVertexMap& EdgeVertices)
+	{
+		if (Vertex.SourceVertex != INDEX_NONE)
+		{
+			if (const int32* Existing = CornerVertices.Find(Vertex.SourceVertex))
+			{
+				return *Existing;
+			}
+			return CornerVertices.Add(Vertex.SourceVertex, Merged.Vertices.Add(Vertex));
+		}
+
+		if (Vertex.EdgeStart != INDEX_NONE)
+		{
+			TArray<int32, TInlineAllocator<4>>& OnEdge = EdgeVertices.FindOrAdd(GetEdgeKey(Vertex.EdgeStart, Vertex.EdgeEnd));
+			for (int32 Existing : OnEdge)
+			{
+				if (Merged.Vertices[Existing].Position.Equals(Vertex.Position, FRuntimeMeshBoolean::PlaneTolerance))
+				{
+					return Existing;
+				}
+			}
+			return OnEdge[OnEdge.Add(Merged.Vertices.Add(Vertex))];
+		}
+
+		return Merged.Vertices.Add(Vertex);
+	}
+
+	/* Source edge two vertices of the same triangle both lie on. False if the segment between them crosses the inside of the triangle. */
+	bool GetSharedSourceEdge(const FCutVertex& A, const FCutVertex& B, int32& OutEdgeStart, int32& OutEdgeEnd)
+	{
+		if (A.SourceVertex != INDEX_NONE && B.SourceVertex != INDEX_NONE)
+		{
+			OutEdgeStart = FMath::Min(A.SourceVertex, B.SourceVertex);
+			OutEdgeEnd = FMath::Max(A.SourceVertex, B.SourceVertex);
+			return A.SourceVertex != B.SourceVertex;
+		}
+
+		const FCutVertex& OnEdge = A.SourceVertex != INDEX_NONE ? B : A;
+		const FCutVertex& Other = A.SourceVertex != INDEX_NONE ? A : B;
+		OutEdgeStart = OnEdge.EdgeStart;
+		OutEdgeEnd = OnEdge.EdgeEnd;
+		if (OnEdge.EdgeStart == INDEX_NONE)
+		{
+			return false;
+		}
+		return Other.SourceVertex != INDEX_NONE
+			? (Other.SourceVertex == OnEdge.EdgeStart || Other.SourceVertex == OnEdge.EdgeEnd)
+			: (Other.EdgeStart == OnEdge.EdgeStart && Other.EdgeEnd == OnEdge.EdgeEnd);
+	}
+
+	/* Vertex found inside a segment, and how far along it */
+	struct FOnSegment
+	{
+		float Alpha;
+		int32 Vertex;
+		bool operator<(const FOnSegment& Other) const { return Alpha < Other.Alpha; }
+	};
+
+	/* Appends the candidates lying inside the segment from A to B, in order along it */
+	void AddVerticesOnSegment(int32 A, int32 B, const int32* Candidates, int32 NumCandidates, const TArray<FCutVertex>& Vertices, TArray<int32, TInlineAllocator<16>>& OutPolygon)
+	{
+		TArray<FOnSegment, TInlineAllocator<8>> OnSegment;
+
+		const FVector Start = Vertices[A].Position;
+		const FVector Direction = Vertices[B].Position - Start;
+		const float LengthSquared = Direction.SizeSquared();
+		if (LengthSquared <= FMath::Square(FRuntimeMeshBoolean::PlaneTolerance))
+		{
+			return;
+		}
+		const float AlphaTolerance = FRuntimeMeshBoolean::PlaneTolerance / FMath::Sqrt(LengthSquared);
+
+		for (int32 Index = 0; Index < NumCandidates; Index++)
+		{
+			const int32 Candidate = Candidates[Index];
+			if (Candidate == A || Candidate == B)
+			{
+				continue;
+			}
+
+			const FVector& Position = Vertices[Candidate].Position;
+			const float Alpha = ((Position - Start) | Direction) / LengthSquared;
+			if (Alpha > AlphaTolerance && Alpha < 1.0f - AlphaTolerance &&
+				FVector::DistSquared(Position, Start + Direction * Alpha) <= FMath::Square(FRuntimeMeshBoolean::PlaneTolerance))
+			{
+				FOnSegment& Found = OnSegment[OnSegment.AddUninitialized()];
+				Found.Alpha = Alpha;
+				Found.Vertex = Candidate;
+			}
+		}
+
+		OnSegment.Sort();
+		for (const FOnSegment& Found : OnSegment)
+		{
+			OutPolygon.Add(Found.Vertex);
+		}
+	}
+
+	/* Is B on the line through A and C */
+	bool IsCollinear(const FVector& A, const FVector& B, const FVector& C)
+	{
+		return ((B - A) ^ (C - A)).Size() <= FRuntimeMeshBoolean::PlaneTolerance * (C - A).Size();
+	}
+
+	/**
+	*	Finds a corner of a convex polygon that doesn't have a run of collinear vertices along either of its sides, so a fan
+	*	from it has no slivers. INDEX_NONE if there's none.
+	*	@param	GetPosition		Callable returning the position of a polygon vertex, (int32) -> FVector, wrapping around
+	*/
+	template<typename PositionAccessor>
+	int32 FindFanApex(int32 Num, const PositionAccessor& GetPosition)
+	{
+		for (int32 Apex = 0; Apex < Num; Apex++)
+		{
+			if (!IsCollinear(GetPosition(Apex), GetPosition(Apex + 1), GetPosition(Apex + 2)) &&
+				!IsCollinear(GetPosition(Apex - 2), GetPosition(Apex - 1), GetPosition(Apex)))
+			{
+				return Apex;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/* Fans a polygon into triangles from one of its corners */
+	template<typename AllocatorType>
+	void AddFan(const TArray<int32, TInlineAllocator<16>>& Polygon, int32 Apex, TArray<int32, AllocatorType>& OutTriangles)
+	{
+		const int32 Num = Polygon.Num();
+		for (int32 Index = 1; Index < Num - 1; Index++)
+		{
+			OutTriangles.Add(Polygon[Apex]);
+			OutTriangles.Add(Polygon[(Apex + Index) % Num]);
+			OutTriangles.Add(Polygon[(Apex + Index + 1) % Num]);
+		}
+	}
+
+	/**
+	*	Fans a convex polygon into triangles from a corner found by FindFanApex(), so no triangle is a sliver.
+	*	Polygons without such a corner are fanned from a new vertex in the middle.
+	*/
+	void TriangulatePolygon(const TArray<int32, TInlineAllocator<16>>& Polygon, int32 SourceTriangle, FPolygonCut& Merged, TArray<int32>& OutTriangles)
+	{
+		const int32 Num = Polygon.Num();
+		auto GetPosition = [&](int32 Index) { return Merged.Vertices[Polygon[(Index + Num) % Num]].Position; };
+
+		const int32 Apex = FindFanApex(Num, GetPosition);
+		if (Apex != INDEX_NONE)
+		{
+			AddFan(Polygon, Apex, OutTriangles);
+			return;
+		}
+
+		FCutVertex Center;
+		Center.Position = FVector(0, 0, 0);
+		Center.Barycentrics = FVector(0, 0, 0);
+		for (int32 Vertex : Polygon)
+		{
+			Center.Position += Merged.Vertices[Vertex].Position;
+			Center.Barycentrics += Merged.Vertices[Vertex].Barycentrics;
+		}
+		Center.Position /= Num;
+		Center.Barycentrics /= Num;
+		Center.SourceTriangle = SourceTriangle;
+		Center.SourceVertex = INDEX_NONE;
+		Center.EdgeStart = INDEX_NONE;
+		Center.EdgeEnd = INDEX_NONE;
+
+		// Polygons flattened onto a line have nothing to fill
+		int32 CenterIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			if (IsCollinear(GetPosition(Index), Center.Position, GetPosition(Index + 1)))
+			{
+				continue;
+			}
+
+			if (CenterIndex == INDEX_NONE)
+			{
+				CenterIndex = Merged.Vertices.Add(Center);
+			}
+			OutTriangles.Add(CenterIndex);
+			OutTriangles.Add(Polygon[Index]);
+			OutTriangles.Add(Polygon[(Index + 1) % Num]);
+		}
+	}
+}
+
+
+void FRuntimeMeshBoolean::Cut(const FRuntimeMeshBVH& Mesh, const FRuntimeMeshBVH& Other, ERuntimeMeshBooleanOperation Operation, bool bIsFirstOperand, FRuntimeMeshBooleanCut& OutCut)
+{
+	using namespace RuntimeMeshBooleanInternal;
+
+	OutCut = FRuntimeMeshBooleanCut();
+	OutCut.bFlip = Operation == ERuntimeMeshBooleanOperation::Subtract && !bIsFirstOperand;
+
+	const TArray<FVector>& Positions = Mesh.GetPositions();
+	const TArray<int32>& Indices = Mesh.GetIndices();
+	const int32 NumTriangles = Mesh.GetNumTriangles();
+	const int32 NumTasks = FMath::DivideAndRoundUp<int32>(NumTriangles, TrianglesPerTask);
+	FBox OtherBounds = Other.GetBounds();
+	if (OtherBounds.IsValid)
+	{
+		OtherBounds = OtherBounds.ExpandBy(PlaneTolerance);
+	}
+
+	TArray<FPolygonCut> TaskCuts;
+	TaskCuts.SetNum(NumTasks);
+
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		CutRange(Mesh, Other, OtherBounds, Operation, bIsFirstOperand,
+			TaskIndex * TrianglesPerTask, FMath::Min<int32>(NumTriangles, (TaskIndex + 1) * TrianglesPerTask), TaskCuts[TaskIndex]);
+	});
+
+	// Merge in task order so the result doesn't depend on scheduling, welding the vertices neighboring triangles share
+	FPolygonCut Merged;
+	TMap<int32, int32> CornerVertices;
+	FEdgeVertexMap EdgeVertices;
+	TArray<int32> Remap;
+	for (const FPolygonCut& TaskCut : TaskCuts)
+	{
+		Remap.SetNumUninitialized(TaskCut.Vertices.Num(), false);
+		for (int32 Index = 0; Index < TaskCut.Vertices.Num(); Index++)
+		{
+			Remap[Index] = WeldVertex(TaskCut.Vertices[Index], Merged, CornerVertices, EdgeVertices);
+		}
+
+		int32 Offset = 0;
+		for (int32 Polygon = 0; Polygon < TaskCut.PolygonSizes.Num(); Polygon++)
+		{
+			// Welding can collapse the corners of slivers together
+			const int32 FirstVertex = Merged.PolygonVertices.Num();
+			for (int32 Index = 0; Index < TaskCut.PolygonSizes[Polygon]; Index++)
+			{
+				const int32 Vertex = Remap[TaskCut.PolygonVertices[Offset + Index]];
+				if (Merged.PolygonVertices.Num() == FirstVertex || Merged.PolygonVertices.Last() != Vertex)
+				{
+					Merged.PolygonVertices.Add(Vertex);
+				}
+			}
+			Offset += TaskCut.PolygonSizes[Polygon];
+
+			if (Merged.PolygonVertices.Num() > FirstVertex + 1 && Merged.PolygonVertices.Last() == Merged.PolygonVertices[FirstVertex])
+			{
+				Merged.PolygonVertices.Pop(false);
+			}
+
+			if (Merged.PolygonVertices.Num() - FirstVertex >= 3)
+			{
+				Merged.PolygonSizes.Add(Merged.PolygonVertices.Num() - FirstVertex);
+				Merged.PolygonSourceTriangles.Add(TaskCut.PolygonSourceTriangles[Polygon]);
+			}
+			else
+			{
+				Merged.PolygonVertices.SetNum(FirstVertex, false);
+			}
+		}
+	}
+
+	// Whole triangles next to a cut one take the vertices it made on their shared edge, so they don't meet it at a T-junction
+	for (const FPolygonCut& TaskCut : TaskCuts)
+	{
+		for (int32 Triangle : TaskCut.WholeTriangles)
+		{
+			bool bHasEdgeVertices = false;
+			for (int32 Corner = 0; Corner < 3 && EdgeVertices.Num() > 0; Corner++)
+			{
+				const int32 Start = Indices[Triangle * 3 + Corner];
+				const int32 End = Indices[Triangle * 3 + (Corner + 1) % 3];
+				bHasEdgeVertices |= EdgeVertices.Contains(GetEdgeKey(FMath::Min(Start, End), FMath::Max(Start, End)));
+			}
+
+			if (!bHasEdgeVertices)
+			{
+				OutCut.WholeTriangles.Add(Triangle);
+				continue;
+			}
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				FCutVertex Vertex;
+				Vertex.SourceVertex = Indices[Triangle * 3 + Corner];
+				Vertex.Position = Positions[Vertex.SourceVertex];
+				Vertex.Barycentrics = FVector(Corner == 0 ? 1 : 0, Corner == 1 ? 1 : 0, Corner == 2 ? 1 : 0);
+				Vertex.SourceTriangle = Triangle;
+				Vertex.EdgeStart = INDEX_NONE;
+				Vertex.EdgeEnd = INDEX_NONE;
+				Merged.PolygonVertices.Add(WeldVertex(Vertex, Merged, CornerVertices, EdgeVertices));
+			}
+			Merged.PolygonSizes.Add(3);
+			Merged.PolygonSourceTriangles.Add(Triangle);
+		}
+	}
+
+	// Add the vertices other polygons have along each polygon's edges, then fan them into triangles.
+	// Edges along a source edge look at what was made on that edge, others at the rest of the triangle's pieces, which are all together.
+	TArray<int32, TInlineAllocator<16>> TriangleVertices;
+	TArray<int32, TInlineAllocator<16>> Polygon;
+	int32 PolygonIndex = 0;
+	int32 Offset = 0;
+	while (PolygonIndex < Merged.PolygonSizes.Num())
+	{
+		const int32 SourceTriangle = Merged.PolygonSourceTriangles[PolygonIndex];
+
+		int32 GroupEnd = PolygonIndex;
+		int32 GroupOffsetEnd = Offset;
+		TriangleVertices.Reset();
+		while (GroupEnd < Merged.PolygonSizes.Num() && Merged.PolygonSourceTriangles[GroupEnd] == SourceTriangle)
+		{
+			for (int32 Index = 0; Index < Merged.PolygonSizes[GroupEnd]; Index++)
+			{
+				TriangleVertices.AddUnique(Merged.PolygonVertices[GroupOffsetEnd + Index]);
+			}
+			GroupOffsetEnd += Merged.PolygonSizes[GroupEnd];
+			GroupEnd++;
+		}
+
+		for (; PolygonIndex < GroupEnd; PolygonIndex++)
+		{
+			const int32 Size = Merged.PolygonSizes[PolygonIndex];
+
+			Polygon.Reset();
+			for (int32 Index = 0; Index < Size; Index++)
+			{
+				const int32 A = Merged.PolygonVertices[Offset + Index];
+				const int32 B = Merged.PolygonVertices[Offset + (Index + 1) % Size];
+				Polygon.Add(A);
+
+				int32 EdgeStart, EdgeEnd;
+				if (GetSharedSourceEdge(Merged.Vertices[A], Merged.Vertices[B], EdgeStart, EdgeEnd))
+				{
+					if (const TArray<int32, TInlineAllocator<4>>* OnEdge = EdgeVertices.Find(GetEdgeKey(EdgeStart, EdgeEnd)))
+					{
+						AddVerticesOnSegment(A, B, OnEdge->GetData(), OnEdge->Num(), Merged.Vertices, Polygon);
+					}
+				}
+				else
+				{
+					AddVerticesOnSegment(A, B, TriangleVertices.GetData(), TriangleVertices.Num(), Merged.Vertices, Polygon);
+				}
+			}
+			Offset += Size;
+
+			TriangulatePolygon(Polygon, SourceTriangle, Merged, OutCut.NewTriangles);
+		}
+	}
+
+	// Only keep the vertices the triangles ended up using
+	Remap.Init(INDEX_NONE, Merged.Vertices.Num());
+	for (int32& Vertex : OutCut.NewTriangles)
+	{
+		if (Remap[Vertex] == INDEX_NONE)
+		{
+			const FCutVertex& CutVertex = Merged.Vertices[Vertex];
+			Remap[Vertex] = OutCut.NewPositions.Add(CutVertex.Position);
+			OutCut.NewSourceTriangles.Add(CutVertex.SourceTriangle);
+			OutCut.NewBarycentrics.Add(CutVertex.Barycentrics);
+			OutCut.NewSourceVertices.Add(CutVertex.SourceVertex);
+		}
+		Vertex = Remap[Vertex];
+	}
+}
+
+
+void FRuntimeMeshBoolean::WeldSeam(int32 FirstOtherTriangle, TArray<FVector>& Positions, TArray<int32>& Triangles, FRuntimeMeshBooleanSeam& OutSeam)
+{
+	using namespace RuntimeMeshBooleanInternal;
+
+	OutSeam = FRuntimeMeshBooleanSeam();
+	const int32 NumTriangles = Triangles.Num() / 3;
+	auto GetEdgeEnd = [](int32 Edge) { return Edge - Edge % 3 + (Edge + 1) % 3; };
+
+	// The seam is where the kept surface of each operand ends, the edges only one of its triangles uses
+	TMap<uint64, int32> EdgeUses;
+	for (int32 Edge = 0; Edge < NumTriangles * 3; Edge++)
+	{
+		const int32 Start = Triangles[Edge];
+		const int32 End = Triangles[GetEdgeEnd(Edge)];
+		EdgeUses.FindOrAdd(GetEdgeKey(FMath::Min(Start, End), FMath::Max(Start, End)))++;
+	}
+
+	TArray<int32> SeamEdges;
+	TArray<uint8> VertexOperands;
+	VertexOperands.SetNumZeroed(Positions.Num());
+	for (int32 Edge = 0; Edge < NumTriangles * 3; Edge++)
+	{
+		const int32 Start = Triangles[Edge];
+		const int32 End = Triangles[GetEdgeEnd(Edge)];
+		if (EdgeUses.FindChecked(GetEdgeKey(FMath::Min(Start, End), FMath::Max(Start, End))) == 1)
+		{
+			const uint8 Operand = Edge / 3 < FirstOtherTriangle ? 1 : 2;
+			SeamEdges.Add(Edge);
+			VertexOperands[Start] |= Operand;
+			VertexOperands[End] |= Operand;
+		}
+	}
+	if (SeamEdges.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<int32> SeamVertices;
+	for (int32 Vertex = 0; Vertex < Positions.Num(); Vertex++)
+	{
+		if (VertexOperands[Vertex] != 0)
+		{
+			SeamVertices.Add(Vertex);
+		}
+	}
+
+	// Move seam vertices cut at the same place together, as the cuts weld their own vertices. Each point keeps its lowest vertex
+	// and which operands have it.
+	TArray<int32> Remap;
+	const int32 NumPoints = FRuntimeMeshWelding::BuildRemap(SeamVertices.Num(), [&](int32 Index) -> const FVector& { return Positions[SeamVertices[Index]]; },
+		[](int32 A, int32 B) { return true; }, PlaneTolerance, Remap);
+
+	TArray<int32> PointVertices;
+	TArray<uint8> PointOperands;
+	PointVertices.Init(INDEX_NONE, NumPoints);
+	PointOperands.SetNumZeroed(NumPoints);
+	for (int32 Index = 0; Index < SeamVertices.Num(); Index++)
+	{
+		const int32 Vertex = SeamVertices[Index];
+		const int32 Point = Remap[Index];
+		if (PointVertices[Point] == INDEX_NONE)
+		{
+			PointVertices[Point] = Vertex;
+		}
+		else
+		{
+			Positions[Vertex] = Positions[PointVertices[Point]];
+		}
+		PointOperands[Point] |= VertexOperands[Vertex];
+	}
+
+	// Hash the points into cells at least as big as any seam edge, so the cells around the middle of an edge hold everything on it
+	float CellSize = PlaneTolerance;
+	for (int32 Edge : SeamEdges)
+	{
+		CellSize = FMath::Max(CellSize, FVector::Dist(Positions[Triangles[Edge]], Positions[Triangles[GetEdgeEnd(Edge)]]) + PlaneTolerance);
+	}
+	auto GetCell = [CellSize](const FVector& Position)
+	{
+		return FIntVector(FMath::FloorToInt(Position.X / CellSize), FMath::FloorToInt(Position.Y / CellSize), FMath::FloorToInt(Position.Z / CellSize));
+	};
+
+	TMap<FIntVector, int32> CellHeads;
+	TArray<int32> NextInCell;
+	NextInCell.SetNumUninitialized(NumPoints);
+	for (int32 Point = 0; Point < NumPoints; Point++)
+	{
+		int32& Head = CellHeads.FindOrAdd(GetCell(Positions[PointVertices[Point]]));
+		NextInCell[Point] = Head - 1;
+		Head = Point + 1;
+	}
+
+	// Give each seam edge a vertex wherever the other operand has one along it, blending the ends of the edge
+	TArray<int32> EdgeInsertStart;
+	TArray<int32> EdgeInserts;
+	EdgeInsertStart.SetNumUninitialized(SeamEdges.Num() + 1);
+	TArray<FOnSegment, TInlineAllocator<8>> OnSegment;
+	for (int32 SeamIndex = 0; SeamIndex < SeamEdges.Num(); SeamIndex++)
+	{
+		EdgeInsertStart[SeamIndex] = EdgeInserts.Num();
+
+		const int32 Edge = SeamEdges[SeamIndex];
+		const int32 EdgeStart = Triangles[Edge];
+		const int32 EdgeEnd = Triangles[GetEdgeEnd(Edge)];
+		const uint8 OtherOperand = Edge / 3 < FirstOtherTriangle ? 2 : 1;
+
+		const FVector Start = Positions[EdgeStart];
+		const FVector Direction = Positions[EdgeEnd] - Start;
+		const float LengthSquared = Direction.SizeSquared();
+		if (LengthSquared <= FMath::Square(PlaneTolerance))
+		{
+			continue;
+		}
+		const float AlphaTolerance = PlaneTolerance / FMath::Sqrt(LengthSquared);
+
+		OnSegment.Reset();
+		const FIntVector Middle = GetCell(Start + Direction * 0.5f);
+		for (int32 Neighbor = 0; Neighbor < 27; Neighbor++)
+		{
+			const int32* Head = CellHeads.Find(Middle + FIntVector(Neighbor % 3 - 1, (Neighbor / 3) % 3 - 1, Neighbor / 9 - 1));
+			for (int32 Point = Head ? *Head - 1 : INDEX_NONE; Point != INDEX_NONE; Point = NextInCell[Point])
+			{
+				if ((PointOperands[Point] & OtherOperand) == 0)
+				{
+					continue;
+				}
+
+				const FVector& Position = Positions[PointVertices[Point]];
+				const float Alpha = ((Position - Start) | Direction) / LengthSquared;
+				if (Alpha > AlphaTolerance && Alpha < 1.0f - AlphaTolerance &&
+					FVector::DistSquared(Position, Start + Direction * Alpha) <= FMath::Square(PlaneTolerance))
+				{
+					FOnSegment& Found = OnSegment[OnSegment.AddUninitialized()];
+					Found.Alpha = Alpha;
+					Found.Vertex = PointVertices[Point];
+				}
+			}
+		}
+
+		// The other operand can have split vertices at the same point
+		OnSegment.Sort();
+		for (int32 Index = 0; Index < OnSegment.Num(); Index++)
+		{
+			const FVector Position = Positions[OnSegment[Index].Vertex];
+			if (Index > 0 && Position == Positions[OnSegment[Index - 1].Vertex])
+			{
+				continue;
+			}
+
+			EdgeInserts.Add(Positions.Add(Position));
+			OutSeam.NewSourceVertices.Add(EdgeStart);
+			OutSeam.NewSourceVertices.Add(EdgeEnd);
+			OutSeam.NewSourceVertices.Add(EdgeStart);
+			OutSeam.NewBarycentrics.Add(FVector(1.0f - OnSegment[Index].Alpha, OnSegment[Index].Alpha, 0.0f));
+		}
+	}
+	EdgeInsertStart[SeamEdges.Num()] = EdgeInserts.Num();
+
+	// Retriangulate the triangles that got new vertices, the first piece replacing the original triangle
+	TArray<int32, TInlineAllocator<16>> Polygon;
+	TArray<int32, TInlineAllocator<48>> Pieces;
+	for (int32 SeamIndex = 0; SeamIndex < SeamEdges.Num();)
+	{
+		const int32 Triangle = SeamEdges[SeamIndex] / 3;
+		Polygon.Reset();
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			Polygon.Add(Triangles[Triangle * 3 + Corner]);
+			if (SeamIndex < SeamEdges.Num() && SeamEdges[SeamIndex] == Triangle * 3 + Corner)
+			{
+				for (int32 Insert = EdgeInsertStart[SeamIndex]; Insert < EdgeInsertStart[SeamIndex + 1]; Insert++)
+				{
+					Polygon.Add(EdgeInserts[Insert]);
+				}
+				SeamIndex++;
+			}
+		}
+
+		const int32 Num = Polygon.Num();
+		if (Num == 3)
+		{
+			continue;
+		}
+
+		auto GetPosition = [&](int32 Index) { return Positions[Polygon[(Index + Num) % Num]]; };
+		Pieces.Reset();
+		const int32 Apex = FindFanApex(Num, GetPosition);
+		if (Apex != INDEX_NONE)
+		{
+			AddFan(Polygon, Apex, Pieces);
+		}
+		else
+		{
+			// The triangle is convex so its middle sees every side
+			FVector Center(0, 0, 0);
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				Center += Positions[Triangles[Triangle * 3 + Corner]] / 3.0f;
+				OutSeam.NewSourceVertices.Add(Triangles[Triangle * 3 + Corner]);
+			}
+			const int32 CenterIndex = Positions.Add(Center);
+			OutSeam.NewBarycentrics.Add(FVector(1.0f / 3.0f));
+
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Pieces.Add(CenterIndex);
+				Pieces.Add(Polygon[Index]);
+				Pieces.Add(Polygon[(Index + 1) % Num]);
+			}
+		}
+
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			Triangles[Triangle * 3 + Corner] = Pieces[Corner];
+		}
+		for (int32 Index = 3; Index < Pieces.Num(); Index++)
+		{
+			Triangles.Add(Pieces[Index]);
+		}
+	}
+}
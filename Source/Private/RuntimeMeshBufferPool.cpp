@@ -0,0 +1,31 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshBufferPool.h"
+
+
+int32 FRuntimeMeshBufferPoolBudget::MaxTotalPooledBytes = 64 * 1024 * 1024;
+int32 FRuntimeMeshBufferPoolBudget::MaxPoolBytes = 8 * 1024 * 1024;
+FThreadSafeCounter FRuntimeMeshBufferPoolBudget::TotalPooledBytes;
+
+
+bool FRuntimeMeshBufferPoolBudget::TryReserve(int32 Bytes)
+{
+	if (TotalPooledBytes.Add(Bytes) + Bytes > MaxTotalPooledBytes)
+	{
+		TotalPooledBytes.Subtract(Bytes);
+		return false;
+	}
+
+	INC_MEMORY_STAT_BY(STAT_RuntimeMesh_UpdateBufferPoolMemory, Bytes);
+	return true;
+}
+
+void FRuntimeMeshBufferPoolBudget::Release(int32 Bytes)
+{
+	if (Bytes > 0)
+	{
+		TotalPooledBytes.Subtract(Bytes);
+		DEC_MEMORY_STAT_BY(STAT_RuntimeMesh_UpdateBufferPoolMemory, Bytes);
+	}
+}
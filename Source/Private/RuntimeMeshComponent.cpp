@@ -7,6 +7,13 @@
 #include "RuntimeMeshCore.h"
 #include "RuntimeMeshGenericVertex.h"
 #include "RuntimeMeshVersion.h"
+#include "RuntimeMeshWelding.h"
+#include "RuntimeMeshOptimization.h"
+#include "RuntimeMeshSimplification.h"
+#include "RuntimeMeshUpdateManager.h"
+#include "Async/Async.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 
 
 /** Runtime mesh scene proxy */
@@ -18,52 +25,46 @@ private:
 public:
 
 	FRuntimeMeshSceneProxy(URuntimeMeshComponent* Component)
-		: FPrimitiveSceneProxy(Component), MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+		: FPrimitiveSceneProxy(Component), MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel())), NumStaticSections(0)
 	{
-		// Get the proxy for all mesh sections
+		// Get the proxy for all mesh sections, they're all created on the render thread by one batch
 
 		const int32 NumSections = Component->MeshSections.Num();
-		Sections.AddDefaulted(NumSections);
+		Sections.Reserve(NumSections);
 
-		for (int32 SectionIdx = 0; SectionIdx < NumSections; SectionIdx++)
+		auto* Commands = new FRuntimeMeshCommandBuffer(Component->CommandBufferPool);
+
+		for (int32 Index = 0; Index < NumSections; Index++)
 		{
-			RuntimeMeshSectionPtr& SourceSection = Component->MeshSections[SectionIdx];
+			const int32 SectionIdx = Component->MeshSections.GetKeyAt(Index);
+			RuntimeMeshSectionPtr& SourceSection = Component->MeshSections.GetValueAt(Index);
 			if (SourceSection.IsValid())
 			{
-				UMaterialInterface* Material = Component->GetMaterial(SectionIdx);
-				if (Material == nullptr)
-				{
-					Material = UMaterial::GetDefaultMaterial(MD_Surface);
-				}
-
+				// Size the render buffers of static sections so they can be updated in place later
+				SourceSection->UpdateRenderCapacity();
 
-				// Get the section creation data
-				auto* SectionData = SourceSection->GetSectionCreationData(Material);
-				
-
-				auto Proxy = SectionData->NewProxy;
+				// Add the section creation command
+				SourceSection->WriteCreateCommand(*Commands, SectionIdx, SourceSection->CreateProxy(Component->GetSectionMaterial(SectionIdx)));
+			}
+		}
 
-				if (!IsInRenderingThread())
-				{
-					// Enqueue update on RT
-					ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
-						FRuntimeMeshCreateSectionInternalCommand,
-						FRuntimeMeshSectionProxyInterface*, Proxy, Proxy,
-						FRuntimeMeshSectionCreateDataInterface*, SectionData, SectionData,
-						{
-							Proxy->FinishCreate_RenderThread(SectionData);
-						}
-					);
-				}
-				else
+		if (!IsInRenderingThread())
+		{
+			// Enqueue update on RT
+			ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+				FRuntimeMeshCreateSectionsInternalCommand,
+				FRuntimeMeshSceneProxy*, RuntimeMeshSceneProxy, this,
+				FRuntimeMeshCommandBuffer*, Commands, Commands,
 				{
-					Proxy->FinishCreate_RenderThread(SectionData);
+					RuntimeMeshSceneProxy->ApplyCommands_RenderThread(*Commands);
+					delete Commands;
 				}
-
-				// Save ref to new section
-				Sections[SectionIdx] = Proxy;
-
-			}
+			);
+		}
+		else
+		{
+			ApplyCommands_RenderThread(*Commands);
+			delete Commands;
 		}
 	}
 
@@ -78,81 +79,81 @@ public:
 		}
 	}
 
-	/** Called on render thread to create a new dynamic section. (Static sections are handled differently) */
-	void CreateSection_RenderThread(FRuntimeMeshSectionCreateDataInterface* SectionData)
+	/** Called on render thread to create a new section from its new section proxy */
+	void CreateSection_RenderThread(int32 SectionIndex, const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshCreateSectionCommand& Command)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_CreateSection_RenderThread);
 
 		check(IsInRenderingThread());
-		check(SectionData);
 
-		int32 SectionIndex = SectionData->GetTargetSection();
-
-		// Make sure the array is big enough
-		if (SectionIndex >= Sections.Num())
-		{
-			Sections.SetNum(SectionIndex + 1, false);
-		}
-		
 		// If a section already exists... destroy it!
-		if (FRuntimeMeshSectionProxyInterface* Section = Sections[SectionIndex])
-		{			
-			delete Section;
-		}
+		DestroySection_RenderThread(SectionIndex);
 		
 		// Get the proxy and finish the creation here on the render thread.
-		FRuntimeMeshSectionProxyInterface* Section = SectionData->NewProxy;
-		Section->FinishCreate_RenderThread(SectionData);		
+		FRuntimeMeshSectionProxyInterface* Section = Command.NewProxy;
+		Section->FinishCreate_RenderThread(Commands, Command);
 
 		// Save ref to new section
-		Sections[SectionIndex] = Section;
-		
-		delete SectionData;
+		Sections.FindOrAdd(SectionIndex) = Section;
+		if (Section->WantsToRenderInStaticPath())
+		{
+			NumStaticSections++;
+		}
+		UpdateSectionMeshBatch_RenderThread(SectionIndex);
 	}
 
 	/** Called on render thread to assign new dynamic data */
-  	void UpdateSection_RenderThread(FRuntimeMeshRenderThreadCommandInterface* SectionData)
+  	void UpdateSection_RenderThread(int32 SectionIndex, const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdateSectionCommand& Command)
   	{
 		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateSection_RenderThread);
 
   		check(IsInRenderingThread());
-		check(SectionData);
 
-		if (SectionData->GetTargetSection() < Sections.Num() && Sections[SectionData->GetTargetSection()] != nullptr)
+		FRuntimeMeshSectionProxyInterface** Section = Sections.Find(SectionIndex);
+		if (Section && *Section != nullptr)
 		{
-			Sections[SectionData->GetTargetSection()]->FinishUpdate_RenderThread(SectionData);
+			(*Section)->FinishUpdate_RenderThread(Commands, Command);
+			UpdateSectionMeshBatch_RenderThread(SectionIndex);
 		}
-
-		delete SectionData;
  	}
 
-	void UpdateSectionPositionOnly_RenderThread(FRuntimeMeshRenderThreadCommandInterface* SectionData)
+	void UpdateSectionPositionOnly_RenderThread(int32 SectionIndex, const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdatePositionsCommand& Command)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateSectionPositionOnly_RenderThread);
 
 		check(IsInRenderingThread());
-		check(SectionData);
 
-		if (SectionData->GetTargetSection() < Sections.Num() && Sections[SectionData->GetTargetSection()] != nullptr)
+		FRuntimeMeshSectionProxyInterface** Section = Sections.Find(SectionIndex);
+		if (Section && *Section != nullptr)
 		{
-			Sections[SectionData->GetTargetSection()]->FinishPositionUpdate_RenderThread(SectionData);
+			(*Section)->FinishPositionUpdate_RenderThread(Commands, Command);
 		}
+	}
 
-		delete SectionData;
+	void UpdateSectionVerticesOnly_RenderThread(int32 SectionIndex, const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdateVerticesCommand& Command)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateSectionVerticesOnly_RenderThread);
+
+		check(IsInRenderingThread());
+
+		FRuntimeMeshSectionProxyInterface** Section = Sections.Find(SectionIndex);
+		if (Section && *Section != nullptr)
+		{
+			(*Section)->FinishVertexUpdate_RenderThread(Commands, Command);
+		}
 	}
 
-	void UpdateSectionProperties_RenderThread(FRuntimeMeshRenderThreadCommandInterface* SectionData)
+	void UpdateSectionProperties_RenderThread(int32 SectionIndex, const FRuntimeMeshUpdatePropertiesCommand& Command)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateSectionProperties_RenderThread);
 
 		check(IsInRenderingThread());
-		check(SectionData);
 
-		int32 SectionIndex = SectionData->GetTargetSection();
-
-		if (SectionIndex < Sections.Num() && Sections[SectionIndex] != nullptr)
+		FRuntimeMeshSectionProxyInterface** Section = Sections.Find(SectionIndex);
+		if (Section && *Section != nullptr)
 		{
-			Sections[SectionIndex]->FinishPropertyUpdate_RenderThread(SectionData);
+			(*Section)->FinishPropertyUpdate_RenderThread(Command);
+			UpdateSectionMeshBatch_RenderThread(SectionIndex);
 		}
 	}
 
@@ -161,46 +162,75 @@ public:
 	{
 		check(IsInRenderingThread());
 
-		if (SectionIndex < Sections.Num() && Sections[SectionIndex] != nullptr)
+		FRuntimeMeshSectionProxyInterface* Section = nullptr;
+		if (Sections.Remove(SectionIndex, &Section) && Section)
 		{
-			delete Sections[SectionIndex];
-			Sections[SectionIndex] = nullptr;
+			if (Section->WantsToRenderInStaticPath())
+			{
+				NumStaticSections--;
+			}
+			delete Section;
 		}
+
+		RenderableDynamicSections.Remove(SectionIndex);
+		RenderableStaticSections.Remove(SectionIndex);
 	}
 
-	void ApplyBatchUpdate_RenderThread(FRuntimeMeshBatchUpdateData* BatchUpdateData)
+	/** Rebuilds the cached mesh batch of a section after it changed, and files it under the renderable sections if it should render */
+	void UpdateSectionMeshBatch_RenderThread(int32 SectionIndex)
 	{
-		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_ApplyBatchUpdate_RenderThread);
-
 		check(IsInRenderingThread());
-		check(BatchUpdateData);
 
-		// Destroy flagged sections
-		for (auto& SectionIndex : BatchUpdateData->DestroySections)
-		{
-			DestroySection_RenderThread(SectionIndex);
-		}
+		RenderableDynamicSections.Remove(SectionIndex);
+		RenderableStaticSections.Remove(SectionIndex);
 
-		// Create new sections
-		for (auto& SectionToCreate : BatchUpdateData->CreateSections)
+		FRuntimeMeshSectionProxyInterface** Section = Sections.Find(SectionIndex);
+		if (Section && *Section != nullptr && (*Section)->ShouldRender())
 		{
-			CreateSection_RenderThread(static_cast<FRuntimeMeshSectionCreateDataInterface*>(SectionToCreate));
+			auto& RenderableSections = (*Section)->WantsToRenderInStaticPath() ? RenderableStaticSections : RenderableDynamicSections;
+
+			FRuntimeMeshRenderableSection& RenderableSection = RenderableSections.FindOrAdd(SectionIndex);
+			RenderableSection.Section = *Section;
+			RenderableSection.MeshBatch = FMeshBatch();
+			CreateMeshBatch(RenderableSection.MeshBatch, *Section, nullptr, false);
 		}
+	}
 
-		// Update sections
-		for (auto& SectionToUpdate : BatchUpdateData->UpdateSections)
-		{
-			UpdateSection_RenderThread(SectionToUpdate);
-		}		
+	/** Runs every command in a command buffer, in the order they were written */
+	void ApplyCommands_RenderThread(const FRuntimeMeshCommandBuffer& Commands)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_ApplyBatchUpdate_RenderThread);
 
-		// Apply section property updates
-		for (auto& SectionToUpdate : BatchUpdateData->PropertyUpdateSections)
+		check(IsInRenderingThread());
+
+		for (int32 CommandOffset = 0; CommandOffset < Commands.GetSize(); CommandOffset += Commands.GetHeader(CommandOffset).Size)
 		{
-			UpdateSectionProperties_RenderThread(SectionToUpdate);
+			const FRuntimeMeshCommandHeader& Header = Commands.GetHeader(CommandOffset);
+			switch (Header.Type)
+			{
+			case ERuntimeMeshCommandType::CreateSection:
+				CreateSection_RenderThread(Header.SectionIndex, Commands, Commands.GetPayload<FRuntimeMeshCreateSectionCommand>(CommandOffset));
+				break;
+			case ERuntimeMeshCommandType::DestroySection:
+				DestroySection_RenderThread(Header.SectionIndex);
+				break;
+			case ERuntimeMeshCommandType::UpdateSection:
+				UpdateSection_RenderThread(Header.SectionIndex, Commands, Commands.GetPayload<FRuntimeMeshUpdateSectionCommand>(CommandOffset));
+				break;
+			case ERuntimeMeshCommandType::UpdatePositions:
+				UpdateSectionPositionOnly_RenderThread(Header.SectionIndex, Commands, Commands.GetPayload<FRuntimeMeshUpdatePositionsCommand>(CommandOffset));
+				break;
+			case ERuntimeMeshCommandType::UpdateVertices:
+				UpdateSectionVerticesOnly_RenderThread(Header.SectionIndex, Commands, Commands.GetPayload<FRuntimeMeshUpdateVerticesCommand>(CommandOffset));
+				break;
+			case ERuntimeMeshCommandType::UpdateProperties:
+				UpdateSectionProperties_RenderThread(Header.SectionIndex, Commands.GetPayload<FRuntimeMeshUpdatePropertiesCommand>(CommandOffset));
+				break;
+			default:
+				checkNoEntry();
+				return;
+			}
 		}
-
-		delete BatchUpdateData;
-
 	}
 
 
@@ -211,30 +241,29 @@ public:
 
 		// Create a uniform buffer with the transform for this mesh.
 		MeshUniformBuffer = CreatePrimitiveUniformBufferImmediate(GetLocalToWorld(), GetBounds(), GetLocalBounds(), true, UseEditorDepthTest());
+
+		// Patch the cached mesh batches with the new transform
+		const bool bReverseCulling = IsLocalToWorldDeterminantNegative();
+		for (FRuntimeMeshRenderableSection& RenderableSection : RenderableDynamicSections)
+		{
+			RenderableSection.MeshBatch.ReverseCulling = bReverseCulling;
+			RenderableSection.MeshBatch.Elements[0].PrimitiveUniformBuffer = MeshUniformBuffer;
+		}
+		for (FRuntimeMeshRenderableSection& RenderableSection : RenderableStaticSections)
+		{
+			RenderableSection.MeshBatch.ReverseCulling = bReverseCulling;
+			RenderableSection.MeshBatch.Elements[0].PrimitiveUniformBuffer = MeshUniformBuffer;
+		}
 	}
 
 	bool HasDynamicSections() const
 	{
-		for (FRuntimeMeshSectionProxyInterface* Section : Sections)
-		{
-			if (Section && !Section->WantsToRenderInStaticPath())
-			{
-				return true;
-			}
-		}
-		return false;
+		return RenderableDynamicSections.Num() > 0;
 	}
 
 	bool HasStaticSections() const 
 	{
-		for (FRuntimeMeshSectionProxyInterface* Section : Sections)
-		{
-			if (Section && Section->WantsToRenderInStaticPath())
-			{
-				return true;
-			}
-		}
-		return false;
+		return NumStaticSections > 0;
 	}
 
 #if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 11
@@ -260,9 +289,9 @@ public:
 		return Result;
 	}
 
-	void CreateMeshBatch(FMeshBatch& MeshBatch, FRuntimeMeshSectionProxyInterface* Section, FMaterialRenderProxy* WireframeMaterial) const
+	void CreateMeshBatch(FMeshBatch& MeshBatch, FRuntimeMeshSectionProxyInterface* Section, FMaterialRenderProxy* WireframeMaterial, bool bIsSelected) const
 	{
-		Section->CreateMeshBatch(MeshBatch, WireframeMaterial, IsSelected());
+		Section->CreateMeshBatch(MeshBatch, WireframeMaterial, bIsSelected);
 
 		MeshBatch.ReverseCulling = IsLocalToWorldDeterminantNegative();
 		MeshBatch.bCanApplyViewModeOverrides = false;
@@ -277,10 +306,11 @@ public:
 
 		for (FRuntimeMeshSectionProxyInterface* Section : Sections)
 		{
-			if (Section && Section->ShouldRender() && Section->WantsToRenderInStaticPath())
+			// Hidden sections are added too, their visibility is checked per frame by the vertex factory
+			if (Section && Section->WantsToRenderInStaticPath() && Section->HasRenderBuffers())
 			{
 				FMeshBatch MeshBatch;
-				CreateMeshBatch(MeshBatch, Section, nullptr);
+				CreateMeshBatch(MeshBatch, Section, nullptr, IsSelected());
 				PDI->DrawMesh(MeshBatch, FLT_MAX);
 			}
 		}
@@ -304,28 +334,22 @@ public:
 			Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
 		}
 
-		// Iterate over sections
-		for (FRuntimeMeshSectionProxyInterface* Section : Sections)
+		// The cached mesh batches are built unselected and without wireframe
+		const bool bUseCachedMeshBatches = WireframeMaterialInstance == nullptr && !IsSelected();
+
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
 		{
-			if (Section && Section->ShouldRender())
+			if (VisibilityMap & (1 << ViewIndex))
 			{
-				// Add the mesh batch to every view it's visible in
-				for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
-				{
-					if (VisibilityMap & (1 << ViewIndex))
-					{
-						bool bForceDynamicPath = IsRichView(*Views[ViewIndex]->Family) || Views[ViewIndex]->Family->EngineShowFlags.Wireframe || IsSelected() || !IsStaticPathAvailable();
+				AddSectionMeshBatches(RenderableDynamicSections, ViewIndex, bUseCachedMeshBatches, WireframeMaterialInstance, Collector);
 
-						if (bForceDynamicPath || !Section->WantsToRenderInStaticPath())
-						{
-							FMeshBatch& MeshBatch = Collector.AllocateMesh();
-							CreateMeshBatch(MeshBatch, Section, WireframeMaterialInstance);
-
-							Collector.AddMesh(ViewIndex, MeshBatch);
-						}
-					}
+				// Static sections are only drawn here when the static path can't be used for this view
+				bool bForceDynamicPath = IsRichView(*Views[ViewIndex]->Family) || Views[ViewIndex]->Family->EngineShowFlags.Wireframe || IsSelected() || !IsStaticPathAvailable();
+				if (bForceDynamicPath)
+				{
+					AddSectionMeshBatches(RenderableStaticSections, ViewIndex, bUseCachedMeshBatches, WireframeMaterialInstance, Collector);
 				}
-			}			
+			}
 		}
 
 		// Draw bounds
@@ -358,12 +382,76 @@ public:
 	}
 
 private:
-	/** Array of sections */
-	TArray<FRuntimeMeshSectionProxyInterface*> Sections;
+	/** A section that should render, with its mesh batch prebuilt */
+	struct FRuntimeMeshRenderableSection
+	{
+		FRuntimeMeshSectionProxyInterface* Section;
+		FMeshBatch MeshBatch;
+	};
+
+	void AddSectionMeshBatches(const TRuntimeMeshSectionMap<FRuntimeMeshRenderableSection>& RenderableSections, int32 ViewIndex,
+		bool bUseCachedMeshBatches, FMaterialRenderProxy* WireframeMaterial, FMeshElementCollector& Collector) const
+	{
+		for (const FRuntimeMeshRenderableSection& RenderableSection : RenderableSections)
+		{
+			FMeshBatch& MeshBatch = Collector.AllocateMesh();
+			if (bUseCachedMeshBatches)
+			{
+				MeshBatch = RenderableSection.MeshBatch;
+			}
+			else
+			{
+				CreateMeshBatch(MeshBatch, RenderableSection.Section, WireframeMaterial, IsSelected());
+			}
+
+			Collector.AddMesh(ViewIndex, MeshBatch);
+		}
+	}
+
+	/** Sections keyed by section index */
+	TRuntimeMeshSectionMap<FRuntimeMeshSectionProxyInterface*> Sections;
+
+	/** Sections that should render through the dynamic path */
+	TRuntimeMeshSectionMap<FRuntimeMeshRenderableSection> RenderableDynamicSections;
+
+	/** Static sections that should render, drawn by the dynamic path only when the static path can't be used */
+	TRuntimeMeshSectionMap<FRuntimeMeshRenderableSection> RenderableStaticSections;
 
 	FMaterialRelevance MaterialRelevance;
+
+	/** Number of sections using the static path, whether they're visible or not */
+	int32 NumStaticSections;
 };
 
+/* Sends a command buffer to a scene proxy. The render thread deletes it once it's applied. */
+static void EnqueueRuntimeMeshCommands(FRuntimeMeshSceneProxy* SceneProxy, FRuntimeMeshCommandBuffer* Commands)
+{
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FRuntimeMeshCommands,
+		FRuntimeMeshSceneProxy*, RuntimeMeshSceneProxy, SceneProxy,
+		FRuntimeMeshCommandBuffer*, Commands, Commands,
+		{
+			RuntimeMeshSceneProxy->ApplyCommands_RenderThread(*Commands);
+			delete Commands;
+		}
+	);
+}
+
+/* Finds the vertices whose positions differ between two position buffers of the same length, in ascending order */
+static void FindMovedVertices(const TArray<FVector>& OldPositions, const TArray<FVector>& NewPositions, TArray<int32>& OutMovedVertices)
+{
+	check(OldPositions.Num() == NewPositions.Num());
+
+	OutMovedVertices.Reset();
+	for (int32 Index = 0; Index < NewPositions.Num(); Index++)
+	{
+		if (OldPositions[Index] != NewPositions[Index])
+		{
+			OutMovedVertices.Add(Index);
+		}
+	}
+}
+
 
 
 
@@ -380,7 +468,16 @@ void FRuntimeMeshComponentPrePhysicsTickFunction::ExecuteTick( float DeltaTime,
 	if (bIsValid)
 	{
 		FScopeCycleCounterUObject ActorScope(Target);
-		Target->BakeCollision();
+
+		if (Target->bCollisionDirty)
+		{
+			Target->BakeCollision();
+		}
+
+		if (Target->bHasDynamicAutoSections)
+		{
+			Target->UpdateAutoSectionPaths();
+		}
 	}
 }
 
@@ -391,6 +488,7 @@ FString FRuntimeMeshComponentPrePhysicsTickFunction::DiagnosticMessage()
 
 
 
+
 /* Helper for converting an array of FLinearColor to an array of FColors*/
 void ConvertLinearColorToFColor(const TArray<FLinearColor>& LinearColors, TArray<FColor>& Colors)
 {
@@ -405,7 +503,9 @@ void ConvertLinearColorToFColor(const TArray<FLinearColor>& LinearColors, TArray
 
 
 URuntimeMeshComponent::URuntimeMeshComponent(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer), bUseComplexAsSimpleCollision(true), bShouldSerializeMeshData(true), bCollisionDirty(true)
+	: Super(ObjectInitializer), bUseComplexAsSimpleCollision(true), bShouldSerializeMeshData(true), bWeldCollisionVertices(false)
+	, CollisionWeldTolerance(0.01f), bCoalesceUpdates(false), bCollisionDirty(true), bHasDynamicAutoSections(false), bHasPendingMorphTargets(false)
+	, LastSectionId(0), CommandBufferPool(MakeShareable(new FRuntimeMeshBufferPool()))
 {
 	// Setup the collision update ticker
 	PrePhysicsTick.TickGroup = TG_PrePhysics;
@@ -508,16 +608,107 @@ TSharedPtr<FRuntimeMeshSectionInterface> URuntimeMeshComponent::CreateOrResetSec
 }
 
 
+void URuntimeMeshComponent::ReplaceSectionInternal(int32 SectionIndex, const FRuntimeMeshSectionInterface& OldSection, FRuntimeMeshSectionInterface& NewSection)
+{
+	// Recreating a section every frame should count as updating it
+	NewSection.CopyUpdateHistory(OldSection);
+
+	// Keep the requested LODs, CreateSectionInternal() starts generating them for the new geometry
+	NewSection.CopyLODSettings(OldSection);
+
+	// The old section's mesh batch is in the static draw lists, so it can only be removed by recreating the proxy
+	if (OldSection.GetRenderUpdateFrequency() == EUpdateFrequency::Infrequent)
+	{
+		if (ShouldBatchUpdate())
+		{
+			BatchState.MarkRenderStateDirty();
+		}
+		else
+		{
+			MarkRenderStateDirty();
+		}
+	}
+}
+
+void URuntimeMeshComponent::ReuseRecycledSection(FRuntimeMeshSectionInterface& NewSection)
+{
+	for (int32 Index = RecycledSections.Num() - 1; Index >= 0; Index--)
+	{
+		FRuntimeMeshSectionInterface& RecycledSection = *RecycledSections[Index];
+		if (RecycledSection.GetVertexType()->Equals(NewSection.GetVertexType()) && RecycledSection.IsDualBufferSection() == NewSection.IsDualBufferSection())
+		{
+			NewSection.TakeBufferAllocations(RecycledSection);
+			RecycledSections.RemoveAtSwap(Index, 1, false);
+			return;
+		}
+	}
+}
+
+bool URuntimeMeshComponent::RecordSectionUpdate(FRuntimeMeshSectionInterface& Section)
+{
+	if (!Section.RecordUpdate())
+	{
+		return false;
+	}
+
+	// Watch the section so it can go back to the static path once it stops being updated
+	if (!bHasDynamicAutoSections)
+	{
+		bHasDynamicAutoSections = true;
+		PrePhysicsTick.SetTickFunctionEnable(true);
+	}
+	return true;
+}
+
+void URuntimeMeshComponent::UpdateAutoSectionPaths()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateAutoSectionPaths);
+
+	bool bAnySectionMoved = false;
+	bHasDynamicAutoSections = false;
+
+	for (const RuntimeMeshSectionPtr& Section : MeshSections)
+	{
+		if (Section->UpdateAutoPath())
+		{
+			bAnySectionMoved = true;
+		}
+		else if (Section->UpdateFrequency == EUpdateFrequency::Auto && Section->AutoUpdateFrequency == EUpdateFrequency::Frequent)
+		{
+			bHasDynamicAutoSections = true;
+		}
+	}
+
+	// Sections can only join the static draw lists through a new proxy
+	if (bAnySectionMoved)
+	{
+		MarkRenderStateDirty();
+	}
+
+	PrePhysicsTick.SetTickFunctionEnable(bCollisionDirty || bHasDynamicAutoSections);
+}
+
 void URuntimeMeshComponent::CreateSectionInternal(int32 SectionIndex)
 {
 	RuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
 	check(Section.IsValid());
 
+	Section->UpdateRevision++;
+
+	if (Section->LODTriangleRatios.Num() > 0)
+	{
+		StartSectionLODGeneration(SectionIndex);
+	}
+
+	// Static sections can only be added by recreating the proxy
+	const bool bMovedToDynamicPath = RecordSectionUpdate(*Section);
+	const bool bRequiresRecreate = bMovedToDynamicPath || Section->GetRenderUpdateFrequency() == EUpdateFrequency::Infrequent;
+
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		// Mark section created
-		BatchState.MarkSectionCreated(SectionIndex, Section->UpdateFrequency == EUpdateFrequency::Infrequent);
+		BatchState.MarkSectionCreated(SectionIndex, bRequiresRecreate);
 
 		// Flag collision if this section affects it
 		if (Section->CollisionEnabled)
@@ -533,21 +724,14 @@ void URuntimeMeshComponent::CreateSectionInternal(int32 SectionIndex)
 	}
 
 	// Enqueue the RT command if we already have a SceneProxy
-	if (SceneProxy && Section->UpdateFrequency != EUpdateFrequency::Infrequent)
+	if (SceneProxy && !bRequiresRecreate)
 	{
 		// Gather all needed update info
-		auto* SectionData = Section->GetSectionCreationData(GetSectionMaterial(SectionIndex));
-		SectionData->SetTargetSection(SectionIndex);
+		auto* Commands = new FRuntimeMeshCommandBuffer(CommandBufferPool);
+		Section->WriteCreateCommand(*Commands, SectionIndex, Section->CreateProxy(GetSectionMaterial(SectionIndex)));
 
 		// Enqueue update on RT
-		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
-			FRuntimeMeshSectionCreate,
-			FRuntimeMeshSceneProxy*, RuntimeMeshSceneProxy, (FRuntimeMeshSceneProxy*)SceneProxy,
-			FRuntimeMeshSectionCreateDataInterface*, SectionData, SectionData,
-			{
-				RuntimeMeshSceneProxy->CreateSection_RenderThread(SectionData);
-			}
-		);
+		EnqueueRuntimeMeshCommands((FRuntimeMeshSceneProxy*)SceneProxy, Commands);
 	}
 	else
 	{
@@ -569,20 +753,42 @@ void URuntimeMeshComponent::CreateSectionInternal(int32 SectionIndex)
 void URuntimeMeshComponent::UpdateSectionInternal(int32 SectionIndex, bool bHadVertexPositionsUpdate, bool bHadVertexUpdates, bool bHadIndexUpdates, bool bNeedsBoundsUpdate)
 {
 	// Ensure that something was updated
-	check(bHadVertexPositionsUpdate || bHadVertexUpdates || bNeedsBoundsUpdate);
+	check(bHadVertexPositionsUpdate || bHadVertexUpdates || bHadIndexUpdates || bNeedsBoundsUpdate);
 
-	check(SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid());	
+	check(MeshSections.Contains(SectionIndex));	
 	RuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
 
+	Section->UpdateRevision++;
+
+	// A section changing path, or a static section outgrowing its buffers, needs the proxy recreated
+	const bool bRequiresRecreate = RecordSectionUpdate(*Section) || !Section->CanUpdateRenderBuffersInPlace();
+
 	/* Make sure this is only flagged if the section is dual buffer */
 	bHadVertexPositionsUpdate = Section->IsDualBufferSection() && bHadVertexPositionsUpdate;
-	bool bNeedsCollisionUpdate = Section->CollisionEnabled && (bHadVertexPositionsUpdate || (!Section->IsDualBufferSection() && bHadVertexUpdates));
+	bool bNeedsCollisionUpdate = Section->CollisionEnabled && (bHadVertexPositionsUpdate || bHadIndexUpdates || (!Section->IsDualBufferSection() && bHadVertexUpdates));
+
+	// The query snapshot can only be refit while the triangles stay the same
+	if (bHadIndexUpdates)
+	{
+		Section->BVH.Reset();
+	}
+
+	// LODs that no longer fit the vertices are dropped, drawing the full section until they're regenerated
+	if (Section->InvalidateLODs(bHadIndexUpdates))
+	{
+		bHadIndexUpdates = true;
+	}
+
+	if (Section->LODTriangleRatios.Num() > 0 && (bHadVertexPositionsUpdate || bHadVertexUpdates || bHadIndexUpdates))
+	{
+		StartSectionLODGeneration(SectionIndex);
+	}
 	
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
-		// Mark update for section or promote to proxy recreate if static section
-		if (Section->UpdateFrequency == EUpdateFrequency::Infrequent)
+		// Mark update for section or promote to proxy recreate
+		if (bRequiresRecreate)
 		{
 			BatchState.MarkRenderStateDirty();
 		}
@@ -613,21 +819,14 @@ void URuntimeMeshComponent::UpdateSectionInternal(int32 SectionIndex, bool bHadV
 	}
 
 
-	// Send the update to the render thread if the scene proxy exists
-	if (SceneProxy && Section->UpdateFrequency != EUpdateFrequency::Infrequent)
+	// Send the update to the render thread if the scene proxy exists and can take it
+	if (SceneProxy && !bRequiresRecreate)
 	{
-		auto* SectionData = Section->GetSectionUpdateData(bHadVertexPositionsUpdate, bHadVertexUpdates, bHadIndexUpdates);
-		SectionData->SetTargetSection(SectionIndex);
+		auto* Commands = new FRuntimeMeshCommandBuffer(CommandBufferPool);
+		Section->WriteUpdateCommand(*Commands, SectionIndex, bHadVertexPositionsUpdate, bHadVertexUpdates, bHadIndexUpdates);
 
 		// Enqueue update on RT
-		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
-			FRuntimeMeshSectionUpdate,
-			FRuntimeMeshSceneProxy*, RuntimeMeshSceneProxy, (FRuntimeMeshSceneProxy*)SceneProxy,
-			FRuntimeMeshRenderThreadCommandInterface*, SectionData, SectionData,
-			{
-				RuntimeMeshSceneProxy->UpdateSection_RenderThread(SectionData);
-			}
-		);
+		EnqueueRuntimeMeshCommands((FRuntimeMeshSceneProxy*)SceneProxy, Commands);
 	}
 	else
 	{
@@ -648,25 +847,66 @@ void URuntimeMeshComponent::UpdateSectionInternal(int32 SectionIndex, bool bHadV
 	}
 }
 
-void URuntimeMeshComponent::UpdateSectionVertexPositionsInternal(int32 SectionIndex, bool bNeedsBoundsUpdate)
+void URuntimeMeshComponent::UpdateSectionVertexPositionsInternal(int32 SectionIndex, bool bNeedsBoundsUpdate, int32 StartIndex, int32 Count, int32 VertexStartIndex, int32 VertexCount)
 {
-	check(SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid());
+	check(MeshSections.Contains(SectionIndex));
 	RuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
 
-	if (SceneProxy)
+	Section->UpdateRevision++;
+
+	// LODs were simplified from the old positions. Only one generation runs per section at a time, so per frame
+	// updates like morph targets just keep restarting the one in flight instead of queueing more.
+	if (Section->LODTriangleRatios.Num() > 0)
 	{
-		auto SectionData = Section->GetSectionPositionUpdateData();
-		SectionData->SetTargetSection(SectionIndex);
+		StartSectionLODGeneration(SectionIndex);
+	}
 
-		// Enqueue command to modify render thread info
-		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
-			FRuntimeMeshSectionPositionUpdate,
-			FRuntimeMeshSceneProxy*, RuntimeMeshSceneProxy, (FRuntimeMeshSceneProxy*)SceneProxy,
-			FRuntimeMeshRenderThreadCommandInterface*, SectionData, SectionData,
+	// A section changing path, or a static section outgrowing its buffers, needs the proxy recreated
+	const bool bRequiresRecreate = RecordSectionUpdate(*Section) || !Section->CanUpdateRenderBuffersInPlace();
+
+	// Use the batch update if one is running
+	if (ShouldBatchUpdate())
+	{
+		// Mark update for section or promote to proxy recreate
+		if (bRequiresRecreate)
+		{
+			BatchState.MarkRenderStateDirty();
+		}
+		else
+		{
+			BatchState.MarkUpdateForSection(SectionIndex, ERuntimeMeshSectionBatchUpdateType::PositionsUpdate);
+			if (VertexCount > 0)
 			{
-				RuntimeMeshSceneProxy->UpdateSectionPositionOnly_RenderThread(SectionData);
+				BatchState.MarkUpdateForSection(SectionIndex, ERuntimeMeshSectionBatchUpdateType::VerticesUpdate);
 			}
-		);
+		}
+
+		// Flag bounds update if needed.
+		if (bNeedsBoundsUpdate)
+		{
+			BatchState.MarkBoundsDirty();
+		}
+
+		// bail since we don't update directly in this case.
+		return;
+	}
+
+	if (SceneProxy && !bRequiresRecreate)
+	{
+		if (Count == INDEX_NONE)
+		{
+			Count = Section->PositionVertexBuffer.Num() - StartIndex;
+		}
+
+		auto* Commands = new FRuntimeMeshCommandBuffer(CommandBufferPool);
+		Section->WritePositionUpdateCommand(*Commands, SectionIndex, StartIndex, Count);
+		if (VertexCount > 0)
+		{
+			Section->WriteVertexUpdateCommand(*Commands, SectionIndex, VertexStartIndex, VertexCount);
+		}
+
+		// Enqueue command to modify render thread info
+		EnqueueRuntimeMeshCommands((FRuntimeMeshSceneProxy*)SceneProxy, Commands);
 	}
 	else
 	{
@@ -681,13 +921,13 @@ void URuntimeMeshComponent::UpdateSectionVertexPositionsInternal(int32 SectionIn
 
 void URuntimeMeshComponent::UpdateSectionPropertiesInternal(int32 SectionIndex, bool bUpdateRequiresProxyRecreateIfStatic)
 {
-	check(SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid());
+	check(MeshSections.Contains(SectionIndex));
 	RuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
 
-	bool bRequiresRecreate = bUpdateRequiresProxyRecreateIfStatic && Section->UpdateFrequency == EUpdateFrequency::Infrequent;
+	bool bRequiresRecreate = bUpdateRequiresProxyRecreateIfStatic && Section->GetRenderUpdateFrequency() == EUpdateFrequency::Infrequent;
 
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		if (bRequiresRecreate)
 		{
@@ -706,21 +946,11 @@ void URuntimeMeshComponent::UpdateSectionPropertiesInternal(int32 SectionIndex,
 
 	if (SceneProxy && !bRequiresRecreate)
 	{
-		auto SectionData = new FRuntimeMeshSectionPropertyUpdateData();
-		SectionData->SetTargetSection(SectionIndex);
-		SectionData->bIsVisible = Section->bIsVisible;
-		SectionData->bCastsShadow = Section->bCastsShadow;
-
+		auto* Commands = new FRuntimeMeshCommandBuffer(CommandBufferPool);
+		Section->WritePropertyUpdateCommand(*Commands, SectionIndex);
 
 		// Enqueue command to modify render thread info
-		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
-			FRuntimeMeshSectionPropertyUpdate,
-			FRuntimeMeshSceneProxy*, RuntimeMeshSceneProxy, (FRuntimeMeshSceneProxy*)SceneProxy,
-			FRuntimeMeshRenderThreadCommandInterface*, SectionData, SectionData,
-			{
-				RuntimeMeshSceneProxy->UpdateSectionProperties_RenderThread(SectionData);
-			}
-		);
+		EnqueueRuntimeMeshCommands((FRuntimeMeshSceneProxy*)SceneProxy, Commands);
 	}
 	else
 	{
@@ -729,6 +959,45 @@ void URuntimeMeshComponent::UpdateSectionPropertiesInternal(int32 SectionIndex,
 }
 
 
+void URuntimeMeshComponent::UpdateSectionVertexPositionsAndTangentsInternal(int32 SectionIndex, const TArray<int32>& MovedVertices, bool bNeedsBoundsUpdate)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_RecalculateNormalTangents);
+
+	if (MovedVertices.Num() == 0)
+	{
+		UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundsUpdate);
+		return;
+	}
+
+	int32 VertexStartIndex, VertexCount;
+	MeshSections[SectionIndex]->RecalculateNormalTangents(MovedVertices, VertexStartIndex, VertexCount);
+
+	// Only the range that moved needs sending, along with the vertices whose normals changed
+	UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundsUpdate, MovedVertices[0], MovedVertices.Last() - MovedVertices[0] + 1, VertexStartIndex, VertexCount);
+}
+
+
+void URuntimeMeshComponent::UpdateMeshSectionTriangles(int32 SectionIndex, TArray<int32>& Triangles, ESectionUpdateFlags UpdateFlags)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateMeshSectionTriangles);
+
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex);
+
+	if (Triangles.Num() == 0)
+	{
+		Log(TEXT("UpdateMeshSectionTriangles() - Triangles empty. They will not be updated."));
+		return;
+	}
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+
+	bool bShouldUseMove = (UpdateFlags & ESectionUpdateFlags::MoveArrays) != ESectionUpdateFlags::None;
+	Section->UpdateIndexBuffer(Triangles, bShouldUseMove);
+
+	UpdateSectionInternal(SectionIndex, false, false, true, false);
+}
+
 void URuntimeMeshComponent::UpdateMeshSectionPositionsImmediate(int32 SectionIndex, TArray<FVector>& VertexPositions, ESectionUpdateFlags UpdateFlags)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateMeshSectionPositionsImmediate);
@@ -747,9 +1016,17 @@ void URuntimeMeshComponent::UpdateMeshSectionPositionsImmediate(int32 SectionInd
 	}
 
 	bool bShouldUseMove = (UpdateFlags & ESectionUpdateFlags::MoveArrays) != ESectionUpdateFlags::None;
+	bool bCalculateNormalTangents = (UpdateFlags & ESectionUpdateFlags::CalculateNormalTangent) != ESectionUpdateFlags::None;
 	bool bNeedsBoundsUpdate = false;
 
-	// Update vertex positions if supplied
+	// Find what moved before the positions are replaced
+	TArray<int32> MovedVertices;
+	if (bCalculateNormalTangents)
+	{
+		FindMovedVertices(Section->PositionVertexBuffer, VertexPositions, MovedVertices);
+	}
+
+	// Update vertex positions if supplied
 	bool bUpdatedVertexPositions = false;
 	if (VertexPositions.Num() > 0)
 	{
@@ -764,7 +1041,16 @@ void URuntimeMeshComponent::UpdateMeshSectionPositionsImmediate(int32 SectionInd
 	// Finalize section update if we have anything to apply
 	if (bUpdatedVertexPositions)
 	{
-		UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundsUpdate);
+		if (bCalculateNormalTangents)
+		{
+			UpdateSectionVertexPositionsAndTangentsInternal(SectionIndex, MovedVertices, bNeedsBoundsUpdate);
+		}
+		else
+		{
+			UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundsUpdate);
+		}
+
+		RebaseMorphTargetsInternal(SectionIndex);
 	}
 }
 
@@ -786,8 +1072,16 @@ void URuntimeMeshComponent::UpdateMeshSectionPositionsImmediate(int32 SectionInd
 	}
 
 	bool bShouldUseMove = (UpdateFlags & ESectionUpdateFlags::MoveArrays) != ESectionUpdateFlags::None;
+	bool bCalculateNormalTangents = (UpdateFlags & ESectionUpdateFlags::CalculateNormalTangent) != ESectionUpdateFlags::None;
 	bool bNeedsBoundsUpdate = false;
 
+	// Find what moved before the positions are replaced
+	TArray<int32> MovedVertices;
+	if (bCalculateNormalTangents)
+	{
+		FindMovedVertices(Section->PositionVertexBuffer, VertexPositions, MovedVertices);
+	}
+
 	// Update vertex positions if supplied
 	bool bUpdatedVertexPositions = false;
 	if (VertexPositions.Num() > 0)
@@ -803,7 +1097,16 @@ void URuntimeMeshComponent::UpdateMeshSectionPositionsImmediate(int32 SectionInd
 	// Finalize section update if we have anything to apply
 	if (bUpdatedVertexPositions)
 	{
-		UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundsUpdate);
+		if (bCalculateNormalTangents)
+		{
+			UpdateSectionVertexPositionsAndTangentsInternal(SectionIndex, MovedVertices, bNeedsBoundsUpdate);
+		}
+		else
+		{
+			UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundsUpdate);
+		}
+
+		RebaseMorphTargetsInternal(SectionIndex);
 	}
 }
 
@@ -823,10 +1126,30 @@ void URuntimeMeshComponent::EndMeshSectionPositionUpdate(int32 SectionIndex)
 {
 	// Validate all update parameters
 	RMC_VALIDATE_UPDATEPARAMETERS_DUALBUFFER(SectionIndex);
-	
-	// TODO: Validate that the position buffer is still the same length
 
-	UpdateSectionVertexPositionsInternal(SectionIndex, true);
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+
+	if (Section->PositionVertexBuffer.Num() != Section->GetNumVertices())
+	{
+		Log(TEXT("EndMeshSectionPositionUpdate() - Positions cannot change length unless the vertexdata is updated as well."), true);
+		return;
+	}
+
+	// Calculate the new bounding box
+	FBox NewBoundingBox(0);
+	for (const FVector& Position : Section->PositionVertexBuffer)
+	{
+		NewBoundingBox += Position;
+	}
+
+	bool bNeedsBoundingBoxUpdate = !(Section->LocalBoundingBox == NewBoundingBox);
+	if (bNeedsBoundingBoxUpdate)
+	{
+		Section->LocalBoundingBox = NewBoundingBox;
+	}
+
+	UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundingBoxUpdate);
+	RebaseMorphTargetsInternal(SectionIndex);
 }
 
 void URuntimeMeshComponent::EndMeshSectionPositionUpdate(int32 SectionIndex, const FBox& BoundingBox)
@@ -835,16 +1158,196 @@ void URuntimeMeshComponent::EndMeshSectionPositionUpdate(int32 SectionIndex, con
 	RMC_VALIDATE_UPDATEPARAMETERS_DUALBUFFER(SectionIndex);
 
 	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+
+	if (Section->PositionVertexBuffer.Num() != Section->GetNumVertices())
+	{
+		Log(TEXT("EndMeshSectionPositionUpdate() - Positions cannot change length unless the vertexdata is updated as well."), true);
+		return;
+	}
 	
 	bool bNeedsBoundingBoxUpdate = !(Section->LocalBoundingBox == BoundingBox);
 	if (bNeedsBoundingBoxUpdate)
 	{
 		Section->LocalBoundingBox = BoundingBox;
 	}
-	
-	// TODO: Validate that the position buffer is still the same length
 
 	UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundingBoxUpdate);
+	RebaseMorphTargetsInternal(SectionIndex);
+}
+
+int32 URuntimeMeshComponent::AddMeshSectionMorphTarget(int32 SectionIndex, const TArray<int32>& VertexIndices, const TArray<FVector>& PositionDeltas)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS_DUALBUFFER(SectionIndex);
+	check((VertexIndices.Num() == PositionDeltas.Num()) && "PositionDeltas must be the same length as VertexIndices");
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+
+	// The current positions become the base the targets are blended on
+	if (!Section->MorphTargets.IsValid())
+	{
+		Section->MorphTargets = MakeShareable(new FRuntimeMeshMorphTargetSet(Section->PositionVertexBuffer, Section->LocalBoundingBox));
+	}
+
+	return Section->MorphTargets->AddTarget(VertexIndices, PositionDeltas);
+}
+
+void URuntimeMeshComponent::SetMeshSectionMorphTargetWeight(int32 SectionIndex, int32 MorphTargetIndex, float Weight)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS_DUALBUFFER(SectionIndex);
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	check(Section->MorphTargets.IsValid() && "Section has no morph targets.");
+
+	if (!Section->MorphTargets->SetWeight(MorphTargetIndex, Weight))
+	{
+		return;
+	}
+
+	QueueMorphTargetBlendInternal(SectionIndex);
+}
+
+float URuntimeMeshComponent::GetMeshSectionMorphTargetWeight(int32 SectionIndex, int32 MorphTargetIndex) const
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS_DUALBUFFER(SectionIndex);
+
+	const RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	check(Section->MorphTargets.IsValid() && "Section has no morph targets.");
+
+	return Section->MorphTargets->GetWeight(MorphTargetIndex);
+}
+
+int32 URuntimeMeshComponent::GetNumMeshSectionMorphTargets(int32 SectionIndex) const
+{
+	const RuntimeMeshSectionPtr* Section = MeshSections.Find(SectionIndex);
+	return Section && (*Section)->MorphTargets.IsValid() ? (*Section)->MorphTargets->Num() : 0;
+}
+
+void URuntimeMeshComponent::ApplyMeshSectionMorphTargets(int32 SectionIndex)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_ApplyMorphTargets);
+
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS_DUALBUFFER(SectionIndex);
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	if (!Section->MorphTargets.IsValid() || !Section->MorphTargets->IsDirty())
+	{
+		return;
+	}
+
+	if (Section->PositionVertexBuffer.Num() != Section->MorphTargets->GetNumBasePositions())
+	{
+		Log(TEXT("ApplyMeshSectionMorphTargets() - Positions changed length since the morph targets were added. Clearing morph targets."), true);
+		Section->MorphTargets.Reset();
+		return;
+	}
+
+	int32 StartIndex, Count;
+	FBox NewBoundingBox(0);
+	Section->MorphTargets->Apply(Section->PositionVertexBuffer, StartIndex, Count, NewBoundingBox);
+
+	bool bNeedsBoundingBoxUpdate = !(Section->LocalBoundingBox == NewBoundingBox);
+	if (bNeedsBoundingBoxUpdate)
+	{
+		Section->LocalBoundingBox = NewBoundingBox;
+	}
+
+	if (Count > 0 || bNeedsBoundingBoxUpdate)
+	{
+		UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundingBoxUpdate, StartIndex, Count);
+	}
+}
+
+void URuntimeMeshComponent::ClearMeshSectionMorphTargets(int32 SectionIndex)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS_DUALBUFFER(SectionIndex);
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	if (!Section->MorphTargets.IsValid())
+	{
+		return;
+	}
+
+	TSharedPtr<FRuntimeMeshMorphTargetSet> MorphTargets = Section->MorphTargets;
+	Section->MorphTargets.Reset();
+
+	if (Section->PositionVertexBuffer.Num() != MorphTargets->GetNumBasePositions())
+	{
+		return;
+	}
+
+	int32 StartIndex, Count;
+	FBox NewBoundingBox(0);
+	MorphTargets->Restore(Section->PositionVertexBuffer, StartIndex, Count, NewBoundingBox);
+
+	bool bNeedsBoundingBoxUpdate = !(Section->LocalBoundingBox == NewBoundingBox);
+	if (bNeedsBoundingBoxUpdate)
+	{
+		Section->LocalBoundingBox = NewBoundingBox;
+	}
+
+	if (Count > 0 || bNeedsBoundingBoxUpdate)
+	{
+		UpdateSectionVertexPositionsInternal(SectionIndex, bNeedsBoundingBoxUpdate, StartIndex, Count);
+	}
+}
+
+void URuntimeMeshComponent::QueueMorphTargetBlendInternal(int32 SectionIndex)
+{
+	// Blend once at the end of the frame, or right away if there's no world to do it
+	if (!bHasPendingMorphTargets)
+	{
+		if (FRuntimeMeshUpdateManager* UpdateManager = FRuntimeMeshUpdateManager::Get(GetWorld()))
+		{
+			bHasPendingMorphTargets = true;
+			UpdateManager->AddPendingMorphComponent(this);
+		}
+		else
+		{
+			ApplyMeshSectionMorphTargets(SectionIndex);
+		}
+	}
+}
+
+void URuntimeMeshComponent::RebaseMorphTargetsInternal(int32 SectionIndex)
+{
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	if (!Section->MorphTargets.IsValid())
+	{
+		return;
+	}
+
+	// The targets move specific vertices, so they can't follow a change in the vertex count
+	if (Section->PositionVertexBuffer.Num() != Section->MorphTargets->GetNumBasePositions())
+	{
+		Log(TEXT("UpdateMeshSection() - Positions changed length. Clearing morph targets."));
+		Section->MorphTargets.Reset();
+		return;
+	}
+
+	Section->MorphTargets->Rebase(Section->PositionVertexBuffer, Section->LocalBoundingBox);
+	if (Section->MorphTargets->IsDirty())
+	{
+		QueueMorphTargetBlendInternal(SectionIndex);
+	}
+}
+
+void URuntimeMeshComponent::ApplyPendingMorphTargets()
+{
+	bHasPendingMorphTargets = false;
+
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
+	{
+		const RuntimeMeshSectionPtr& Section = MeshSections.GetValueAt(Index);
+		if (Section->MorphTargets.IsValid() && Section->MorphTargets->IsDirty())
+		{
+			ApplyMeshSectionMorphTargets(MeshSections.GetKeyAt(Index));
+		}
+	}
 }
 
 
@@ -1005,17 +1508,18 @@ void URuntimeMeshComponent::ClearMeshSection(int32 SectionIndex)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_ClearMeshSection);
 
- 	if (SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid())
+ 	RuntimeMeshSectionPtr Section;
+ 	if (MeshSections.Remove(SectionIndex, &Section) && Section.IsValid())
  	{
 		// Did this section have collision
-		bool HadCollision = MeshSections[SectionIndex]->CollisionEnabled;
-		bool bWasStaticSection = MeshSections[SectionIndex]->UpdateFrequency == EUpdateFrequency::Infrequent;
+		bool HadCollision = Section->CollisionEnabled;
+		bool bWasStaticSection = Section->GetRenderUpdateFrequency() == EUpdateFrequency::Infrequent;
 
 		// Clear the section
-		MeshSections[SectionIndex].Reset();
+		Section.Reset();
 		
 		// Use the batch update if one is running
-		if (BatchState.IsBatchPending())
+		if (ShouldBatchUpdate())
 		{
 			// Mark section created
 			BatchState.MarkSectionDestroyed(SectionIndex, bWasStaticSection);
@@ -1067,7 +1571,7 @@ void URuntimeMeshComponent::ClearAllMeshSections()
  	MeshSections.Empty();
 
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		// Mark render state dirty
 		BatchState.MarkRenderStateDirty();
@@ -1089,7 +1593,7 @@ void URuntimeMeshComponent::ClearAllMeshSections()
 
 bool URuntimeMeshComponent::GetSectionBoundingBox(int32 SectionIndex, FBox& OutBoundingBox)
 {
-	if (SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid())
+	if (MeshSections.Contains(SectionIndex))
 	{
 		OutBoundingBox = MeshSections[SectionIndex]->LocalBoundingBox;
 		return true;
@@ -1099,7 +1603,7 @@ bool URuntimeMeshComponent::GetSectionBoundingBox(int32 SectionIndex, FBox& OutB
 
 void URuntimeMeshComponent::SetMeshSectionVisible(int32 SectionIndex, bool bNewVisibility)
 {
- 	if (SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid())
+ 	if (MeshSections.Contains(SectionIndex))
  	{
  		// Set game thread state
  		MeshSections[SectionIndex]->bIsVisible = bNewVisibility;
@@ -1111,12 +1615,12 @@ void URuntimeMeshComponent::SetMeshSectionVisible(int32 SectionIndex, bool bNewV
 
 bool URuntimeMeshComponent::IsMeshSectionVisible(int32 SectionIndex) const
 {
-	return SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid() && MeshSections[SectionIndex]->bIsVisible;
+	return MeshSections.Contains(SectionIndex) && MeshSections[SectionIndex]->bIsVisible;
 }
 
 void URuntimeMeshComponent::SetMeshSectionCastsShadow(int32 SectionIndex, bool bNewCastsShadow)
 {
-	if (SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid())
+	if (MeshSections.Contains(SectionIndex))
 	{
 		// Set game thread state
 		MeshSections[SectionIndex]->bCastsShadow = bNewCastsShadow;
@@ -1128,12 +1632,12 @@ void URuntimeMeshComponent::SetMeshSectionCastsShadow(int32 SectionIndex, bool b
 
 bool URuntimeMeshComponent::IsMeshSectionCastingShadows(int32 SectionIndex) const
 {
-	return SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid() && MeshSections[SectionIndex]->bCastsShadow;
+	return MeshSections.Contains(SectionIndex) && MeshSections[SectionIndex]->bCastsShadow;
 }
 
 void URuntimeMeshComponent::SetMeshSectionCollisionEnabled(int32 SectionIndex, bool bNewCollisionEnabled)
 {
-	if (SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid())
+	if (MeshSections.Contains(SectionIndex))
 	{
 		auto& Section = MeshSections[SectionIndex];
 		if (Section->CollisionEnabled != bNewCollisionEnabled)
@@ -1141,7 +1645,7 @@ void URuntimeMeshComponent::SetMeshSectionCollisionEnabled(int32 SectionIndex, b
 			Section->CollisionEnabled = bNewCollisionEnabled;
 			
 			// Use the batch update if one is running
-			if (BatchState.IsBatchPending())
+			if (ShouldBatchUpdate())
 			{
 				// Mark render state dirty
 				BatchState.MarkCollisionDirty();
@@ -1156,40 +1660,24 @@ void URuntimeMeshComponent::SetMeshSectionCollisionEnabled(int32 SectionIndex, b
 
 bool URuntimeMeshComponent::IsMeshSectionCollisionEnabled(int32 SectionIndex)
 {
-	return SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid() && MeshSections[SectionIndex]->CollisionEnabled;
+	return MeshSections.Contains(SectionIndex) && MeshSections[SectionIndex]->CollisionEnabled;
 }
 
 
 
 int32 URuntimeMeshComponent::GetNumSections() const
 {
-	int32 SectionCount = 0;
-	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
-	{
-		if (MeshSections[Index].IsValid())
-		{
-			SectionCount++;
-		}
-	}
-
-	return SectionCount;
+	return MeshSections.Num();
 }
 
 bool URuntimeMeshComponent::DoesSectionExist(int32 SectionIndex) const
 {
-	return SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid();
+	return MeshSections.Contains(SectionIndex);
 }
 
 int32 URuntimeMeshComponent::FirstAvailableMeshSectionIndex(int32 SectionIndex) const
 {
-	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
-	{
-		if (!MeshSections[Index].IsValid())
-		{
-			return Index;
-		}
-	}
-	return MeshSections.Num();
+	return MeshSections.GetFirstUnusedKey();
 }
 
 
@@ -1207,7 +1695,7 @@ void URuntimeMeshComponent::SetMeshCollisionSection(int32 CollisionSectionIndex,
 	Section.IndexBuffer = Triangles;
 
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		// Mark render state dirty
 		BatchState.MarkCollisionDirty();
@@ -1228,7 +1716,7 @@ void URuntimeMeshComponent::ClearMeshCollisionSection(int32 CollisionSectionInde
 	MeshCollisionSections[CollisionSectionIndex].Reset();
 
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		// Mark render state dirty
 		BatchState.MarkCollisionDirty();
@@ -1246,7 +1734,7 @@ void URuntimeMeshComponent::ClearAllMeshCollisionSections()
 	MeshCollisionSections.Empty();
 
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		// Mark render state dirty
 		BatchState.MarkCollisionDirty();
@@ -1271,7 +1759,7 @@ void URuntimeMeshComponent::AddCollisionConvexMesh(TArray<FVector> ConvexVerts)
 		
 
 		// Use the batch update if one is running
-		if (BatchState.IsBatchPending())
+		if (ShouldBatchUpdate())
 		{
 			// Mark render state dirty
 			BatchState.MarkCollisionDirty();
@@ -1292,7 +1780,7 @@ void URuntimeMeshComponent::ClearCollisionConvexMeshes()
 
 
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		// Mark render state dirty
 		BatchState.MarkCollisionDirty();
@@ -1320,7 +1808,7 @@ void URuntimeMeshComponent::SetCollisionConvexMeshes(const TArray< TArray<FVecto
 
 
 	// Use the batch update if one is running
-	if (BatchState.IsBatchPending())
+	if (ShouldBatchUpdate())
 	{
 		// Mark render state dirty
 		BatchState.MarkCollisionDirty();
@@ -1367,7 +1855,21 @@ FPrimitiveSceneProxy* URuntimeMeshComponent::CreateSceneProxy()
 
 int32 URuntimeMeshComponent::GetNumMaterials() const
 {
-	return MeshSections.Num();
+	// Materials are indexed by section index
+	return MeshSections.GetMaxKey() + 1;
+}
+
+void URuntimeMeshComponent::GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials) const
+{
+	// Only look at the materials of sections that exist, instead of every index up to the largest
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
+	{
+		UMaterialInterface* Material = GetMaterial(MeshSections.GetKeyAt(Index));
+		if (Material)
+		{
+			OutMaterials.AddUnique(Material);
+		}
+	}
 }
 
 FBoxSphereBounds URuntimeMeshComponent::CalcBounds(const FTransform& LocalToWorld) const
@@ -1385,98 +1887,123 @@ void URuntimeMeshComponent::EndBatchUpdates()
 	if (!BatchState.IsBatchPending())
 		return;
 
-	// Handle all pending rendering updates..
-	if (BatchState.RequiresSceneProxyRecreate())
+	TArray<FRuntimeMeshSectionProxyInterface*> NewProxies;
+	CreateBatchSectionProxies(NewProxies);
+
+	if (FRuntimeMeshCommandBuffer* Commands = PrepareBatchUpdate(NewProxies))
 	{
-		MarkRenderStateDirty();
+		// Enqueue update on RT
+		EnqueueRuntimeMeshCommands((FRuntimeMeshSceneProxy*)SceneProxy, Commands);
 	}
-	else
-	{
-		auto* BatchUpdateData = new FRuntimeMeshBatchUpdateData;
 
-		for (int32 Index = 0; Index <= BatchState.GetMaxSection(); Index++)
-		{
-			// Skip this section if it has no updates.
-			if (!BatchState.HasAnyFlagSet(Index))
-			{
-				continue;
-			}
+	FinishBatchUpdate();
+}
 
-			// Check that we don't have both create and destroy flagged
-			check(!(BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Create) && BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Destroy)));
+void URuntimeMeshComponent::CreateBatchSectionProxies(TArray<FRuntimeMeshSectionProxyInterface*>& OutNewProxies) const
+{
+	OutNewProxies.Reset();
 
-			// Handle section created
-			if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Create))
-			{
-				// Validate section exists
-				check(MeshSections.Num() >= Index && MeshSections[Index].IsValid());
-				
-				UMaterialInterface* Material = GetMaterial(Index);
-				if (Material == nullptr)
-				{
-					Material = UMaterial::GetDefaultMaterial(MD_Surface);
-				}
+	// Nothing gets sent without a proxy, see PrepareBatchUpdate()
+	if (!BatchState.IsBatchPending() || BatchState.RequiresSceneProxyRecreate() || !SceneProxy)
+	{
+		return;
+	}
 
-				// Get the section create data and add it to the list
-				auto SectionCreateData = MeshSections[Index]->GetSectionCreationData(Material);
-				SectionCreateData->SetTargetSection(Index);
+	OutNewProxies.SetNumZeroed(BatchState.GetNumUpdatedSections());
+	for (int32 UpdateIndex = 0; UpdateIndex < BatchState.GetNumUpdatedSections(); UpdateIndex++)
+	{
+		const int32 Index = BatchState.GetUpdatedSectionAt(UpdateIndex);
+		if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Create))
+		{
+			// Validate section exists
+			check(MeshSections.Contains(Index));
 
-				BatchUpdateData->CreateSections.Add(SectionCreateData);
-			}
-			// Handle destroy
-			else if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Destroy))
-			{
-				BatchUpdateData->DestroySections.Add(Index);
-			}
-			// Handle vertex/index updates
-			else if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::VerticesUpdate) || BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::IndicesUpdate))
-			{
-				// Validate section exists
-				check(MeshSections.Num() >= Index && MeshSections[Index].IsValid());
+			OutNewProxies[UpdateIndex] = MeshSections[Index]->CreateProxy(GetSectionMaterial(Index));
+		}
+	}
+}
 
-				// Get the section update data and add it to the list.
-				bool bHadPositionUpdates = BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::PositionsUpdate);
-				bool bHadVertexUpdates = BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::VerticesUpdate);
-				bool bHadIndexUpdates = BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::IndicesUpdate);
-				auto SectionUpdateData = MeshSections[Index]->GetSectionUpdateData(bHadPositionUpdates, bHadVertexUpdates, bHadIndexUpdates);
-				SectionUpdateData->SetTargetSection(Index);
+FRuntimeMeshCommandBuffer* URuntimeMeshComponent::PrepareBatchUpdate(const TArray<FRuntimeMeshSectionProxyInterface*>& NewProxies) const
+{
+	// Without a proxy there's nothing to update, it'll get everything when it's created.
+	if (!BatchState.IsBatchPending() || BatchState.RequiresSceneProxyRecreate() || !SceneProxy)
+	{
+		check(NewProxies.Num() == 0);
+		return nullptr;
+	}
 
-				BatchUpdateData->UpdateSections.Add(SectionUpdateData);
-			}
-			// Handle property updates
-			else if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::PropertyUpdate))
-			{
-				// Validate section exists
-				check(MeshSections.Num() >= Index && MeshSections[Index].IsValid());
+	check(NewProxies.Num() == BatchState.GetNumUpdatedSections());
 
-				auto SectionProperties = new(BatchUpdateData->PropertyUpdateSections) FRuntimeMeshSectionPropertyUpdateData;
+	auto* Commands = new FRuntimeMeshCommandBuffer(CommandBufferPool);
 
-				auto& Section = MeshSections[Index];
+	for (int32 UpdateIndex = 0; UpdateIndex < BatchState.GetNumUpdatedSections(); UpdateIndex++)
+	{
+		const int32 Index = BatchState.GetUpdatedSectionAt(UpdateIndex);
 
-				SectionProperties->SetTargetSection(Index);
-				SectionProperties->bIsVisible = Section->bIsVisible;
-				SectionProperties->bCastsShadow = Section->bCastsShadow;
-			}
-			else
-			{
-				// Unknown update type.
-				checkNoEntry();
-			}
+		// Skip this section if it has no updates.
+		if (!BatchState.HasAnyFlagSet(Index))
+		{
+			continue;
 		}
 
+		// Check that we don't have both create and destroy flagged
+		check(!(BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Create) && BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Destroy)));
 
+		// Handle section created
+		if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Create))
+		{
+			// Add the section create command
+			MeshSections[Index]->WriteCreateCommand(*Commands, Index, NewProxies[UpdateIndex]);
+		}
+		// Handle destroy
+		else if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::Destroy))
+		{
+			Commands->AddCommand(ERuntimeMeshCommandType::DestroySection, Index);
+		}
+		// Handle position/vertex/index updates
+		else if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::PositionsUpdate) || 
+			BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::VerticesUpdate) || BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::IndicesUpdate))
+		{
+			// Validate section exists
+			check(MeshSections.Contains(Index));
+
+			// Get the section update data and add it to the list.
+			bool bHadPositionUpdates = BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::PositionsUpdate);
+			bool bHadVertexUpdates = BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::VerticesUpdate);
+			bool bHadIndexUpdates = BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::IndicesUpdate);
+			MeshSections[Index]->WriteUpdateCommand(*Commands, Index, bHadPositionUpdates, bHadVertexUpdates, bHadIndexUpdates);
+		}
+		// Handle property updates
+		else if (BatchState.HasFlagSet(Index, ERuntimeMeshSectionBatchUpdateType::PropertyUpdate))
+		{
+			// Validate section exists
+			check(MeshSections.Contains(Index));
 
-		// Enqueue update on RT
-		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
-			FRuntimeMeshBatchUpdateCommand,
-			FRuntimeMeshSceneProxy*, RuntimeMeshSceneProxy, (FRuntimeMeshSceneProxy*)SceneProxy,
-			FRuntimeMeshBatchUpdateData*, BatchUpdateData, BatchUpdateData,
-			{
-				RuntimeMeshSceneProxy->ApplyBatchUpdate_RenderThread(BatchUpdateData);
-			}
-		);
+			MeshSections[Index]->WritePropertyUpdateCommand(*Commands, Index);
+		}
+		else
+		{
+			// Unknown update type.
+			checkNoEntry();
+		}
+	}
+
+	// Don't bother the render thread if nothing changed for it
+	if (Commands->IsEmpty())
+	{
+		delete Commands;
+		return nullptr;
+	}
 
+	return Commands;
+}
 
+void URuntimeMeshComponent::FinishBatchUpdate()
+{
+	// Handle all pending rendering updates that couldn't be sent directly.
+	if (BatchState.RequiresSceneProxyRecreate() || !SceneProxy)
+	{
+		MarkRenderStateDirty();
 	}
 
 	// Update collision if necessary
@@ -1495,15 +2022,597 @@ void URuntimeMeshComponent::EndBatchUpdates()
 	BatchState.ResetBatch();
 }
 
+void URuntimeMeshComponent::SubmitBatchUpdates(const TArray<URuntimeMeshComponent*>& Components, const TArray<FRuntimeMeshCommandBuffer*>& BatchUpdates)
+{
+	check(Components.Num() == BatchUpdates.Num());
 
+	auto* ProxyUpdates = new TArray<FRuntimeMeshProxyCommands>();
+	ProxyUpdates->Reserve(Components.Num());
+	for (int32 Index = 0; Index < Components.Num(); Index++)
+	{
+		if (BatchUpdates[Index])
+		{
+			FRuntimeMeshProxyCommands& ProxyUpdate = (*ProxyUpdates)[ProxyUpdates->AddUninitialized()];
+			ProxyUpdate.SceneProxy = Components[Index]->SceneProxy;
+			ProxyUpdate.Commands = BatchUpdates[Index];
+		}
+	}
 
+	if (ProxyUpdates->Num() == 0)
+	{
+		delete ProxyUpdates;
+		return;
+	}
 
+	// Enqueue all the updates on the RT as one command
+	ENQUEUE_UNIQUE_RENDER_COMMAND_ONEPARAMETER(
+		FRuntimeMeshMultiBatchUpdateCommand,
+		TArray<FRuntimeMeshProxyCommands>*, ProxyUpdates, ProxyUpdates,
+		{
+			for (const FRuntimeMeshProxyCommands& ProxyUpdate : *ProxyUpdates)
+			{
+				static_cast<FRuntimeMeshSceneProxy*>(ProxyUpdate.SceneProxy)->ApplyCommands_RenderThread(*ProxyUpdate.Commands);
+				delete ProxyUpdate.Commands;
+			}
+			delete ProxyUpdates;
+		}
+	);
+}
 
+void URuntimeMeshComponent::SetCoalesceUpdates(bool bNewCoalesceUpdates)
+{
+	bCoalesceUpdates = bNewCoalesceUpdates;
 
+	// Send anything that was waiting on the end of the frame. A batch the caller began is left for them to end.
+	if (!bCoalesceUpdates && BatchState.IsCoalescedBatchPending())
+	{
+		EndBatchUpdates();
+	}
+}
 
-
-
-bool URuntimeMeshComponent::GetPhysicsTriMeshData(struct FTriMeshCollisionData* CollisionData, bool InUseAllTriData)
+bool URuntimeMeshComponent::ShouldBatchUpdate()
+{
+	// Start a batch that the world's update manager sends at the end of the frame
+	if (bCoalesceUpdates && !BatchState.IsBatchPending())
+	{
+		if (FRuntimeMeshUpdateManager* UpdateManager = FRuntimeMeshUpdateManager::Get(GetWorld()))
+		{
+			BatchState.StartCoalescedBatch();
+			UpdateManager->AddPendingComponent(this);
+		}
+	}
+
+	return BatchState.IsBatchPending();
+}
+
+
+
+
+
+
+
+
+
+void URuntimeMeshComponent::OptimizeMeshSectionForRendering(int32 SectionIndex)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex);
+
+	RuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
+
+	// Snapshot what the worker needs so it never touches the section
+	struct FOptimizationTask
+	{
+		TArray<int32> Indices;
+		int32 NumVertices;
+		TArray<int32> VertexRemap;
+		FRuntimeMeshOptimizationStats Stats;
+	};
+	TSharedPtr<FOptimizationTask, ESPMode::ThreadSafe> Task = MakeShareable(new FOptimizationTask());
+	Task->Indices = Section->IndexBuffer;
+	Task->NumVertices = Section->GetNumVertices();
+
+	TWeakObjectPtr<URuntimeMeshComponent> WeakThis(this);
+	const uint32 SectionId = Section->SectionId;
+	const uint32 Revision = Section->UpdateRevision;
+
+	// The section itself stays on the game thread, the result finds it again by index and id
+	Async<void>(EAsyncExecution::ThreadPool, [Task, WeakThis, SectionIndex, SectionId, Revision]()
+	{
+		FRuntimeMeshOptimizer::OptimizeForRendering(Task->Indices, Task->NumVertices, Task->VertexRemap, &Task->Stats);
+
+		AsyncTask(ENamedThreads::GameThread, [Task, WeakThis, SectionIndex, SectionId, Revision]()
+		{
+			URuntimeMeshComponent* Mesh = WeakThis.Get();
+
+			// Discard the result if the section was removed, replaced or changed since we started
+			const RuntimeMeshSectionPtr* CurrentSection = Mesh ? Mesh->MeshSections.Find(SectionIndex) : nullptr;
+			if (CurrentSection == nullptr || (*CurrentSection)->SectionId != SectionId || (*CurrentSection)->UpdateRevision != Revision)
+			{
+				return;
+			}
+			RuntimeMeshSectionPtr Section = *CurrentSection;
+
+			Section->RemapVertices(Task->VertexRemap);
+			Section->IndexBuffer = MoveTemp(Task->Indices);
+
+			Mesh->UpdateSectionInternal(SectionIndex, Section->IsDualBufferSection(), true, true, false);
+
+			UE_LOG(RuntimeMeshLog, Verbose, TEXT("RuntimeMeshComponent: Optimized section %d of %s, ACMR %.3f -> %.3f"),
+				SectionIndex, *Mesh->GetName(), Task->Stats.ACMRBefore, Task->Stats.ACMRAfter);
+
+			Mesh->OnSectionOptimized.Broadcast(SectionIndex, Task->Stats.ACMRBefore, Task->Stats.ACMRAfter);
+		});
+	});
+}
+
+void URuntimeMeshComponent::GenerateMeshSectionLODs(int32 SectionIndex, const TArray<float>& TriangleRatios)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex);
+
+	for (float Ratio : TriangleRatios)
+	{
+		if (Ratio <= 0.0f || Ratio > 1.0f)
+		{
+			Log(TEXT("GenerateMeshSectionLODs() - Triangle ratios must be greater than 0 and at most 1."), true);
+			return;
+		}
+	}
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	Section->LODTriangleRatios = TriangleRatios;
+
+	if (TriangleRatios.Num() > 0)
+	{
+		StartSectionLODGeneration(SectionIndex);
+	}
+	else
+	{
+		ClearMeshSectionLODs(SectionIndex);
+	}
+}
+
+void URuntimeMeshComponent::ClearMeshSectionLODs(int32 SectionIndex)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex);
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	const bool bWasDrawingLOD = &Section->GetRenderIndexBuffer() != &Section->IndexBuffer;
+
+	// Any generation still running is discarded when it finishes
+	Section->LODRevision++;
+	Section->LODTriangleRatios.Empty();
+	Section->LODIndexBuffers.Empty();
+	Section->CurrentLOD = 0;
+
+	if (bWasDrawingLOD)
+	{
+		UpdateSectionRenderIndicesInternal(SectionIndex);
+	}
+}
+
+void URuntimeMeshComponent::SetMeshSectionLOD(int32 SectionIndex, int32 LODIndex)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex);
+	check(LODIndex >= 0 && "LODIndex cannot be negative.");
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	const TArray<int32>* OldIndices = &Section->GetRenderIndexBuffer();
+	Section->CurrentLOD = LODIndex;
+
+	if (&Section->GetRenderIndexBuffer() != OldIndices)
+	{
+		UpdateSectionRenderIndicesInternal(SectionIndex);
+	}
+}
+
+int32 URuntimeMeshComponent::GetMeshSectionLOD(int32 SectionIndex) const
+{
+	const RuntimeMeshSectionPtr* Section = MeshSections.Find(SectionIndex);
+	return Section ? (*Section)->CurrentLOD : 0;
+}
+
+int32 URuntimeMeshComponent::GetNumMeshSectionLODs(int32 SectionIndex) const
+{
+	const RuntimeMeshSectionPtr* Section = MeshSections.Find(SectionIndex);
+	return Section ? (*Section)->LODIndexBuffers.Num() : 0;
+}
+
+void URuntimeMeshComponent::StartSectionLODGeneration(int32 SectionIndex)
+{
+	RuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
+	Section->LODRevision++;
+
+	// Only the newest data matters, so let the running generation restart when it sees it's stale
+	if (Section->bLODGenerationInFlight)
+	{
+		return;
+	}
+	Section->bLODGenerationInFlight = true;
+
+	// Snapshot what the worker needs so it never touches the section
+	struct FLODGenerationTask
+	{
+		TArray<FVector> Positions;
+		TArray<int32> Indices;
+		TArray<float> TriangleRatios;
+		TArray<TArray<int32>> LODIndices;
+	};
+	TSharedPtr<FLODGenerationTask, ESPMode::ThreadSafe> Task = MakeShareable(new FLODGenerationTask());
+	Section->GetAllVertexPositions(Task->Positions);
+	Task->Indices = Section->IndexBuffer;
+	Task->TriangleRatios = Section->LODTriangleRatios;
+
+	TWeakObjectPtr<URuntimeMeshComponent> WeakThis(this);
+	const uint32 SectionId = Section->SectionId;
+	const uint32 Revision = Section->LODRevision;
+
+	// The section itself stays on the game thread, the result finds it again by index and id
+	Async<void>(EAsyncExecution::ThreadPool, [Task, WeakThis, SectionIndex, SectionId, Revision]()
+	{
+		FRuntimeMeshSimplifier::GenerateLODs(Task->Positions, Task->Indices, Task->TriangleRatios, Task->LODIndices);
+
+		AsyncTask(ENamedThreads::GameThread, [Task, WeakThis, SectionIndex, SectionId, Revision]()
+		{
+			URuntimeMeshComponent* Mesh = WeakThis.Get();
+
+			// Discard the result if the section was removed or replaced since we started. A replacement tracks its own generation.
+			const RuntimeMeshSectionPtr* CurrentSection = Mesh ? Mesh->MeshSections.Find(SectionIndex) : nullptr;
+			if (CurrentSection == nullptr || (*CurrentSection)->SectionId != SectionId)
+			{
+				return;
+			}
+			RuntimeMeshSectionPtr Section = *CurrentSection;
+			Section->bLODGenerationInFlight = false;
+
+			// Start over if the section changed while this ran, unless its LODs were cleared
+			if (Section->LODRevision != Revision || Section->GetNumVertices() != Task->Positions.Num())
+			{
+				if (Section->LODTriangleRatios.Num() > 0)
+				{
+					Mesh->StartSectionLODGeneration(SectionIndex);
+				}
+				return;
+			}
+
+			Section->LODIndexBuffers = MoveTemp(Task->LODIndices);
+			Section->LODNumVertices = Task->Positions.Num();
+
+			if (Section->CurrentLOD > 0)
+			{
+				Mesh->UpdateSectionRenderIndicesInternal(SectionIndex);
+			}
+
+			Mesh->OnSectionLODsGenerated.Broadcast(SectionIndex, Section->LODIndexBuffers.Num());
+		});
+	});
+}
+
+void URuntimeMeshComponent::UpdateSectionRenderIndicesInternal(int32 SectionIndex)
+{
+	RuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
+
+	// LODs never have more indices than the full section, so they fit the buffers of a static section
+	const bool bRequiresRecreate = !Section->CanUpdateRenderBuffersInPlace();
+
+	// Use the batch update if one is running
+	if (ShouldBatchUpdate())
+	{
+		if (bRequiresRecreate)
+		{
+			BatchState.MarkRenderStateDirty();
+		}
+		else
+		{
+			BatchState.MarkUpdateForSection(SectionIndex, ERuntimeMeshSectionBatchUpdateType::IndicesUpdate);
+		}
+		return;
+	}
+
+	if (SceneProxy && !bRequiresRecreate)
+	{
+		auto* Commands = new FRuntimeMeshCommandBuffer(CommandBufferPool);
+		Section->WriteUpdateCommand(*Commands, SectionIndex, false, false, true);
+
+		// Enqueue update on RT
+		EnqueueRuntimeMeshCommands((FRuntimeMeshSceneProxy*)SceneProxy, Commands);
+	}
+	else
+	{
+		// Mark the renderstate dirty so it's recreated when necessary.
+		MarkRenderStateDirty();
+	}
+}
+
+FRuntimeMeshBVHPtr URuntimeMeshComponent::GetMeshSectionBVH(int32 SectionIndex)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex);
+
+	RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	if (Section->BVH.IsValid() && Section->BVHRevision == Section->UpdateRevision)
+	{
+		return Section->BVH;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_BuildBVH);
+
+	TArray<FVector> Positions;
+	TArray<FVector2D> UVs;
+	Section->GetAllVertexPositions(Positions);
+	Section->GetAllVertexUVs(UVs);
+
+	// Same triangles over the same vertices, so only the bounds need updating
+	if (Section->BVH.IsValid() && Section->BVHIndexRevision == Section->IndexRevision && Section->BVH->GetNumVertices() == Positions.Num())
+	{
+		Section->BVH = MakeShareable(new FRuntimeMeshBVH(*Section->BVH, MoveTemp(Positions), MoveTemp(UVs)));
+	}
+	else
+	{
+		Section->BVH = MakeShareable(new FRuntimeMeshBVH(SectionIndex, MoveTemp(Positions), Section->IndexBuffer, MoveTemp(UVs)));
+		Section->BVHIndexRevision = Section->IndexRevision;
+	}
+
+	Section->BVHRevision = Section->UpdateRevision;
+	return Section->BVH;
+}
+
+void URuntimeMeshComponent::GetMeshSectionBVHs(TArray<FRuntimeMeshBVHPtr>& OutBVHs)
+{
+	OutBVHs.Reset(MeshSections.Num());
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
+	{
+		OutBVHs.Add(GetMeshSectionBVH(MeshSections.GetKeyAt(Index)));
+	}
+}
+
+FRuntimeMeshTopologyPtr URuntimeMeshComponent::GetMeshSectionTopology(int32 SectionIndex)
+{
+	// Validate all update parameters
+	RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex);
+
+	return MeshSections[SectionIndex]->GetTopology();
+}
+
+bool URuntimeMeshComponent::RayCastMeshSections(FVector Start, FVector End, FRuntimeMeshQueryHit& OutHit)
+{
+	TArray<FRuntimeMeshBVHPtr> BVHs;
+	GetMeshSectionBVHs(BVHs);
+
+	// Shorten the ray to each hit so later sections only report closer ones
+	bool bHit = false;
+	FVector RayEnd = End;
+	for (const FRuntimeMeshBVHPtr& BVH : BVHs)
+	{
+		FRuntimeMeshQueryHit Hit;
+		if (BVH->RayCast(Start, RayEnd, Hit))
+		{
+			OutHit = Hit;
+			OutHit.Distance = FVector::Dist(Start, Hit.Position);
+			RayEnd = Hit.Position;
+			bHit = true;
+		}
+	}
+	return bHit;
+}
+
+bool URuntimeMeshComponent::OverlapMeshSectionsSphere(FVector Center, float Radius, TArray<FRuntimeMeshQueryHit>& OutHits)
+{
+	TArray<FRuntimeMeshBVHPtr> BVHs;
+	GetMeshSectionBVHs(BVHs);
+
+	OutHits.Reset();
+	for (const FRuntimeMeshBVHPtr& BVH : BVHs)
+	{
+		BVH->OverlapSphere(Center, Radius, OutHits);
+	}
+	return OutHits.Num() > 0;
+}
+
+bool URuntimeMeshComponent::OverlapMeshSectionsBox(FBox Box, TArray<FRuntimeMeshQueryHit>& OutHits)
+{
+	TArray<FRuntimeMeshBVHPtr> BVHs;
+	GetMeshSectionBVHs(BVHs);
+
+	OutHits.Reset();
+	for (const FRuntimeMeshBVHPtr& BVH : BVHs)
+	{
+		BVH->OverlapBox(Box, OutHits);
+	}
+	return OutHits.Num() > 0;
+}
+
+bool URuntimeMeshComponent::GetClosestPointOnMeshSections(FVector Point, float MaxDistance, FRuntimeMeshQueryHit& OutHit)
+{
+	TArray<FRuntimeMeshBVHPtr> BVHs;
+	GetMeshSectionBVHs(BVHs);
+
+	// Shrink the search to each hit so later sections only report closer ones
+	bool bHit = false;
+	for (const FRuntimeMeshBVHPtr& BVH : BVHs)
+	{
+		FRuntimeMeshQueryHit Hit;
+		if (BVH->GetClosestPoint(Point, MaxDistance, Hit))
+		{
+			OutHit = Hit;
+			MaxDistance = Hit.Distance;
+			bHit = true;
+		}
+	}
+	return bHit;
+}
+
+void URuntimeMeshComponent::AddSectionInternal(int32 SectionIndex, const RuntimeMeshSectionPtr& NewSection)
+{
+	// Carry over what's needed from the section being replaced
+	if (RuntimeMeshSectionPtr* ExistingSection = MeshSections.Find(SectionIndex))
+	{
+		ReplaceSectionInternal(SectionIndex, **ExistingSection, *NewSection);
+	}
+
+	NewSection->SectionId = ++LastSectionId;
+	MeshSections.FindOrAdd(SectionIndex) = NewSection;
+
+	CreateSectionInternal(SectionIndex);
+}
+
+void URuntimeMeshComponent::SliceMeshSections(FVector PlanePosition, FVector PlaneNormal, bool bCreateCap, URuntimeMeshComponent* OtherHalfComponent, TArray<int32>& OutOtherHalfSections)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_SliceMeshSections);
+
+	OutOtherHalfSections.Reset();
+
+	if (PlaneNormal.IsNearlyZero())
+	{
+		Log(TEXT("SliceMeshSections() - PlaneNormal cannot be zero."), true);
+		return;
+	}
+
+	if (OtherHalfComponent == this)
+	{
+		OtherHalfComponent = nullptr;
+	}
+
+	const FPlane Plane(PlanePosition, PlaneNormal.GetSafeNormal());
+
+	// Slice everything before changing anything, sections only read themselves while slicing
+	const int32 NumSections = MeshSections.Num();
+	TArray<int32> SectionIndices;
+	TArray<RuntimeMeshSectionPtr> PositiveHalves;
+	TArray<RuntimeMeshSectionPtr> NegativeHalves;
+	TArray<bool> WasSliced;
+	SectionIndices.SetNumUninitialized(NumSections);
+	PositiveHalves.SetNum(NumSections);
+	NegativeHalves.SetNum(NumSections);
+	WasSliced.SetNumZeroed(NumSections);
+
+	ParallelFor(NumSections, [&](int32 Index)
+	{
+		SectionIndices[Index] = MeshSections.GetKeyAt(Index);
+		WasSliced[Index] = MeshSections.GetValueAt(Index)->Slice(Plane, bCreateCap, PositiveHalves[Index], NegativeHalves[Index]);
+	});
+
+	// Send every change to both components in one batch
+	const bool bStartedBatch = !BatchState.IsBatchPending();
+	const bool bOtherStartedBatch = OtherHalfComponent && !OtherHalfComponent->BatchState.IsBatchPending();
+	if (bStartedBatch)
+	{
+		BeginBatchUpdates();
+	}
+	if (bOtherStartedBatch)
+	{
+		OtherHalfComponent->BeginBatchUpdates();
+	}
+
+	int32 NextSectionIndex = MeshSections.GetMaxKey() + 1;
+	for (int32 Index = 0; Index < NumSections; Index++)
+	{
+		// Sections entirely in front of the plane are left alone
+		if (!WasSliced[Index])
+		{
+			continue;
+		}
+
+		const int32 SectionIndex = SectionIndices[Index];
+		UMaterialInterface* Material = GetMaterial(SectionIndex);
+
+		if (PositiveHalves[Index].IsValid())
+		{
+			AddSectionInternal(SectionIndex, PositiveHalves[Index]);
+		}
+		else
+		{
+			ClearMeshSection(SectionIndex);
+		}
+
+		if (NegativeHalves[Index].IsValid())
+		{
+			URuntimeMeshComponent* TargetComponent = OtherHalfComponent ? OtherHalfComponent : this;
+			const int32 TargetSectionIndex = OtherHalfComponent ? SectionIndex : NextSectionIndex++;
+
+			TargetComponent->AddSectionInternal(TargetSectionIndex, NegativeHalves[Index]);
+			if (TargetComponent->GetMaterial(TargetSectionIndex) != Material)
+			{
+				TargetComponent->SetMaterial(TargetSectionIndex, Material);
+			}
+
+			OutOtherHalfSections.Add(TargetSectionIndex);
+		}
+	}
+
+	if (bStartedBatch)
+	{
+		EndBatchUpdates();
+	}
+	if (bOtherStartedBatch)
+	{
+		OtherHalfComponent->EndBatchUpdates();
+	}
+}
+
+bool URuntimeMeshComponent::BooleanMeshSections(int32 SectionIndex, int32 OtherSectionIndex, ERuntimeMeshBooleanOperation Operation, bool bRemoveOtherSection)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_BooleanMeshSections);
+
+	if (SectionIndex == OtherSectionIndex)
+	{
+		Log(TEXT("BooleanMeshSections() - Cannot combine a section with itself."), true);
+		return false;
+	}
+
+	RuntimeMeshSectionPtr* Section = MeshSections.Find(SectionIndex);
+	RuntimeMeshSectionPtr* OtherSection = MeshSections.Find(OtherSectionIndex);
+	if (Section == nullptr || OtherSection == nullptr)
+	{
+		Log(TEXT("BooleanMeshSections() - Invalid SectionIndex."), true);
+		return false;
+	}
+
+	if (!(*Section)->GetVertexType()->Equals((*OtherSection)->GetVertexType()))
+	{
+		Log(TEXT("BooleanMeshSections() - Sections must have the same vertex type."), true);
+		return false;
+	}
+
+	// Hold on to the snapshots in case anything replaces them while they're in use
+	const FRuntimeMeshBVHPtr BVH = GetMeshSectionBVH(SectionIndex);
+	const FRuntimeMeshBVHPtr OtherBVH = GetMeshSectionBVH(OtherSectionIndex);
+
+	RuntimeMeshSectionPtr Result = (*Section)->Boolean(**OtherSection, *BVH, *OtherBVH, Operation);
+
+	// Send both changes in one batch
+	const bool bStartedBatch = !BatchState.IsBatchPending();
+	if (bStartedBatch)
+	{
+		BeginBatchUpdates();
+	}
+
+	if (Result.IsValid())
+	{
+		AddSectionInternal(SectionIndex, Result);
+	}
+	else
+	{
+		ClearMeshSection(SectionIndex);
+	}
+
+	if (bRemoveOtherSection)
+	{
+		ClearMeshSection(OtherSectionIndex);
+	}
+
+	if (bStartedBatch)
+	{
+		EndBatchUpdates();
+	}
+
+	return true;
+}
+
+bool URuntimeMeshComponent::GetPhysicsTriMeshData(struct FTriMeshCollisionData* CollisionData, bool InUseAllTriData)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_GetPhysicsTriMeshData);
  	int32 VertexBase = 0; // Base vertex index for current section
@@ -1511,9 +2620,10 @@ bool URuntimeMeshComponent::GetPhysicsTriMeshData(struct FTriMeshCollisionData*
 	bool HadCollision = false;
 
 	// For each section..
-	for (int32 SectionIdx = 0; SectionIdx < MeshSections.Num(); SectionIdx++)
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
 	{ 
-		const RuntimeMeshSectionPtr& Section = MeshSections[SectionIdx];
+		const int32 SectionIdx = MeshSections.GetKeyAt(Index);
+		const RuntimeMeshSectionPtr& Section = MeshSections.GetValueAt(Index);
 
 		if (Section.IsValid() && Section->CollisionEnabled)
 		{
@@ -1566,6 +2676,36 @@ bool URuntimeMeshComponent::GetPhysicsTriMeshData(struct FTriMeshCollisionData*
 		}
 	}
  
+	// Weld the collision vertices so split vertices don't produce disconnected triangles
+	if (bWeldCollisionVertices && HadCollision)
+	{
+		TArray<FVector>& Vertices = CollisionData->Vertices;
+
+		TArray<int32> Remap;
+		int32 NumUnique = FRuntimeMeshWelding::BuildRemap(Vertices.Num(), [&Vertices](int32 Index) -> const FVector& { return Vertices[Index]; },
+			[](int32 A, int32 B) { return true; }, CollisionWeldTolerance, Remap);
+		FRuntimeMeshWelding::CompactVertexBuffer(Vertices, Remap, NumUnique);
+
+		// Remap the triangles, dropping any that collapsed
+		int32 NumTriangles = 0;
+		for (int32 TriIdx = 0; TriIdx < CollisionData->Indices.Num(); TriIdx++)
+		{
+			FTriIndices Triangle = CollisionData->Indices[TriIdx];
+			Triangle.v0 = Remap[Triangle.v0];
+			Triangle.v1 = Remap[Triangle.v1];
+			Triangle.v2 = Remap[Triangle.v2];
+
+			if (Triangle.v0 != Triangle.v1 && Triangle.v1 != Triangle.v2 && Triangle.v2 != Triangle.v0)
+			{
+				CollisionData->Indices[NumTriangles] = Triangle;
+				CollisionData->MaterialIndices[NumTriangles] = CollisionData->MaterialIndices[TriIdx];
+				NumTriangles++;
+			}
+		}
+		CollisionData->Indices.SetNum(NumTriangles, false);
+		CollisionData->MaterialIndices.SetNum(NumTriangles, false);
+	}
+
  	CollisionData->bFlipNormals = true;
  
  	return HadCollision;
@@ -1673,7 +2813,48 @@ void URuntimeMeshComponent::BakeCollision()
 	UpdateCollision();
 
 	bCollisionDirty = false;
-	PrePhysicsTick.SetTickFunctionEnable(false);
+	PrePhysicsTick.SetTickFunctionEnable(bHasDynamicAutoSections);
+}
+
+void URuntimeMeshComponent::ResetForPool()
+{
+	// The proxy is about to go away, so drop anything still waiting to be sent to it
+	BatchState.ResetBatch();
+	bHasPendingMorphTargets = false;
+	bHasDynamicAutoSections = false;
+
+	if (IsRegistered())
+	{
+		UnregisterComponent();
+	}
+	DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+
+	// Only the last sections are kept, so recycled allocations can't pile up over many reuses
+	RecycledSections.Reset();
+	for (RuntimeMeshSectionPtr& Section : MeshSections)
+	{
+		if (Section.IsValid())
+		{
+			RecycledSections.Add(Section);
+		}
+	}
+
+	MeshSections.Empty();
+	MeshCollisionSections.Empty();
+	ConvexCollisionSections.Empty();
+	OverrideMaterials.Reset();
+
+	// Empty the BodySetup now, so registering again doesn't bring back the old collision
+	if (BodySetup)
+	{
+		BakeCollision();
+	}
+	else
+	{
+		bCollisionDirty = false;
+	}
+
+	UpdateLocalBounds(false);
 }
 
 void URuntimeMeshComponent::RegisterComponentTickFunctions(bool bRegister)
@@ -1685,7 +2866,7 @@ void URuntimeMeshComponent::RegisterComponentTickFunctions(bool bRegister)
 		if (SetupActorComponentTickFunction(&PrePhysicsTick))
 		{
 			PrePhysicsTick.Target = this;
-			PrePhysicsTick.SetTickFunctionEnable(bCollisionDirty);
+			PrePhysicsTick.SetTickFunctionEnable(bCollisionDirty || bHasDynamicAutoSections);
 		}
 	}
 	else
@@ -1706,21 +2887,35 @@ void URuntimeMeshComponent::Serialize(FArchive& Ar)
 
 	Ar.UsingCustomVersion(FRuntimeMeshVersion::GUID);
 
-	if (Ar.CustomVer(FRuntimeMeshVersion::GUID) >= FRuntimeMeshVersion::Initial)
+	if (Ar.CustomVer(FRuntimeMeshVersion::GUID) >= FRuntimeMeshVersion::ParallelSectionBlocks)
+	{
+		SerializeSectionBlocks(Ar);
+	}
+	else if (Ar.CustomVer(FRuntimeMeshVersion::GUID) >= FRuntimeMeshVersion::Initial)
 	{
+		// Older versions stored every index up to the largest section, newer ones store the index of each section
+		const bool bHasSectionIndices = Ar.CustomVer(FRuntimeMeshVersion::GUID) >= FRuntimeMeshVersion::SparseSections;
+
 		int32 SectionsCount = bShouldSerializeMeshData ? MeshSections.Num() : 0;
 		Ar << SectionsCount;
-		if (Ar.IsLoading() && MeshSections.Num() < SectionsCount)
-		{
-			MeshSections.SetNum(SectionsCount);
-		}
 
 		for (int32 Index = 0; Index < SectionsCount; Index++)
 		{
-			bool IsSectionValid = MeshSections[Index].IsValid();
+			int32 SectionIndex = Index;
+			if (bHasSectionIndices)
+			{
+				if (Ar.IsSaving())
+				{
+					SectionIndex = MeshSections.GetKeyAt(Index);
+				}
+				Ar << SectionIndex;
+			}
+
+			const RuntimeMeshSectionPtr* ExistingSection = MeshSections.Find(SectionIndex);
+			bool IsSectionValid = ExistingSection && ExistingSection->IsValid();
 
 			// WE can only load/save internal types (we don't know how to serialize arbitrary vertex types.
-			if (Ar.IsSaving() && (IsSectionValid && !MeshSections[Index]->bIsInternalSectionType))
+			if (Ar.IsSaving() && (IsSectionValid && !(*ExistingSection)->bIsInternalSectionType))
 			{
 				IsSectionValid = false;
 			}
@@ -1736,7 +2931,7 @@ void URuntimeMeshComponent::Serialize(FArchive& Ar)
 
 					if (Ar.IsSaving())
 					{
-						MeshSections[Index]->GetInternalVertexComponents(NumUVChannels, WantsHalfPrecisionUVs);
+						MeshSections[SectionIndex]->GetInternalVertexComponents(NumUVChannels, WantsHalfPrecisionUVs);
 					}
 
 					Ar << NumUVChannels;
@@ -1744,7 +2939,7 @@ void URuntimeMeshComponent::Serialize(FArchive& Ar)
 
 					if (Ar.IsLoading())
 					{
-						CreateOrResetSectionInternalType(Index, NumUVChannels, WantsHalfPrecisionUVs);
+						CreateOrResetSectionInternalType(SectionIndex, NumUVChannels, WantsHalfPrecisionUVs);
 					}
 
 				}
@@ -1762,11 +2957,11 @@ void URuntimeMeshComponent::Serialize(FArchive& Ar)
 
 					if (Ar.IsLoading())
 					{
-						CreateOrResetSectionInternalType(Index, TextureChannels, false);
+						CreateOrResetSectionInternalType(SectionIndex, TextureChannels, false);
 					}
 				}
 
-				FRuntimeMeshSectionInterface& SectionPtr = *MeshSections[Index].Get();
+				FRuntimeMeshSectionInterface& SectionPtr = *MeshSections[SectionIndex].Get();
 				Ar << SectionPtr;
 
 			}
@@ -1795,6 +2990,161 @@ void URuntimeMeshComponent::Serialize(FArchive& Ar)
 	}
 }	
 
+namespace RuntimeMeshSerializationInternal
+{
+	/* What's needed to create a section before its block is decoded */
+	struct FSectionBlockHeader
+	{
+		int32 SectionIndex;
+		int32 NumUVChannels;
+		bool bWantsHalfPrecisionUVs;
+
+		friend FArchive& operator<<(FArchive& Ar, FSectionBlockHeader& Header)
+		{
+			Ar << Header.SectionIndex;
+			Ar << Header.NumUVChannels;
+			Ar << Header.bWantsHalfPrecisionUVs;
+			return Ar;
+		}
+	};
+
+	/* Blocks are written by their own archives, which need to match the outer one */
+	void CopyArchiveState(FArchive& BlockAr, const FArchive& Ar, const FCustomVersionContainer& CustomVersions)
+	{
+		BlockAr.SetUE4Ver(Ar.UE4Ver());
+		BlockAr.SetCustomVersions(CustomVersions);
+		BlockAr.SetByteSwapping(Ar.ForceByteSwapping());
+	}
+
+	/* Does the offset table describe NumBlocks blocks laid out back to back from the start of the data, in order */
+	bool IsValidBlockTable(const TArray<int64>& BlockOffsets, int32 NumBlocks)
+	{
+		if (BlockOffsets.Num() != NumBlocks + 1 || BlockOffsets[0] != 0 || BlockOffsets.Last() > MAX_int32)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < NumBlocks; Index++)
+		{
+			if (BlockOffsets[Index + 1] < BlockOffsets[Index])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+void URuntimeMeshComponent::SerializeSectionBlocks(FArchive& Ar)
+{
+	using namespace RuntimeMeshSerializationInternal;
+
+	// Headers come first so every section can be created before any of them is decoded
+	TArray<FSectionBlockHeader> Headers;
+	TArray<FRuntimeMeshSectionInterface*> Sections;
+	if (Ar.IsSaving() && bShouldSerializeMeshData)
+	{
+		for (int32 Index = 0; Index < MeshSections.Num(); Index++)
+		{
+			const int32 SectionIndex = MeshSections.GetKeyAt(Index);
+			const RuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+
+			// We can only save internal types, we don't know how to serialize arbitrary vertex types
+			if (Section.IsValid() && Section->bIsInternalSectionType)
+			{
+				FSectionBlockHeader& Header = Headers[Headers.AddDefaulted()];
+				Header.SectionIndex = SectionIndex;
+				Section->GetInternalVertexComponents(Header.NumUVChannels, Header.bWantsHalfPrecisionUVs);
+				Sections.Add(Section.Get());
+			}
+		}
+	}
+
+	Ar << Headers;
+
+	if (Ar.IsLoading())
+	{
+		for (FSectionBlockHeader& Header : Headers)
+		{
+			Sections.Add(CreateOrResetSectionInternalType(Header.SectionIndex, Header.NumUVChannels, Header.bWantsHalfPrecisionUVs).Get());
+		}
+	}
+
+	// Block offsets into the data that follows, with one extra entry holding the total size
+	TArray<int64> BlockOffsets;
+	const FCustomVersionContainer CustomVersions = Ar.GetCustomVersions();
+
+	if (Ar.IsSaving())
+	{
+		TArray<TArray<uint8>> Blocks;
+		Blocks.SetNum(Sections.Num());
+
+		ParallelFor(Sections.Num(), [&](int32 Index)
+		{
+			FMemoryWriter Writer(Blocks[Index], Ar.IsPersistent());
+			CopyArchiveState(Writer, Ar, CustomVersions);
+			Writer << *Sections[Index];
+		});
+
+		BlockOffsets.SetNumUninitialized(Sections.Num() + 1);
+		BlockOffsets[0] = 0;
+		for (int32 Index = 0; Index < Sections.Num(); Index++)
+		{
+			BlockOffsets[Index + 1] = BlockOffsets[Index] + Blocks[Index].Num();
+		}
+
+		Ar << BlockOffsets;
+		for (TArray<uint8>& Block : Blocks)
+		{
+			Ar.Serialize(Block.GetData(), Block.Num());
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		Ar << BlockOffsets;
+		const int64 RemainingSize = Ar.TotalSize() >= 0 ? Ar.TotalSize() - Ar.Tell() : MAX_int64;
+		if (!IsValidBlockTable(BlockOffsets, Sections.Num()) || BlockOffsets.Last() > RemainingSize)
+		{
+			UE_LOG(RuntimeMeshLog, Error, TEXT("RuntimeMeshComponent: Section offset table doesn't match the %d saved sections."), Sections.Num());
+			Ar.SetError();
+			return;
+		}
+
+		TArray<uint8> Data;
+		Data.SetNumUninitialized((int32)BlockOffsets.Last());
+		Ar.Serialize(Data.GetData(), Data.Num());
+
+		TArray<bool> BlockFailed;
+		BlockFailed.SetNumZeroed(Sections.Num());
+
+		// Each block only fills its own section
+		ParallelFor(Sections.Num(), [&](int32 Index)
+		{
+			FMemoryReader Reader(Data, Ar.IsPersistent());
+			CopyArchiveState(Reader, Ar, CustomVersions);
+			Reader.Seek(BlockOffsets[Index]);
+			Reader << *Sections[Index];
+			BlockFailed[Index] = Reader.IsError() || Reader.Tell() != BlockOffsets[Index + 1];
+		});
+
+		for (int32 Index = 0; Index < Sections.Num(); Index++)
+		{
+			if (BlockFailed[Index])
+			{
+				UE_LOG(RuntimeMeshLog, Error, TEXT("RuntimeMeshComponent: Section %d failed to load."), Headers[Index].SectionIndex);
+				Ar.SetError();
+			}
+		}
+
+		// Loading into a live component, as for undo, so hand every section to the renderer at once
+		if (Sections.Num() > 0 && IsRegistered())
+		{
+			UpdateLocalBounds();
+			MarkRenderStateDirty();
+		}
+	}
+}
+
 void URuntimeMeshComponent::PostLoad()
 {
 	Super::PostLoad();
@@ -3,6 +3,7 @@
 #include "RuntimeMeshComponentPluginPrivatePCH.h"
 #include "RuntimeMeshVersion.h"
 #include "RuntimeMeshComponentPlugin.h"
+#include "RuntimeMeshUpdateManager.h"
 
 
 // Register the custom version with core
@@ -24,13 +25,13 @@ IMPLEMENT_MODULE(FRuntimeMeshComponentPlugin, RuntimeMeshComponent)
 
 void FRuntimeMeshComponentPlugin::StartupModule()
 {
-
+	FRuntimeMeshUpdateManager::Initialize();
 }
 
 
 void FRuntimeMeshComponentPlugin::ShutdownModule()
 {
-
+	FRuntimeMeshUpdateManager::Shutdown();
 }
 
 
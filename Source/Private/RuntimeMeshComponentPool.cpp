@@ -0,0 +1,153 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshComponentPool.h"
+#include "RuntimeMeshComponent.h"
+
+
+URuntimeMeshComponentPool::URuntimeMeshComponentPool(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer), MaxPooledComponents(64), bKeepRenderState(false), NumActive(0), NumHits(0), NumMisses(0), NumDiscarded(0)
+{
+}
+
+URuntimeMeshComponent* URuntimeMeshComponentPool::AcquireComponent(AActor* Owner, USceneComponent* AttachParent)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_AcquirePooledComponent);
+
+	check(Owner && "Pooled components need an owner.");
+
+	if (AttachParent == nullptr)
+	{
+		AttachParent = Owner->GetRootComponent();
+	}
+
+	// Most recently released first, its allocations are the most likely to still be in cache
+	for (int32 Index = PooledComponents.Num() - 1; Index >= 0; Index--)
+	{
+		const FRuntimeMeshPooledComponent Pooled = PooledComponents[Index];
+		URuntimeMeshComponent* Component = Pooled.Component;
+
+		// Components go away with their owner
+		if (Component == nullptr || Component->IsPendingKill())
+		{
+			RemovePooledComponent(Index);
+			continue;
+		}
+
+		if (Component->GetOwner() != Owner)
+		{
+			continue;
+		}
+
+		RemovePooledComponent(Index);
+
+		if (Pooled.bKeptRenderState && Component->IsRegistered())
+		{
+			Component->AttachToComponent(AttachParent, FAttachmentTransformRules::KeepRelativeTransform);
+			Component->SetCollisionEnabled(Pooled.CollisionEnabled);
+			Component->SetVisibility(true);
+		}
+		else
+		{
+			if (Pooled.bKeptRenderState)
+			{
+				Component->ResetForPool();
+			}
+			Component->SetupAttachment(AttachParent);
+			Component->RegisterComponent();
+		}
+
+		NumHits++;
+		NumActive++;
+		INC_DWORD_STAT(STAT_RuntimeMesh_ComponentPoolHits);
+		return Component;
+	}
+
+	URuntimeMeshComponent* Component = NewObject<URuntimeMeshComponent>(Owner);
+	Component->SetupAttachment(AttachParent);
+	Component->RegisterComponent();
+
+	NumMisses++;
+	NumActive++;
+	INC_DWORD_STAT(STAT_RuntimeMesh_ComponentPoolMisses);
+	return Component;
+}
+
+void URuntimeMeshComponentPool::ReleaseComponent(URuntimeMeshComponent* Component)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_ReleasePooledComponent);
+
+	if (Component == nullptr || Component->IsPendingKill())
+	{
+		return;
+	}
+
+	checkSlow(!PooledComponents.ContainsByPredicate([Component](const FRuntimeMeshPooledComponent& Pooled) { return Pooled.Component == Component; }));
+
+	// Components created elsewhere can be released into the pool too
+	NumActive = FMath::Max(0, NumActive - 1);
+
+	if (PooledComponents.Num() >= MaxPooledComponents)
+	{
+		Component->DestroyComponent();
+		NumDiscarded++;
+		return;
+	}
+
+	FRuntimeMeshPooledComponent& Pooled = PooledComponents[PooledComponents.AddDefaulted()];
+	Pooled.Component = Component;
+	Pooled.bKeptRenderState = bKeepRenderState && Component->IsRegistered();
+
+	if (Pooled.bKeptRenderState)
+	{
+		Pooled.CollisionEnabled = Component->GetCollisionEnabled();
+		Component->SetVisibility(false);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+	else
+	{
+		Component->ResetForPool();
+	}
+
+	INC_DWORD_STAT(STAT_RuntimeMesh_PooledComponents);
+}
+
+void URuntimeMeshComponentPool::Trim(int32 MaxComponents)
+{
+	MaxComponents = FMath::Max(0, MaxComponents);
+	while (PooledComponents.Num() > MaxComponents)
+	{
+		URuntimeMeshComponent* Component = PooledComponents[0].Component;
+		RemovePooledComponent(0);
+
+		if (Component && !Component->IsPendingKill())
+		{
+			Component->DestroyComponent();
+		}
+	}
+}
+
+FRuntimeMeshComponentPoolStats URuntimeMeshComponentPool::GetStats() const
+{
+	FRuntimeMeshComponentPoolStats Stats;
+	Stats.NumPooled = PooledComponents.Num();
+	Stats.NumActive = NumActive;
+	Stats.NumHits = NumHits;
+	Stats.NumMisses = NumMisses;
+	Stats.NumDiscarded = NumDiscarded;
+	Stats.HitRate = NumHits + NumMisses > 0 ? NumHits / float(NumHits + NumMisses) : 0.0f;
+	return Stats;
+}
+
+void URuntimeMeshComponentPool::LogStats() const
+{
+	const FRuntimeMeshComponentPoolStats Stats = GetStats();
+	UE_LOG(RuntimeMeshLog, Log, TEXT("RuntimeMeshComponentPool %s: %d pooled, %d active, %d hits, %d misses (%.1f%% hit rate), %d discarded"),
+		*GetName(), Stats.NumPooled, Stats.NumActive, Stats.NumHits, Stats.NumMisses, Stats.HitRate * 100.0f, Stats.NumDiscarded);
+}
+
+void URuntimeMeshComponentPool::RemovePooledComponent(int32 Index)
+{
+	PooledComponents.RemoveAt(Index, 1, false);
+	DEC_DWORD_STAT(STAT_RuntimeMesh_PooledComponents);
+}
@@ -26,31 +26,38 @@ void URuntimeMeshLibrary::ConvertQuadToTriangles(TArray<int32>& Triangles, int32
 
 void URuntimeMeshLibrary::CreateGridMeshTriangles(int32 NumX, int32 NumY, bool bWinding, TArray<int32>& Triangles)
 {
-	Triangles.Reset();
+	CreateGridMeshIndices(NumX, NumY, bWinding, Triangles);
+}
+
+void URuntimeMeshLibrary::CreateGridMesh(int32 NumX, int32 NumY, FVector2D Spacing, bool bWinding, TArray<FVector>& Vertices, TArray<int32>& Triangles,
+	TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FRuntimeMeshTangent>& Tangents)
+{
+	if (!CreateGridMeshIndices(NumX, NumY, bWinding, Triangles))
+	{
+		Vertices.Reset();
+		Normals.Reset();
+		UVs.Reset();
+		Tangents.Reset();
+		return;
+	}
 
-	if (NumX >= 2 && NumY >= 2)
+	const int32 NumVertices = NumX * NumY;
+	Vertices.SetNumUninitialized(NumVertices);
+	Normals.SetNumUninitialized(NumVertices);
+	UVs.SetNumUninitialized(NumVertices);
+	Tangents.SetNumUninitialized(NumVertices);
+
+	ParallelFor(NumX, [&](int32 XIdx)
 	{
-		// Build Quads
-		for (int XIdx = 0; XIdx < NumX - 1; XIdx++)
+		for (int32 YIdx = 0; YIdx < NumY; YIdx++)
 		{
-			for (int YIdx = 0; YIdx < NumY - 1; YIdx++)
-			{
-				const int32 I0 = (XIdx + 0)*NumY + (YIdx + 0);
-				const int32 I1 = (XIdx + 1)*NumY + (YIdx + 0);
-				const int32 I2 = (XIdx + 1)*NumY + (YIdx + 1);
-				const int32 I3 = (XIdx + 0)*NumY + (YIdx + 1);
-
-				if (bWinding)
-				{
-					ConvertQuadToTriangles(Triangles, I0, I1, I2, I3);
-				}
-				else
-				{
-					ConvertQuadToTriangles(Triangles, I0, I3, I2, I1);
-				}
-			}
+			const int32 Index = XIdx * NumY + YIdx;
+			Vertices[Index] = FVector(XIdx * Spacing.X, YIdx * Spacing.Y, 0.0f);
+			Normals[Index] = FVector(0.0f, 0.0f, 1.0f);
+			UVs[Index] = FVector2D((float)XIdx / (NumX - 1), (float)YIdx / (NumY - 1));
+			Tangents[Index] = FRuntimeMeshTangent(1.0f, 0.0f, 0.0f);
 		}
-	}
+	});
 }
 
 
@@ -140,3 +147,60 @@ void URuntimeMeshLibrary::CreateBoxMesh(FVector BoxRadius, TArray<FVector>& Vert
 	UVs[3] = UVs[7] = UVs[11] = UVs[15] = UVs[19] = UVs[23] = FVector2D(1.f, 0.f);
 }
 
+
+int32 URuntimeMeshLibrary::WeldVertices(TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, 
+	TArray<FLinearColor>& Colors, TArray<FRuntimeMeshTangent>& Tangents, const FRuntimeMeshWeldSettings& Settings)
+{
+	const int32 NumVertices = Vertices.Num();
+	const bool bHasNormals = Normals.Num() == NumVertices && !Settings.bPositionsOnly;
+	const bool bHasUVs = UVs.Num() == NumVertices && !Settings.bPositionsOnly;
+	const bool bHasColors = Colors.Num() == NumVertices && !Settings.bPositionsOnly;
+	const bool bHasTangents = Tangents.Num() == NumVertices && !Settings.bPositionsOnly;
+
+	const float NormalThreshold = Settings.GetNormalThreshold();
+	const float UVToleranceSquared = FMath::Square(Settings.UVTolerance);
+	const float ColorTolerance = Settings.ColorTolerance / 255.0f;
+
+	auto Matches = [&](int32 A, int32 B) -> bool
+	{
+		return (!bHasNormals || (Normals[A] | Normals[B]) >= NormalThreshold) &&
+			(!bHasTangents || ((Tangents[A].TangentX | Tangents[B].TangentX) >= NormalThreshold && Tangents[A].bFlipTangentY == Tangents[B].bFlipTangentY)) &&
+			(!bHasUVs || FVector2D::DistSquared(UVs[A], UVs[B]) <= UVToleranceSquared) &&
+			(!bHasColors || Colors[A].Equals(Colors[B], ColorTolerance));
+	};
+
+	TArray<int32> Remap;
+	int32 NumUnique = FRuntimeMeshWelding::BuildRemap(NumVertices, [&Vertices](int32 Index) -> const FVector& { return Vertices[Index]; },
+		Matches, Settings.PositionTolerance, Remap);
+
+	FRuntimeMeshWelding::CompactVertexBuffer(Vertices, Remap, NumUnique);
+	if (Normals.Num() == NumVertices)
+	{
+		FRuntimeMeshWelding::CompactVertexBuffer(Normals, Remap, NumUnique);
+	}
+	if (UVs.Num() == NumVertices)
+	{
+		FRuntimeMeshWelding::CompactVertexBuffer(UVs, Remap, NumUnique);
+	}
+	if (Colors.Num() == NumVertices)
+	{
+		FRuntimeMeshWelding::CompactVertexBuffer(Colors, Remap, NumUnique);
+	}
+	if (Tangents.Num() == NumVertices)
+	{
+		FRuntimeMeshWelding::CompactVertexBuffer(Tangents, Remap, NumUnique);
+	}
+
+	FRuntimeMeshWelding::RemapIndexBuffer(Triangles, Remap);
+	if (Settings.bRemoveDegenerateTriangles)
+	{
+		FRuntimeMeshWelding::RemoveDegenerateTriangles(Triangles);
+	}
+
+	return NumVertices - NumUnique;
+}
+
+int32 URuntimeMeshLibrary::WeldPositions(TArray<FVector>& Vertices, TArray<int32>& Triangles, float PositionTolerance)
+{
+	return FRuntimeMeshWelding::WeldPositions(Vertices, Triangles, PositionTolerance);
+}
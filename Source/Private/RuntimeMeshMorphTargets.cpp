@@ -0,0 +1,202 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshMorphTargets.h"
+#include "RuntimeMeshOptimization.h"
+
+
+namespace RuntimeMeshMorphTargetsInternal
+{
+	/* Sorts a target's deltas by vertex index and calculates its delta bounds */
+	static void FinalizeTarget(FRuntimeMeshMorphTarget& Target)
+	{
+		TArray<int32> Order;
+		Order.SetNumUninitialized(Target.VertexIndices.Num());
+		for (int32 Index = 0; Index < Order.Num(); Index++)
+		{
+			Order[Index] = Index;
+		}
+
+		const TArray<int32>& VertexIndices = Target.VertexIndices;
+		Order.Sort([&VertexIndices](int32 A, int32 B) { return VertexIndices[A] < VertexIndices[B]; });
+
+		TArray<int32> SortedIndices;
+		TArray<FVector> SortedDeltas;
+		SortedIndices.SetNumUninitialized(Order.Num());
+		SortedDeltas.SetNumUninitialized(Order.Num());
+
+		Target.DeltaBounds = FBox(FVector::ZeroVector, FVector::ZeroVector);
+		for (int32 Index = 0; Index < Order.Num(); Index++)
+		{
+			SortedIndices[Index] = Target.VertexIndices[Order[Index]];
+			SortedDeltas[Index] = Target.PositionDeltas[Order[Index]];
+			Target.DeltaBounds += SortedDeltas[Index];
+		}
+
+		Target.VertexIndices = MoveTemp(SortedIndices);
+		Target.PositionDeltas = MoveTemp(SortedDeltas);
+	}
+}
+
+
+FRuntimeMeshMorphTargetSet::FRuntimeMeshMorphTargetSet(const TArray<FVector>& InBasePositions, const FBox& InBaseBounds)
+	: BasePositions(InBasePositions), BaseBounds(InBaseBounds), AppliedStart(0), AppliedEnd(0), bIsDirty(false)
+{
+}
+
+int32 FRuntimeMeshMorphTargetSet::AddTarget(const TArray<int32>& VertexIndices, const TArray<FVector>& PositionDeltas)
+{
+	check(VertexIndices.Num() == PositionDeltas.Num() && "PositionDeltas must be the same length as VertexIndices.");
+
+	FRuntimeMeshMorphTarget Target;
+	Target.VertexIndices = VertexIndices;
+	Target.PositionDeltas = PositionDeltas;
+
+	for (int32 VertexIndex : Target.VertexIndices)
+	{
+		check(VertexIndex >= 0 && VertexIndex < BasePositions.Num() && "Morph target vertex index out of range.");
+	}
+
+	RuntimeMeshMorphTargetsInternal::FinalizeTarget(Target);
+	return Targets.Add(MoveTemp(Target));
+}
+
+bool FRuntimeMeshMorphTargetSet::SetWeight(int32 TargetIndex, float Weight)
+{
+	check(Targets.IsValidIndex(TargetIndex) && "Invalid morph target index.");
+
+	FRuntimeMeshMorphTarget& Target = Targets[TargetIndex];
+	if (Target.Weight == Weight)
+	{
+		return false;
+	}
+
+	Target.Weight = Weight;
+	bIsDirty = true;
+	return true;
+}
+
+void FRuntimeMeshMorphTargetSet::Apply(TArray<FVector>& Positions, int32& OutStartIndex, int32& OutCount, FBox& OutBounds)
+{
+	check(Positions.Num() == BasePositions.Num());
+
+	// Find the range the active targets touch, and grow the bounds by their weighted deltas
+	int32 ActiveStart = MAX_int32;
+	int32 ActiveEnd = 0;
+	FVector BoundsMin = BaseBounds.Min;
+	FVector BoundsMax = BaseBounds.Max;
+	for (const FRuntimeMeshMorphTarget& Target : Targets)
+	{
+		if (Target.Weight == 0.0f || Target.VertexIndices.Num() == 0)
+		{
+			continue;
+		}
+
+		ActiveStart = FMath::Min(ActiveStart, Target.GetFirstVertex());
+		ActiveEnd = FMath::Max(ActiveEnd, Target.GetLastVertex() + 1);
+
+		// A negative weight flips the delta bounds
+		const FVector ScaledMin = Target.DeltaBounds.Min * Target.Weight;
+		const FVector ScaledMax = Target.DeltaBounds.Max * Target.Weight;
+		BoundsMin += ScaledMin.ComponentMin(ScaledMax);
+		BoundsMax += ScaledMin.ComponentMax(ScaledMax);
+	}
+	OutBounds = FBox(BoundsMin, BoundsMax);
+
+	// Everything the last blend moved has to be rewritten, even if its target is no longer active
+	const bool bHasActive = ActiveStart < ActiveEnd;
+	const bool bHadApplied = AppliedStart < AppliedEnd;
+	const int32 StartIndex = bHadApplied ? (bHasActive ? FMath::Min(ActiveStart, AppliedStart) : AppliedStart) : (bHasActive ? ActiveStart : 0);
+	const int32 EndIndex = bHadApplied ? (bHasActive ? FMath::Max(ActiveEnd, AppliedEnd) : AppliedEnd) : (bHasActive ? ActiveEnd : 0);
+
+	RestoreRange(Positions, StartIndex, EndIndex);
+
+	// Accumulate the sparse deltas, one vertex per vector operation
+	FVector* PositionData = Positions.GetData();
+	for (const FRuntimeMeshMorphTarget& Target : Targets)
+	{
+		if (Target.Weight == 0.0f)
+		{
+			continue;
+		}
+
+		const VectorRegister Weight = VectorLoadFloat1(&Target.Weight);
+		const int32* VertexIndices = Target.VertexIndices.GetData();
+		const FVector* Deltas = Target.PositionDeltas.GetData();
+		const int32 NumDeltas = Target.VertexIndices.Num();
+		for (int32 Index = 0; Index < NumDeltas; Index++)
+		{
+			FVector* Position = PositionData + VertexIndices[Index];
+			const VectorRegister Delta = VectorLoadFloat3(Deltas + Index);
+			VectorStoreFloat3(VectorMultiplyAdd(Delta, Weight, VectorLoadFloat3(Position)), Position);
+		}
+	}
+
+	AppliedStart = bHasActive ? ActiveStart : 0;
+	AppliedEnd = bHasActive ? ActiveEnd : 0;
+	bIsDirty = false;
+
+	OutStartIndex = StartIndex;
+	OutCount = EndIndex - StartIndex;
+}
+
+void FRuntimeMeshMorphTargetSet::Restore(TArray<FVector>& Positions, int32& OutStartIndex, int32& OutCount, FBox& OutBounds)
+{
+	check(Positions.Num() == BasePositions.Num());
+
+	RestoreRange(Positions, AppliedStart, AppliedEnd);
+
+	OutStartIndex = AppliedStart;
+	OutCount = AppliedEnd - AppliedStart;
+	OutBounds = BaseBounds;
+
+	AppliedStart = 0;
+	AppliedEnd = 0;
+}
+
+void FRuntimeMeshMorphTargetSet::Rebase(const TArray<FVector>& InBasePositions, const FBox& InBaseBounds)
+{
+	check(InBasePositions.Num() == BasePositions.Num());
+
+	FMemory::Memcpy(BasePositions.GetData(), InBasePositions.GetData(), BasePositions.Num() * sizeof(FVector));
+	BaseBounds = InBaseBounds;
+
+	// Nothing is blended in anymore, so only active targets need applying
+	AppliedStart = 0;
+	AppliedEnd = 0;
+	bIsDirty = false;
+	for (const FRuntimeMeshMorphTarget& Target : Targets)
+	{
+		bIsDirty |= Target.Weight != 0.0f && Target.VertexIndices.Num() > 0;
+	}
+}
+
+void FRuntimeMeshMorphTargetSet::RemapVertices(const TArray<int32>& Remap)
+{
+	FRuntimeMeshOptimizer::RemapVertexBuffer(BasePositions, Remap);
+
+	for (FRuntimeMeshMorphTarget& Target : Targets)
+	{
+		for (int32& VertexIndex : Target.VertexIndices)
+		{
+			VertexIndex = Remap[VertexIndex];
+		}
+		RuntimeMeshMorphTargetsInternal::FinalizeTarget(Target);
+	}
+
+	// The blended vertices are scattered now, so the next blend rewrites everything
+	if (AppliedStart < AppliedEnd)
+	{
+		AppliedStart = 0;
+		AppliedEnd = BasePositions.Num();
+		bIsDirty = true;
+	}
+}
+
+void FRuntimeMeshMorphTargetSet::RestoreRange(TArray<FVector>& Positions, int32 StartIndex, int32 EndIndex) const
+{
+	if (StartIndex < EndIndex)
+	{
+		FMemory::Memcpy(Positions.GetData() + StartIndex, BasePositions.GetData() + StartIndex, (EndIndex - StartIndex) * sizeof(FVector));
+	}
+}
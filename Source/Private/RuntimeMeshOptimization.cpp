@@ -0,0 +1,302 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshOptimization.h"
+
+
+namespace RuntimeMeshOptimizationInternal
+{
+	/* Scoring constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation" */
+	static const float CacheDecayPower = 1.5f;
+	static const float LastTriScore = 0.75f;
+	static const float ValenceBoostScale = 2.0f;
+	static const float ValenceBoostPower = 0.5f;
+
+	static float ScoreVertex(int32 CachePosition, int32 NumActiveTriangles)
+	{
+		// No triangles left to use this vertex, it doesn't matter
+		if (NumActiveTriangles == 0)
+		{
+			return -1.0f;
+		}
+
+		float Score = 0.0f;
+		if (CachePosition >= 0)
+		{
+			if (CachePosition < 3)
+			{
+				// Used by the last triangle, so fixed score regardless of which vertex it was
+				Score = LastTriScore;
+			}
+			else
+			{
+				const float Scaler = 1.0f / (FRuntimeMeshOptimizer::CacheSize - 3);
+				Score = FMath::Pow(1.0f - (CachePosition - 3) * Scaler, CacheDecayPower);
+			}
+		}
+
+		// Boost vertices with few triangles left so they're finished off and don't linger
+		Score += ValenceBoostScale * FMath::Pow((float)NumActiveTriangles, -ValenceBoostPower);
+		return Score;
+	}
+
+	/* Is this corner's vertex also used by an earlier corner of the same triangle. Degenerate triangles only count once per vertex. */
+	static bool IsRepeatedCorner(const TArray<int32>& Indices, int32 Index)
+	{
+		const int32 Corner = Index % 3;
+		return (Corner > 0 && Indices[Index] == Indices[Index - 1]) || (Corner > 1 && Indices[Index] == Indices[Index - 2]);
+	}
+}
+
+
+float FRuntimeMeshOptimizer::CalculateACMR(const TArray<int32>& Indices, int32 NumVertices, int32 FIFOSize)
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+	if (NumTriangles == 0)
+	{
+		return 0.0f;
+	}
+
+	// Time each vertex entered the cache, a vertex is present while fewer than FIFOSize misses have happened since
+	TArray<int32> EntryTime;
+	EntryTime.Init(INDEX_NONE, NumVertices);
+
+	int32 NumMisses = 0;
+	for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+	{
+		const int32 Vertex = Indices[Index];
+		if (EntryTime[Vertex] == INDEX_NONE || NumMisses - EntryTime[Vertex] >= FIFOSize)
+		{
+			EntryTime[Vertex] = NumMisses;
+			NumMisses++;
+		}
+	}
+
+	return (float)NumMisses / NumTriangles;
+}
+
+void FRuntimeMeshOptimizer::OptimizeVertexCache(TArray<int32>& Indices, int32 NumVertices)
+{
+	using namespace RuntimeMeshOptimizationInternal;
+
+	const int32 NumTriangles = Indices.Num() / 3;
+	if (NumTriangles == 0 || NumVertices == 0)
+	{
+		return;
+	}
+
+	// Build the vertex -> triangle adjacency. Each vertex's active triangles are kept at the front of its range.
+	TArray<int32> NumActiveTriangles;
+	NumActiveTriangles.SetNumZeroed(NumVertices);
+	for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+	{
+		if (!IsRepeatedCorner(Indices, Index))
+		{
+			NumActiveTriangles[Indices[Index]]++;
+		}
+	}
+
+	TArray<int32> AdjacencyStart;
+	AdjacencyStart.SetNumUninitialized(NumVertices + 1);
+	AdjacencyStart[0] = 0;
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		AdjacencyStart[Vertex + 1] = AdjacencyStart[Vertex] + NumActiveTriangles[Vertex];
+	}
+
+	TArray<int32> Adjacency;
+	Adjacency.SetNumUninitialized(AdjacencyStart[NumVertices]);
+	{
+		TArray<int32> Fill(AdjacencyStart.GetData(), NumVertices);
+		for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+		{
+			if (!IsRepeatedCorner(Indices, Index))
+			{
+				Adjacency[Fill[Indices[Index]]++] = Index / 3;
+			}
+		}
+	}
+
+	// Initial scores
+	TArray<int32> CachePosition;
+	CachePosition.Init(INDEX_NONE, NumVertices);
+
+	TArray<float> VertexScore;
+	VertexScore.SetNumUninitialized(NumVertices);
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		VertexScore[Vertex] = ScoreVertex(INDEX_NONE, NumActiveTriangles[Vertex]);
+	}
+
+	TArray<float> TriangleScore;
+	TriangleScore.SetNumUninitialized(NumTriangles);
+	TArray<bool> TriangleAdded;
+	TriangleAdded.Init(false, NumTriangles);
+
+	int32 BestTriangle = INDEX_NONE;
+	float BestScore = -1.0f;
+	for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+	{
+		TriangleScore[Triangle] = VertexScore[Indices[Triangle * 3 + 0]] + VertexScore[Indices[Triangle * 3 + 1]] + VertexScore[Indices[Triangle * 3 + 2]];
+		if (TriangleScore[Triangle] > BestScore)
+		{
+			BestScore = TriangleScore[Triangle];
+			BestTriangle = Triangle;
+		}
+	}
+
+	// The simulated cache, with room for the 3 vertices pushed in before the oldest fall out
+	int32 Cache[CacheSize + 3];
+	int32 NumCached = 0;
+
+	TArray<int32> NewIndices;
+	NewIndices.SetNumUninitialized(NumTriangles * 3);
+	int32 NextUnaddedTriangle = 0;
+
+	for (int32 OutTriangle = 0; OutTriangle < NumTriangles; OutTriangle++)
+	{
+		// Nothing in the cache is useful, so start again from the next unused triangle
+		if (BestTriangle == INDEX_NONE)
+		{
+			while (TriangleAdded[NextUnaddedTriangle])
+			{
+				NextUnaddedTriangle++;
+			}
+			BestTriangle = NextUnaddedTriangle;
+		}
+
+		const int32 TriangleVertices[3] = { Indices[BestTriangle * 3 + 0], Indices[BestTriangle * 3 + 1], Indices[BestTriangle * 3 + 2] };
+		NewIndices[OutTriangle * 3 + 0] = TriangleVertices[0];
+		NewIndices[OutTriangle * 3 + 1] = TriangleVertices[1];
+		NewIndices[OutTriangle * 3 + 2] = TriangleVertices[2];
+		TriangleAdded[BestTriangle] = true;
+
+		// Retire the triangle from its vertices' active lists, once per distinct vertex
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			if (IsRepeatedCorner(Indices, BestTriangle * 3 + Corner))
+			{
+				continue;
+			}
+
+			const int32 Vertex = TriangleVertices[Corner];
+			const int32 Start = AdjacencyStart[Vertex];
+			const int32 End = Start + NumActiveTriangles[Vertex];
+			for (int32 Entry = Start; Entry < End; Entry++)
+			{
+				if (Adjacency[Entry] == BestTriangle)
+				{
+					Adjacency[Entry] = Adjacency[End - 1];
+					Adjacency[End - 1] = BestTriangle;
+					NumActiveTriangles[Vertex]--;
+					break;
+				}
+			}
+		}
+
+		// Push the triangle's vertices to the front of the cache
+		int32 NewCache[CacheSize + 3];
+		int32 NumNewCached = 0;
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			const int32 Vertex = TriangleVertices[Corner];
+			bool bAlreadyAdded = false;
+			for (int32 Entry = 0; Entry < NumNewCached; Entry++)
+			{
+				bAlreadyAdded |= NewCache[Entry] == Vertex;
+			}
+			if (!bAlreadyAdded)
+			{
+				NewCache[NumNewCached++] = Vertex;
+			}
+		}
+		for (int32 Entry = 0; Entry < NumCached; Entry++)
+		{
+			const int32 Vertex = Cache[Entry];
+			if (Vertex != TriangleVertices[0] && Vertex != TriangleVertices[1] && Vertex != TriangleVertices[2])
+			{
+				NewCache[NumNewCached++] = Vertex;
+			}
+		}
+
+		// Rescore every vertex that moved in or out of the cache
+		for (int32 Entry = 0; Entry < NumNewCached; Entry++)
+		{
+			const int32 Vertex = NewCache[Entry];
+			CachePosition[Vertex] = Entry < CacheSize ? Entry : INDEX_NONE;
+			VertexScore[Vertex] = ScoreVertex(CachePosition[Vertex], NumActiveTriangles[Vertex]);
+		}
+
+		// Rescore the remaining triangles of the cached vertices, looking for the next best
+		BestTriangle = INDEX_NONE;
+		BestScore = -1.0f;
+		for (int32 Entry = 0; Entry < NumNewCached; Entry++)
+		{
+			const int32 Vertex = NewCache[Entry];
+			const int32 Start = AdjacencyStart[Vertex];
+			const int32 End = Start + NumActiveTriangles[Vertex];
+			for (int32 AdjacencyEntry = Start; AdjacencyEntry < End; AdjacencyEntry++)
+			{
+				const int32 Triangle = Adjacency[AdjacencyEntry];
+				const float Score = VertexScore[Indices[Triangle * 3 + 0]] + VertexScore[Indices[Triangle * 3 + 1]] + VertexScore[Indices[Triangle * 3 + 2]];
+				TriangleScore[Triangle] = Score;
+				if (Score > BestScore)
+				{
+					BestScore = Score;
+					BestTriangle = Triangle;
+				}
+			}
+		}
+
+		NumCached = NumNewCached < CacheSize ? NumNewCached : CacheSize;
+		FMemory::Memcpy(Cache, NewCache, NumCached * sizeof(int32));
+	}
+
+	// Keep any trailing indices that don't make up a whole triangle
+	for (int32 Index = NumTriangles * 3; Index < Indices.Num(); Index++)
+	{
+		NewIndices.Add(Indices[Index]);
+	}
+	Indices = MoveTemp(NewIndices);
+}
+
+void FRuntimeMeshOptimizer::OptimizeVertexFetch(TArray<int32>& Indices, int32 NumVertices, TArray<int32>& OutRemap)
+{
+	OutRemap.Init(INDEX_NONE, NumVertices);
+
+	int32 NextVertex = 0;
+	for (int32 Index = 0; Index < Indices.Num(); Index++)
+	{
+		int32& NewVertex = OutRemap[Indices[Index]];
+		if (NewVertex == INDEX_NONE)
+		{
+			NewVertex = NextVertex++;
+		}
+		Indices[Index] = NewVertex;
+	}
+
+	// Unreferenced vertices go to the end, keeping the vertex count the same
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		if (OutRemap[Vertex] == INDEX_NONE)
+		{
+			OutRemap[Vertex] = NextVertex++;
+		}
+	}
+}
+
+void FRuntimeMeshOptimizer::OptimizeForRendering(TArray<int32>& Indices, int32 NumVertices, TArray<int32>& OutRemap, FRuntimeMeshOptimizationStats* OutStats)
+{
+	if (OutStats)
+	{
+		OutStats->ACMRBefore = CalculateACMR(Indices, NumVertices);
+	}
+
+	OptimizeVertexCache(Indices, NumVertices);
+	OptimizeVertexFetch(Indices, NumVertices, OutRemap);
+
+	if (OutStats)
+	{
+		OutStats->ACMRAfter = CalculateACMR(Indices, NumVertices);
+	}
+}
@@ -0,0 +1,110 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshPositionWriter.h"
+#include "RuntimeMeshProfiling.h"
+#include "Async/ParallelFor.h"
+
+
+FRuntimeMeshPositionWriter::FRuntimeMeshPositionWriter(URuntimeMeshComponent* InComponent, int32 InSectionIndex, int32 InSliceSize)
+	: Component(InComponent), SectionIndex(InSectionIndex), Positions(nullptr), NumPositions(0), SliceSize(InSliceSize), bCommitted(false)
+{
+	check(IsInGameThread());
+	check(InComponent && "Component cannot be null.");
+	check(SliceSize > 0 && "SliceSize must be greater than 0.");
+	check(SectionIndex >= 0 && "SectionIndex cannot be negative.");
+
+	RuntimeMeshSectionPtr* SectionPtr = InComponent->MeshSections.Find(SectionIndex);
+	check(SectionPtr && "Invalid SectionIndex.");
+	check((*SectionPtr)->IsDualBufferSection() && "Section is not dual buffer.");
+
+	Section = *SectionPtr;
+	Positions = (*SectionPtr)->PositionVertexBuffer.GetData();
+	NumPositions = (*SectionPtr)->PositionVertexBuffer.Num();
+
+	const int32 NumSlices = (NumPositions + SliceSize - 1) / SliceSize;
+	SliceBounds.Init(FBox(0), NumSlices);
+}
+
+FRuntimeMeshPositionWriter::~FRuntimeMeshPositionWriter()
+{
+	if (!bCommitted)
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("FRuntimeMeshPositionWriter destroyed without Commit(). Section %d will not be updated."), SectionIndex);
+	}
+}
+
+FRuntimeMeshPositionSlice FRuntimeMeshPositionWriter::GetSlice(int32 SliceIndex)
+{
+	check(SliceIndex >= 0 && SliceIndex < SliceBounds.Num());
+	check(!bCommitted && "Cannot write after Commit().");
+
+	const int32 StartIndex = SliceIndex * SliceSize;
+	const int32 Count = FMath::Min(SliceSize, NumPositions - StartIndex);
+	return FRuntimeMeshPositionSlice(Positions + StartIndex, StartIndex, Count, &SliceBounds[SliceIndex]);
+}
+
+void FRuntimeMeshPositionWriter::ParallelWrite(TFunctionRef<void(FRuntimeMeshPositionSlice&)> Func)
+{
+	ParallelFor(SliceBounds.Num(), [&](int32 SliceIndex)
+	{
+		FRuntimeMeshPositionSlice Slice = GetSlice(SliceIndex);
+		Func(Slice);
+	});
+}
+
+bool FRuntimeMeshPositionWriter::Commit()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_PositionWriterCommit);
+
+	check(IsInGameThread());
+	check(!bCommitted && "Commit() can only be called once.");
+	bCommitted = true;
+
+	URuntimeMeshComponent* ComponentPtr = Component.Get();
+	if (ComponentPtr == nullptr)
+	{
+		UE_LOG(RuntimeMeshLog, Error, TEXT("FRuntimeMeshPositionWriter::Commit() - Component was destroyed while writing."));
+		return false;
+	}
+
+	// Make sure the section wasn't replaced or resized while the positions were being written
+	RuntimeMeshSectionPtr* CurrentSection = ComponentPtr->MeshSections.Find(SectionIndex);
+	if (CurrentSection == nullptr || *CurrentSection != Section.Pin())
+	{
+		ComponentPtr->Log(TEXT("FRuntimeMeshPositionWriter::Commit() - Section was removed or replaced while writing."), true);
+		return false;
+	}
+
+	if ((*CurrentSection)->PositionVertexBuffer.GetData() != Positions || (*CurrentSection)->PositionVertexBuffer.Num() != NumPositions)
+	{
+		ComponentPtr->Log(TEXT("FRuntimeMeshPositionWriter::Commit() - Positions were reallocated while writing."), true);
+		return false;
+	}
+
+	// Reduce the slice bounds. Slices that weren't written still hold their old positions.
+	FBox BoundingBox(0);
+	for (int32 SliceIndex = 0; SliceIndex < SliceBounds.Num(); SliceIndex++)
+	{
+		FBox& Bounds = SliceBounds[SliceIndex];
+		if (!Bounds.IsValid)
+		{
+			const int32 StartIndex = SliceIndex * SliceSize;
+			const int32 EndIndex = FMath::Min(StartIndex + SliceSize, NumPositions);
+			for (int32 Index = StartIndex; Index < EndIndex; Index++)
+			{
+				Bounds += Positions[Index];
+			}
+		}
+		BoundingBox += Bounds;
+	}
+
+	if (!BoundingBox.IsValid)
+	{
+		ComponentPtr->Log(TEXT("FRuntimeMeshPositionWriter::Commit() - Section has no positions."), true);
+		return false;
+	}
+
+	ComponentPtr->EndMeshSectionPositionUpdate(SectionIndex, BoundingBox);
+	return true;
+}
@@ -0,0 +1,357 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshSimplification.h"
+#include "RuntimeMeshProfiling.h"
+
+
+namespace RuntimeMeshSimplificationInternal
+{
+	/* Smallest cosine allowed between a triangle's normal before and after a collapse */
+	static const float MinNormalDot = 0.2f;
+
+	static uint64 GetEdgeKey(int32 PointA, int32 PointB)
+	{
+		return PointA < PointB ? ((uint64)PointA << 32) | (uint32)PointB : ((uint64)PointB << 32) | (uint32)PointA;
+	}
+}
+
+
+FRuntimeMeshSimplifier::FQuadric::FQuadric(const FVector& Normal, float Distance, float Weight)
+{
+	const double X = Normal.X, Y = Normal.Y, Z = Normal.Z, D = Distance;
+	A[0] = X * X * Weight; A[1] = X * Y * Weight; A[2] = X * Z * Weight; A[3] = X * D * Weight;
+	A[4] = Y * Y * Weight; A[5] = Y * Z * Weight; A[6] = Y * D * Weight;
+	A[7] = Z * Z * Weight; A[8] = Z * D * Weight;
+	A[9] = D * D * Weight;
+}
+
+double FRuntimeMeshSimplifier::FQuadric::Evaluate(const FVector& Position) const
+{
+	const double X = Position.X, Y = Position.Y, Z = Position.Z;
+	return A[0] * X * X + 2 * A[1] * X * Y + 2 * A[2] * X * Z + 2 * A[3] * X
+		+ A[4] * Y * Y + 2 * A[5] * Y * Z + 2 * A[6] * Y
+		+ A[7] * Z * Z + 2 * A[8] * Z
+		+ A[9];
+}
+
+
+FRuntimeMeshSimplifier::FRuntimeMeshSimplifier(const TArray<FVector>& Positions, const TArray<int32>& Indices)
+	: Corners(Indices), NumAliveTriangles(0)
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+	Corners.SetNum(NumTriangles * 3);
+	TriangleRemoved.Init(false, NumTriangles);
+
+	// Weld referenced vertices with identical positions into points
+	TMap<FVector, int32> PointMap;
+	TArray<int32> PointFirstVertex;
+	VertexPoints.Init(INDEX_NONE, Positions.Num());
+	for (int32 Vertex : Corners)
+	{
+		check(Positions.IsValidIndex(Vertex) && "Index out of range of the vertex buffer.");
+
+		if (VertexPoints[Vertex] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		int32* ExistingPoint = PointMap.Find(Positions[Vertex]);
+		if (ExistingPoint)
+		{
+			// A second vertex at the same position is a seam
+			VertexPoints[Vertex] = *ExistingPoint;
+			PointLocked[*ExistingPoint] = true;
+		}
+		else
+		{
+			const int32 Point = PointPositions.Add(Positions[Vertex]);
+			PointMap.Add(Positions[Vertex], Point);
+			PointLocked.Add(false);
+			VertexPoints[Vertex] = Point;
+		}
+	}
+
+	const int32 NumPoints = PointPositions.Num();
+	PointQuadrics.SetNum(NumPoints);
+	PointRevisions.Init(0, NumPoints);
+	PointRemoved.Init(false, NumPoints);
+	PointTriangles.SetNum(NumPoints);
+
+	// Gather triangles, plane quadrics and edge use counts
+	TMap<uint64, int32> EdgeUseCounts;
+	for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+	{
+		const int32 Points[3] = { GetCornerPoint(Triangle, 0), GetCornerPoint(Triangle, 1), GetCornerPoint(Triangle, 2) };
+		if (Points[0] == Points[1] || Points[1] == Points[2] || Points[2] == Points[0])
+		{
+			TriangleRemoved[Triangle] = true;
+			continue;
+		}
+
+		NumAliveTriangles++;
+
+		const FVector& P0 = PointPositions[Points[0]];
+		FVector Normal = (PointPositions[Points[1]] - P0) ^ (PointPositions[Points[2]] - P0);
+		const float Area = Normal.Size() * 0.5f;
+		Normal = Normal.GetSafeNormal();
+		const FQuadric Quadric(Normal, -(Normal | P0), Area);
+
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			PointQuadrics[Points[Corner]] += Quadric;
+			PointTriangles[Points[Corner]].Add(Triangle);
+			EdgeUseCounts.FindOrAdd(RuntimeMeshSimplificationInternal::GetEdgeKey(Points[Corner], Points[(Corner + 1) % 3]))++;
+		}
+	}
+
+	// Lock both ends of open and non manifold edges
+	for (const auto& Edge : EdgeUseCounts)
+	{
+		if (Edge.Value != 2)
+		{
+			PointLocked[(int32)(Edge.Key >> 32)] = true;
+			PointLocked[(int32)(Edge.Key & 0xFFFFFFFF)] = true;
+		}
+	}
+
+	TArray<int32> Neighbors;
+	for (int32 Point = 0; Point < NumPoints; Point++)
+	{
+		if (!PointLocked[Point])
+		{
+			GetNeighborPoints(Point, Neighbors);
+			for (int32 Neighbor : Neighbors)
+			{
+				QueueCollapse(Point, Neighbor);
+			}
+		}
+	}
+}
+
+void FRuntimeMeshSimplifier::Simplify(int32 TargetTriangles)
+{
+	while (NumAliveTriangles > TargetTriangles && Heap.Num() > 0)
+	{
+		FCollapse Candidate;
+		Heap.HeapPop(Candidate, false);
+
+		// Skip candidates queued before either point changed
+		if (PointRemoved[Candidate.From] || PointRemoved[Candidate.To] ||
+			PointRevisions[Candidate.From] != Candidate.FromRevision || PointRevisions[Candidate.To] != Candidate.ToRevision)
+		{
+			continue;
+		}
+
+		if (CanCollapse(Candidate.From, Candidate.To))
+		{
+			Collapse(Candidate.From, Candidate.To);
+		}
+	}
+}
+
+void FRuntimeMeshSimplifier::GetIndices(TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset(NumAliveTriangles * 3);
+	for (int32 Triangle = 0; Triangle < TriangleRemoved.Num(); Triangle++)
+	{
+		if (!TriangleRemoved[Triangle])
+		{
+			OutIndices.Append(&Corners[Triangle * 3], 3);
+		}
+	}
+}
+
+void FRuntimeMeshSimplifier::GenerateLODs(const TArray<FVector>& Positions, const TArray<int32>& Indices, const TArray<float>& TriangleRatios, TArray<TArray<int32>>& OutLODIndices)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_GenerateLODs);
+
+	OutLODIndices.SetNum(TriangleRatios.Num());
+
+	// Simplify from the most to the least detailed LOD
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < TriangleRatios.Num(); Index++)
+	{
+		Order.Add(Index);
+	}
+	Order.Sort([&TriangleRatios](int32 A, int32 B) { return TriangleRatios[A] > TriangleRatios[B]; });
+
+	FRuntimeMeshSimplifier Simplifier(Positions, Indices);
+	const int32 NumTriangles = Indices.Num() / 3;
+	for (int32 LODIndex : Order)
+	{
+		const float Ratio = FMath::Clamp(TriangleRatios[LODIndex], 0.0f, 1.0f);
+		Simplifier.Simplify(FMath::Max(1, FMath::RoundToInt(NumTriangles * Ratio)));
+		Simplifier.GetIndices(OutLODIndices[LODIndex]);
+	}
+}
+
+bool FRuntimeMeshSimplifier::TriangleHasPoint(int32 Triangle, int32 Point) const
+{
+	return GetCornerPoint(Triangle, 0) == Point || GetCornerPoint(Triangle, 1) == Point || GetCornerPoint(Triangle, 2) == Point;
+}
+
+void FRuntimeMeshSimplifier::GetNeighborPoints(int32 Point, TArray<int32>& OutNeighbors) const
+{
+	OutNeighbors.Reset();
+	for (int32 Triangle : PointTriangles[Point])
+	{
+		if (TriangleRemoved[Triangle])
+		{
+			continue;
+		}
+
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			const int32 CornerPoint = GetCornerPoint(Triangle, Corner);
+			if (CornerPoint != Point)
+			{
+				OutNeighbors.AddUnique(CornerPoint);
+			}
+		}
+	}
+}
+
+void FRuntimeMeshSimplifier::QueueCollapse(int32 From, int32 To)
+{
+	FQuadric Quadric = PointQuadrics[From];
+	Quadric += PointQuadrics[To];
+
+	FCollapse Candidate;
+	Candidate.Cost = Quadric.Evaluate(PointPositions[To]);
+	Candidate.From = From;
+	Candidate.To = To;
+	Candidate.FromRevision = PointRevisions[From];
+	Candidate.ToRevision = PointRevisions[To];
+	Heap.HeapPush(Candidate);
+}
+
+bool FRuntimeMeshSimplifier::CanCollapse(int32 From, int32 To) const
+{
+	const FVector& FromPosition = PointPositions[From];
+	const FVector& ToPosition = PointPositions[To];
+
+	int32 NumShared = 0;
+	for (int32 Triangle : PointTriangles[From])
+	{
+		if (TriangleRemoved[Triangle])
+		{
+			continue;
+		}
+
+		// Triangles on the edge are removed by the collapse
+		if (TriangleHasPoint(Triangle, To))
+		{
+			NumShared++;
+			continue;
+		}
+
+		// Every other triangle around From must keep facing the same way and not collapse to a sliver
+		int32 Corner = 0;
+		while (GetCornerPoint(Triangle, Corner) != From)
+		{
+			Corner++;
+		}
+
+		const FVector& P1 = PointPositions[GetCornerPoint(Triangle, (Corner + 1) % 3)];
+		const FVector& P2 = PointPositions[GetCornerPoint(Triangle, (Corner + 2) % 3)];
+		const FVector OldNormal = ((P1 - FromPosition) ^ (P2 - FromPosition)).GetSafeNormal();
+		const FVector NewNormal = ((P1 - ToPosition) ^ (P2 - ToPosition)).GetSafeNormal();
+		if ((OldNormal | NewNormal) < RuntimeMeshSimplificationInternal::MinNormalDot)
+		{
+			return false;
+		}
+	}
+
+	// The points are no longer connected
+	if (NumShared == 0)
+	{
+		return false;
+	}
+
+	// Link condition. Any neighbor shared other than across the edge's triangles would become a non manifold edge.
+	TArray<int32> FromNeighbors;
+	TArray<int32> ToNeighbors;
+	GetNeighborPoints(From, FromNeighbors);
+	GetNeighborPoints(To, ToNeighbors);
+
+	int32 NumCommon = 0;
+	for (int32 Neighbor : FromNeighbors)
+	{
+		if (ToNeighbors.Contains(Neighbor))
+		{
+			NumCommon++;
+		}
+	}
+
+	return NumCommon <= NumShared;
+}
+
+void FRuntimeMeshSimplifier::Collapse(int32 From, int32 To)
+{
+	// From isn't a seam, so every triangle around it can use the vertex of To from the triangles on the edge
+	int32 ToVertex = INDEX_NONE;
+	for (int32 Triangle : PointTriangles[From])
+	{
+		if (!TriangleRemoved[Triangle] && TriangleHasPoint(Triangle, To))
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				if (GetCornerPoint(Triangle, Corner) == To)
+				{
+					ToVertex = Corners[Triangle * 3 + Corner];
+				}
+			}
+			break;
+		}
+	}
+	check(ToVertex != INDEX_NONE);
+
+	for (int32 Triangle : PointTriangles[From])
+	{
+		if (TriangleRemoved[Triangle])
+		{
+			continue;
+		}
+
+		if (TriangleHasPoint(Triangle, To))
+		{
+			TriangleRemoved[Triangle] = true;
+			NumAliveTriangles--;
+			continue;
+		}
+
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			if (GetCornerPoint(Triangle, Corner) == From)
+			{
+				Corners[Triangle * 3 + Corner] = ToVertex;
+			}
+		}
+		PointTriangles[To].Add(Triangle);
+	}
+
+	PointRemoved[From] = true;
+	PointTriangles[From].Empty();
+
+	PointQuadrics[To] += PointQuadrics[From];
+	PointRevisions[To]++;
+
+	TArray<bool>& Removed = TriangleRemoved;
+	PointTriangles[To].RemoveAllSwap([&Removed](int32 Triangle) { return Removed[Triangle]; });
+
+	// Every collapse into or out of To has a new cost now
+	TArray<int32> Neighbors;
+	GetNeighborPoints(To, Neighbors);
+	for (int32 Neighbor : Neighbors)
+	{
+		if (!PointLocked[To])
+		{
+			QueueCollapse(To, Neighbor);
+		}
+		if (!PointLocked[Neighbor])
+		{
+			QueueCollapse(Neighbor, To);
+		}
+	}
+}
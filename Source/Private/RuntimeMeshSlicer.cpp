@@ -0,0 +1,367 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshSlicer.h"
+#include "RuntimeMeshWelding.h"
+
+
+const float FRuntimeMeshSliceCap::WeldTolerance = 0.01f;
+
+
+namespace RuntimeMeshSlicerInternal
+{
+	/* Twice the signed area of the triangle ABC */
+	FORCEINLINE float Cross(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+	{
+		return (B - A) ^ (C - A);
+	}
+
+	float GetSignedArea(const TArray<FVector2D>& Points, const TArray<int32>& Loop)
+	{
+		float Area = 0.0f;
+		for (int32 Index = 0; Index < Loop.Num(); Index++)
+		{
+			Area += Points[Loop[Index]] ^ Points[Loop[(Index + 1) % Loop.Num()]];
+		}
+		return Area * 0.5f;
+	}
+
+	bool IsInsideLoop(const TArray<FVector2D>& Points, const TArray<int32>& Loop, const FVector2D& Point)
+	{
+		bool bInside = false;
+		for (int32 Index = 0, Prev = Loop.Num() - 1; Index < Loop.Num(); Prev = Index++)
+		{
+			const FVector2D& A = Points[Loop[Index]];
+			const FVector2D& B = Points[Loop[Prev]];
+			if ((A.Y > Point.Y) != (B.Y > Point.Y) && Point.X < A.X + (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y))
+			{
+				bInside = !bInside;
+			}
+		}
+		return bInside;
+	}
+
+	/* Is Point inside or on the triangle ABC wound with Sign */
+	bool IsInsideTriangle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& Point, float Sign)
+	{
+		return Cross(A, B, Point) * Sign >= 0.0f && Cross(B, C, Point) * Sign >= 0.0f && Cross(C, A, Point) * Sign >= 0.0f;
+	}
+
+	/**
+	*	Joins a hole into the loop around it with a pair of edges, using the vertex visibility search from
+	*	Eberly's "Triangulation by Ear Clipping". The hole must be wound against the outer loop.
+	*/
+	bool BridgeHole(const TArray<FVector2D>& Points, TArray<int32>& Outer, const TArray<int32>& Hole, float Sign)
+	{
+		// Connect from the hole's rightmost point
+		int32 HoleStart = 0;
+		for (int32 Index = 1; Index < Hole.Num(); Index++)
+		{
+			if (Points[Hole[Index]].X > Points[Hole[HoleStart]].X)
+			{
+				HoleStart = Index;
+			}
+		}
+		const FVector2D& M = Points[Hole[HoleStart]];
+
+		// Closest edge of the outer loop to the right of it
+		int32 HitEdge = INDEX_NONE;
+		float HitX = MAX_flt;
+		for (int32 Index = 0; Index < Outer.Num(); Index++)
+		{
+			const FVector2D& A = Points[Outer[Index]];
+			const FVector2D& B = Points[Outer[(Index + 1) % Outer.Num()]];
+			if ((A.Y <= M.Y) != (B.Y <= M.Y))
+			{
+				const float X = A.X + (B.X - A.X) * (M.Y - A.Y) / (B.Y - A.Y);
+				if (X >= M.X && X < HitX)
+				{
+					HitX = X;
+					HitEdge = Index;
+				}
+			}
+		}
+
+		if (HitEdge == INDEX_NONE)
+		{
+			return false;
+		}
+
+		// The edge's right end is visible unless a reflex vertex is in the way
+		const FVector2D I(HitX, M.Y);
+		int32 Bridge = Points[Outer[HitEdge]].X > Points[Outer[(HitEdge + 1) % Outer.Num()]].X ? HitEdge : (HitEdge + 1) % Outer.Num();
+		const FVector2D P = Points[Outer[Bridge]];
+
+		float BestAngle = MAX_flt;
+		float BestDistance = MAX_flt;
+		for (int32 Index = 0; Index < Outer.Num(); Index++)
+		{
+			const FVector2D& Prev = Points[Outer[(Index + Outer.Num() - 1) % Outer.Num()]];
+			const FVector2D& Current = Points[Outer[Index]];
+			const FVector2D& Next = Points[Outer[(Index + 1) % Outer.Num()]];
+
+			if (Index == Bridge || Cross(Prev, Current, Next) * Sign > 0.0f || !IsInsideTriangle(M, I, P, Current, Cross(M, I, P) >= 0.0f ? 1.0f : -1.0f))
+			{
+				continue;
+			}
+
+			const FVector2D Offset = Current - M;
+			const float Distance = Offset.Size();
+			const float Angle = Distance > 0.0f ? FMath::Abs(Offset.Y) / Distance : 0.0f;
+			if (Angle < BestAngle || (Angle == BestAngle && Distance < BestDistance))
+			{
+				BestAngle = Angle;
+				BestDistance = Distance;
+				Bridge = Index;
+			}
+		}
+
+		// Go around the hole from M, then back to the bridge vertex
+		TArray<int32> Merged;
+		Merged.Reserve(Outer.Num() + Hole.Num() + 2);
+		Merged.Append(Outer.GetData(), Bridge + 1);
+		for (int32 Index = 0; Index <= Hole.Num(); Index++)
+		{
+			Merged.Add(Hole[(HoleStart + Index) % Hole.Num()]);
+		}
+		Merged.Append(Outer.GetData() + Bridge, Outer.Num() - Bridge);
+
+		Outer = MoveTemp(Merged);
+		return true;
+	}
+}
+
+void FRuntimeMeshSliceCap::GetPlaneAxes(const FVector& PlaneNormal, FVector& OutAxisX, FVector& OutAxisY)
+{
+	FVector Unused;
+	PlaneNormal.FindBestAxisVectors(OutAxisX, Unused);
+
+	// Make X, Y and the normal right handed
+	OutAxisY = PlaneNormal ^ OutAxisX;
+}
+
+bool FRuntimeMeshSliceCap::TriangulateLoop(const TArray<FVector2D>& Points, const TArray<int32>& Loop, TArray<int32>& OutTriangles)
+{
+	using namespace RuntimeMeshSlicerInternal;
+
+	const float Sign = GetSignedArea(Points, Loop) >= 0.0f ? 1.0f : -1.0f;
+
+	// Scale the collinearity threshold with the loop's size
+	FBox2D Bounds(0);
+	for (int32 Point : Loop)
+	{
+		Bounds += Points[Point];
+	}
+	const float Epsilon = Bounds.GetSize().SizeSquared() * 1.e-10f;
+
+	TArray<int32> Remaining = Loop;
+	int32 Current = 0;
+	int32 Attempts = 0;
+	while (Remaining.Num() > 3)
+	{
+		// Every vertex was tried without finding an ear, so the loop must cross itself
+		if (Attempts++ > Remaining.Num())
+		{
+			return false;
+		}
+
+		Current %= Remaining.Num();
+		const int32 Prev = Remaining[(Current + Remaining.Num() - 1) % Remaining.Num()];
+		const int32 Vertex = Remaining[Current];
+		const int32 Next = Remaining[(Current + 1) % Remaining.Num()];
+		const FVector2D& A = Points[Prev];
+		const FVector2D& B = Points[Vertex];
+		const FVector2D& C = Points[Next];
+
+		const float Area = Cross(A, B, C) * Sign;
+
+		// Collinear points add nothing to the cap
+		if (FMath::Abs(Area) <= Epsilon)
+		{
+			Remaining.RemoveAt(Current);
+			Attempts = 0;
+			continue;
+		}
+
+		// Reflex vertices can't be ears
+		bool bIsEar = Area > 0.0f;
+		for (int32 Index = 0; bIsEar && Index < Remaining.Num(); Index++)
+		{
+			const int32 Other = Remaining[Index];
+			if (Other != Prev && Other != Vertex && Other != Next && IsInsideTriangle(A, B, C, Points[Other], Sign))
+			{
+				bIsEar = false;
+			}
+		}
+
+		if (!bIsEar)
+		{
+			Current++;
+			continue;
+		}
+
+		OutTriangles.Add(Prev);
+		OutTriangles.Add(Vertex);
+		OutTriangles.Add(Next);
+		Remaining.RemoveAt(Current);
+		Attempts = 0;
+	}
+
+	if (Remaining.Num() == 3 && FMath::Abs(Cross(Points[Remaining[0]], Points[Remaining[1]], Points[Remaining[2]])) > Epsilon)
+	{
+		OutTriangles.Append(Remaining);
+	}
+	return true;
+}
+
+void FRuntimeMeshSliceCap::Triangulate(const TArray<FRuntimeMeshSliceCapEdge>& Edges, const FVector& PlaneNormal, TArray<FVector>& OutPositions, TArray<int32>& OutTriangles)
+{
+	using namespace RuntimeMeshSlicerInternal;
+
+	OutPositions.Reset();
+	OutTriangles.Reset();
+
+	// Join the ends of neighboring edges, which were computed separately for each triangle
+	TArray<int32> Remap;
+	const int32 NumPoints = FRuntimeMeshWelding::BuildRemap(Edges.Num() * 2,
+		[&Edges](int32 Index) -> const FVector& { return (Index & 1) ? Edges[Index >> 1].End : Edges[Index >> 1].Start; },
+		[](int32 A, int32 B) { return true; }, WeldTolerance, Remap);
+
+	TArray<FVector> Positions;
+	Positions.SetNumUninitialized(NumPoints);
+	TArray<int32> NextPoint;
+	NextPoint.Init(INDEX_NONE, NumPoints);
+	for (int32 Edge = 0; Edge < Edges.Num(); Edge++)
+	{
+		const int32 Start = Remap[Edge * 2];
+		const int32 End = Remap[Edge * 2 + 1];
+		Positions[Start] = Edges[Edge].Start;
+		Positions[End] = Edges[Edge].End;
+
+		// Where the cut touches itself the first edge leaving a point wins
+		if (Start != End && NextPoint[Start] == INDEX_NONE)
+		{
+			NextPoint[Start] = End;
+		}
+	}
+
+	// Follow the edges into closed loops
+	TArray<TArray<int32>> Loops;
+	TArray<int32> VisitedBy;
+	VisitedBy.Init(INDEX_NONE, NumPoints);
+	for (int32 Start = 0; Start < NumPoints; Start++)
+	{
+		if (VisitedBy[Start] != INDEX_NONE || NextPoint[Start] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		TArray<int32> Chain;
+		int32 Point = Start;
+		while (Point != INDEX_NONE && VisitedBy[Point] == INDEX_NONE)
+		{
+			VisitedBy[Point] = Start;
+			Chain.Add(Point);
+			Point = NextPoint[Point];
+		}
+
+		// Only a chain that came back to itself is closed, possibly after a tail leading into the loop
+		if (Point != INDEX_NONE && VisitedBy[Point] == Start)
+		{
+			const int32 LoopStart = Chain.Find(Point);
+			if (Chain.Num() - LoopStart >= 3)
+			{
+				Loops.Emplace(Chain.GetData() + LoopStart, Chain.Num() - LoopStart);
+			}
+		}
+	}
+
+	if (Loops.Num() == 0)
+	{
+		return;
+	}
+
+	FVector AxisX, AxisY;
+	GetPlaneAxes(PlaneNormal, AxisX, AxisY);
+
+	TArray<FVector2D> Points;
+	Points.SetNumUninitialized(NumPoints);
+	for (int32 Point = 0; Point < NumPoints; Point++)
+	{
+		Points[Point] = FVector2D(Positions[Point] | AxisX, Positions[Point] | AxisY);
+	}
+
+	// The largest loop has to be an outline, so every loop wound the same way is one too, and the rest are holes
+	TArray<float> Areas;
+	int32 Largest = 0;
+	for (int32 Loop = 0; Loop < Loops.Num(); Loop++)
+	{
+		Areas.Add(GetSignedArea(Points, Loops[Loop]));
+		if (FMath::Abs(Areas[Loop]) > FMath::Abs(Areas[Largest]))
+		{
+			Largest = Loop;
+		}
+	}
+	const float OutlineSign = Areas[Largest] >= 0.0f ? 1.0f : -1.0f;
+
+	TArray<int32> Outlines;
+	TArray<int32> Holes;
+	for (int32 Loop = 0; Loop < Loops.Num(); Loop++)
+	{
+		(Areas[Loop] * OutlineSign > 0.0f ? Outlines : Holes).Add(Loop);
+	}
+
+	// Bridge holes from right to left, so later bridges can't cross earlier ones
+	auto GetMaxX = [&](int32 Loop)
+	{
+		float MaxX = -MAX_flt;
+		for (int32 Point : Loops[Loop])
+		{
+			MaxX = FMath::Max(MaxX, Points[Point].X);
+		}
+		return MaxX;
+	};
+	Holes.Sort([&](int32 A, int32 B) { return GetMaxX(A) > GetMaxX(B); });
+
+	for (int32 Hole : Holes)
+	{
+		// Each hole belongs to the smallest outline around it
+		int32 Owner = INDEX_NONE;
+		for (int32 Outline : Outlines)
+		{
+			if ((Owner == INDEX_NONE || FMath::Abs(Areas[Outline]) < FMath::Abs(Areas[Owner])) && IsInsideLoop(Points, Loops[Outline], Points[Loops[Hole][0]]))
+			{
+				Owner = Outline;
+			}
+		}
+
+		if (Owner != INDEX_NONE)
+		{
+			BridgeHole(Points, Loops[Owner], Loops[Hole], OutlineSign);
+		}
+	}
+
+	TArray<int32> Triangles;
+	for (int32 Outline : Outlines)
+	{
+		TArray<int32> LoopTriangles;
+		if (TriangulateLoop(Points, Loops[Outline], LoopTriangles))
+		{
+			Triangles.Append(LoopTriangles);
+		}
+	}
+
+	// Only keep the points the triangles use
+	TArray<int32> PointRemap;
+	PointRemap.Init(INDEX_NONE, NumPoints);
+	OutTriangles.SetNumUninitialized(Triangles.Num());
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		int32& NewIndex = PointRemap[Triangles[Index]];
+		if (NewIndex == INDEX_NONE)
+		{
+			NewIndex = OutPositions.Add(Positions[Triangles[Index]]);
+		}
+		OutTriangles[Index] = NewIndex;
+	}
+}
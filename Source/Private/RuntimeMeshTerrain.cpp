@@ -0,0 +1,518 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshTerrain.h"
+#include "Async/ParallelFor.h"
+
+
+namespace RuntimeMeshTerrainInternal
+{
+	/* Adds a triangle by grid coordinates, fixing the winding so it faces +Z like CreateGridMeshTriangles() without bWinding */
+	static void AddTriangle(int32 NumVerticesPerSide, int32 X0, int32 Y0, int32 X1, int32 Y1, int32 X2, int32 Y2, TArray<int32>& OutIndices)
+	{
+		if ((X1 - X0) * (Y2 - Y0) - (Y1 - Y0) * (X2 - X0) > 0)
+		{
+			Swap(X1, X2);
+			Swap(Y1, Y2);
+		}
+		OutIndices.Add(X0 * NumVerticesPerSide + Y0);
+		OutIndices.Add(X1 * NumVerticesPerSide + Y1);
+		OutIndices.Add(X2 * NumVerticesPerSide + Y2);
+	}
+}
+
+
+FRuntimeMeshTerrainLODIndices::FRuntimeMeshTerrainLODIndices(int32 InChunkSize)
+	: ChunkSize(InChunkSize), NumLODs(0)
+{
+	check(ChunkSize >= 2 && FMath::IsPowerOfTwo(ChunkSize));
+
+	// The coarsest LOD still has 2x2 quads so it has an inner vertex for the seams to fan to
+	while ((ChunkSize >> NumLODs) >= 2)
+	{
+		NumLODs++;
+	}
+
+	Interiors.SetNum(NumLODs);
+	EdgeStrips.SetNum(NumLODs * NumSides * 2);
+	for (int32 LOD = 0; LOD < NumLODs; LOD++)
+	{
+		BuildInterior(LOD, Interiors[LOD]);
+		for (int32 Side = 0; Side < NumSides; Side++)
+		{
+			BuildEdgeStrip(LOD, Side, false, EdgeStrips[GetEdgeStripIndex(LOD, Side, false)]);
+			BuildEdgeStrip(LOD, Side, true, EdgeStrips[GetEdgeStripIndex(LOD, Side, true)]);
+		}
+	}
+}
+
+TSharedRef<const FRuntimeMeshTerrainLODIndices, ESPMode::ThreadSafe> FRuntimeMeshTerrainLODIndices::Get(int32 ChunkSize)
+{
+	static FCriticalSection CacheLock;
+	static TMap<int32, TWeakPtr<const FRuntimeMeshTerrainLODIndices, ESPMode::ThreadSafe>> Cache;
+
+	FScopeLock Lock(&CacheLock);
+
+	// Entries are weak so the indices are freed with the last terrain using them, drop the ones that already were
+	for (auto It = Cache.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (auto* Existing = Cache.Find(ChunkSize))
+	{
+		TSharedPtr<const FRuntimeMeshTerrainLODIndices, ESPMode::ThreadSafe> Pinned = Existing->Pin();
+		if (Pinned.IsValid())
+		{
+			return Pinned.ToSharedRef();
+		}
+	}
+
+	TSharedRef<const FRuntimeMeshTerrainLODIndices, ESPMode::ThreadSafe> NewIndices = MakeShareable(new FRuntimeMeshTerrainLODIndices(ChunkSize));
+	Cache.Add(ChunkSize, NewIndices);
+	return NewIndices;
+}
+
+void FRuntimeMeshTerrainLODIndices::GetIndices(int32 LOD, int32 StitchFlags, TArray<int32>& OutIndices) const
+{
+	check(LOD >= 0 && LOD < NumLODs);
+	check(StitchFlags >= 0 && StitchFlags < NumStitchCombinations);
+
+	const TArray<int32>& Interior = Interiors[LOD];
+
+	int32 NumIndices = Interior.Num();
+	for (int32 Side = 0; Side < NumSides; Side++)
+	{
+		NumIndices += EdgeStrips[GetEdgeStripIndex(LOD, Side, (StitchFlags & (1 << Side)) != 0)].Num();
+	}
+
+	OutIndices.Reset(NumIndices);
+	OutIndices.Append(Interior);
+	for (int32 Side = 0; Side < NumSides; Side++)
+	{
+		OutIndices.Append(EdgeStrips[GetEdgeStripIndex(LOD, Side, (StitchFlags & (1 << Side)) != 0)]);
+	}
+}
+
+void FRuntimeMeshTerrainLODIndices::BuildInterior(int32 LOD, TArray<int32>& OutIndices) const
+{
+	const int32 Step = 1 << LOD;
+	const int32 NumVerticesPerSide = ChunkSize + 1;
+
+	OutIndices.Reset();
+	OutIndices.Reserve(FMath::Square(FMath::Max(ChunkSize / Step - 2, 0)) * 6);
+
+	// Everything but the outer ring of quads
+	for (int32 X = Step; X < ChunkSize - Step; X += Step)
+	{
+		for (int32 Y = Step; Y < ChunkSize - Step; Y += Step)
+		{
+			RuntimeMeshTerrainInternal::AddTriangle(NumVerticesPerSide, X, Y, X + Step, Y, X, Y + Step, OutIndices);
+			RuntimeMeshTerrainInternal::AddTriangle(NumVerticesPerSide, X + Step, Y, X + Step, Y + Step, X, Y + Step, OutIndices);
+		}
+	}
+}
+
+void FRuntimeMeshTerrainLODIndices::BuildEdgeStrip(int32 LOD, int32 Side, bool bStitch, TArray<int32>& OutIndices) const
+{
+	const int32 Step = 1 << LOD;
+	const int32 NumVerticesPerSide = ChunkSize + 1;
+
+	// The outer ring is 4 trapezoids between the chunk edge and the inner ring, meeting on the diagonals.
+	// Each is zipped together between the two rows, so the edge can use a coarser step when stitching.
+	const int32 OuterStep = bStitch ? Step * 2 : Step;
+	const int32 NumOuter = ChunkSize / OuterStep;
+	const int32 NumInner = ChunkSize / Step - 2;
+
+	OutIndices.Reset();
+	OutIndices.Reserve((NumOuter + NumInner) * 3);
+
+	// Maps a position along the side and a depth in from the edge to grid coordinates
+	auto ToGrid = [&](int32 U, int32 Depth, int32& OutX, int32& OutY)
+	{
+		switch (Side)
+		{
+		case 0: OutX = Depth; OutY = U; break;
+		case 1: OutX = ChunkSize - Depth; OutY = U; break;
+		case 2: OutX = U; OutY = Depth; break;
+		default: OutX = U; OutY = ChunkSize - Depth; break;
+		}
+	};
+
+	int32 Outer = 0;
+	int32 Inner = 0;
+	while (Outer < NumOuter || Inner < NumInner)
+	{
+		const int32 OuterU = Outer * OuterStep;
+		const int32 InnerU = Step + Inner * Step;
+
+		int32 X0, Y0, X1, Y1, X2, Y2;
+		if (Inner == NumInner || (Outer < NumOuter && OuterU + OuterStep <= InnerU + Step))
+		{
+			ToGrid(OuterU, 0, X0, Y0);
+			ToGrid(OuterU + OuterStep, 0, X1, Y1);
+			ToGrid(InnerU, Step, X2, Y2);
+			Outer++;
+		}
+		else
+		{
+			ToGrid(OuterU, 0, X0, Y0);
+			ToGrid(InnerU, Step, X1, Y1);
+			ToGrid(InnerU + Step, Step, X2, Y2);
+			Inner++;
+		}
+		RuntimeMeshTerrainInternal::AddTriangle(NumVerticesPerSide, X0, Y0, X1, Y1, X2, Y2, OutIndices);
+	}
+}
+
+
+
+FRuntimeMeshHeightmapTerrain::FRuntimeMeshHeightmapTerrain(URuntimeMeshComponent* InComponent, int32 InNumChunksX, int32 InNumChunksY, int32 InChunkSize,
+	const FVector& InScale, int32 InFirstSectionIndex)
+	: bCreateCollision(false), UpdateFrequency(EUpdateFrequency::Average), Component(InComponent), NumChunksX(InNumChunksX), NumChunksY(InNumChunksY)
+	, ChunkSize(InChunkSize), Scale(InScale), FirstSectionIndex(InFirstSectionIndex), LODIndices(FRuntimeMeshTerrainLODIndices::Get(InChunkSize))
+{
+	check(InComponent);
+	check(NumChunksX > 0 && NumChunksY > 0);
+
+	Heights.SetNumZeroed(GetHeightmapSizeX() * GetHeightmapSizeY());
+	Chunks.SetNum(NumChunksX * NumChunksY);
+}
+
+void FRuntimeMeshHeightmapTerrain::SetHeights(const TArray<float>& InHeights)
+{
+	check(InHeights.Num() == Heights.Num());
+
+	Heights = InHeights;
+	MarkHeightsDirty(0, 0, GetHeightmapSizeX() - 1, GetHeightmapSizeY() - 1);
+}
+
+void FRuntimeMeshHeightmapTerrain::SetHeight(int32 X, int32 Y, float Height)
+{
+	float& Existing = Heights[X * GetHeightmapSizeY() + Y];
+	if (Existing != Height)
+	{
+		Existing = Height;
+		MarkHeightsDirty(X, Y, X, Y);
+	}
+}
+
+void FRuntimeMeshHeightmapTerrain::SetHeightRegion(int32 MinX, int32 MinY, int32 RegionSizeX, int32 RegionSizeY, const TArray<float>& RegionHeights)
+{
+	check(MinX >= 0 && MinY >= 0 && MinX + RegionSizeX <= GetHeightmapSizeX() && MinY + RegionSizeY <= GetHeightmapSizeY());
+	check(RegionHeights.Num() == RegionSizeX * RegionSizeY);
+
+	if (RegionSizeX <= 0 || RegionSizeY <= 0)
+	{
+		return;
+	}
+
+	const int32 SizeY = GetHeightmapSizeY();
+	for (int32 X = 0; X < RegionSizeX; X++)
+	{
+		FMemory::Memcpy(&Heights[(MinX + X) * SizeY + MinY], &RegionHeights[X * RegionSizeY], RegionSizeY * sizeof(float));
+	}
+
+	MarkHeightsDirty(MinX, MinY, MinX + RegionSizeX - 1, MinY + RegionSizeY - 1);
+}
+
+void FRuntimeMeshHeightmapTerrain::MarkHeightsDirty(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)
+{
+	// Normals read one sample either side, so grow the region by one. Edge samples belong to both chunks.
+	const int32 MinChunkX = FMath::Max(0, (MinX - 2) / ChunkSize);
+	const int32 MinChunkY = FMath::Max(0, (MinY - 2) / ChunkSize);
+	const int32 MaxChunkX = FMath::Min(NumChunksX - 1, (MaxX + 1) / ChunkSize);
+	const int32 MaxChunkY = FMath::Min(NumChunksY - 1, (MaxY + 1) / ChunkSize);
+
+	for (int32 ChunkX = MinChunkX; ChunkX <= MaxChunkX; ChunkX++)
+	{
+		for (int32 ChunkY = MinChunkY; ChunkY <= MaxChunkY; ChunkY++)
+		{
+			Chunks[ChunkX * NumChunksY + ChunkY].bHeightsDirty = true;
+		}
+	}
+}
+
+void FRuntimeMeshHeightmapTerrain::SetChunkLOD(int32 ChunkX, int32 ChunkY, int32 LOD)
+{
+	Chunks[ChunkX * NumChunksY + ChunkY].LOD = FMath::Clamp(LOD, 0, GetNumLODs() - 1);
+}
+
+void FRuntimeMeshHeightmapTerrain::UpdateLODs(const FVector& LocalViewPosition, float LOD0Distance)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Terrain_UpdateLODs);
+
+	check(LOD0Distance > 0.0f);
+
+	const FVector2D ChunkExtent(ChunkSize * Scale.X, ChunkSize * Scale.Y);
+	for (int32 ChunkX = 0; ChunkX < NumChunksX; ChunkX++)
+	{
+		for (int32 ChunkY = 0; ChunkY < NumChunksY; ChunkY++)
+		{
+			// Distance to the chunk's footprint, ignoring height
+			const FBox2D ChunkBox(FVector2D(ChunkX * ChunkExtent.X, ChunkY * ChunkExtent.Y), FVector2D((ChunkX + 1) * ChunkExtent.X, (ChunkY + 1) * ChunkExtent.Y));
+			const float Distance = FMath::Sqrt(ChunkBox.ComputeSquaredDistanceToPoint(FVector2D(LocalViewPosition)));
+
+			const int32 LOD = Distance <= LOD0Distance ? 0 : FMath::FloorToInt(FMath::Log2(Distance / LOD0Distance)) + 1;
+			SetChunkLOD(ChunkX, ChunkY, LOD);
+		}
+	}
+}
+
+void FRuntimeMeshHeightmapTerrain::EnforceLODConstraints()
+{
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 ChunkX = 0; ChunkX < NumChunksX; ChunkX++)
+		{
+			for (int32 ChunkY = 0; ChunkY < NumChunksY; ChunkY++)
+			{
+				int32& LOD = Chunks[ChunkX * NumChunksY + ChunkY].LOD;
+
+				int32 MinNeighborLOD = LOD;
+				if (ChunkX > 0) MinNeighborLOD = FMath::Min(MinNeighborLOD, GetChunkLOD(ChunkX - 1, ChunkY));
+				if (ChunkX < NumChunksX - 1) MinNeighborLOD = FMath::Min(MinNeighborLOD, GetChunkLOD(ChunkX + 1, ChunkY));
+				if (ChunkY > 0) MinNeighborLOD = FMath::Min(MinNeighborLOD, GetChunkLOD(ChunkX, ChunkY - 1));
+				if (ChunkY < NumChunksY - 1) MinNeighborLOD = FMath::Min(MinNeighborLOD, GetChunkLOD(ChunkX, ChunkY + 1));
+
+				if (LOD > MinNeighborLOD + 1)
+				{
+					LOD = MinNeighborLOD + 1;
+					bChanged = true;
+				}
+			}
+		}
+	}
+}
+
+int32 FRuntimeMeshHeightmapTerrain::GetStitchFlags(int32 ChunkX, int32 ChunkY) const
+{
+	const int32 LOD = GetChunkLOD(ChunkX, ChunkY);
+
+	int32 StitchFlags = 0;
+	if (ChunkX > 0 && GetChunkLOD(ChunkX - 1, ChunkY) > LOD) StitchFlags |= FRuntimeMeshTerrainLODIndices::StitchNegX;
+	if (ChunkX < NumChunksX - 1 && GetChunkLOD(ChunkX + 1, ChunkY) > LOD) StitchFlags |= FRuntimeMeshTerrainLODIndices::StitchPosX;
+	if (ChunkY > 0 && GetChunkLOD(ChunkX, ChunkY - 1) > LOD) StitchFlags |= FRuntimeMeshTerrainLODIndices::StitchNegY;
+	if (ChunkY < NumChunksY - 1 && GetChunkLOD(ChunkX, ChunkY + 1) > LOD) StitchFlags |= FRuntimeMeshTerrainLODIndices::StitchPosY;
+	return StitchFlags;
+}
+
+void FRuntimeMeshHeightmapTerrain::BuildChunkVertices(int32 ChunkX, int32 ChunkY, TArray<FRuntimeMeshVertexSimple>& OutVertices, FBox& OutBounds) const
+{
+	const int32 SizeX = GetHeightmapSizeX();
+	const int32 SizeY = GetHeightmapSizeY();
+	const int32 NumVerticesPerSide = ChunkSize + 1;
+
+	OutVertices.SetNumUninitialized(NumVerticesPerSide * NumVerticesPerSide);
+
+	float MinHeight = MAX_flt;
+	float MaxHeight = -MAX_flt;
+
+	// Gradient terms for each lane of a block, stored out of the SIMD registers
+	float GradientX[4];
+	float GradientY[4];
+	float NormalX[4];
+	float NormalY[4];
+	float NormalZ[4];
+	float TangentX[4];
+	float TangentZ[4];
+
+	for (int32 LocalX = 0; LocalX < NumVerticesPerSide; LocalX++)
+	{
+		const int32 X = ChunkX * ChunkSize + LocalX;
+		const int32 LeftX = FMath::Max(X - 1, 0);
+		const int32 RightX = FMath::Min(X + 1, SizeX - 1);
+
+		const float* Row = &Heights[X * SizeY];
+		const float* LeftRow = &Heights[LeftX * SizeY];
+		const float* RightRow = &Heights[RightX * SizeY];
+
+		// Central differences, falling back to one sided at the heightmap edge
+		const float ScaleDX = Scale.Z / ((RightX - LeftX) * Scale.X);
+		const float ScaleDYInterior = Scale.Z / (2.0f * Scale.Y);
+
+		const VectorRegister VecScaleDX = VectorSetFloat1(ScaleDX);
+		const VectorRegister VecScaleDY = VectorSetFloat1(ScaleDYInterior);
+		const VectorRegister VecOne = VectorOne();
+
+		int32 LocalY = 0;
+		while (LocalY < NumVerticesPerSide)
+		{
+			const int32 Y = ChunkY * ChunkSize + LocalY;
+			int32 NumInBlock;
+
+			if (LocalY + 4 <= NumVerticesPerSide && Y - 1 >= 0 && Y + 4 < SizeY)
+			{
+				// 4 vertices at once, all with both Y neighbors available
+				const VectorRegister Left = VectorLoad(LeftRow + Y);
+				const VectorRegister Right = VectorLoad(RightRow + Y);
+				const VectorRegister Down = VectorLoad(Row + Y - 1);
+				const VectorRegister Up = VectorLoad(Row + Y + 1);
+
+				const VectorRegister DX = VectorMultiply(VectorSubtract(Right, Left), VecScaleDX);
+				const VectorRegister DY = VectorMultiply(VectorSubtract(Up, Down), VecScaleDY);
+
+				// Normal = normalize(-DX, -DY, 1), Tangent = normalize(1, 0, DX)
+				const VectorRegister InvNormalLength = VectorReciprocalSqrtAccurate(VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VecOne)));
+				const VectorRegister InvTangentLength = VectorReciprocalSqrtAccurate(VectorMultiplyAdd(DX, DX, VecOne));
+
+				VectorStore(VectorNegate(VectorMultiply(DX, InvNormalLength)), NormalX);
+				VectorStore(VectorNegate(VectorMultiply(DY, InvNormalLength)), NormalY);
+				VectorStore(InvNormalLength, NormalZ);
+				VectorStore(InvTangentLength, TangentX);
+				VectorStore(VectorMultiply(DX, InvTangentLength), TangentZ);
+
+				NumInBlock = 4;
+			}
+			else
+			{
+				// Heightmap edges and the end of the row
+				const int32 DownY = FMath::Max(Y - 1, 0);
+				const int32 UpY = FMath::Min(Y + 1, SizeY - 1);
+
+				GradientX[0] = (RightRow[Y] - LeftRow[Y]) * ScaleDX;
+				GradientY[0] = (Row[UpY] - Row[DownY]) * Scale.Z / ((UpY - DownY) * Scale.Y);
+
+				const FVector Normal = FVector(-GradientX[0], -GradientY[0], 1.0f).GetUnsafeNormal();
+				const FVector Tangent = FVector(1.0f, 0.0f, GradientX[0]).GetUnsafeNormal();
+				NormalX[0] = Normal.X;
+				NormalY[0] = Normal.Y;
+				NormalZ[0] = Normal.Z;
+				TangentX[0] = Tangent.X;
+				TangentZ[0] = Tangent.Z;
+
+				NumInBlock = 1;
+			}
+
+			for (int32 Lane = 0; Lane < NumInBlock; Lane++)
+			{
+				const int32 VertexY = Y + Lane;
+				const float Height = Row[VertexY];
+				MinHeight = FMath::Min(MinHeight, Height);
+				MaxHeight = FMath::Max(MaxHeight, Height);
+
+				new (&OutVertices[LocalX * NumVerticesPerSide + LocalY + Lane]) FRuntimeMeshVertexSimple(
+					FVector(X * Scale.X, VertexY * Scale.Y, Height * Scale.Z),
+					FVector(NormalX[Lane], NormalY[Lane], NormalZ[Lane]),
+					FRuntimeMeshTangent(FVector(TangentX[Lane], 0.0f, TangentZ[Lane]), false),
+					FColor::White,
+					FVector2D((float)X / (SizeX - 1), (float)VertexY / (SizeY - 1)));
+			}
+
+			LocalY += NumInBlock;
+		}
+	}
+
+	const FVector Min(ChunkX * ChunkSize * Scale.X, ChunkY * ChunkSize * Scale.Y, FMath::Min(MinHeight * Scale.Z, MaxHeight * Scale.Z));
+	const FVector Max((ChunkX + 1) * ChunkSize * Scale.X, (ChunkY + 1) * ChunkSize * Scale.Y, FMath::Max(MinHeight * Scale.Z, MaxHeight * Scale.Z));
+	OutBounds = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+}
+
+void FRuntimeMeshHeightmapTerrain::Update()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Terrain_UpdateChunks);
+
+	URuntimeMeshComponent* Mesh = Component.Get();
+	if (Mesh == nullptr)
+	{
+		return;
+	}
+
+	EnforceLODConstraints();
+
+	// Find everything that needs work
+	TArray<int32> VertexChunks;
+	TArray<int32> IndexOnlyChunks;
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+	{
+		const FChunk& Chunk = Chunks[ChunkIndex];
+		if (Chunk.bHeightsDirty || !Chunk.bCreated)
+		{
+			VertexChunks.Add(ChunkIndex);
+		}
+		else if (Chunk.AppliedLOD != Chunk.LOD || Chunk.AppliedStitchFlags != GetStitchFlags(ChunkIndex / NumChunksY, ChunkIndex % NumChunksY))
+		{
+			IndexOnlyChunks.Add(ChunkIndex);
+		}
+	}
+
+	if (VertexChunks.Num() == 0 && IndexOnlyChunks.Num() == 0)
+	{
+		return;
+	}
+
+	// Build the vertices of all dirty chunks in parallel
+	TArray<TArray<FRuntimeMeshVertexSimple>> ChunkVertices;
+	TArray<FBox> ChunkBounds;
+	ChunkVertices.SetNum(VertexChunks.Num());
+	ChunkBounds.SetNum(VertexChunks.Num());
+	ParallelFor(VertexChunks.Num(), [&](int32 Index)
+	{
+		const int32 ChunkIndex = VertexChunks[Index];
+		BuildChunkVertices(ChunkIndex / NumChunksY, ChunkIndex % NumChunksY, ChunkVertices[Index], ChunkBounds[Index]);
+	});
+
+	// Apply everything in one batch, joining the caller's batch if there already is one
+	const bool bStartedBatch = !Mesh->IsBatchUpdatePending();
+	if (bStartedBatch)
+	{
+		Mesh->BeginBatchUpdates();
+	}
+
+	for (int32 Index = 0; Index < VertexChunks.Num(); Index++)
+	{
+		const int32 ChunkIndex = VertexChunks[Index];
+		const int32 ChunkX = ChunkIndex / NumChunksY;
+		const int32 ChunkY = ChunkIndex % NumChunksY;
+		const int32 StitchFlags = GetStitchFlags(ChunkX, ChunkY);
+		const int32 SectionIndex = GetChunkSectionIndex(ChunkX, ChunkY);
+		FChunk& Chunk = Chunks[ChunkIndex];
+
+		if (!Chunk.bCreated)
+		{
+			TArray<int32> Triangles;
+			LODIndices->GetIndices(Chunk.LOD, StitchFlags, Triangles);
+			Mesh->CreateMeshSection(SectionIndex, ChunkVertices[Index], Triangles, ChunkBounds[Index], bCreateCollision, UpdateFrequency, ESectionUpdateFlags::MoveArrays);
+			Chunk.bCreated = true;
+		}
+		else if (Chunk.AppliedLOD != Chunk.LOD || Chunk.AppliedStitchFlags != StitchFlags)
+		{
+			TArray<int32> Triangles;
+			LODIndices->GetIndices(Chunk.LOD, StitchFlags, Triangles);
+			Mesh->UpdateMeshSection(SectionIndex, ChunkVertices[Index], Triangles, ChunkBounds[Index], ESectionUpdateFlags::MoveArrays);
+		}
+		else
+		{
+			Mesh->UpdateMeshSection(SectionIndex, ChunkVertices[Index], ChunkBounds[Index], ESectionUpdateFlags::MoveArrays);
+		}
+
+		Chunk.AppliedLOD = Chunk.LOD;
+		Chunk.AppliedStitchFlags = StitchFlags;
+		Chunk.bHeightsDirty = false;
+	}
+
+	for (int32 ChunkIndex : IndexOnlyChunks)
+	{
+		const int32 ChunkX = ChunkIndex / NumChunksY;
+		const int32 ChunkY = ChunkIndex % NumChunksY;
+		const int32 StitchFlags = GetStitchFlags(ChunkX, ChunkY);
+		FChunk& Chunk = Chunks[ChunkIndex];
+
+		TArray<int32> Triangles;
+		LODIndices->GetIndices(Chunk.LOD, StitchFlags, Triangles);
+		Mesh->UpdateMeshSectionTriangles(GetChunkSectionIndex(ChunkX, ChunkY), Triangles, ESectionUpdateFlags::MoveArrays);
+
+		Chunk.AppliedLOD = Chunk.LOD;
+		Chunk.AppliedStitchFlags = StitchFlags;
+	}
+
+	if (bStartedBatch)
+	{
+		Mesh->EndBatchUpdates();
+	}
+}
@@ -0,0 +1,246 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshTopology.h"
+#include "Async/ParallelFor.h"
+
+
+FRuntimeMeshTopology::FRuntimeMeshTopology(const TArray<int32>& InIndices, int32 NumVertices)
+	: Indices(InIndices)
+	, NumNonManifoldHalfEdges(0)
+{
+	Indices.SetNum(Indices.Num() - Indices.Num() % 3);
+
+	BuildOutgoingHalfEdges(NumVertices);
+
+	TArray<bool> IsBoundary;
+	BuildTwins(IsBoundary);
+	BuildRings();
+	BuildBoundaryLoops(IsBoundary);
+}
+
+void FRuntimeMeshTopology::BuildOutgoingHalfEdges(int32 NumVertices)
+{
+	// Count the half-edges leaving each vertex, then turn the counts into offsets
+	OutgoingOffsets.SetNumZeroed(NumVertices + 1);
+	for (int32 HalfEdge = 0; HalfEdge < Indices.Num(); HalfEdge++)
+	{
+		check(Indices[HalfEdge] >= 0 && Indices[HalfEdge] < NumVertices);
+		OutgoingOffsets[Indices[HalfEdge] + 1]++;
+	}
+
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		OutgoingOffsets[Vertex + 1] += OutgoingOffsets[Vertex];
+	}
+
+	// Fill each vertex's range, in half-edge order
+	TArray<int32> Cursors;
+	Cursors.SetNumUninitialized(NumVertices);
+	FMemory::Memcpy(Cursors.GetData(), OutgoingOffsets.GetData(), NumVertices * sizeof(int32));
+
+	OutgoingHalfEdges.SetNumUninitialized(Indices.Num());
+	for (int32 HalfEdge = 0; HalfEdge < Indices.Num(); HalfEdge++)
+	{
+		OutgoingHalfEdges[Cursors[Indices[HalfEdge]]++] = HalfEdge;
+	}
+}
+
+void FRuntimeMeshTopology::BuildTwins(TArray<bool>& OutIsBoundary)
+{
+	Twins.SetNumUninitialized(Indices.Num());
+	OutIsBoundary.SetNumUninitialized(Indices.Num());
+
+	const int32 NumTasks = FMath::DivideAndRoundUp<int32>(Indices.Num(), ElementsPerTask);
+	TArray<int32> TaskNonManifold;
+	TaskNonManifold.SetNumZeroed(NumTasks);
+
+	// Each half-edge only looks at the half-edges leaving its two ends, so every half-edge decides its own twin
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		const int32 End = FMath::Min<int32>(Indices.Num(), (TaskIndex + 1) * ElementsPerTask);
+		for (int32 HalfEdge = TaskIndex * ElementsPerTask; HalfEdge < End; HalfEdge++)
+		{
+			const int32 StartVertex = GetStartVertex(HalfEdge);
+			const int32 EndVertex = GetEndVertex(HalfEdge);
+
+			Twins[HalfEdge] = INDEX_NONE;
+			OutIsBoundary[HalfEdge] = false;
+
+			// Collapsed edges have no sensible neighbor
+			if (StartVertex == EndVertex)
+			{
+				TaskNonManifold[TaskIndex]++;
+				continue;
+			}
+
+			int32 NumSame = 0;
+			for (int32 Index = OutgoingOffsets[StartVertex]; Index < OutgoingOffsets[StartVertex + 1]; Index++)
+			{
+				NumSame += GetEndVertex(OutgoingHalfEdges[Index]) == EndVertex ? 1 : 0;
+			}
+
+			int32 NumReverse = 0;
+			int32 Reverse = INDEX_NONE;
+			for (int32 Index = OutgoingOffsets[EndVertex]; Index < OutgoingOffsets[EndVertex + 1]; Index++)
+			{
+				if (GetEndVertex(OutgoingHalfEdges[Index]) == StartVertex)
+				{
+					Reverse = OutgoingHalfEdges[Index];
+					NumReverse++;
+				}
+			}
+
+			if (NumSame == 1 && NumReverse == 1)
+			{
+				Twins[HalfEdge] = Reverse;
+			}
+			else if (NumSame == 1 && NumReverse == 0)
+			{
+				OutIsBoundary[HalfEdge] = true;
+			}
+			else
+			{
+				TaskNonManifold[TaskIndex]++;
+			}
+		}
+	});
+
+	for (int32 Count : TaskNonManifold)
+	{
+		NumNonManifoldHalfEdges += Count;
+	}
+}
+
+void FRuntimeMeshTopology::BuildRings()
+{
+	const int32 NumVertices = GetNumVertices();
+	const int32 NumTasks = FMath::DivideAndRoundUp<int32>(NumVertices, ElementsPerTask);
+
+	auto GetRing = [this](int32 Vertex, TArray<int32, TInlineAllocator<32>>& OutRing)
+	{
+		OutRing.Reset();
+		GatherNeighbors(Vertex, OutRing);
+		OutRing.Remove(Vertex);
+		OutRing.Sort();
+
+		int32 NumUnique = 0;
+		for (int32 Index = 0; Index < OutRing.Num(); Index++)
+		{
+			if (NumUnique == 0 || OutRing[NumUnique - 1] != OutRing[Index])
+			{
+				OutRing[NumUnique++] = OutRing[Index];
+			}
+		}
+		OutRing.SetNum(NumUnique, false);
+	};
+
+	// Size every ring first so they can be written straight into the flat array
+	RingOffsets.SetNumZeroed(NumVertices + 1);
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		TArray<int32, TInlineAllocator<32>> Ring;
+		const int32 End = FMath::Min<int32>(NumVertices, (TaskIndex + 1) * ElementsPerTask);
+		for (int32 Vertex = TaskIndex * ElementsPerTask; Vertex < End; Vertex++)
+		{
+			GetRing(Vertex, Ring);
+			RingOffsets[Vertex + 1] = Ring.Num();
+		}
+	});
+
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		RingOffsets[Vertex + 1] += RingOffsets[Vertex];
+	}
+
+	RingVertices.SetNumUninitialized(RingOffsets[NumVertices]);
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		TArray<int32, TInlineAllocator<32>> Ring;
+		const int32 End = FMath::Min<int32>(NumVertices, (TaskIndex + 1) * ElementsPerTask);
+		for (int32 Vertex = TaskIndex * ElementsPerTask; Vertex < End; Vertex++)
+		{
+			GetRing(Vertex, Ring);
+			if (Ring.Num() > 0)
+			{
+				FMemory::Memcpy(&RingVertices[RingOffsets[Vertex]], Ring.GetData(), Ring.Num() * sizeof(int32));
+			}
+		}
+	});
+}
+
+void FRuntimeMeshTopology::BuildBoundaryLoops(const TArray<bool>& IsBoundary)
+{
+	BoundaryLoopOf.Init(INDEX_NONE, Indices.Num());
+	BoundaryLoopOffsets.Reset();
+	BoundaryLoopOffsets.Add(0);
+
+	// Boundaries are usually a tiny part of the mesh, so walk them on this thread
+	for (int32 First = 0; First < Indices.Num(); First++)
+	{
+		if (!IsBoundary[First] || BoundaryLoopOf[First] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		const int32 Loop = BoundaryLoopOffsets.Num() - 1;
+		int32 HalfEdge = First;
+		while (HalfEdge != INDEX_NONE)
+		{
+			BoundaryLoopOf[HalfEdge] = Loop;
+			BoundaryHalfEdges.Add(HalfEdge);
+
+			// Continue with a boundary half-edge leaving the end vertex. Vertices where several holes meet are left by the first one not walked yet.
+			const int32 Vertex = GetEndVertex(HalfEdge);
+			HalfEdge = INDEX_NONE;
+			for (int32 Index = OutgoingOffsets[Vertex]; Index < OutgoingOffsets[Vertex + 1]; Index++)
+			{
+				const int32 Candidate = OutgoingHalfEdges[Index];
+				if (IsBoundary[Candidate] && BoundaryLoopOf[Candidate] == INDEX_NONE)
+				{
+					HalfEdge = Candidate;
+					break;
+				}
+			}
+		}
+
+		BoundaryLoopOffsets.Add(BoundaryHalfEdges.Num());
+	}
+}
+
+bool FRuntimeMeshTopology::IsBoundaryVertex(int32 Vertex) const
+{
+	for (int32 Index = OutgoingOffsets[Vertex]; Index < OutgoingOffsets[Vertex + 1]; Index++)
+	{
+		const int32 HalfEdge = OutgoingHalfEdges[Index];
+		if (IsBoundaryHalfEdge(HalfEdge) || IsBoundaryHalfEdge(GetPrevious(HalfEdge)))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FRuntimeMeshTopology::GetOneRingNeighborhood(const TArray<int32>& Vertices, TArray<int32>& OutNeighborhood) const
+{
+	TBitArray<> IsInNeighborhood(false, GetNumVertices());
+	for (int32 Vertex : Vertices)
+	{
+		// Vertices no triangle uses don't affect anything
+		if (OutgoingOffsets[Vertex] == OutgoingOffsets[Vertex + 1])
+		{
+			continue;
+		}
+
+		IsInNeighborhood[Vertex] = true;
+		for (int32 Index = RingOffsets[Vertex]; Index < RingOffsets[Vertex + 1]; Index++)
+		{
+			IsInNeighborhood[RingVertices[Index]] = true;
+		}
+	}
+
+	for (TConstSetBitIterator<> It(IsInNeighborhood); It; ++It)
+	{
+		OutNeighborhood.Add(It.GetIndex());
+	}
+}
@@ -0,0 +1,21 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshUpdateCommands.h"
+
+
+FRuntimeMeshCommandBuffer::FRuntimeMeshCommandBuffer(const FRuntimeMeshBufferPoolPtr& InStoragePool)
+	: StoragePool(InStoragePool)
+{
+	check(StoragePool.IsValid());
+	StoragePool->Acquire(Storage, InitialSize);
+}
+
+FRuntimeMeshCommandBuffer::~FRuntimeMeshCommandBuffer()
+{
+	StoragePool->Release(Storage);
+	for (int32 Index = 0; Index < ExternalArrays.Num(); Index++)
+	{
+		ExternalArrayPools[Index]->Release(ExternalArrays[Index]);
+	}
+}
@@ -0,0 +1,131 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshUpdateManager.h"
+#include "Async/ParallelFor.h"
+
+
+TMap<UWorld*, TSharedPtr<FRuntimeMeshUpdateManager>> FRuntimeMeshUpdateManager::Managers;
+FDelegateHandle FRuntimeMeshUpdateManager::WorldPostActorTickHandle;
+FDelegateHandle FRuntimeMeshUpdateManager::WorldCleanupHandle;
+
+
+void FRuntimeMeshUpdateManager::Initialize()
+{
+	WorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&FRuntimeMeshUpdateManager::OnWorldPostActorTick);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FRuntimeMeshUpdateManager::OnWorldCleanup);
+}
+
+void FRuntimeMeshUpdateManager::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	Managers.Empty();
+}
+
+FRuntimeMeshUpdateManager* FRuntimeMeshUpdateManager::Get(UWorld* World)
+{
+	check(IsInGameThread());
+
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FRuntimeMeshUpdateManager>& Manager = Managers.FindOrAdd(World);
+	if (!Manager.IsValid())
+	{
+		Manager = MakeShareable(new FRuntimeMeshUpdateManager());
+	}
+	return Manager.Get();
+}
+
+void FRuntimeMeshUpdateManager::AddPendingComponent(URuntimeMeshComponent* Component)
+{
+	PendingComponents.Add(Component);
+}
+
+void FRuntimeMeshUpdateManager::AddPendingMorphComponent(URuntimeMeshComponent* Component)
+{
+	PendingMorphComponents.Add(Component);
+}
+
+void FRuntimeMeshUpdateManager::Flush()
+{
+	// Blend morph targets first so coalescing components send them with the rest of their batch
+	TArray<TWeakObjectPtr<URuntimeMeshComponent>> MorphComponents = MoveTemp(PendingMorphComponents);
+	PendingMorphComponents.Reset();
+	for (const TWeakObjectPtr<URuntimeMeshComponent>& PendingComponent : MorphComponents)
+	{
+		URuntimeMeshComponent* Component = PendingComponent.Get();
+		if (Component && Component->bHasPendingMorphTargets)
+		{
+			Component->ApplyPendingMorphTargets();
+		}
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_FlushCoalescedUpdates);
+
+	// Gather the components that still have a coalesced batch. They may have been destroyed, had their batch ended early,
+	// or be inside a batch begun with BeginBatchUpdates(), which only the caller ends.
+	TArray<URuntimeMeshComponent*> Components;
+	TSet<URuntimeMeshComponent*> AddedComponents;
+	Components.Reserve(PendingComponents.Num());
+	for (const TWeakObjectPtr<URuntimeMeshComponent>& PendingComponent : PendingComponents)
+	{
+		URuntimeMeshComponent* Component = PendingComponent.Get();
+		if (Component && Component->BatchState.IsCoalescedBatchPending() && !AddedComponents.Contains(Component))
+		{
+			AddedComponents.Add(Component);
+			Components.Add(Component);
+		}
+	}
+	PendingComponents.Reset();
+
+	if (Components.Num() == 0)
+	{
+		return;
+	}
+
+	// Materials have to be resolved on the game thread, so create the new section proxies here
+	TArray<TArray<FRuntimeMeshSectionProxyInterface*>> NewProxies;
+	NewProxies.SetNum(Components.Num());
+	for (int32 Index = 0; Index < Components.Num(); Index++)
+	{
+		Components[Index]->CreateBatchSectionProxies(NewProxies[Index]);
+	}
+
+	// Pack every payload in parallel
+	TArray<FRuntimeMeshCommandBuffer*> BatchUpdates;
+	BatchUpdates.SetNumZeroed(Components.Num());
+	ParallelFor(Components.Num(), [&](int32 Index)
+	{
+		BatchUpdates[Index] = Components[Index]->PrepareBatchUpdate(NewProxies[Index]);
+	});
+
+	// Send them all in one render command
+	URuntimeMeshComponent::SubmitBatchUpdates(Components, BatchUpdates);
+
+	// Handle collision, bounds and proxy recreates
+	for (URuntimeMeshComponent* Component : Components)
+	{
+		Component->FinishBatchUpdate();
+	}
+}
+
+void FRuntimeMeshUpdateManager::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (TSharedPtr<FRuntimeMeshUpdateManager>* Manager = Managers.Find(World))
+	{
+		(*Manager)->Flush();
+	}
+}
+
+void FRuntimeMeshUpdateManager::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (TSharedPtr<FRuntimeMeshUpdateManager>* Manager = Managers.Find(World))
+	{
+		(*Manager)->Flush();
+		Managers.Remove(World);
+	}
+}
@@ -0,0 +1,566 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshComponentPluginPrivatePCH.h"
+#include "RuntimeMeshVoxel.h"
+#include "RuntimeMeshLibrary.h"
+#include "Async/ParallelFor.h"
+
+
+namespace RuntimeMeshVoxelInternal
+{
+	/**
+	*	Marching cubes case table, built from the cube topology instead of hardcoded.
+	*	Corner C is at (C & 1, (C >> 1) & 1, (C >> 2) & 1). Each face of the cube gets one segment per run of solid corners,
+	*	so faces with diagonally opposite solid corners are always split the same way by both cubes sharing them,
+	*	the segments are chained into loops around the cube and each loop is fanned into triangles.
+	*/
+	struct FMarchingCubesTable
+	{
+		/* The two corners of each edge, lowest first */
+		int32 EdgeCorners[12][2];
+
+		/* Axis each edge runs along */
+		int32 EdgeAxis[12];
+
+		/* Edge triplets making up the triangles of each case, at most 5 triangles */
+		int8 CaseEdges[256][15];
+		int32 CaseNumIndices[256];
+
+		FMarchingCubesTable()
+		{
+			int32 EdgeIndex[8][8];
+			int32 NumEdges = 0;
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				for (int32 Corner = 0; Corner < 8; Corner++)
+				{
+					if ((Corner & (1 << Axis)) == 0)
+					{
+						const int32 OtherCorner = Corner | (1 << Axis);
+						EdgeCorners[NumEdges][0] = Corner;
+						EdgeCorners[NumEdges][1] = OtherCorner;
+						EdgeAxis[NumEdges] = Axis;
+						EdgeIndex[Corner][OtherCorner] = EdgeIndex[OtherCorner][Corner] = NumEdges;
+						NumEdges++;
+					}
+				}
+			}
+
+			// Corners of each face, counter clockwise seen from outside the cube
+			int32 FaceCorners[6][4];
+			const int32 CycleU[4] = { 0, 1, 1, 0 };
+			const int32 CycleV[4] = { 0, 0, 1, 1 };
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				const int32 AxisU = (Axis + 1) % 3;
+				const int32 AxisV = (Axis + 2) % 3;
+				for (int32 Side = 0; Side < 2; Side++)
+				{
+					for (int32 Index = 0; Index < 4; Index++)
+					{
+						const int32 Cycle = Side ? Index : 3 - Index;
+						FaceCorners[Axis * 2 + Side][Index] = (Side << Axis) | (CycleU[Cycle] << AxisU) | (CycleV[Cycle] << AxisV);
+					}
+				}
+			}
+
+			// Faces each edge lies on, used to keep triangle fans from creating edges across a cube face
+			int32 EdgeFaces[12] = { 0 };
+			for (int32 Face = 0; Face < 6; Face++)
+			{
+				for (int32 Index = 0; Index < 4; Index++)
+				{
+					EdgeFaces[EdgeIndex[FaceCorners[Face][Index]][FaceCorners[Face][(Index + 1) % 4]]] |= 1 << Face;
+				}
+			}
+
+			for (int32 Case = 0; Case < 256; Case++)
+			{
+				auto IsSolid = [Case](int32 Corner) { return ((Case >> Corner) & 1) != 0; };
+
+				// Every crossed edge is entered on one face and left on the other
+				int32 NextEdge[12];
+				for (int32 Edge = 0; Edge < 12; Edge++)
+				{
+					NextEdge[Edge] = INDEX_NONE;
+				}
+
+				for (int32 Face = 0; Face < 6; Face++)
+				{
+					const int32* Corners = FaceCorners[Face];
+					for (int32 Index = 0; Index < 4; Index++)
+					{
+						if (IsSolid(Corners[Index]) && !IsSolid(Corners[(Index + 1) % 4]))
+						{
+							// Walk back to the start of this run of solid corners
+							int32 RunStart = Index;
+							while (IsSolid(Corners[(RunStart + 3) % 4]))
+							{
+								RunStart = (RunStart + 3) % 4;
+							}
+
+							const int32 EntryEdge = EdgeIndex[Corners[(RunStart + 3) % 4]][Corners[RunStart]];
+							const int32 ExitEdge = EdgeIndex[Corners[Index]][Corners[(Index + 1) % 4]];
+							NextEdge[EntryEdge] = ExitEdge;
+						}
+					}
+				}
+
+				int32 NumIndices = 0;
+				bool bEdgeUsed[12] = { false };
+				for (int32 FirstEdge = 0; FirstEdge < 12; FirstEdge++)
+				{
+					if (NextEdge[FirstEdge] == INDEX_NONE || bEdgeUsed[FirstEdge])
+					{
+						continue;
+					}
+
+					int32 Loop[12];
+					int32 LoopLength = 0;
+					for (int32 Edge = FirstEdge; !bEdgeUsed[Edge]; Edge = NextEdge[Edge])
+					{
+						bEdgeUsed[Edge] = true;
+						Loop[LoopLength++] = Edge;
+					}
+
+					// Fan from a vertex whose diagonals don't lie on a cube face, those would be shared with the neighboring cube
+					int32 FanStart = 0;
+					for (int32 Candidate = 0; Candidate < LoopLength; Candidate++)
+					{
+						bool bValid = true;
+						for (int32 Offset = 2; Offset + 1 < LoopLength; Offset++)
+						{
+							bValid &= (EdgeFaces[Loop[Candidate]] & EdgeFaces[Loop[(Candidate + Offset) % LoopLength]]) == 0;
+						}
+						if (bValid)
+						{
+							FanStart = Candidate;
+							break;
+						}
+					}
+
+					// Every case fits in 5 triangles, check before writing past the row
+					check(NumIndices + (LoopLength - 2) * 3 <= 15);
+
+					for (int32 Offset = 1; Offset + 1 < LoopLength; Offset++)
+					{
+						CaseEdges[Case][NumIndices++] = Loop[FanStart];
+						CaseEdges[Case][NumIndices++] = Loop[(FanStart + Offset + 1) % LoopLength];
+						CaseEdges[Case][NumIndices++] = Loop[(FanStart + Offset) % LoopLength];
+					}
+				}
+
+				CaseNumIndices[Case] = NumIndices;
+			}
+		}
+	};
+
+	static const FMarchingCubesTable& GetMarchingCubesTable()
+	{
+		static const FMarchingCubesTable Table;
+		return Table;
+	}
+
+	/* Tangent perpendicular to the normal, preferring the XY plane */
+	static FVector GetTangentFromNormal(const FVector& Normal)
+	{
+		const FVector Tangent = FVector::CrossProduct(Normal, FMath::Abs(Normal.Z) < 0.999f ? FVector(0, 0, 1) : FVector(1, 0, 0));
+		return Tangent.GetSafeNormal();
+	}
+}
+
+
+FRuntimeMeshVoxelMesher::FRuntimeMeshVoxelMesher()
+	: IsoLevel(0.0f), SlicesPerSlab(8)
+{
+}
+
+void FRuntimeMeshVoxelMesher::AddSlabTasks(int32 ChunkIndex, int32 Axis, int32 SliceBegin, int32 SliceEnd)
+{
+	const int32 SlabSize = FMath::Max(SlicesPerSlab, 1);
+	for (int32 Slice = SliceBegin; Slice < SliceEnd; Slice += SlabSize)
+	{
+		FSlabTask& Task = Tasks[Tasks.AddUninitialized()];
+		Task.ChunkIndex = ChunkIndex;
+		Task.Axis = Axis;
+		Task.SliceBegin = Slice;
+		Task.SliceEnd = FMath::Min(Slice + SlabSize, SliceEnd);
+	}
+}
+
+void FRuntimeMeshVoxelMesher::RunTasks(int32 NumChunks, TArray<FRuntimeMeshVoxelMeshData>& OutMeshes, TFunctionRef<void(const FSlabTask&, FSlabScratch&)> MeshSlab)
+{
+	// Only ever grow the scratch so its buffers are kept for the next call
+	if (Scratch.Num() < Tasks.Num())
+	{
+		Scratch.SetNum(Tasks.Num());
+	}
+
+	ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+	{
+		FSlabScratch& TaskScratch = Scratch[TaskIndex];
+		TaskScratch.Vertices.Reset();
+		TaskScratch.Triangles.Reset();
+		TaskScratch.BoundingBox = FBox(0);
+		MeshSlab(Tasks[TaskIndex], TaskScratch);
+	});
+
+	// Tasks are added in chunk order, find where each chunk's tasks start
+	TArray<int32> ChunkFirstTask;
+	ChunkFirstTask.Init(Tasks.Num(), NumChunks + 1);
+	for (int32 TaskIndex = Tasks.Num() - 1; TaskIndex >= 0; TaskIndex--)
+	{
+		ChunkFirstTask[Tasks[TaskIndex].ChunkIndex] = TaskIndex;
+	}
+	for (int32 ChunkIndex = NumChunks - 1; ChunkIndex >= 0; ChunkIndex--)
+	{
+		ChunkFirstTask[ChunkIndex] = FMath::Min(ChunkFirstTask[ChunkIndex], ChunkFirstTask[ChunkIndex + 1]);
+	}
+
+	// Join the slabs straight into the output buffers
+	OutMeshes.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		FRuntimeMeshVoxelMeshData& Mesh = OutMeshes[ChunkIndex];
+
+		int32 NumVertices = 0;
+		int32 NumIndices = 0;
+		Mesh.BoundingBox = FBox(0);
+		for (int32 TaskIndex = ChunkFirstTask[ChunkIndex]; TaskIndex < ChunkFirstTask[ChunkIndex + 1]; TaskIndex++)
+		{
+			NumVertices += Scratch[TaskIndex].Vertices.Num();
+			NumIndices += Scratch[TaskIndex].Triangles.Num();
+			Mesh.BoundingBox += Scratch[TaskIndex].BoundingBox;
+		}
+
+		Mesh.Vertices.SetNumUninitialized(NumVertices);
+		Mesh.Triangles.SetNumUninitialized(NumIndices);
+
+		int32 VertexOffset = 0;
+		int32 IndexOffset = 0;
+		for (int32 TaskIndex = ChunkFirstTask[ChunkIndex]; TaskIndex < ChunkFirstTask[ChunkIndex + 1]; TaskIndex++)
+		{
+			const FSlabScratch& TaskScratch = Scratch[TaskIndex];
+			FMemory::Memcpy(Mesh.Vertices.GetData() + VertexOffset, TaskScratch.Vertices.GetData(), TaskScratch.Vertices.Num() * sizeof(FRuntimeMeshVertexSimple));
+
+			for (int32 Index = 0; Index < TaskScratch.Triangles.Num(); Index++)
+			{
+				Mesh.Triangles[IndexOffset + Index] = TaskScratch.Triangles[Index] + VertexOffset;
+			}
+
+			VertexOffset += TaskScratch.Vertices.Num();
+			IndexOffset += TaskScratch.Triangles.Num();
+		}
+	});
+}
+
+void FRuntimeMeshVoxelMesher::MarchingCubes(const TArray<const FRuntimeMeshVoxelChunk*>& Chunks, TArray<FRuntimeMeshVoxelMeshData>& OutMeshes)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Voxel_MarchingCubes);
+
+	Tasks.Reset();
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+	{
+		const FRuntimeMeshVoxelChunk& Chunk = *Chunks[ChunkIndex];
+		check(Chunk.Densities.Num() == Chunk.GetNumVoxels());
+
+		// Slabs of cells along X
+		AddSlabTasks(ChunkIndex, 0, 0, Chunk.Size.X - 1);
+	}
+
+	RunTasks(Chunks.Num(), OutMeshes, [&](const FSlabTask& Task, FSlabScratch& TaskScratch)
+	{
+		MarchingCubesSlab(*Chunks[Task.ChunkIndex], Task, TaskScratch);
+	});
+}
+
+void FRuntimeMeshVoxelMesher::GreedyMesh(const TArray<const FRuntimeMeshVoxelChunk*>& Chunks, TArray<FRuntimeMeshVoxelMeshData>& OutMeshes)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Voxel_GreedyMesh);
+
+	Tasks.Reset();
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+	{
+		const FRuntimeMeshVoxelChunk& Chunk = *Chunks[ChunkIndex];
+		check(Chunk.Materials.Num() == Chunk.GetNumVoxels());
+
+		// Slice N is the plane between voxel N - 1 and N, for each axis
+		const int32 Border = Chunk.bHasBorder ? 1 : 0;
+		const int32 Size[3] = { Chunk.Size.X, Chunk.Size.Y, Chunk.Size.Z };
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			AddSlabTasks(ChunkIndex, Axis, Border, Size[Axis] - Border + 1);
+		}
+	}
+
+	RunTasks(Chunks.Num(), OutMeshes, [&](const FSlabTask& Task, FSlabScratch& TaskScratch)
+	{
+		GreedyMeshSlab(*Chunks[Task.ChunkIndex], Task, TaskScratch);
+	});
+}
+
+void FRuntimeMeshVoxelMesher::MarchingCubesSlab(const FRuntimeMeshVoxelChunk& Chunk, const FSlabTask& Task, FSlabScratch& OutScratch) const
+{
+	using namespace RuntimeMeshVoxelInternal;
+
+	const FMarchingCubesTable& Table = GetMarchingCubesTable();
+	const FIntVector& Size = Chunk.Size;
+	const float* Densities = Chunk.Densities.GetData();
+
+	// Vertex index of each crossed edge in this slab, by the edge's lowest sample and axis
+	const int32 NumSlabSamples = (Task.SliceEnd - Task.SliceBegin + 1) * Size.Y * Size.Z;
+	OutScratch.EdgeVertices.Reset();
+	OutScratch.EdgeVertices.Init(INDEX_NONE, NumSlabSamples * 3);
+
+	auto GetDensity = [&](int32 X, int32 Y, int32 Z)
+	{
+		return Densities[Chunk.GetIndex(FMath::Clamp(X, 0, Size.X - 1), FMath::Clamp(Y, 0, Size.Y - 1), FMath::Clamp(Z, 0, Size.Z - 1))];
+	};
+
+	auto GetGradient = [&](int32 X, int32 Y, int32 Z)
+	{
+		return FVector(
+			GetDensity(X + 1, Y, Z) - GetDensity(X - 1, Y, Z),
+			GetDensity(X, Y + 1, Z) - GetDensity(X, Y - 1, Z),
+			GetDensity(X, Y, Z + 1) - GetDensity(X, Y, Z - 1)) / Chunk.VoxelSize;
+	};
+
+	auto GetEdgeVertex = [&](int32 X, int32 Y, int32 Z, int32 Axis, float Density0, float Density1)
+	{
+		int32& Vertex = OutScratch.EdgeVertices[(((X - Task.SliceBegin) * Size.Y + Y) * Size.Z + Z) * 3 + Axis];
+		if (Vertex == INDEX_NONE)
+		{
+			const int32 OtherX = X + (Axis == 0 ? 1 : 0);
+			const int32 OtherY = Y + (Axis == 1 ? 1 : 0);
+			const int32 OtherZ = Z + (Axis == 2 ? 1 : 0);
+			const float Alpha = (IsoLevel - Density0) / (Density1 - Density0);
+
+			FVector SamplePosition(X, Y, Z);
+			SamplePosition[Axis] += Alpha;
+
+			// Density increases into the solid, so the normal is against the gradient
+			FVector Normal = -FMath::Lerp(GetGradient(X, Y, Z), GetGradient(OtherX, OtherY, OtherZ), Alpha);
+			if (!Normal.Normalize())
+			{
+				Normal = FVector::ZeroVector;
+				Normal[Axis] = Density1 >= IsoLevel ? -1.0f : 1.0f;
+			}
+
+			// Project UVs along the dominant normal axis
+			const FVector AbsNormal = Normal.GetAbs();
+			const FVector2D UV = AbsNormal.X >= AbsNormal.Y && AbsNormal.X >= AbsNormal.Z ? FVector2D(SamplePosition.Y, SamplePosition.Z) :
+				AbsNormal.Y >= AbsNormal.Z ? FVector2D(SamplePosition.X, SamplePosition.Z) : FVector2D(SamplePosition.X, SamplePosition.Y);
+
+			const FVector Position = Chunk.Origin + SamplePosition * Chunk.VoxelSize;
+			OutScratch.BoundingBox += Position;
+
+			Vertex = OutScratch.Vertices.Num();
+			OutScratch.Vertices.Emplace(Position, Normal, FRuntimeMeshTangent(GetTangentFromNormal(Normal), false), FColor::White, UV);
+		}
+		return Vertex;
+	};
+
+	for (int32 X = Task.SliceBegin; X < Task.SliceEnd; X++)
+	{
+		for (int32 Y = 0; Y < Size.Y - 1; Y++)
+		{
+			for (int32 Z = 0; Z < Size.Z - 1; Z++)
+			{
+				float CornerDensities[8];
+				int32 Case = 0;
+				for (int32 Corner = 0; Corner < 8; Corner++)
+				{
+					CornerDensities[Corner] = Densities[Chunk.GetIndex(X + (Corner & 1), Y + ((Corner >> 1) & 1), Z + ((Corner >> 2) & 1))];
+					Case |= CornerDensities[Corner] >= IsoLevel ? (1 << Corner) : 0;
+				}
+
+				const int32 NumIndices = Table.CaseNumIndices[Case];
+				for (int32 Index = 0; Index < NumIndices; Index++)
+				{
+					const int32 Edge = Table.CaseEdges[Case][Index];
+					const int32 Corner0 = Table.EdgeCorners[Edge][0];
+					const int32 Corner1 = Table.EdgeCorners[Edge][1];
+
+					OutScratch.Triangles.Add(GetEdgeVertex(X + (Corner0 & 1), Y + ((Corner0 >> 1) & 1), Z + ((Corner0 >> 2) & 1),
+						Table.EdgeAxis[Edge], CornerDensities[Corner0], CornerDensities[Corner1]));
+				}
+			}
+		}
+	}
+}
+
+void FRuntimeMeshVoxelMesher::GreedyMeshSlab(const FRuntimeMeshVoxelChunk& Chunk, const FSlabTask& Task, FSlabScratch& OutScratch) const
+{
+	using namespace RuntimeMeshVoxelInternal;
+
+	const int32 Size[3] = { Chunk.Size.X, Chunk.Size.Y, Chunk.Size.Z };
+	const int32 Border = Chunk.bHasBorder ? 1 : 0;
+
+	// Slices are planes across Axis, with the mask in the plane of AxisU and AxisV
+	const int32 Axis = Task.Axis;
+	const int32 AxisU = (Axis + 1) % 3;
+	const int32 AxisV = (Axis + 2) % 3;
+	const int32 MaskWidth = Size[AxisU] - Border * 2;
+	const int32 MaskHeight = Size[AxisV] - Border * 2;
+	if (MaskWidth <= 0 || MaskHeight <= 0)
+	{
+		return;
+	}
+
+	OutScratch.Mask.SetNumUninitialized(MaskWidth * MaskHeight, false);
+	int32* Mask = OutScratch.Mask.GetData();
+
+	auto GetMaterial = [&](const int32* Voxel) -> uint8
+	{
+		if (Voxel[0] < 0 || Voxel[1] < 0 || Voxel[2] < 0 || Voxel[0] >= Size[0] || Voxel[1] >= Size[1] || Voxel[2] >= Size[2])
+		{
+			return 0;
+		}
+		return Chunk.Materials[Chunk.GetIndex(Voxel[0], Voxel[1], Voxel[2])];
+	};
+
+	FVector Normals[2];
+	Normals[0] = Normals[1] = FVector::ZeroVector;
+	Normals[0][Axis] = -1.0f;
+	Normals[1][Axis] = 1.0f;
+	FVector Tangent = FVector::ZeroVector;
+	Tangent[AxisU] = 1.0f;
+
+	for (int32 Slice = Task.SliceBegin; Slice < Task.SliceEnd; Slice++)
+	{
+		// Faces are only owned by this chunk if the solid voxel isn't in the border
+		const bool bBackMeshed = Slice - 1 >= Border;
+		const bool bFrontMeshed = Slice < Size[Axis] - Border;
+
+		// Build the mask of visible faces, positive material facing +Axis, negative facing -Axis
+		for (int32 V = 0; V < MaskHeight; V++)
+		{
+			for (int32 U = 0; U < MaskWidth; U++)
+			{
+				int32 Voxel[3];
+				Voxel[Axis] = Slice - 1;
+				Voxel[AxisU] = U + Border;
+				Voxel[AxisV] = V + Border;
+				const uint8 BackMaterial = GetMaterial(Voxel);
+				Voxel[Axis] = Slice;
+				const uint8 FrontMaterial = GetMaterial(Voxel);
+
+				int32 MaskValue = 0;
+				if (BackMaterial != 0 && FrontMaterial == 0 && bBackMeshed)
+				{
+					MaskValue = BackMaterial;
+				}
+				else if (FrontMaterial != 0 && BackMaterial == 0 && bFrontMeshed)
+				{
+					MaskValue = -FrontMaterial;
+				}
+				Mask[V * MaskWidth + U] = MaskValue;
+			}
+		}
+
+		// Merge the mask into rectangles
+		for (int32 V = 0; V < MaskHeight; V++)
+		{
+			for (int32 U = 0; U < MaskWidth; )
+			{
+				const int32 MaskValue = Mask[V * MaskWidth + U];
+				if (MaskValue == 0)
+				{
+					U++;
+					continue;
+				}
+
+				int32 Width = 1;
+				while (U + Width < MaskWidth && Mask[V * MaskWidth + U + Width] == MaskValue)
+				{
+					Width++;
+				}
+
+				int32 Height = 1;
+				for (bool bRowMatches = true; bRowMatches && V + Height < MaskHeight; )
+				{
+					for (int32 Offset = 0; Offset < Width; Offset++)
+					{
+						bRowMatches &= Mask[(V + Height) * MaskWidth + U + Offset] == MaskValue;
+					}
+					Height += bRowMatches ? 1 : 0;
+				}
+
+				for (int32 ClearV = V; ClearV < V + Height; ClearV++)
+				{
+					FMemory::Memzero(&Mask[ClearV * MaskWidth + U], Width * sizeof(int32));
+				}
+
+				// Emit the quad
+				const bool bFacesPositive = MaskValue > 0;
+				const int32 Material = FMath::Abs(MaskValue);
+				const FColor Color = Chunk.Palette.IsValidIndex(Material) ? Chunk.Palette[Material] : FColor::White;
+				const FRuntimeMeshTangent QuadTangent(Tangent, !bFacesPositive);
+				const int32 FirstVertex = OutScratch.Vertices.Num();
+
+				const int32 CornerU[4] = { 0, Width, Width, 0 };
+				const int32 CornerV[4] = { 0, 0, Height, Height };
+				for (int32 Corner = 0; Corner < 4; Corner++)
+				{
+					FVector VoxelPosition;
+					VoxelPosition[Axis] = Slice;
+					VoxelPosition[AxisU] = U + Border + CornerU[Corner];
+					VoxelPosition[AxisV] = V + Border + CornerV[Corner];
+
+					const FVector Position = Chunk.Origin + VoxelPosition * Chunk.VoxelSize;
+					OutScratch.BoundingBox += Position;
+					OutScratch.Vertices.Emplace(Position, Normals[bFacesPositive ? 1 : 0], QuadTangent, Color,
+						FVector2D(VoxelPosition[AxisU], VoxelPosition[AxisV]));
+				}
+
+				if (bFacesPositive)
+				{
+					URuntimeMeshLibrary::ConvertQuadToTriangles(OutScratch.Triangles, FirstVertex + 0, FirstVertex + 3, FirstVertex + 2, FirstVertex + 1);
+				}
+				else
+				{
+					URuntimeMeshLibrary::ConvertQuadToTriangles(OutScratch.Triangles, FirstVertex + 0, FirstVertex + 1, FirstVertex + 2, FirstVertex + 3);
+				}
+
+				U += Width;
+			}
+		}
+	}
+}
+
+void FRuntimeMeshVoxelMesher::ApplyToComponent(URuntimeMeshComponent* Component, const TArray<int32>& SectionIndices, TArray<FRuntimeMeshVoxelMeshData>& Meshes,
+	bool bCreateCollision, EUpdateFrequency UpdateFrequency)
+{
+	check(Component);
+	check(SectionIndices.Num() == Meshes.Num());
+
+	// Join the batch already pending on the component, if any, and only end one we began
+	const bool bStartedBatch = !Component->IsBatchUpdatePending();
+	if (bStartedBatch)
+	{
+		Component->BeginBatchUpdates();
+	}
+
+	for (int32 Index = 0; Index < Meshes.Num(); Index++)
+	{
+		FRuntimeMeshVoxelMeshData& Mesh = Meshes[Index];
+		const int32 SectionIndex = SectionIndices[Index];
+
+		if (Mesh.Triangles.Num() == 0)
+		{
+			if (Component->DoesSectionExist(SectionIndex))
+			{
+				Component->ClearMeshSection(SectionIndex);
+			}
+			Mesh.Vertices.Reset();
+			continue;
+		}
+
+		Component->CreateMeshSection(SectionIndex, Mesh.Vertices, Mesh.Triangles, Mesh.BoundingBox, bCreateCollision, UpdateFrequency, ESectionUpdateFlags::MoveArrays);
+	}
+
+	if (bStartedBatch)
+	{
+		Component->EndBatchUpdates();
+	}
+}
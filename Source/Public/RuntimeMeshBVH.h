@@ -0,0 +1,137 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshBVH.generated.h"
+
+/* A triangle found by a query against a section's geometry. Everything is in component space. */
+USTRUCT(BlueprintType)
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshQueryHit
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Query")
+	int32 SectionIndex;
+
+	/* Index of the triangle in the section's index buffer, divided by 3 */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Query")
+	int32 TriangleIndex;
+
+	/* Point on the triangle. The hit point for ray casts, the closest point to the query otherwise. */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Query")
+	FVector Position;
+
+	/* Weights of the triangle's three vertices at Position */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Query")
+	FVector Barycentrics;
+
+	/* Face normal of the triangle */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Query")
+	FVector Normal;
+
+	/* First UV channel interpolated at Position */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Query")
+	FVector2D UV;
+
+	/* Distance along the ray for ray casts, distance to the query point otherwise */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Query")
+	float Distance;
+
+	FRuntimeMeshQueryHit()
+		: SectionIndex(INDEX_NONE), TriangleIndex(INDEX_NONE), Position(0, 0, 0), Barycentrics(0, 0, 0), Normal(0, 0, 0), UV(0, 0), Distance(0)
+	{}
+};
+
+/**
+*	Bounding volume hierarchy over a snapshot of one section's triangles, for triangle accurate queries without cooked collision.
+*
+*	Built top down with binned SAH splits, with large subtrees built in parallel. A snapshot never changes once built,
+*	so any number of threads can query it while the section it came from keeps changing. Position only updates are
+*	handled by refitting a copy of the tree instead of rebuilding it.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshBVH
+{
+public:
+	/* Most triangles in a leaf */
+	static const int32 MaxLeafTriangles = 4;
+
+	/* Number of SAH bins per axis */
+	static const int32 NumBins = 16;
+
+	/* Subtrees with at least this many triangles build their children in parallel */
+	static const int32 ParallelBuildThreshold = 16384;
+
+	/* Builds a tree over the section's geometry. UVs can be empty. */
+	FRuntimeMeshBVH(int32 InSectionIndex, TArray<FVector>&& InPositions, const TArray<int32>& InIndices, TArray<FVector2D>&& InUVs);
+
+	/* Copies a tree with new positions and UVs for the same triangles, refitting the bounds */
+	FRuntimeMeshBVH(const FRuntimeMeshBVH& Source, TArray<FVector>&& InPositions, TArray<FVector2D>&& InUVs);
+
+	int32 GetSectionIndex() const { return SectionIndex; }
+	int32 GetNumVertices() const { return Positions.Num(); }
+	int32 GetNumTriangles() const { return Indices.Num() / 3; }
+
+	const TArray<FVector>& GetPositions() const { return Positions; }
+	const TArray<int32>& GetIndices() const { return Indices; }
+
+	/* Bounds of every triangle in the tree */
+	FBox GetBounds() const;
+
+	/* Finds the closest triangle hit by the segment from Start to End. Both sides of triangles are hit. */
+	bool RayCast(const FVector& Start, const FVector& End, FRuntimeMeshQueryHit& OutHit) const;
+
+	/* Finds every triangle touching a sphere. Each hit holds the closest point of its triangle to the center. */
+	bool OverlapSphere(const FVector& Center, float Radius, TArray<FRuntimeMeshQueryHit>& OutHits) const;
+
+	/* Finds every triangle touching a box. Each hit holds the closest point of its triangle to the box center. */
+	bool OverlapBox(const FBox& Box, TArray<FRuntimeMeshQueryHit>& OutHits) const;
+
+	/* Finds the closest point on any triangle to Point, ignoring triangles further than MaxDistance */
+	bool GetClosestPoint(const FVector& Point, float MaxDistance, FRuntimeMeshQueryHit& OutHit) const;
+
+	/* Appends every triangle whose bounds overlap Box. Cheaper than OverlapBox when the exact test is done by the caller. */
+	void GetTrianglesInBox(const FBox& Box, TArray<int32>& OutTriangles) const;
+
+	/* Is Point inside the mesh, by the number of times rays from it cross the surface. Only meaningful for closed meshes. */
+	bool IsPointInside(const FVector& Point) const;
+
+private:
+	/* Node of the tree. The left child of an interior node always directly follows it. */
+	struct FNode
+	{
+		FVector Min;
+		/* First entry in TriangleOrder for leaves, index of the right child for interior nodes */
+		int32 Start;
+		FVector Max;
+		/* Number of triangles for leaves, 0 for interior nodes and INDEX_NONE for unused nodes */
+		int32 Count;
+	};
+
+	int32 SectionIndex;
+
+	TArray<FVector> Positions;
+	TArray<int32> Indices;
+	TArray<FVector2D> UVs;
+
+	/* Triangles in leaf order */
+	TArray<int32> TriangleOrder;
+
+	/* Nodes of a subtree over N triangles use at most the 2N - 1 slots after its root, so subtrees can be built independently */
+	TArray<FNode> Nodes;
+
+	void BuildNode(int32 NodeIndex, int32 Start, int32 Count, const TArray<FBox>& TriangleBounds, const TArray<FVector>& Centroids);
+	void Refit();
+
+	void GetTriangle(int32 Triangle, FVector& OutA, FVector& OutB, FVector& OutC) const;
+	void FillHit(int32 Triangle, const FVector& Position, const FVector& Barycentrics, float Distance, FRuntimeMeshQueryHit& OutHit) const;
+
+	/* Visits the triangles of every leaf whose bounds overlap Box */
+	void ForEachTriangleInBox(const FBox& Box, TFunctionRef<void(int32)> Func) const;
+
+	/* Counts the triangles crossed by a ray leaving the bounds. Returns false if the ray grazes an edge, so the count can't be trusted. */
+	bool CountRayCrossings(const FVector& Start, const FVector& Direction, int32& OutCrossings) const;
+};
+
+/* Shared pointer to an immutable tree snapshot, safe to pass to other threads */
+using FRuntimeMeshBVHPtr = TSharedPtr<const FRuntimeMeshBVH, ESPMode::ThreadSafe>;
@@ -0,0 +1,209 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "Commandlets/Commandlet.h"
+#include "RuntimeMeshComponent.h"
+#include "RuntimeMeshComponentPool.h"
+#include "RuntimeMeshBenchmark.generated.h"
+
+/* Workloads that the benchmark can run */
+UENUM(BlueprintType)
+enum class ERuntimeMeshBenchmarkScenario : uint8
+{
+	/* N components with M sections each using mixed update frequencies. Frequent sections are updated every frame. */
+	MixedFrequency UMETA(DisplayName = "Mixed Frequency"),
+	/* Dual buffer sections whose positions are animated every frame through UpdateMeshSectionPositionsImmediate. */
+	PositionAnimation UMETA(DisplayName = "Position Animation"),
+	/* Components are created and destroyed every frame to simulate chunk streaming. */
+	StreamingChurn UMETA(DisplayName = "Streaming Churn"),
+	/* All sections are updated every frame wrapped in BeginBatchUpdates/EndBatchUpdates. */
+	BatchUpdates UMETA(DisplayName = "Batch Updates"),
+	/* A single component subtracts a sphere from a sphere of BooleanTriangles triangles every frame. Not run by default, and only against the RMC. */
+	MeshBoolean UMETA(DisplayName = "Mesh Boolean"),
+	/* Streaming churn with components recycled through a URuntimeMeshComponentPool. Not run by default, and only against the RMC. */
+	PooledStreamingChurn UMETA(DisplayName = "Pooled Streaming Churn"),
+};
+
+/* Component type a scenario is run against */
+UENUM(BlueprintType)
+enum class ERuntimeMeshBenchmarkTarget : uint8
+{
+	RuntimeMesh UMETA(DisplayName = "Runtime Mesh Component"),
+	ProceduralMesh UMETA(DisplayName = "Procedural Mesh Component"),
+};
+
+/* Timings and memory recorded for a single scenario run */
+USTRUCT(BlueprintType)
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshBenchmarkResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	ERuntimeMeshBenchmarkScenario Scenario;
+
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	ERuntimeMeshBenchmarkTarget Target;
+
+	/* Number of measured frames */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	int32 NumFrames;
+
+	/* Average game thread time per frame, including end of frame render updates */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	float GameThreadMs;
+
+	/* Worst game thread frame */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	float GameThreadMaxMs;
+
+	/* Average time taken for the render thread to drain the commands issued by one frame */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	float RenderThreadMs;
+
+	/* Worst render thread frame */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	float RenderThreadMaxMs;
+
+	/* Process memory after the scenario was set up, relative to before it */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	float SetupMemoryMB;
+
+	/* Highest process memory seen during the run, relative to before it */
+	UPROPERTY(BlueprintReadOnly, Category = "RuntimeMesh|Benchmark")
+	float PeakMemoryMB;
+
+	FRuntimeMeshBenchmarkResult()
+		: Scenario(ERuntimeMeshBenchmarkScenario::MixedFrequency), Target(ERuntimeMeshBenchmarkTarget::RuntimeMesh), NumFrames(0)
+		, GameThreadMs(0), GameThreadMaxMs(0), RenderThreadMs(0), RenderThreadMaxMs(0), SetupMemoryMB(0), PeakMemoryMB(0)
+	{}
+
+	/* Header line matching ToCSV() */
+	static FString GetCSVHeader();
+
+	FString ToCSV() const;
+};
+
+/**
+*	Actor that runs scripted benchmark scenarios against the RMC and, optionally, the UProceduralMeshComponent.
+*	Drop it into an empty level to get a benchmark level, or let URuntimeMeshBenchmarkCommandlet drive it headless.
+*	Each frame is run synchronously: the scenario step and end of frame updates are timed on the game thread,
+*	then the rendering commands are flushed and timed as the render thread cost of that frame.
+*/
+UCLASS(NotBlueprintable)
+class RUNTIMEMESHCOMPONENT_API ARuntimeMeshBenchmarkActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARuntimeMeshBenchmarkActor(const FObjectInitializer& ObjectInitializer);
+
+	/* Scenarios to run */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	TArray<ERuntimeMeshBenchmarkScenario> Scenarios;
+
+	/* Number of components created per scenario */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 NumComponents;
+
+	/* Number of sections per component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 NumSectionsPerComponent;
+
+	/* Vertices per side of the grid used for every section */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "2"))
+	int32 GridSize;
+
+	/* Triangles in the sphere cut by the mesh boolean scenario */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "8"))
+	int32 BooleanTriangles;
+
+	/* Number of measured frames per scenario */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 NumFrames;
+
+	/* Also run every scenario against the UProceduralMeshComponent. Needs the module built with bBenchmarkAgainstProceduralMesh. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	bool bCompareWithProceduralMesh;
+
+	/* Run all scenarios as soon as play begins */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	bool bRunOnBeginPlay;
+
+	/* Results of the last run */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "Benchmark")
+	TArray<FRuntimeMeshBenchmarkResult> Results;
+
+	/* Runs every configured scenario against every target. Results are logged and written to Saved/RuntimeMeshBenchmark */
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	void RunAllScenarios();
+
+	/* Runs a single scenario against a single target */
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	FRuntimeMeshBenchmarkResult RunScenario(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target);
+
+	/* Writes the results of the last run as CSV to the supplied path, or Saved/RuntimeMeshBenchmark if none supplied */
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	bool SaveResults(const FString& FilePath = TEXT(""));
+
+	virtual void BeginPlay() override;
+
+private:
+	/* Why a scenario can't run against a target, or null if it can */
+	static const TCHAR* GetSkipReason(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target);
+
+	/* Creates a component of the target type with all sections */
+	UPrimitiveComponent* CreateBenchmarkComponent(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target, int32 ComponentIndex);
+
+	/* Destroys a component created by CreateBenchmarkComponent */
+	void DestroyBenchmarkComponent(UPrimitiveComponent* Component);
+
+	/* Runs the per frame work of a scenario */
+	void StepScenario(ERuntimeMeshBenchmarkScenario Scenario, ERuntimeMeshBenchmarkTarget Target, int32 Frame);
+
+	/* Generates the mesh data for a frame outside of the timed region */
+	void PrepareFrameData(int32 Frame);
+
+	/* Components alive for the current scenario */
+	UPROPERTY(Transient)
+	TArray<UPrimitiveComponent*> ActiveComponents;
+
+	/* Pool components are taken from and given back to while the pooled churn scenario runs */
+	UPROPERTY(Transient)
+	URuntimeMeshComponentPool* ComponentPool;
+
+	/* Next component index, used to offset components during churn */
+	int32 NextComponentIndex;
+
+	/* Shared mesh data used by every section. Regenerated every frame for animated scenarios. */
+	TArray<int32> Triangles;
+	TArray<FVector> Positions;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UVs;
+	TArray<FColor> Colors;
+	TArray<FRuntimeMeshVertexSimple> Vertices;
+	TArray<FRuntimeMeshVertexNoPosition> VertexData;
+
+	/* Spheres used by the mesh boolean scenario */
+	TArray<FRuntimeMeshVertexSimple> BooleanVertices;
+	TArray<int32> BooleanIndices;
+	TArray<FRuntimeMeshVertexSimple> BrushVertices;
+	TArray<int32> BrushIndices;
+};
+
+/**
+*	Runs the RMC benchmark scenarios headless.
+*	Usage: UE4Editor-Cmd.exe <Project> -run=RuntimeMeshBenchmark [-Components=N] [-Sections=M] [-Grid=G] [-Frames=F]
+*		[-Scenario=MixedFrequency|PositionAnimation|StreamingChurn|BatchUpdates|MeshBoolean|PooledStreamingChurn] [-BooleanTriangles=T] [-NoPMC] [-Output=<Path.csv>]
+*/
+UCLASS()
+class RUNTIMEMESHCOMPONENT_API URuntimeMeshBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URuntimeMeshBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	virtual int32 Main(const FString& Params) override;
+};
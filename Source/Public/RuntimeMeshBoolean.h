@@ -0,0 +1,248 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshCore.h"
+#include "RuntimeMeshBVH.h"
+#include "Async/ParallelFor.h"
+#include "RuntimeMeshBoolean.generated.h"
+
+/* Boolean operations between two closed meshes */
+UENUM(BlueprintType)
+enum class ERuntimeMeshBooleanOperation : uint8
+{
+	/* Everything inside either mesh */
+	Union,
+	/* The first mesh with the second carved out of it */
+	Subtract,
+	/* Only what's inside both meshes */
+	Intersect,
+};
+
+/**
+*	The part of one mesh a boolean keeps, after cutting its triangles along the other mesh's surface.
+*	New vertices are described by the triangle they came from and the weights of its corners, so the
+*	result can be built for any vertex type.
+*/
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshBooleanCut
+{
+	/* Triangles kept whole */
+	TArray<int32> WholeTriangles;
+
+	/* Position, source triangle and corner weights of every new vertex */
+	TArray<FVector> NewPositions;
+	TArray<int32> NewSourceTriangles;
+	TArray<FVector> NewBarycentrics;
+
+	/* Vertex of the mesh each new vertex is, for corners of cut triangles, or INDEX_NONE. These reuse the original vertex. */
+	TArray<int32> NewSourceVertices;
+
+	/* Triangles over the new vertices */
+	TArray<int32> NewTriangles;
+
+	/* Should the kept surface be turned inside out, as for the mesh being subtracted */
+	bool bFlip;
+
+	FRuntimeMeshBooleanCut() : bFlip(false) { }
+};
+
+/* Vertices added to close the seam between the two operands of a boolean, appended to the result in this order */
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshBooleanSeam
+{
+	/* The three result vertices each new vertex blends, and their weights */
+	TArray<int32> NewSourceVertices;
+	TArray<FVector> NewBarycentrics;
+};
+
+/**
+*	Mesh booleans on BVH snapshots of closed meshes.
+*
+*	Each triangle is split into convex pieces by the other mesh's triangles that actually cross it, found through the
+*	other mesh's BVH. A cut only splits the pieces the cutting triangle reaches, so every piece lies entirely inside or
+*	outside the other mesh without cuts spreading across the rest of the triangle. Pieces are then classified by
+*	casting rays against the other BVH. Pieces lying on the other surface are kept from the first mesh only, when
+*	the surfaces face the way the operation needs. Triangles are processed in parallel chunks.
+*
+*	The result stays welded so it can be cut again. Corners of cut triangles are the original vertices, vertices on an
+*	edge are shared with the triangle across it, and the vertices neighboring pieces have along each other's edges are
+*	added before the pieces are triangulated, so there are no T-junctions. WeldSeam() then closes the seam between the
+*	two operands the same way.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshBoolean
+{
+public:
+	/* Triangles handled by each parallel task */
+	static const int32 TrianglesPerTask = 1024;
+
+	/* Points closer than this to a cutting plane count as on it */
+	static const float PlaneTolerance;
+
+	/* Pieces closer than this to a parallel triangle of the other mesh count as lying on its surface */
+	static const float CoplanarTolerance;
+
+	/**
+	*	Cuts the triangles of Mesh along the surface of Other, keeping what the operation needs.
+	*	@param	bIsFirstOperand		Is Mesh the first operand, which decides which side is kept for Subtract
+	*/
+	static void Cut(const FRuntimeMeshBVH& Mesh, const FRuntimeMeshBVH& Other, ERuntimeMeshBooleanOperation Operation, bool bIsFirstOperand, FRuntimeMeshBooleanCut& OutCut);
+
+	/**
+	*	Closes the seam between the two operands of a result, where the kept surface of each ends. Seam vertices within
+	*	PlaneTolerance are moved together, then each seam edge gets a vertex wherever the other operand has one along it and
+	*	its triangle is split, so the seam has no T-junctions. Vertices stay split across the seam, as their attributes come
+	*	from different meshes.
+	*	@param	FirstOtherTriangle	First triangle of the second operand in Triangles
+	*	@out	OutSeam				The vertices appended to Positions, for building them for any vertex type
+	*/
+	static void WeldSeam(int32 FirstOtherTriangle, TArray<FVector>& Positions, TArray<int32>& Triangles, FRuntimeMeshBooleanSeam& OutSeam);
+};
+
+/* Builds the vertices and triangles of a boolean from the cuts of both operands */
+template<typename VertexType>
+class TRuntimeMeshBoolean
+{
+public:
+	typedef FRuntimeMeshVertexInterpolator<VertexType> Interpolator;
+
+	/* Vertices interpolated by each parallel task */
+	static const int32 VerticesPerTask = 4096;
+
+	/**
+	*	Appends what one operand keeps to the result.
+	*	@param	Vertices	Vertices of the operand, matching the positions in Mesh
+	*	@param	Mesh		Snapshot of the operand the cut was made from
+	*	@param	Cut			What the boolean keeps of the operand
+	*/
+	static void Append(const TArray<VertexType>& Vertices, const FRuntimeMeshBVH& Mesh, const FRuntimeMeshBooleanCut& Cut,
+		TArray<FVector>& OutPositions, TArray<VertexType>& OutVertices, TArray<int32>& OutTriangles, FBox& OutBoundingBox)
+	{
+		const TArray<FVector>& Positions = Mesh.GetPositions();
+		const TArray<int32>& Indices = Mesh.GetIndices();
+		check(Vertices.Num() == Positions.Num());
+
+		// Whole triangles keep their original vertices, added in the order they're first used
+		TArray<int32> Remap;
+		Remap.Init(INDEX_NONE, Vertices.Num());
+		TArray<int32> KeptVertices;
+		const int32 FirstTriangle = OutTriangles.Num();
+		OutTriangles.Reserve(FirstTriangle + Cut.WholeTriangles.Num() * 3 + Cut.NewTriangles.Num());
+
+		for (int32 Triangle : Cut.WholeTriangles)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const int32 Vertex = Indices[Triangle * 3 + (Cut.bFlip ? 2 - Corner : Corner)];
+				if (Remap[Vertex] == INDEX_NONE)
+				{
+					Remap[Vertex] = OutVertices.Num() + KeptVertices.Add(Vertex);
+				}
+				OutTriangles.Add(Remap[Vertex]);
+			}
+		}
+
+		// Corners of cut triangles are original vertices too, which keeps the cut pieces welded to the whole triangles
+		TArray<int32> NewRemap;
+		TArray<int32> CreatedVertices;
+		NewRemap.SetNumUninitialized(Cut.NewPositions.Num());
+		for (int32 Index = 0; Index < Cut.NewPositions.Num(); Index++)
+		{
+			const int32 Vertex = Cut.NewSourceVertices[Index];
+			if (Vertex == INDEX_NONE)
+			{
+				NewRemap[Index] = INDEX_NONE;
+				CreatedVertices.Add(Index);
+				continue;
+			}
+
+			if (Remap[Vertex] == INDEX_NONE)
+			{
+				Remap[Vertex] = OutVertices.Num() + KeptVertices.Add(Vertex);
+			}
+			NewRemap[Index] = Remap[Vertex];
+		}
+
+		const int32 FirstKeptVertex = OutVertices.Num();
+		const int32 FirstNewVertex = FirstKeptVertex + KeptVertices.Num();
+		for (int32 Index = 0; Index < CreatedVertices.Num(); Index++)
+		{
+			NewRemap[CreatedVertices[Index]] = FirstNewVertex + Index;
+		}
+		OutPositions.SetNumUninitialized(FirstNewVertex + CreatedVertices.Num());
+		OutVertices.SetNumUninitialized(FirstNewVertex + CreatedVertices.Num());
+
+		ParallelFor(FMath::DivideAndRoundUp<int32>(KeptVertices.Num(), VerticesPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(KeptVertices.Num(), (TaskIndex + 1) * VerticesPerTask);
+			for (int32 Index = TaskIndex * VerticesPerTask; Index < End; Index++)
+			{
+				const int32 Vertex = KeptVertices[Index];
+				OutPositions[FirstKeptVertex + Index] = Positions[Vertex];
+				OutVertices[FirstKeptVertex + Index] = Cut.bFlip ? Interpolator::Flip(Vertices[Vertex]) : Vertices[Vertex];
+			}
+		});
+
+		// New vertices blend the corners of the triangle they came from
+		ParallelFor(FMath::DivideAndRoundUp<int32>(CreatedVertices.Num(), VerticesPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(CreatedVertices.Num(), (TaskIndex + 1) * VerticesPerTask);
+			for (int32 Index = TaskIndex * VerticesPerTask; Index < End; Index++)
+			{
+				const int32 NewVertex = CreatedVertices[Index];
+				const int32 Triangle = Cut.NewSourceTriangles[NewVertex];
+				const FVector& Weights = Cut.NewBarycentrics[NewVertex];
+				const VertexType Blended = Blend(Vertices[Indices[Triangle * 3 + 0]], Vertices[Indices[Triangle * 3 + 1]], Vertices[Indices[Triangle * 3 + 2]], Weights);
+
+				OutPositions[FirstNewVertex + Index] = Cut.NewPositions[NewVertex];
+				OutVertices[FirstNewVertex + Index] = Cut.bFlip ? Interpolator::Flip(Blended) : Blended;
+			}
+		});
+
+		for (int32 Index = 0; Index < Cut.NewTriangles.Num(); Index += 3)
+		{
+			OutTriangles.Add(NewRemap[Cut.NewTriangles[Index]]);
+			OutTriangles.Add(NewRemap[Cut.NewTriangles[Index + (Cut.bFlip ? 2 : 1)]]);
+			OutTriangles.Add(NewRemap[Cut.NewTriangles[Index + (Cut.bFlip ? 1 : 2)]]);
+		}
+
+		for (int32 Index = FirstKeptVertex; Index < OutPositions.Num(); Index++)
+		{
+			OutBoundingBox += OutPositions[Index];
+		}
+	}
+
+	/**
+	*	Closes the seam between the two operands once both are appended, see FRuntimeMeshBoolean::WeldSeam().
+	*	@param	FirstOtherTriangle	First triangle appended for the second operand
+	*/
+	static void WeldSeam(int32 FirstOtherTriangle, TArray<FVector>& Positions, TArray<VertexType>& Vertices, TArray<int32>& Triangles)
+	{
+		FRuntimeMeshBooleanSeam Seam;
+		FRuntimeMeshBoolean::WeldSeam(FirstOtherTriangle, Positions, Triangles, Seam);
+
+		const int32 FirstNewVertex = Vertices.Num();
+		const int32 NumNewVertices = Seam.NewBarycentrics.Num();
+		check(Positions.Num() == FirstNewVertex + NumNewVertices);
+		Vertices.SetNumUninitialized(FirstNewVertex + NumNewVertices);
+
+		ParallelFor(FMath::DivideAndRoundUp<int32>(NumNewVertices, VerticesPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(NumNewVertices, (TaskIndex + 1) * VerticesPerTask);
+			for (int32 Index = TaskIndex * VerticesPerTask; Index < End; Index++)
+			{
+				const int32* Sources = &Seam.NewSourceVertices[Index * 3];
+				Vertices[FirstNewVertex + Index] = Blend(Vertices[Sources[0]], Vertices[Sources[1]], Vertices[Sources[2]], Seam.NewBarycentrics[Index]);
+			}
+		});
+	}
+
+private:
+	/* Blends the corners of a triangle by their weights */
+	static VertexType Blend(const VertexType& A, const VertexType& B, const VertexType& C, const FVector& Weights)
+	{
+		const float WeightAB = Weights.X + Weights.Y;
+		return WeightAB > SMALL_NUMBER
+			? Interpolator::Lerp(Interpolator::Lerp(A, B, Weights.Y / WeightAB), C, Weights.Z)
+			: C;
+	}
+};
@@ -0,0 +1,146 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshProfiling.h"
+
+/* Memory limits for the update buffer pools, shared by every section */
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshBufferPoolBudget
+{
+public:
+	/* Most memory all pools together keep for reuse */
+	static int32 MaxTotalPooledBytes;
+
+	/* Most memory a single pool keeps for reuse */
+	static int32 MaxPoolBytes;
+
+	/* Reserves room for an array in the global budget. Returns false if it would go over. */
+	static bool TryReserve(int32 Bytes);
+
+	/* Gives back room reserved with TryReserve */
+	static void Release(int32 Bytes);
+
+	static int32 GetTotalPooledBytes() { return TotalPooledBytes.GetValue(); }
+
+private:
+	static FThreadSafeCounter TotalPooledBytes;
+};
+
+/**
+*	Thread safe free lists of arrays of one element type, bucketed by capacity.
+*	The game thread takes arrays to fill command buffers with, and the render thread gives them back once the data is uploaded,
+*	so frequent updates reuse the same allocations instead of allocating and freeing them every frame.
+*	Bucket N holds arrays with a capacity of 2^N to 2^(N+1)-1 elements, so finding one only looks at a couple of buckets.
+*/
+template<typename ElementType>
+class TRuntimeMeshArrayPool
+{
+public:
+	TRuntimeMeshArrayPool() : PooledBytes(0) { }
+
+	~TRuntimeMeshArrayPool()
+	{
+		FRuntimeMeshBufferPoolBudget::Release(PooledBytes);
+	}
+
+	/* Copies Num elements into an empty array, reusing a pooled array that can hold them */
+	void CopyToPooledArray(TArray<ElementType>& OutArray, const ElementType* Data, int32 Num)
+	{
+		if (Num > 0)
+		{
+			Acquire(OutArray, Num);
+			OutArray.Append(Data, Num);
+		}
+	}
+
+	/* Gives an empty array a pooled allocation that can hold Num elements, or allocates one */
+	void Acquire(TArray<ElementType>& OutArray, int32 Num)
+	{
+		check(OutArray.Num() == 0);
+
+		if (Num > 0)
+		{
+			FScopeLock Lock(&CriticalSection);
+
+			// Arrays in Num's own bucket might be too small, the ones in the next buckets never are. Going further up would waste too much.
+			const int32 FirstBucket = GetBucket(Num);
+			const int32 LastBucket = FMath::Min<int32>(FirstBucket + 2, NumBuckets - 1);
+
+			int32 FoundBucket = INDEX_NONE;
+			int32 FoundIndex = INDEX_NONE;
+			for (int32 Bucket = FirstBucket; Bucket <= LastBucket && FoundBucket == INDEX_NONE; Bucket++)
+			{
+				TArray<TArray<ElementType>>& FreeArrays = Buckets[Bucket];
+				for (int32 Index = FreeArrays.Num() - 1; Index >= 0; Index--)
+				{
+					if (FreeArrays[Index].Max() >= Num)
+					{
+						FoundBucket = Bucket;
+						FoundIndex = Index;
+						break;
+					}
+				}
+			}
+
+			if (FoundBucket != INDEX_NONE)
+			{
+				TArray<TArray<ElementType>>& FreeArrays = Buckets[FoundBucket];
+				const int32 Bytes = FreeArrays[FoundIndex].GetAllocatedSize();
+				OutArray = MoveTemp(FreeArrays[FoundIndex]);
+				FreeArrays.RemoveAtSwap(FoundIndex, 1, false);
+				PooledBytes -= Bytes;
+				FRuntimeMeshBufferPoolBudget::Release(Bytes);
+				INC_DWORD_STAT(STAT_RuntimeMesh_UpdateBufferPoolHits);
+			}
+			else
+			{
+				INC_DWORD_STAT(STAT_RuntimeMesh_UpdateBufferPoolMisses);
+			}
+		}
+
+		OutArray.Reserve(Num);
+	}
+
+	/* Takes the allocation of an array for reuse. The array is left empty. Arrays that don't fit in the budget are freed. */
+	void Release(TArray<ElementType>& Array)
+	{
+		const int32 Bytes = Array.GetAllocatedSize();
+		if (Bytes == 0)
+		{
+			return;
+		}
+
+		Array.Reset();
+
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (PooledBytes + Bytes <= FRuntimeMeshBufferPoolBudget::MaxPoolBytes && FRuntimeMeshBufferPoolBudget::TryReserve(Bytes))
+			{
+				Buckets[GetBucket(Array.Max())].Add(MoveTemp(Array));
+				PooledBytes += Bytes;
+				return;
+			}
+		}
+
+		Array.Empty();
+	}
+
+private:
+	enum { NumBuckets = 32 };
+
+	static int32 GetBucket(int32 Num)
+	{
+		return FMath::FloorLog2((uint32)Num);
+	}
+
+	FCriticalSection CriticalSection;
+	TArray<TArray<ElementType>> Buckets[NumBuckets];
+
+	/* Memory held by the buckets */
+	int32 PooledBytes;
+};
+
+/* Pool of the update arrays of one section, or the command streams of one component. Command buffers in flight share it to give their arrays back. */
+typedef TRuntimeMeshArrayPool<uint8> FRuntimeMeshBufferPool;
+typedef TSharedPtr<FRuntimeMeshBufferPool, ESPMode::ThreadSafe> FRuntimeMeshBufferPoolPtr;
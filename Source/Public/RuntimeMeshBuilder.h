@@ -4,95 +4,430 @@
 
 #include "RuntimeMeshComponent.h"
 
-//////////////////////////////////////////////////////////////////////////
-//	This feature in development. Not usable yet.
-//////////////////////////////////////////////////////////////////////////
-
+namespace RuntimeMeshBuilderInternal
+{
+	template<typename VertexType>
+	static typename TEnableIf<FRuntimeMeshVertexTraits<VertexType>::HasPositionComponent>::Type
+		SetPosition(TArray<VertexType>& Vertices, TArray<FVector>& Positions, int32 Index, const FVector& InPosition)
+	{
+		Vertices[Index].Position = InPosition;
+	}
+
+	template<typename VertexType>
+	static typename TEnableIf<!FRuntimeMeshVertexTraits<VertexType>::HasPositionComponent>::Type
+		SetPosition(TArray<VertexType>& Vertices, TArray<FVector>& Positions, int32 Index, const FVector& InPosition)
+	{
+		Positions[Index] = InPosition;
+	}
+
+	template<typename VertexType>
+	static typename TEnableIf<FRuntimeMeshVertexTraits<VertexType>::HasPositionComponent, const FVector&>::Type
+		GetPosition(const TArray<VertexType>& Vertices, const TArray<FVector>& Positions, int32 Index)
+	{
+		return Vertices[Index].Position;
+	}
+
+	template<typename VertexType>
+	static typename TEnableIf<!FRuntimeMeshVertexTraits<VertexType>::HasPositionComponent, const FVector&>::Type
+		GetPosition(const TArray<VertexType>& Vertices, const TArray<FVector>& Positions, int32 Index)
+	{
+		return Positions[Index];
+	}
+}
+
+/**
+*	Cursor style writer for building a mesh section without intermediate arrays.
+*
+*	The builder writes directly into storage laid out the same as a section's VertexBuffer, PositionVertexBuffer (for vertex
+*	types without a position component) and IndexBuffer. Storage grows ahead of the cursor so streaming data in doesn't
+*	reallocate per vertex, and seeking back lets you rewrite part of the mesh in place. When done, the storage is moved into
+*	the component through CreateMeshSection()/UpdateMeshSection().
+*
+*	Example:
+*		FRuntimeMeshBuilder<FRuntimeMeshVertexSimple> Mesh(3, 1);
+*
+*		// Create 3 vertices setting position, normal, and UV0
+*		int32 Vertex1 = Mesh.SetVertex(FVector(0, 0, 0));
+*		Mesh.SetNormal(FVector(1, 0, 0));
+*		Mesh.SetUV(0, FVector2D(0, 0));
+*		Mesh.MoveNext();
+*		...
+*		Mesh.AddTriangle(Vertex1, Vertex2, Vertex3);
+*
+*		// Update the first vertex position, leaving everything else the same
+*		Mesh.SeekVertices(0);
+*		Mesh.SetPosition(FVector(5, 5, 5));
+*
+*		Mesh.CreateMeshSection(RuntimeMeshComponent, 0);
+*/
 template<typename VertexType>
 class FRuntimeMeshBuilder
 {
 public:
-	int32 SetVertex(const VertexType& InVertex);
-	int32 SetVertex(const FVector& InPosition);
-	int32 SetVertex(const FVector& InPosition, const FColor& InColor);
-	int32 SetVertex(const FVector& InPosition, const FVector2D& InUV0);
-	int32 SetVertex(const FVector& InPosition, const FVector& InNormal, const FRuntimeMeshTangent& InTangent, const FColor& InColor, const FVector2D& InUV0);
+	typedef FRuntimeMeshVertexTraits<VertexType> VertexTraits;
+
+	FRuntimeMeshBuilder(int32 InitialVertexCapacity = 0, int32 InitialTriangleCapacity = 0)
+		: VertexCursor(0), IndexCursor(0)
+	{
+		Reserve(InitialVertexCapacity, InitialTriangleCapacity);
+	}
+
+	/* Is the position stored in a separate buffer, and so committed as a dual buffer section */
+	static bool IsDualBuffer() { return !VertexTraits::HasPositionComponent; }
+
+	int32 NumVertices() const { return Vertices.Num(); }
+	int32 NumTriangles() const { return Triangles.Num() / 3; }
+
+	/* Index of the vertex the setters currently write to */
+	int32 GetVertexPosition() const { return VertexCursor; }
+
+	/* Index of the triangle the next AddTriangle() writes to */
+	int32 GetTrianglePosition() const { return IndexCursor / 3; }
+
+	/* Makes sure the storage can hold this many vertices and triangles without reallocating */
+	void Reserve(int32 VertexCapacity, int32 TriangleCapacity)
+	{
+		Vertices.Reserve(VertexCapacity);
+		if (IsDualBuffer())
+		{
+			Positions.Reserve(VertexCapacity);
+		}
+		Triangles.Reserve(TriangleCapacity * 3);
+	}
+
+	/* Empties the builder and rewinds both cursors. Storage is kept for reuse unless told otherwise. */
+	void Reset(bool bKeepStorage = true)
+	{
+		if (bKeepStorage)
+		{
+			Vertices.Reset();
+			Positions.Reset();
+			Triangles.Reset();
+		}
+		else
+		{
+			Vertices.Empty();
+			Positions.Empty();
+			Triangles.Empty();
+		}
+		VertexCursor = 0;
+		IndexCursor = 0;
+	}
+
+
+	/* Writes a full vertex at the cursor. Returns the vertex index. */
+	int32 SetVertex(const VertexType& InVertex)
+	{
+		EnsureVertex();
+		Vertices[VertexCursor] = InVertex;
+		return VertexCursor;
+	}
+	int32 SetVertex(const FVector& InPosition)
+	{
+		ResetVertex();
+		SetPosition(InPosition);
+		return VertexCursor;
+	}
+	int32 SetVertex(const FVector& InPosition, const FColor& InColor)
+	{
+		ResetVertex();
+		SetPosition(InPosition);
+		SetColor(InColor);
+		return VertexCursor;
+	}
+	int32 SetVertex(const FVector& InPosition, const FVector2D& InUV0)
+	{
+		ResetVertex();
+		SetPosition(InPosition);
+		SetUV(0, InUV0);
+		return VertexCursor;
+	}
+	int32 SetVertex(const FVector& InPosition, const FVector& InNormal, const FRuntimeMeshTangent& InTangent, const FColor& InColor, const FVector2D& InUV0)
+	{
+		ResetVertex();
+		SetPosition(InPosition);
+		SetNormal(InNormal);
+		SetTangent(InTangent);
+		SetColor(InColor);
+		SetUV(0, InUV0);
+		return VertexCursor;
+	}
 	int32 SetVertex(const FVector& InPosition, const FVector& InTangentX, const FVector& InTangentY, const FVector& InTangentZ,
-		const FColor& InColor, const FVector2D& InUV0);
-
-
-	void SetPosition(const FVector& InPosition);
-	void SetNormal(const FVector& InNormal);
-	void SetTangent(const FRuntimeMeshTangent& InTangent);
-	void SetTangents(const FVector& InTangentX, const FVector& InTangentY, const FVector& InTangentZ);
-	void SetColor(const FColor& InColor);
-	void SetUV(int32 Channel, const FVector2D& UV);
-
-
-	void MoveNext();
-
-
-	int32 AddTriangle(int32 V0, int32 V1, int32 V2);
-
-	int32 AddVertices(const TArray<VertexType>& Vertices);
-	int32 AddTriangles(const TArray<int32>& Triangles);
-
-	void SeekVertices(int32 StreamPosition);
-	void SeekTriangles(int32 StreamPosition);
-
-
-	
-
-
-
-
-
-
-
-
+		const FColor& InColor, const FVector2D& InUV0)
+	{
+		ResetVertex();
+		SetPosition(InPosition);
+		SetTangents(InTangentX, InTangentY, InTangentZ);
+		SetColor(InColor);
+		SetUV(0, InUV0);
+		return VertexCursor;
+	}
+
+
+	/* Setters for the components of the vertex at the cursor. Anything not set keeps its current value. */
+	void SetPosition(const FVector& InPosition)
+	{
+		EnsureVertex();
+		RuntimeMeshBuilderInternal::SetPosition(Vertices, Positions, VertexCursor, InPosition);
+	}
+	void SetNormal(const FVector& InNormal)
+	{
+		EnsureVertex();
+		FPackedNormal& Normal = Vertices[VertexCursor].Normal;
+
+		// Keep the tangent basis sign stored in W
+		uint8 BasisSign = Normal.Vector.W;
+		Normal = InNormal;
+		Normal.Vector.W = BasisSign;
+	}
+	void SetTangent(const FRuntimeMeshTangent& InTangent)
+	{
+		EnsureVertex();
+		VertexType& Vertex = Vertices[VertexCursor];
+		Vertex.Tangent = InTangent.TangentX;
+		InTangent.AdjustNormal(Vertex.Normal);
+	}
+	void SetTangents(const FVector& InTangentX, const FVector& InTangentY, const FVector& InTangentZ)
+	{
+		EnsureVertex();
+		Vertices[VertexCursor].SetNormalAndTangent(InTangentX, InTangentY, InTangentZ);
+	}
+	void SetColor(const FColor& InColor)
+	{
+		EnsureVertex();
+		Vertices[VertexCursor].Color = InColor;
+	}
+	void SetUV(int32 Channel, const FVector2D& UV)
+	{
+		check(Channel >= 0 && Channel < VertexTraits::NumUVChannels);
+		EnsureVertex();
+		RuntimeMeshVertexInternal::SetUV(Vertices[VertexCursor], Channel, UV);
+	}
+
+	/* Position of a vertex already written */
+	const FVector& GetPosition(int32 VertexIndex) const
+	{
+		return RuntimeMeshBuilderInternal::GetPosition(Vertices, Positions, VertexIndex);
+	}
+
+	/* Direct access to a vertex already written */
+	VertexType& GetVertex(int32 VertexIndex) { return Vertices[VertexIndex]; }
+	const VertexType& GetVertex(int32 VertexIndex) const { return Vertices[VertexIndex]; }
+
+
+	/* Advances the cursor to the next vertex */
+	void MoveNext()
+	{
+		EnsureVertex();
+		VertexCursor++;
+	}
+
+
+	/* Writes a triangle at the triangle cursor and advances it. Returns the triangle index. */
+	int32 AddTriangle(int32 V0, int32 V1, int32 V2)
+	{
+		if (IndexCursor == Triangles.Num())
+		{
+			GrowTriangles(1);
+			Triangles.AddUninitialized(3);
+		}
+
+		Triangles[IndexCursor + 0] = V0;
+		Triangles[IndexCursor + 1] = V1;
+		Triangles[IndexCursor + 2] = V2;
+		IndexCursor += 3;
+		return IndexCursor / 3 - 1;
+	}
+
+	/* Appends vertices after the last vertex, leaving the cursor after them. Returns the index of the first new vertex. */
+	int32 AddVertices(const TArray<VertexType>& InVertices)
+	{
+		int32 FirstVertex = Vertices.Num();
+		GrowVertices(InVertices.Num());
+		Vertices.Append(InVertices);
+		if (IsDualBuffer())
+		{
+			Positions.AddZeroed(InVertices.Num());
+		}
+		VertexCursor = Vertices.Num();
+		return FirstVertex;
+	}
+
+	/* Appends triangles after the last triangle, leaving the triangle cursor after them. Returns the index of the first new triangle. */
+	int32 AddTriangles(const TArray<int32>& InTriangles)
+	{
+		check(InTriangles.Num() % 3 == 0);
+		int32 FirstTriangle = Triangles.Num() / 3;
+		GrowTriangles(InTriangles.Num() / 3);
+		Triangles.Append(InTriangles);
+		IndexCursor = Triangles.Num();
+		return FirstTriangle;
+	}
+
+	/* Moves the vertex cursor. Seeking to an existing vertex allows it to be rewritten in place. */
+	void SeekVertices(int32 StreamPosition)
+	{
+		check(StreamPosition >= 0 && StreamPosition <= Vertices.Num());
+		VertexCursor = StreamPosition;
+	}
+
+	/* Moves the triangle cursor. Seeking to an existing triangle allows it to be rewritten in place. */
+	void SeekTriangles(int32 StreamPosition)
+	{
+		check(StreamPosition >= 0 && StreamPosition * 3 <= Triangles.Num());
+		IndexCursor = StreamPosition * 3;
+	}
+
+	/* Drops every vertex at or after the vertex cursor */
+	void TruncateVertices()
+	{
+		Vertices.SetNum(VertexCursor, false);
+		if (IsDualBuffer())
+		{
+			Positions.SetNum(VertexCursor, false);
+		}
+	}
+
+	/* Drops every triangle at or after the triangle cursor */
+	void TruncateTriangles()
+	{
+		Triangles.SetNum(IndexCursor, false);
+	}
+
+
+	/**
+	*	Creates/replaces a section on the component from the builder.
+	*	Unless bKeepData is set the storage is moved into the section and the builder is left empty.
+	*/
+	void CreateMeshSection(URuntimeMeshComponent* Component, int32 SectionIndex, bool bCreateCollision = false,
+		EUpdateFrequency UpdateFrequency = EUpdateFrequency::Average, bool bKeepData = false)
+	{
+		check(Component);
+		ESectionUpdateFlags UpdateFlags = bKeepData ? ESectionUpdateFlags::None : ESectionUpdateFlags::MoveArrays;
+		CommitCreate(Component, SectionIndex, bCreateCollision, UpdateFrequency, UpdateFlags);
+		FinishCommit(bKeepData);
+	}
+
+	/**
+	*	Updates an existing section on the component from the builder.
+	*	Unless bKeepData is set the storage is moved into the section and the builder is left empty.
+	*/
+	void UpdateMeshSection(URuntimeMeshComponent* Component, int32 SectionIndex, bool bUpdateTriangles = true, bool bKeepData = false)
+	{
+		check(Component);
+		ESectionUpdateFlags UpdateFlags = bKeepData ? ESectionUpdateFlags::None : ESectionUpdateFlags::MoveArrays;
+		CommitUpdate(Component, SectionIndex, bUpdateTriangles, UpdateFlags);
+		FinishCommit(bKeepData);
+	}
+
+private:
+	/* Vertex storage, matching FRuntimeMeshSection::VertexBuffer */
+	TArray<VertexType> Vertices;
+
+	/* Position storage for vertex types without a position, matching FRuntimeMeshSectionInterface::PositionVertexBuffer */
+	TArray<FVector> Positions;
+
+	/* Index storage, matching FRuntimeMeshSectionInterface::IndexBuffer */
+	TArray<int32> Triangles;
+
+	/* Current vertex */
+	int32 VertexCursor;
+
+	/* Current index into Triangles */
+	int32 IndexCursor;
+
+	/* Grows the storage ahead of the write so that appending many elements doesn't reallocate each time */
+	void GrowVertices(int32 Count)
+	{
+		int32 Required = Vertices.Num() + Count;
+		if (Required > Vertices.Max())
+		{
+			int32 NewCapacity = FMath::Max3(Required, Vertices.Max() * 2, 64);
+			Vertices.Reserve(NewCapacity);
+			if (IsDualBuffer())
+			{
+				Positions.Reserve(NewCapacity);
+			}
+		}
+	}
+
+	void GrowTriangles(int32 Count)
+	{
+		int32 Required = Triangles.Num() + Count * 3;
+		if (Required > Triangles.Max())
+		{
+			Triangles.Reserve(FMath::Max3(Required, Triangles.Max() * 2, 192));
+		}
+	}
+
+	/* Makes sure the vertex at the cursor exists */
+	void EnsureVertex()
+	{
+		if (VertexCursor == Vertices.Num())
+		{
+			GrowVertices(1);
+			Vertices.Add(VertexType());
+			if (IsDualBuffer())
+			{
+				Positions.Add(FVector::ZeroVector);
+			}
+		}
+	}
+
+	/* Makes sure the vertex at the cursor exists and sets it back to defaults */
+	void ResetVertex()
+	{
+		EnsureVertex();
+		Vertices[VertexCursor] = VertexType();
+	}
+
+	void FinishCommit(bool bKeepData)
+	{
+		if (!bKeepData)
+		{
+			Reset(false);
+		}
+	}
+
+	template<typename Type = VertexType>
+	typename TEnableIf<FRuntimeMeshVertexTraits<Type>::HasPositionComponent>::Type
+		CommitCreate(URuntimeMeshComponent* Component, int32 SectionIndex, bool bCreateCollision, EUpdateFrequency UpdateFrequency, ESectionUpdateFlags UpdateFlags)
+	{
+		Component->CreateMeshSection(SectionIndex, Vertices, Triangles, bCreateCollision, UpdateFrequency, UpdateFlags);
+	}
+
+	template<typename Type = VertexType>
+	typename TEnableIf<!FRuntimeMeshVertexTraits<Type>::HasPositionComponent>::Type
+		CommitCreate(URuntimeMeshComponent* Component, int32 SectionIndex, bool bCreateCollision, EUpdateFrequency UpdateFrequency, ESectionUpdateFlags UpdateFlags)
+	{
+		Component->CreateMeshSectionDualBuffer(SectionIndex, Positions, Vertices, Triangles, bCreateCollision, UpdateFrequency, UpdateFlags);
+	}
+
+	template<typename Type = VertexType>
+	typename TEnableIf<FRuntimeMeshVertexTraits<Type>::HasPositionComponent>::Type
+		CommitUpdate(URuntimeMeshComponent* Component, int32 SectionIndex, bool bUpdateTriangles, ESectionUpdateFlags UpdateFlags)
+	{
+		if (bUpdateTriangles)
+		{
+			Component->UpdateMeshSection(SectionIndex, Vertices, Triangles, UpdateFlags);
+		}
+		else
+		{
+			Component->UpdateMeshSection(SectionIndex, Vertices, UpdateFlags);
+		}
+	}
+
+	template<typename Type = VertexType>
+	typename TEnableIf<!FRuntimeMeshVertexTraits<Type>::HasPositionComponent>::Type
+		CommitUpdate(URuntimeMeshComponent* Component, int32 SectionIndex, bool bUpdateTriangles, ESectionUpdateFlags UpdateFlags)
+	{
+		if (bUpdateTriangles)
+		{
+			Component->UpdateMeshSection(SectionIndex, Positions, Vertices, Triangles, UpdateFlags);
+		}
+		else
+		{
+			Component->UpdateMeshSection(SectionIndex, Positions, Vertices, UpdateFlags);
+		}
+	}
 };
-
-
-
-void Test()
-{
-	FRuntimeMeshBuilder<FRuntimeMeshVertexSimple> Mesh;
-
-	// Create 3 vertices setting position, normal, and UV0
-	int32 Vertex1 = Mesh.SetVertex(FVector(0, 0, 0));
-	Mesh.SetNormal(FVector(1, 0, 0));
-	Mesh.SetUV(0, FVector2D(0, 0));
-	Mesh.MoveNext();
-
-	int32 Vertex2 = Mesh.AddVertex(FVector(1, 1, 1));
-	Mesh.SetNormal(FVector(1, 0, 0));
-	Mesh.SetUV(0, FVector2D(1, 1));
-	Mesh.MoveNext();
-
-	int32 Vertex3 = Mesh.AddVertex(FVector(2, 2, 2));
-	Mesh.SetNormal(FVector(1, 0, 0));
-	Mesh.SetUV(0, FVector2D(1, 1));
-	Mesh.MoveNext();
-
-
-	// Add the triangle
-	Mesh.AddTriangle(Vertex1, Vertex2, Vertex3);
-
-
-	// Update the 3 vertices positions, leaving everything else the same
-	Mesh.SeekVertices(0);
-	Mesh.SetVertex(FVector(5, 5, 5));
-	Mesh.MoveNext();
-	Mesh.SetVertex(FVector(6, 6, 6));
-	Mesh.MoveNext();
-	Mesh.SetVertex(FVector(7, 7, 7));
-	Mesh.MoveNext();
-
-
-
-	Mesh.SeekTriangles(0);
-	Mesh.AddTriangle(Vertex3, Vertex2, Vertex1);
-
-
-
-}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Components/MeshComponent.h"
 #include "RuntimeMeshCore.h"
 #include "RuntimeMeshSection.h"
+#include "RuntimeMeshSectionMap.h"
 #include "RuntimeMeshGenericVertex.h"
 #include "PhysicsEngine/ConvexElem.h"
 #include "RuntimeMeshComponent.generated.h"
@@ -23,7 +24,7 @@
 
 #define RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex) \
 		check(SectionIndex >= 0 && "SectionIndex cannot be negative."); \
-		check(SectionIndex < MeshSections.Num() && MeshSections[SectionIndex].IsValid() && "Invalid SectionIndex.");
+		check(MeshSections.Contains(SectionIndex) && "Invalid SectionIndex.");
 
 #define RMC_VALIDATE_UPDATEPARAMETERS_INTERNALSECTION(SectionIndex) \
 		RMC_VALIDATE_UPDATEPARAMETERS(SectionIndex) \
@@ -38,6 +39,7 @@
 /* 
 *	This tick function is used to drive the collision cooker. It is enabled for one frame when we need to update collision. 
 *	This keeps from cooking on each individual create/update section as the original PMC did
+*	It also stays enabled while Auto sections are on the dynamic path, to move them back to the static path once idle.
 */
 USTRUCT()
 struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshComponentPrePhysicsTickFunction : public FTickFunction
@@ -53,6 +55,12 @@ struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshComponentPrePhysicsTickFunction : pu
 	virtual FString DiagnosticMessage() override;
 };
 
+/* Called when a section finishes async optimization with the average cache miss ratio before and after */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FRuntimeMeshSectionOptimizedDelegate, int32, SectionIndex, float, ACMRBefore, float, ACMRAfter);
+
+/* Called when a section's LODs finish generating, with the number of LODs it now has */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FRuntimeMeshSectionLODsGeneratedDelegate, int32, SectionIndex, int32, NumLODs);
+
 /**
 *	Component that allows you to specify custom triangle mesh geometry for rendering and collision.
 */
@@ -67,18 +75,25 @@ private:
 	template<typename SectionType>
 	TSharedPtr<SectionType> CreateOrResetSection(int32 SectionIndex, bool bWantsSeparatePositionBuffer, bool bIsInternalSectionType = false)
 	{
-		// Ensure sections array is long enough
-		if (SectionIndex >= MeshSections.Num())
-		{
-			MeshSections.SetNum(SectionIndex + 1, false);
-		}
-
 		// Create new section
 		TSharedPtr<SectionType> NewSection = MakeShareable(new SectionType(bWantsSeparatePositionBuffer));
 		NewSection->bIsInternalSectionType = bIsInternalSectionType;
 
+		// Fill the allocations left by the sections this component had before it was pooled
+		if (RecycledSections.Num() > 0)
+		{
+			ReuseRecycledSection(*NewSection);
+		}
+
+		// Carry over what's needed from the section being replaced
+		if (RuntimeMeshSectionPtr* ExistingSection = MeshSections.Find(SectionIndex))
+		{
+			ReplaceSectionInternal(SectionIndex, **ExistingSection, *NewSection);
+		}
+
 		// Store section at index
-		MeshSections[SectionIndex] = NewSection;
+		NewSection->SectionId = ++LastSectionId;
+		MeshSections.FindOrAdd(SectionIndex) = NewSection;
 
 		return NewSection;
 	}
@@ -86,22 +101,68 @@ private:
 	/* Creates a mesh section of an internal type meant for the generic vertex and the old PMC style API */
 	TSharedPtr<FRuntimeMeshSectionInterface> CreateOrResetSectionInternalType(int32 SectionIndex, int32 NumUVChannels, bool WantsHalfPrecsionUVs);
 
+	/* Gives a new section the buffer allocations of a recycled section of the same type, if there is one */
+	void ReuseRecycledSection(FRuntimeMeshSectionInterface& NewSection);
+
+	/**
+	*	Unregisters the component and removes all its sections and collision, for a component pool to reuse it later.
+	*	The BodySetup is kept, and so are the buffer allocations of the removed sections for the next sections of the same type.
+	*/
+	void ResetForPool();
+
 	/* Gets the material for a section or the default material if one's not provided. */
-	UMaterialInterface* GetSectionMaterial(int32 Index)
+	UMaterialInterface* GetSectionMaterial(int32 Index) const
 	{
 		auto Material = GetMaterial(Index);
 		return Material ? Material : UMaterial::GetDefaultMaterial(MD_Surface);
 	}
 
 
+	/* Handles a section being replaced by a new one at the same index, keeping its update history */
+	void ReplaceSectionInternal(int32 SectionIndex, const FRuntimeMeshSectionInterface& OldSection, FRuntimeMeshSectionInterface& NewSection);
+
+	/* Adds an update to the section's history. Returns true if it moved an Auto section to the dynamic path, which requires a proxy recreate. */
+	bool RecordSectionUpdate(FRuntimeMeshSectionInterface& Section);
+
+	/* Moves Auto sections that stopped being updated back to the static path */
+	void UpdateAutoSectionPaths();
+
 	/* Finishes creating a section, including entering it for batch updating, or updating the RT directly */
 	void CreateSectionInternal(int32 SectionIndex);
 
 	/* Finishes updating a section, including entering it for batch updating, or updating the RT directly */
 	void UpdateSectionInternal(int32 SectionIndex, bool bHadVertexPositionsUpdate, bool bHadVertexUpdates, bool bHadIndexUpdates, bool bNeedsBoundsUpdate);
 
-	/* Finishes updating a sections positions (Only used if section is dual vertex buffer), including entering it for batch updating, or updating the RT directly */
-	void UpdateSectionVertexPositionsInternal(int32 SectionIndex, bool bNeedsBoundsUpdate);
+	/**
+	*	Finishes updating a sections positions (Only used if section is dual vertex buffer), including entering it for batch updating, or updating the RT directly.
+	*	Only Count positions starting at StartIndex are sent when updating the RT directly. A Count of INDEX_NONE sends the rest of the buffer.
+	*	VertexCount vertices starting at VertexStartIndex are sent along with them, for vertex attributes derived from the positions.
+	*/
+	void UpdateSectionVertexPositionsInternal(int32 SectionIndex, bool bNeedsBoundsUpdate, int32 StartIndex = 0, int32 Count = INDEX_NONE, int32 VertexStartIndex = 0, int32 VertexCount = 0);
+
+	/* Recalculates the normals and tangents around the moved vertices, then finishes the position update with the vertices that changed */
+	void UpdateSectionVertexPositionsAndTangentsInternal(int32 SectionIndex, const TArray<int32>& MovedVertices, bool bNeedsBoundsUpdate);
+
+	/* Blends the morph targets of every section whose weights changed */
+	void ApplyPendingMorphTargets();
+
+	/* Blends a section's morph targets at the end of the frame, or right away if there's no world to do it */
+	void QueueMorphTargetBlendInternal(int32 SectionIndex);
+
+	/**
+	*	Makes a section's positions the base of its morph targets after they were replaced outside the morph targets,
+	*	then queues blending the targets back in. Drops the targets if the number of positions changed.
+	*/
+	void RebaseMorphTargetsInternal(int32 SectionIndex);
+
+	/* Starts generating a section's LODs on a worker thread. If one is already running it starts again once that finishes. */
+	void StartSectionLODGeneration(int32 SectionIndex);
+
+	/* Sends the index buffer of a section's current LOD to the RT, without counting as a change to the section */
+	void UpdateSectionRenderIndicesInternal(int32 SectionIndex);
+
+	/* Adds a section that was built outside the component, replacing any section at the same index */
+	void AddSectionInternal(int32 SectionIndex, const RuntimeMeshSectionPtr& NewSection);
 
 	/* Finishes updating a sections properties, like visible/casts shadow, a*/
 	void UpdateSectionPropertiesInternal(int32 SectionIndex, bool bUpdateRequiresProxyRecreateIfStatic);
@@ -551,6 +612,12 @@ public:
 		if (bUpdatedVertexPositions || bUpdatedVertices)
 		{
 			UpdateSectionInternal(SectionIndex, bUpdatedVertexPositions, bUpdatedVertices, false, bNeedsBoundsUpdate);
+
+			// The new positions are what the morph targets blend on now
+			if (bUpdatedVertexPositions)
+			{
+				RebaseMorphTargetsInternal(SectionIndex);
+			}
 		}
 	}
 
@@ -617,6 +684,12 @@ public:
 		if (bUpdatedVertexPositions || bUpdatedVertices)
 		{
 			UpdateSectionInternal(SectionIndex, bUpdatedVertexPositions, bUpdatedVertices, false, bNeedsBoundsUpdate);
+
+			// The new positions are what the morph targets blend on now
+			if (bUpdatedVertexPositions)
+			{
+				RebaseMorphTargetsInternal(SectionIndex);
+			}
 		}
 	}
 
@@ -694,6 +767,12 @@ public:
 		if (bUpdatedVertexPositions || bUpdatedVertices || bUpdatedIndices)
 		{
 			UpdateSectionInternal(SectionIndex, bUpdatedVertexPositions, bUpdatedVertices, bUpdatedIndices, bNeedsBoundsUpdate);
+
+			// The new positions are what the morph targets blend on now
+			if (bUpdatedVertexPositions)
+			{
+				RebaseMorphTargetsInternal(SectionIndex);
+			}
 		}
 	}
 
@@ -773,9 +852,22 @@ public:
 		if (bUpdatedVertexPositions || bUpdatedVertices || bUpdatedIndices)
 		{
 			UpdateSectionInternal(SectionIndex, bUpdatedVertexPositions, bUpdatedVertices, bUpdatedIndices, bNeedsBoundsUpdate);
+
+			// The new positions are what the morph targets blend on now
+			if (bUpdatedVertexPositions)
+			{
+				RebaseMorphTargetsInternal(SectionIndex);
+			}
 		}
 	}
 
+	/**
+	*	Updates a sections index buffer only, leaving the vertices as they are. Useful for switching between index sets over the same vertices, like terrain LODs.
+	*	@param	SectionIndex		Index of the section to update.
+	*	@param	Triangles			Index buffer indicating which vertices make up each triangle. Length must be a multiple of 3.
+	*	@param	UpdateFlags			Flags pertaining to this particular update.
+	*/
+	void UpdateMeshSectionTriangles(int32 SectionIndex, TArray<int32>& Triangles, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None);
 	
 	/**
 	*	Updates a sections position buffer only. This cannot be used on a non-dual buffer section. You cannot change the length of the vertex position buffer with this function.
@@ -796,7 +888,7 @@ public:
 	
 
 	/**
-	*	Starts an in place update of vertex positions. 
+	*	Starts an in place update of vertex positions. Use FRuntimeMeshPositionWriter to fill the positions from many threads.
 	*	@param	SectionIndex		Index of the section to update.
 	*/
 	TArray<FVector>* BeginMeshSectionPositionUpdate(int32 SectionIndex);
@@ -817,6 +909,41 @@ public:
 	void EndMeshSectionPositionUpdate(int32 SectionIndex, const FBox& BoundingBox);
 
 
+	/**
+	*	Adds a morph target to a dual buffer section. Morph targets are sparse position offsets blended on top of the
+	*	section's current positions, which are kept as the base the first time a target is added. Positions replaced
+	*	later by a section update become the new base and the targets are blended back on. Positions left as they were
+	*	by BeginMeshSectionPositionUpdate() or a position writer keep their current blend in the base. If the number of
+	*	positions changes, the targets are cleared.
+	*	@param	SectionIndex		Index of the section to add the morph target to.
+	*	@param	VertexIndices		Vertices moved by the morph target.
+	*	@param	PositionDeltas		Offset of each of those vertices at a weight of 1. Must be the same length as VertexIndices.
+	*	@return	Index of the new morph target in the section.
+	*/
+	int32 AddMeshSectionMorphTarget(int32 SectionIndex, const TArray<int32>& VertexIndices, const TArray<FVector>& PositionDeltas);
+
+	/**
+	*	Sets the weight of a morph target. The section is blended once at the end of the frame, after all weights were set,
+	*	and only the range of vertices moved by the morph targets is sent to the GPU.
+	*	@param	SectionIndex		Index of the section.
+	*	@param	MorphTargetIndex	Index of the morph target returned by AddMeshSectionMorphTarget().
+	*	@param	Weight				New weight. 0 disables the morph target.
+	*/
+	void SetMeshSectionMorphTargetWeight(int32 SectionIndex, int32 MorphTargetIndex, float Weight);
+
+	/* Gets the weight of a morph target */
+	float GetMeshSectionMorphTargetWeight(int32 SectionIndex, int32 MorphTargetIndex) const;
+
+	/* Gets the number of morph targets on a section */
+	int32 GetNumMeshSectionMorphTargets(int32 SectionIndex) const;
+
+	/* Blends the morph targets of a section now, instead of waiting for the end of the frame */
+	void ApplyMeshSectionMorphTargets(int32 SectionIndex);
+
+	/* Removes all morph targets from a section, putting back the positions it had when the first one was added */
+	void ClearMeshSectionMorphTargets(int32 SectionIndex);
+
+
 	/**
 	*	Create/replace a section.
 	*	@param	SectionIndex		Index of the section to create or replace.
@@ -1028,6 +1155,130 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
 	void EndBatchUpdates();
 
+	/** Is a batch of updates pending, begun by a caller or by coalescing. Code that batches its own updates should only end a batch it began. */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool IsBatchUpdatePending() const
+	{
+		return BatchState.IsBatchPending();
+	}
+
+	/**
+	*	Enables or disables coalescing of section updates. While enabled every update is accumulated into a batch
+	*	that's sent once at the end of the frame. Disabling sends any pending coalesced updates immediately.
+	*	A batch begun with BeginBatchUpdates() takes in the updates coalesced so far and is only ever sent by EndBatchUpdates().
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void SetCoalesceUpdates(bool bNewCoalesceUpdates);
+
+
+	/**
+	*	Reorders a section's triangles for the post-transform vertex cache and its vertices for fetch locality.
+	*	The work runs on a worker thread and is applied once complete, unless the section has changed in the meantime.
+	*	Most useful for Infrequent sections, as they're drawn every frame for their whole lifetime.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void OptimizeMeshSectionForRendering(int32 SectionIndex);
+
+	/** Called when OptimizeMeshSectionForRendering() has been applied to a section */
+	UPROPERTY(BlueprintAssignable, Category = "Components|RuntimeMesh")
+	FRuntimeMeshSectionOptimizedDelegate OnSectionOptimized;
+
+
+	/**
+	*	Generates simplified LODs of a section on a worker thread using quadric error edge collapse.
+	*	LODs only hold an index buffer into the section's own vertices, so they work with every vertex type.
+	*	Vertices on UV seams, hard edges and open borders are never moved. The LODs are regenerated in the
+	*	background whenever the section's vertices or triangles change, and results for older data are discarded.
+	*	Position only updates of dual buffer sections, like morph targets, keep the existing LODs.
+	*	@param	SectionIndex		Index of the section to generate LODs for.
+	*	@param	TriangleRatios		Fraction of the section's triangles to keep in each LOD, from most to least detailed.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void GenerateMeshSectionLODs(int32 SectionIndex, const TArray<float>& TriangleRatios);
+
+	/* Removes a section's LODs and stops regenerating them */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void ClearMeshSectionLODs(int32 SectionIndex);
+
+	/**
+	*	Sets the LOD a section is drawn with. 0 is the full section, 1 is the first ratio passed to GenerateMeshSectionLODs().
+	*	Until that LOD has been generated the full section is drawn. Only the index buffer is sent to the GPU.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void SetMeshSectionLOD(int32 SectionIndex, int32 LODIndex);
+
+	/* Gets the LOD a section is set to be drawn with */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	int32 GetMeshSectionLOD(int32 SectionIndex) const;
+
+	/* Gets the number of LODs that have been generated for a section, not counting the full section */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	int32 GetNumMeshSectionLODs(int32 SectionIndex) const;
+
+	/** Called when a section's LODs have been generated or regenerated */
+	UPROPERTY(BlueprintAssignable, Category = "Components|RuntimeMesh")
+	FRuntimeMeshSectionLODsGeneratedDelegate OnSectionLODsGenerated;
+
+
+	/**
+	*	Gets a snapshot of a section's triangles prepared for CPU queries, which don't need cooked collision.
+	*	The snapshot is built the first time it's needed after the section's triangles change, and refit when only
+	*	positions changed. It never changes once returned, so it can be queried from any thread.
+	*/
+	FRuntimeMeshBVHPtr GetMeshSectionBVH(int32 SectionIndex);
+
+	/* Gets snapshots of every section, for running queries against the whole component from another thread */
+	void GetMeshSectionBVHs(TArray<FRuntimeMeshBVHPtr>& OutBVHs);
+
+	/**
+	*	Gets the half-edge topology of a section's triangles: twins, vertex rings and boundary loops.
+	*	It's built the first time it's needed after the section's triangles change, and kept through position and
+	*	vertex updates. It never changes once returned, so it can be read from any thread.
+	*/
+	FRuntimeMeshTopologyPtr GetMeshSectionTopology(int32 SectionIndex);
+
+	/** Finds the closest triangle of any section hit by the segment from Start to End, in component space */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool RayCastMeshSections(FVector Start, FVector End, FRuntimeMeshQueryHit& OutHit);
+
+	/** Finds every triangle of any section touching a sphere, in component space */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool OverlapMeshSectionsSphere(FVector Center, float Radius, TArray<FRuntimeMeshQueryHit>& OutHits);
+
+	/** Finds every triangle of any section touching a box, in component space */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool OverlapMeshSectionsBox(FBox Box, TArray<FRuntimeMeshQueryHit>& OutHits);
+
+	/** Finds the closest point on any section to Point within MaxDistance, in component space */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool GetClosestPointOnMeshSections(FVector Point, float MaxDistance, FRuntimeMeshQueryHit& OutHit);
+
+	/**
+	*	Cuts every section with a plane, in component space. Sections are sliced in parallel, and the vertices along the
+	*	cut interpolate every attribute of the generic vertex types. The half on the side the normal points to replaces
+	*	the original section. All the new sections go out in one batch, so collision is only cooked once.
+	*	@param	PlanePosition		Any point on the plane
+	*	@param	PlaneNormal			Normal of the plane, pointing to the half that stays in the original sections
+	*	@param	bCreateCap			Should both halves be closed along the cut. Caps go in the section they close.
+	*	@param	OtherHalfComponent	Receives the other halves at the same section indices, keeping their positions in this
+	*								component's space. If null they're added to this component after its last section.
+	*	@out	OutOtherHalfSections	Section index of each of the other halves
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void SliceMeshSections(FVector PlanePosition, FVector PlaneNormal, bool bCreateCap, URuntimeMeshComponent* OtherHalfComponent, TArray<int32>& OutOtherHalfSections);
+
+	/**
+	*	Combines two sections of the same vertex type with a boolean operation, writing the result over the first section.
+	*	Both sections should be closed meshes. Triangles are culled through each section's query tree and cut in parallel,
+	*	and the vertices along the cut interpolate every attribute of the generic vertex types.
+	*	@param	SectionIndex		First operand, replaced by the result. Cleared if nothing is left.
+	*	@param	OtherSectionIndex	Second operand, the section carved out for Subtract
+	*	@param	bRemoveOtherSection	Should the second operand be cleared, as it's usually a brush
+	*	Returns false if the sections couldn't be combined.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool BooleanMeshSections(int32 SectionIndex, int32 OtherSectionIndex, ERuntimeMeshBooleanOperation Operation, bool bRemoveOtherSection = true);
+
 
 
 	/**
@@ -1043,6 +1294,26 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RuntimeMesh")
 	bool bShouldSerializeMeshData;
 
+	/**
+	*	Controls whether collision vertices with the same position are welded before cooking.
+	*	This produces smaller, connected trimeshes from meshes with split vertices (hard edges, UV seams, per face quads).
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RuntimeMesh")
+	bool bWeldCollisionVertices;
+
+	/** Max distance between collision vertices that are welded together */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RuntimeMesh", meta = (EditCondition = "bWeldCollisionVertices", ClampMin = "0"))
+	float CollisionWeldTolerance;
+
+	/**
+	*	Controls whether section updates are accumulated and sent once at the end of the frame, as if every frame was wrapped in
+	*	BeginBatchUpdates()/EndBatchUpdates(). Multiple updates to a section in a frame only upload its latest data.
+	*	The batches of all coalescing components in a world are sent together in a single render command by FRuntimeMeshUpdateManager.
+	*	Collision and bounds are updated along with the batch.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RuntimeMesh")
+	bool bCoalesceUpdates;
+
 	/** Collision data */
 	UPROPERTY(Transient, DuplicateTransient)
 	class UBodySetup* BodySetup;
@@ -1068,6 +1339,7 @@ private:
 
 	//~ Begin UMeshComponent Interface.
 	virtual int32 GetNumMaterials() const override;
+	virtual void GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials) const override;
 	//~ End UMeshComponent Interface.
 
 
@@ -1088,6 +1360,9 @@ private:
 	/* Serializes this component */
 	virtual void Serialize(FArchive& Ar) override;
 
+	/* Serializes the sections as a header table, an offset table and one independent block per section, encoded and decoded in parallel */
+	void SerializeSectionBlocks(FArchive& Ar);
+
 	/* Does post load fixups */
 	virtual void PostLoad() override;
 
@@ -1095,14 +1370,51 @@ private:
 	virtual void RegisterComponentTickFunctions(bool bRegister) override;
 
 
+	/* Should an update go into the batch? Starts the end of frame batch if coalescing updates. */
+	bool ShouldBatchUpdate();
+
+	/**
+	*	Creates the section proxies for the sections the pending batch creates, one entry per updated section and null for the rest.
+	*	Materials can only be resolved on the game thread, so call this there before PrepareBatchUpdate().
+	*/
+	void CreateBatchSectionProxies(TArray<FRuntimeMeshSectionProxyInterface*>& OutNewProxies) const;
+
+	/**
+	*	Packs the render thread payload for the pending batch, handing over the proxies from CreateBatchSectionProxies().
+	*	Doesn't modify the component so it's safe to run for many components in parallel.
+	*	Returns null if there's nothing to send, or the proxy needs recreating instead.
+	*/
+	FRuntimeMeshCommandBuffer* PrepareBatchUpdate(const TArray<FRuntimeMeshSectionProxyInterface*>& NewProxies) const;
+
+	/* Finishes the pending batch on the game thread, marking render state, collision and bounds dirty as needed, and resets it */
+	void FinishBatchUpdate();
+
+	/* Sends the prepared batches of many components to the render thread in a single command */
+	static void SubmitBatchUpdates(const TArray<URuntimeMeshComponent*>& Components, const TArray<FRuntimeMeshCommandBuffer*>& BatchUpdates);
+
 	/* Current state of a batch update. */
 	FRuntimeMeshBatchUpdateState BatchState;
 
 	/* Is the collision in need of a rebake? */
 	bool bCollisionDirty;
 
-	/** Array of sections of mesh */	
-	TArray<RuntimeMeshSectionPtr> MeshSections;
+	/* Are there Auto sections on the dynamic path? The pre physics tick watches them to move them back once idle. */
+	bool bHasDynamicAutoSections;
+
+	/* Have morph target weights changed since the last blend? Set while the component is queued with the update manager. */
+	bool bHasPendingMorphTargets;
+
+	/* SectionId given to the last section added */
+	uint32 LastSectionId;
+
+	/* Command streams given back by the render thread, reused for the next updates of this component */
+	FRuntimeMeshBufferPoolPtr CommandBufferPool;
+
+	/** Sections of the mesh, keyed by section index */
+	TRuntimeMeshSectionMap<RuntimeMeshSectionPtr> MeshSections;
+
+	/* Sections removed when the component was last pooled, whose buffer allocations are handed to new sections */
+	TArray<RuntimeMeshSectionPtr> RecycledSections;
 
 	/* Array of collision only mesh sections*/
 	UPROPERTY(Transient)
@@ -1123,4 +1435,7 @@ private:
 
 	friend class FRuntimeMeshSceneProxy;
 	friend struct FRuntimeMeshComponentPrePhysicsTickFunction;
+	friend class FRuntimeMeshUpdateManager;
+	friend class FRuntimeMeshPositionWriter;
+	friend class URuntimeMeshComponentPool;
 };
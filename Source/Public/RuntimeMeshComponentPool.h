@@ -0,0 +1,120 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshComponentPool.generated.h"
+
+class URuntimeMeshComponent;
+
+/* Sizes and counters reported by a component pool */
+USTRUCT(BlueprintType)
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshComponentPoolStats
+{
+	GENERATED_BODY()
+
+	/* Released components waiting to be reused */
+	UPROPERTY(BlueprintReadOnly, Category = "Components|RuntimeMesh")
+	int32 NumPooled;
+
+	/* Components handed out and not released yet */
+	UPROPERTY(BlueprintReadOnly, Category = "Components|RuntimeMesh")
+	int32 NumActive;
+
+	/* Acquires served by a pooled component */
+	UPROPERTY(BlueprintReadOnly, Category = "Components|RuntimeMesh")
+	int32 NumHits;
+
+	/* Acquires that had to create a component */
+	UPROPERTY(BlueprintReadOnly, Category = "Components|RuntimeMesh")
+	int32 NumMisses;
+
+	/* Released components destroyed because the pool was full */
+	UPROPERTY(BlueprintReadOnly, Category = "Components|RuntimeMesh")
+	int32 NumDiscarded;
+
+	/* Fraction of acquires served by a pooled component */
+	UPROPERTY(BlueprintReadOnly, Category = "Components|RuntimeMesh")
+	float HitRate;
+
+	FRuntimeMeshComponentPoolStats() : NumPooled(0), NumActive(0), NumHits(0), NumMisses(0), NumDiscarded(0), HitRate(0.0f) { }
+};
+
+/* A released component waiting in a pool */
+USTRUCT()
+struct FRuntimeMeshPooledComponent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	URuntimeMeshComponent* Component;
+
+	/* Was the component left registered and hidden instead of being reset */
+	bool bKeptRenderState;
+
+	/* Collision the component had when it was hidden, restored when it's acquired */
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled;
+
+	FRuntimeMeshPooledComponent() : Component(nullptr), bKeptRenderState(false), CollisionEnabled(ECollisionEnabled::NoCollision) { }
+};
+
+/**
+*	Recycles runtime mesh components for systems that constantly stream chunks in and out.
+*
+*	Released components are kept instead of destroyed, along with their BodySetup and the buffer allocations of their
+*	sections, which the next sections of the same vertex type reuse. By default they're unregistered, so acquiring one
+*	only costs registering it again. With bKeepRenderState they stay registered and hidden instead, keeping their scene
+*	proxy, GPU buffers and tick functions. They also keep their sections, which the next user should update in place
+*	to reuse the GPU buffers, clearing the ones it doesn't need.
+*/
+UCLASS(BlueprintType)
+class RUNTIMEMESHCOMPONENT_API URuntimeMeshComponentPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	URuntimeMeshComponentPool(const FObjectInitializer& ObjectInitializer);
+
+	/* Most released components kept for reuse. Components released beyond this are destroyed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|RuntimeMesh", meta = (ClampMin = "0"))
+	int32 MaxPooledComponents;
+
+	/* Keep released components registered and hidden, along with their sections and GPU buffers */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|RuntimeMesh")
+	bool bKeepRenderState;
+
+	/**
+	*	Gets a registered component owned by Owner, reusing a pooled one when there is one.
+	*	@param	AttachParent	Component to attach to, or the owner's root component if null
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	URuntimeMeshComponent* AcquireComponent(AActor* Owner, USceneComponent* AttachParent = nullptr);
+
+	/* Hands a component back to the pool. It shouldn't be used again until it's acquired. Components the pool has no room for are destroyed. */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void ReleaseComponent(URuntimeMeshComponent* Component);
+
+	/* Destroys pooled components until at most MaxComponents are left, oldest first */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void Trim(int32 MaxComponents = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	FRuntimeMeshComponentPoolStats GetStats() const;
+
+	/* Logs the pool size and hit rate */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void LogStats() const;
+
+private:
+	/* Released components, oldest first */
+	UPROPERTY(Transient)
+	TArray<FRuntimeMeshPooledComponent> PooledComponents;
+
+	int32 NumActive;
+	int32 NumHits;
+	int32 NumMisses;
+	int32 NumDiscarded;
+
+	/* Removes a pooled component, keeping the order of the rest */
+	void RemovePooledComponent(int32 Index);
+};
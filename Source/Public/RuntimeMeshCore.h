@@ -25,6 +25,145 @@ template<typename T> struct FVertexHasPositionComponent {
 	static bool const Value = sizeof(f<Derived>(0)) == 2;
 };
 
+/* Helper for determining if a struct has a member named "UV0", of any type */
+template<typename T> struct FVertexHasUV0Component {
+	struct Fallback { FVector2D UV0; };
+	struct Derived : T, Fallback { };
+
+	template<typename C, C> struct ChT;
+
+	template<typename C> static char(&f(ChT<FVector2D Fallback::*, &C::UV0>*))[1];
+	template<typename C> static char(&f(...))[2];
+
+	static bool const Value = sizeof(f<Derived>(0)) == 2;
+};
+
+/* Describes the layout of a vertex type to generic code such as FRuntimeMeshBuilder. Specialize this for custom vertex types with more than one UV channel. */
+template<typename VertexType>
+struct FRuntimeMeshVertexTraits
+{
+	static const bool HasPositionComponent = FVertexHasPositionComponent<VertexType>::Value;
+	static const int32 NumUVChannels = FVertexHasUV0Component<VertexType>::Value ? 1 : 0;
+};
+
+namespace RuntimeMeshVertexInternal
+{
+	/* Reads and writes one UV channel by name. Only compiled for channels the vertex type has, so the members don't need to be contiguous. */
+#define RUNTIMEMESH_VERTEX_UVCHANNEL(Channel) \
+	template<typename VertexType> \
+	static typename TEnableIf<(Channel < FRuntimeMeshVertexTraits<VertexType>::NumUVChannels), FVector2D>::Type \
+		GetUV##Channel(const VertexType& Vertex) \
+	{ \
+		return FVector2D(Vertex.UV##Channel); \
+	} \
+	template<typename VertexType> \
+	static typename TEnableIf<!(Channel < FRuntimeMeshVertexTraits<VertexType>::NumUVChannels), FVector2D>::Type \
+		GetUV##Channel(const VertexType& Vertex) \
+	{ \
+		checkNoEntry(); \
+		return FVector2D::ZeroVector; \
+	} \
+	template<typename VertexType> \
+	static typename TEnableIf<(Channel < FRuntimeMeshVertexTraits<VertexType>::NumUVChannels)>::Type \
+		SetUV##Channel(VertexType& Vertex, const FVector2D& UV) \
+	{ \
+		Vertex.UV##Channel = UV; \
+	} \
+	template<typename VertexType> \
+	static typename TEnableIf<!(Channel < FRuntimeMeshVertexTraits<VertexType>::NumUVChannels)>::Type \
+		SetUV##Channel(VertexType& Vertex, const FVector2D& UV) \
+	{ \
+		checkNoEntry(); \
+	}
+
+	RUNTIMEMESH_VERTEX_UVCHANNEL(0)
+	RUNTIMEMESH_VERTEX_UVCHANNEL(1)
+	RUNTIMEMESH_VERTEX_UVCHANNEL(2)
+	RUNTIMEMESH_VERTEX_UVCHANNEL(3)
+	RUNTIMEMESH_VERTEX_UVCHANNEL(4)
+	RUNTIMEMESH_VERTEX_UVCHANNEL(5)
+	RUNTIMEMESH_VERTEX_UVCHANNEL(6)
+	RUNTIMEMESH_VERTEX_UVCHANNEL(7)
+
+#undef RUNTIMEMESH_VERTEX_UVCHANNEL
+
+	/* Reads a UV channel the vertex type has, by index */
+	template<typename VertexType>
+	static FVector2D GetUV(const VertexType& Vertex, int32 Channel)
+	{
+		switch (Channel)
+		{
+		case 0: return GetUV0(Vertex);
+		case 1: return GetUV1(Vertex);
+		case 2: return GetUV2(Vertex);
+		case 3: return GetUV3(Vertex);
+		case 4: return GetUV4(Vertex);
+		case 5: return GetUV5(Vertex);
+		case 6: return GetUV6(Vertex);
+		case 7: return GetUV7(Vertex);
+		default: checkNoEntry(); return FVector2D::ZeroVector;
+		}
+	}
+
+	/* Writes a UV channel the vertex type has, by index */
+	template<typename VertexType>
+	static void SetUV(VertexType& Vertex, int32 Channel, const FVector2D& UV)
+	{
+		switch (Channel)
+		{
+		case 0: SetUV0(Vertex, UV); break;
+		case 1: SetUV1(Vertex, UV); break;
+		case 2: SetUV2(Vertex, UV); break;
+		case 3: SetUV3(Vertex, UV); break;
+		case 4: SetUV4(Vertex, UV); break;
+		case 5: SetUV5(Vertex, UV); break;
+		case 6: SetUV6(Vertex, UV); break;
+		case 7: SetUV7(Vertex, UV); break;
+		default: checkNoEntry(); break;
+		}
+	}
+}
+
+/**
+*	Blends vertex attributes for geometry built from existing vertices, like the new vertices along a slice or a boolean cut.
+*	Positions are handled separately so this works the same for single and dual buffer sections.
+*	The generic vertex handles every attribute. Custom vertex types copy the nearest vertex, can't be flipped and keep
+*	their tangents unless they specialize this.
+*/
+template<typename VertexType>
+struct FRuntimeMeshVertexInterpolator
+{
+	/* Can SetTangents change the vertex */
+	static const bool bHasTangents = false;
+
+	static VertexType Lerp(const VertexType& A, const VertexType& B, float Alpha)
+	{
+		return Alpha < 0.5f ? A : B;
+	}
+
+	/* Vertex on a flat cap, based on a vertex of the surface it closes */
+	static VertexType MakeCapVertex(const VertexType& Template, const FVector& Normal, const FVector& TangentX, const FVector& TangentY, const FVector2D& UV)
+	{
+		return Template;
+	}
+
+	/* Vertex of the same surface facing the other way */
+	static VertexType Flip(const VertexType& Vertex)
+	{
+		return Vertex;
+	}
+
+	/* First UV channel, used to orient recalculated tangents */
+	static FVector2D GetUV(const VertexType& Vertex)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	static void SetTangents(VertexType& Vertex, const FVector& TangentX, const FVector& TangentY, const FVector& TangentZ)
+	{
+	}
+};
+
 
 
 
@@ -47,8 +186,10 @@ enum class EUpdateFrequency
 	Average UMETA(DisplayName = "Average"),
 	/* Tries to skip recreating the scene proxy if possible and optimizes the buffers for frequent updates. */
 	Frequent UMETA(DisplayName = "Frequent"),
-	/* If the component is static it will try to use the static rendering path (this will force a recreate of the scene proxy) */
-	Infrequent UMETA(DisplayName = "Infrequent")
+	/* If the component is static it will try to use the static rendering path. Creating the section, or growing it past its buffers, forces a recreate of the scene proxy. */
+	Infrequent UMETA(DisplayName = "Infrequent"),
+	/* Starts on the static path, moves to the dynamic path when updated often and back once it stops being updated. Each move recreates the scene proxy. */
+	Auto UMETA(DisplayName = "Auto")
 };
 
 /* Update frequency for a section. Used to optimize for update or render speed*/
@@ -65,7 +206,11 @@ enum class ESectionUpdateFlags
 	MoveArrays = 0x1,
 
 
-	//CalculateNormalTangent = 0x2,
+	/**
+		Recalculates normals and tangents around the vertices whose positions changed, and sends only the vertices that
+		changed to the GPU. Only used by position updates of dual buffer sections.
+	*/
+	CalculateNormalTangent = 0x2,
 	
 };
 ENUM_CLASS_FLAGS(ESectionUpdateFlags)
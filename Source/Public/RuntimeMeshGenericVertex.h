@@ -727,6 +727,83 @@ const FRuntimeMeshVertexTypeInfo_GenericVertex<1, HalfPrecisionUVs, false>
 
 
 
+/* Vertex traits for the generic vertex */
+template<int32 TextureChannels, bool HalfPrecisionUVs, bool HasPosition>
+struct FRuntimeMeshVertexTraits<FRuntimeMeshVertex<TextureChannels, HalfPrecisionUVs, HasPosition>>
+{
+	static const bool HasPositionComponent = HasPosition;
+	static const int32 NumUVChannels = TextureChannels;
+};
+
+/* Interpolates every attribute of the generic vertex. Blends keep the basis sign of the first vertex. */
+template<int32 TextureChannels, bool HalfPrecisionUVs, bool HasPosition>
+struct FRuntimeMeshVertexInterpolator<FRuntimeMeshVertex<TextureChannels, HalfPrecisionUVs, HasPosition>>
+{
+	typedef FRuntimeMeshVertex<TextureChannels, HalfPrecisionUVs, HasPosition> VertexType;
+
+	static const bool bHasTangents = true;
+
+	static VertexType Lerp(const VertexType& A, const VertexType& B, float Alpha)
+	{
+		VertexType Result = A;
+
+		const uint8 BasisSign = A.Normal.Vector.W;
+		Result.Normal = FMath::Lerp(FVector(A.Normal), FVector(B.Normal), Alpha).GetSafeNormal();
+		Result.Normal.Vector.W = BasisSign;
+		Result.Tangent = FMath::Lerp(FVector(A.Tangent), FVector(B.Tangent), Alpha).GetSafeNormal();
+
+		Result.Color = FColor(
+			(uint8)FMath::RoundToInt(FMath::Lerp<float>(A.Color.R, B.Color.R, Alpha)),
+			(uint8)FMath::RoundToInt(FMath::Lerp<float>(A.Color.G, B.Color.G, Alpha)),
+			(uint8)FMath::RoundToInt(FMath::Lerp<float>(A.Color.B, B.Color.B, Alpha)),
+			(uint8)FMath::RoundToInt(FMath::Lerp<float>(A.Color.A, B.Color.A, Alpha)));
+
+		for (int32 Channel = 0; Channel < TextureChannels; Channel++)
+		{
+			RuntimeMeshVertexInternal::SetUV(Result, Channel,
+				FMath::Lerp(RuntimeMeshVertexInternal::GetUV(A, Channel), RuntimeMeshVertexInternal::GetUV(B, Channel), Alpha));
+		}
+
+		return Result;
+	}
+
+	static VertexType MakeCapVertex(const VertexType& Template, const FVector& Normal, const FVector& TangentX, const FVector& TangentY, const FVector2D& UV)
+	{
+		VertexType Result = Template;
+		Result.Normal = Normal;
+		Result.Normal.Vector.W = GetBasisDeterminantSign(TangentX, TangentY, Normal) < 0.0f ? 0 : 255;
+		Result.Tangent = TangentX;
+
+		for (int32 Channel = 0; Channel < TextureChannels; Channel++)
+		{
+			RuntimeMeshVertexInternal::SetUV(Result, Channel, UV);
+		}
+
+		return Result;
+	}
+
+	static VertexType Flip(const VertexType& Vertex)
+	{
+		// Flip the basis sign too so the bitangent, and with it the UV mapping, stays the same
+		VertexType Result = Vertex;
+		const uint8 BasisSign = Vertex.Normal.Vector.W;
+		Result.Normal = -FVector(Vertex.Normal);
+		Result.Normal.Vector.W = BasisSign > 127 ? 0 : 255;
+		return Result;
+	}
+
+	static FVector2D GetUV(const VertexType& Vertex)
+	{
+		return FVector2D(Vertex.UV0);
+	}
+
+	static void SetTangents(VertexType& Vertex, const FVector& TangentX, const FVector& TangentY, const FVector& TangentZ)
+	{
+		Vertex.SetNormalAndTangent(TangentX, TangentY, TangentZ);
+	}
+};
+
+
 /** Simple vertex with 1 UV channel */
 using FRuntimeMeshVertexSimple = FRuntimeMeshVertex<1, false, true>;
 
@@ -984,6 +1061,11 @@ public:
 	FRuntimeMeshSectionInternal(bool bWantsSeparatePositionBuffer /*Ignored for this section type*/) : Super(false) { }
 	virtual ~FRuntimeMeshSectionInternal() override { }
 
+	virtual TSharedPtr<Super> CreateEmptySection() const override
+	{
+		return MakeShareable(new FRuntimeMeshSectionInternal(false));
+	}
+
 	virtual bool UpdateVertexBufferInternal(const TArray<FVector>& Positions, const TArray<FVector>& Normals, const TArray<FRuntimeMeshTangent>& Tangents, const TArray<FVector2D>& UV0, const TArray<FVector2D>& UV1, const TArray<FColor>& Colors) override
 	{
 		int32 NewVertexCount = (Positions.Num() > 0) ? Positions.Num() : Super::VertexBuffer.Num();
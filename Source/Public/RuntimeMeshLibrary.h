@@ -4,6 +4,8 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "RuntimeMeshComponent.h"
+#include "RuntimeMeshWelding.h"
+#include "Async/ParallelFor.h"
 #include "RuntimeMeshLibrary.generated.h"
 
 UCLASS()
@@ -25,9 +27,156 @@ class RUNTIMEMESHCOMPONENT_API URuntimeMeshLibrary : public UBlueprintFunctionLi
 	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
 	static void CreateGridMeshTriangles(int32 NumX, int32 NumY, bool bWinding, TArray<int32>& Triangles);
 
+	/**
+	*	Generate a flat grid in the XY plane, with vertex (X, Y) at index X * NumY + Y. Normals face +Z, tangents +X and UVs span 0 to 1.
+	*	@param	NumX			Number of vertices in X direction (must be >= 2)
+	*	@param	NumY			Number of vertices in y direction (must be >= 2)
+	*	@param	Spacing			Distance between neighboring vertices
+	*	@param	bWinding		Reverses winding of indices generated for each quad
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	static void CreateGridMesh(int32 NumX, int32 NumY, FVector2D Spacing, bool bWinding, TArray<FVector>& Vertices, TArray<int32>& Triangles, 
+		TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FRuntimeMeshTangent>& Tangents);
+
 	/** Generate vertex and index buffer for a simple box, given the supplied dimensions. Normals, UVs and tangents are also generated for each vertex. */
 	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
 	static void CreateBoxMesh(FVector BoxRadius, TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FRuntimeMeshTangent>& Tangents);
 
+	/**
+	*	Welds vertices that share a position, remapping the index buffer in place.
+	*	Attribute arrays may be empty, otherwise they must match the length of Vertices and are compacted alongside it.
+	*	@return		Number of vertices removed
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	static int32 WeldVertices(UPARAM(ref) TArray<FVector>& Vertices, UPARAM(ref) TArray<int32>& Triangles, UPARAM(ref) TArray<FVector>& Normals, 
+		UPARAM(ref) TArray<FVector2D>& UVs, UPARAM(ref) TArray<FLinearColor>& Colors, UPARAM(ref) TArray<FRuntimeMeshTangent>& Tangents, const FRuntimeMeshWeldSettings& Settings);
+
+	/**
+	*	Welds vertices by position only. Meant for collision data where other attributes don't matter.
+	*	@return		Number of vertices removed
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	static int32 WeldPositions(UPARAM(ref) TArray<FVector>& Vertices, UPARAM(ref) TArray<int32>& Triangles, float PositionTolerance = 0.01f);
+
+
+	/**
+	*	Generate an index buffer for a grid of quads, sized exactly and filled in parallel by row.
+	*	IndexType may be int32, uint32 or uint16. Fails if the grid has more vertices than IndexType can address.
+	*/
+	template<typename IndexType>
+	static bool CreateGridMeshIndices(int32 NumX, int32 NumY, bool bWinding, TArray<IndexType>& Triangles)
+	{
+		Triangles.Reset();
+
+		if (NumX < 2 || NumY < 2)
+		{
+			return false;
+		}
+
+		if ((int64)NumX * NumY - 1 > (int64)TNumericLimits<IndexType>::Max())
+		{
+			UE_LOG(RuntimeMeshLog, Error, TEXT("CreateGridMeshIndices() - %dx%d grid has too many vertices for the index type."), NumX, NumY);
+			return false;
+		}
+
+		const int32 IndicesPerRow = (NumY - 1) * 6;
+		Triangles.SetNumUninitialized((NumX - 1) * IndicesPerRow);
+
+		ParallelFor(NumX - 1, [&](int32 XIdx)
+		{
+			IndexType* RowIndices = Triangles.GetData() + XIdx * IndicesPerRow;
+
+			for (int32 YIdx = 0; YIdx < NumY - 1; YIdx++)
+			{
+				const IndexType I0 = (IndexType)((XIdx + 0) * NumY + (YIdx + 0));
+				const IndexType I1 = (IndexType)((XIdx + 1) * NumY + (YIdx + 0));
+				const IndexType I2 = (IndexType)((XIdx + 1) * NumY + (YIdx + 1));
+				const IndexType I3 = (IndexType)((XIdx + 0) * NumY + (YIdx + 1));
+
+				// Same triangles as ConvertQuadToTriangles()
+				if (bWinding)
+				{
+					RowIndices[0] = I0; RowIndices[1] = I1; RowIndices[2] = I3;
+					RowIndices[3] = I1; RowIndices[4] = I2; RowIndices[5] = I3;
+				}
+				else
+				{
+					RowIndices[0] = I0; RowIndices[1] = I3; RowIndices[2] = I1;
+					RowIndices[3] = I3; RowIndices[4] = I2; RowIndices[5] = I1;
+				}
+				RowIndices += 6;
+			}
+		});
+
+		return true;
+	}
+
+	/**
+	*	Generate a flat grid directly into a vertex type with a position component, laid out as CreateGridMesh().
+	*	Vertices keep their default normal, tangent and color, and get UV0 spanning 0 to 1 if the vertex type has it.
+	*/
+	template<typename VertexType, typename IndexType>
+	static bool CreateGridMesh(int32 NumX, int32 NumY, const FVector2D& Spacing, bool bWinding, TArray<VertexType>& Vertices, TArray<IndexType>& Triangles)
+	{
+		static_assert(FRuntimeMeshVertexTraits<VertexType>::HasPositionComponent, "Vertex type has no position. Use CreateGridMeshDualBuffer().");
+
+		if (!CreateGridMeshIndices(NumX, NumY, bWinding, Triangles))
+		{
+			Vertices.Reset();
+			return false;
+		}
+
+		Vertices.SetNumUninitialized(NumX * NumY);
+		ParallelFor(NumX, [&](int32 XIdx)
+		{
+			for (int32 YIdx = 0; YIdx < NumY; YIdx++)
+			{
+				VertexType& Vertex = *new (&Vertices[XIdx * NumY + YIdx]) VertexType();
+				Vertex.Position = FVector(XIdx * Spacing.X, YIdx * Spacing.Y, 0.0f);
+				if (FRuntimeMeshVertexTraits<VertexType>::NumUVChannels > 0)
+				{
+					RuntimeMeshVertexInternal::SetUV0(Vertex, FVector2D((float)XIdx / (NumX - 1), (float)YIdx / (NumY - 1)));
+				}
+			}
+		});
+
+		return true;
+	}
+
+	/**
+	*	Generate a flat grid into separate position and vertex data buffers, laid out as CreateGridMesh().
+	*	Vertices keep their default normal, tangent and color, and get UV0 spanning 0 to 1 if the vertex type has it.
+	*/
+	template<typename VertexType, typename IndexType>
+	static bool CreateGridMeshDualBuffer(int32 NumX, int32 NumY, const FVector2D& Spacing, bool bWinding, TArray<FVector>& Positions, 
+		TArray<VertexType>& VertexData, TArray<IndexType>& Triangles)
+	{
+		if (!CreateGridMeshIndices(NumX, NumY, bWinding, Triangles))
+		{
+			Positions.Reset();
+			VertexData.Reset();
+			return false;
+		}
+
+		Positions.SetNumUninitialized(NumX * NumY);
+		VertexData.SetNumUninitialized(NumX * NumY);
+		ParallelFor(NumX, [&](int32 XIdx)
+		{
+			for (int32 YIdx = 0; YIdx < NumY; YIdx++)
+			{
+				const int32 Index = XIdx * NumY + YIdx;
+				Positions[Index] = FVector(XIdx * Spacing.X, YIdx * Spacing.Y, 0.0f);
+
+				VertexType& Vertex = *new (&VertexData[Index]) VertexType();
+				if (FRuntimeMeshVertexTraits<VertexType>::NumUVChannels > 0)
+				{
+					RuntimeMeshVertexInternal::SetUV0(Vertex, FVector2D((float)XIdx / (NumX - 1), (float)YIdx / (NumY - 1)));
+				}
+			}
+		});
+
+		return true;
+	}
+
 	
 };
\ No newline at end of file
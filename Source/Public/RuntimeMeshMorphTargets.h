@@ -0,0 +1,90 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+/* Sparse position offsets for some of a section's vertices */
+struct FRuntimeMeshMorphTarget
+{
+	/* Vertices moved by this target, in ascending order */
+	TArray<int32> VertexIndices;
+
+	/* Offset of each vertex at a weight of 1 */
+	TArray<FVector> PositionDeltas;
+
+	/* Bounds of the deltas, including zero. Used to grow the section bounds without looking at the blended positions. */
+	FBox DeltaBounds;
+
+	float Weight;
+
+	FRuntimeMeshMorphTarget() : DeltaBounds(0), Weight(0.0f) { }
+
+	int32 GetFirstVertex() const { return VertexIndices.Num() > 0 ? VertexIndices[0] : 0; }
+	int32 GetLastVertex() const { return VertexIndices.Num() > 0 ? VertexIndices.Last() : -1; }
+};
+
+/**
+*	Morph targets of a dual buffer section.
+*
+*	Keeps a copy of the positions the targets are relative to, and blends the weighted targets into the
+*	section's position buffer. Only vertices touched by the current or previous blend are rewritten, so
+*	the caller only has to upload that range. The bounds are the base bounds grown by the weighted
+*	delta bounds of every active target, so they're conservative and cost nothing per vertex.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshMorphTargetSet
+{
+public:
+	FRuntimeMeshMorphTargetSet(const TArray<FVector>& InBasePositions, const FBox& InBaseBounds);
+
+	/* Adds a target. VertexIndices and PositionDeltas must be the same length. Returns the index of the new target. */
+	int32 AddTarget(const TArray<int32>& VertexIndices, const TArray<FVector>& PositionDeltas);
+
+	int32 Num() const { return Targets.Num(); }
+
+	float GetWeight(int32 TargetIndex) const { return Targets[TargetIndex].Weight; }
+
+	/* Sets the weight of a target. Returns true if it changed. */
+	bool SetWeight(int32 TargetIndex, float Weight);
+
+	/* Have weights changed since the last blend? */
+	bool IsDirty() const { return bIsDirty; }
+
+	int32 GetNumBasePositions() const { return BasePositions.Num(); }
+
+	/**
+	*	Blends the active targets into Positions, which must be the same length as the base positions.
+	*	@out	OutStartIndex	First vertex written
+	*	@out	OutCount		Number of vertices written. 0 if nothing needed to change.
+	*	@out	OutBounds		Conservative bounds of the blended positions
+	*/
+	void Apply(TArray<FVector>& Positions, int32& OutStartIndex, int32& OutCount, FBox& OutBounds);
+
+	/* Writes the base positions back over everything a previous blend changed. Outputs match Apply(). */
+	void Restore(TArray<FVector>& Positions, int32& OutStartIndex, int32& OutCount, FBox& OutBounds);
+
+	/**
+	*	Replaces the base positions with positions written outside the targets, which hold no blend.
+	*	The targets stay the same and are blended onto the new base by the next Apply().
+	*/
+	void Rebase(const TArray<FVector>& InBasePositions, const FBox& InBaseBounds);
+
+	/* Moves the base positions and target vertices to new indices. See FRuntimeMeshOptimizer::RemapVertexBuffer() */
+	void RemapVertices(const TArray<int32>& Remap);
+
+private:
+	/* Positions the targets are relative to */
+	TArray<FVector> BasePositions;
+	FBox BaseBounds;
+
+	TArray<FRuntimeMeshMorphTarget> Targets;
+
+	/* Range of vertices the last blend moved away from the base positions */
+	int32 AppliedStart;
+	int32 AppliedEnd;
+
+	bool bIsDirty;
+
+	/* Copies the base positions over a range of vertices */
+	void RestoreRange(TArray<FVector>& Positions, int32 StartIndex, int32 EndIndex) const;
+};
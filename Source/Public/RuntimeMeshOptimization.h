@@ -0,0 +1,56 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+/* Average cache miss ratio of an index buffer before and after optimization */
+struct FRuntimeMeshOptimizationStats
+{
+	float ACMRBefore;
+	float ACMRAfter;
+
+	FRuntimeMeshOptimizationStats() : ACMRBefore(0), ACMRAfter(0) { }
+};
+
+/**
+*	Index and vertex buffer reordering for rendering performance.
+*	Triangles are reordered for the post-transform vertex cache using Tom Forsyth's linear-speed algorithm,
+*	then vertices are reordered in the order they are first referenced so vertex fetch walks memory linearly.
+*	None of this touches the engine and it is safe to run off the game thread.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshOptimizer
+{
+public:
+	/* Size of the simulated post-transform cache */
+	static const int32 CacheSize = 32;
+
+	/* Average number of cache misses per triangle, using a FIFO cache of the given size. 3.0 is the worst case, 0.5 is about ideal for a regular grid. */
+	static float CalculateACMR(const TArray<int32>& Indices, int32 NumVertices, int32 FIFOSize = CacheSize);
+
+	/* Reorders triangles in place for the post-transform vertex cache */
+	static void OptimizeVertexCache(TArray<int32>& Indices, int32 NumVertices);
+
+	/**
+	*	Remaps indices in place so vertices are numbered in the order they're first used.
+	*	@out	OutRemap	New index for each old vertex. Vertices not referenced by any triangle are moved to the end.
+	*/
+	static void OptimizeVertexFetch(TArray<int32>& Indices, int32 NumVertices, TArray<int32>& OutRemap);
+
+	/* Runs the vertex cache then vertex fetch optimization. Apply OutRemap to every vertex buffer with RemapVertexBuffer() */
+	static void OptimizeForRendering(TArray<int32>& Indices, int32 NumVertices, TArray<int32>& OutRemap, FRuntimeMeshOptimizationStats* OutStats = nullptr);
+
+	/* Moves every element of a per vertex buffer to its new index */
+	template<typename ElementType>
+	static void RemapVertexBuffer(TArray<ElementType>& Buffer, const TArray<int32>& Remap)
+	{
+		check(Buffer.Num() == Remap.Num());
+
+		TArray<ElementType> OldBuffer = MoveTemp(Buffer);
+		Buffer.SetNumUninitialized(OldBuffer.Num());
+		for (int32 Index = 0; Index < OldBuffer.Num(); Index++)
+		{
+			Buffer[Remap[Index]] = OldBuffer[Index];
+		}
+	}
+};
@@ -0,0 +1,114 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "RuntimeMeshComponent.h"
+
+/**
+*	A fixed range of a section's positions that a single thread can write.
+*	Tracks the bounds of everything written so the section bounds don't need another pass.
+*/
+class FRuntimeMeshPositionSlice
+{
+public:
+	FRuntimeMeshPositionSlice(FVector* InPositions, int32 InStartIndex, int32 InNum, FBox* InOutBounds)
+		: Positions(InPositions), StartIndex(InStartIndex), Count(InNum), Bounds(0), OutBounds(InOutBounds) { }
+
+	FRuntimeMeshPositionSlice(FRuntimeMeshPositionSlice&& Other)
+		: Positions(Other.Positions), StartIndex(Other.StartIndex), Count(Other.Count), Bounds(Other.Bounds), OutBounds(Other.OutBounds)
+	{
+		Other.OutBounds = nullptr;
+	}
+
+	/* Adds the bounds of the written positions to the writer */
+	~FRuntimeMeshPositionSlice()
+	{
+		if (OutBounds && Bounds.IsValid)
+		{
+			*OutBounds += Bounds;
+		}
+	}
+
+	/* Number of positions in this slice */
+	int32 Num() const { return Count; }
+
+	/* Index in the section of the first position in this slice */
+	int32 GetStartIndex() const { return StartIndex; }
+
+	/* Gets the current position. Index is relative to the start of the slice. */
+	const FVector& Get(int32 Index) const
+	{
+		checkSlow(Index >= 0 && Index < Count);
+		return Positions[Index];
+	}
+
+	/* Sets a position. Index is relative to the start of the slice. */
+	void Set(int32 Index, const FVector& Position)
+	{
+		checkSlow(Index >= 0 && Index < Count);
+		Positions[Index] = Position;
+		Bounds += Position;
+	}
+
+private:
+	FVector* Positions;
+	int32 StartIndex;
+	int32 Count;
+	FBox Bounds;
+	FBox* OutBounds;
+
+	FRuntimeMeshPositionSlice(const FRuntimeMeshPositionSlice&) = delete;
+	FRuntimeMeshPositionSlice& operator=(const FRuntimeMeshPositionSlice&) = delete;
+};
+
+/**
+*	Writes the positions of a dual buffer section in place from many threads.
+*
+*	The position buffer is split into fixed size slices. Each slice can be filled by a different thread,
+*	from ParallelWrite or your own ParallelFor using GetSlice. Commit then validates the section,
+*	reduces the slice bounds into the section bounds and sends the update, like EndMeshSectionPositionUpdate.
+*
+*	Create and commit the writer on the game thread, and don't modify the section in between.
+*	Slices that were never written keep their old positions, and their bounds are calculated on commit.
+*	A slice that is written must have every position set, as only the positions set contribute to the bounds.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshPositionWriter
+{
+public:
+	FRuntimeMeshPositionWriter(URuntimeMeshComponent* InComponent, int32 InSectionIndex, int32 InSliceSize = 4096);
+	~FRuntimeMeshPositionWriter();
+
+	/* Number of positions in the section */
+	int32 Num() const { return NumPositions; }
+
+	int32 GetNumSlices() const { return SliceBounds.Num(); }
+
+	int32 GetSliceSize() const { return SliceSize; }
+
+	/* Gets a slice to write. Any thread can call this, but each slice should only be written by one thread at a time. */
+	FRuntimeMeshPositionSlice GetSlice(int32 SliceIndex);
+
+	/* Calls Func for every slice in parallel */
+	void ParallelWrite(TFunctionRef<void(FRuntimeMeshPositionSlice&)> Func);
+
+	/* Validates and sends the new positions. Returns false if the section changed since the writer was created. */
+	bool Commit();
+
+private:
+	TWeakObjectPtr<URuntimeMeshComponent> Component;
+	int32 SectionIndex;
+
+	/* Section being written, used to detect it being replaced */
+	TWeakPtr<FRuntimeMeshSectionInterface> Section;
+
+	/* Position buffer when the writer was created, used to detect it being reallocated */
+	FVector* Positions;
+	int32 NumPositions;
+
+	int32 SliceSize;
+
+	/* Bounds of the positions written to each slice */
+	TArray<FBox> SliceBounds;
+
+	bool bCommitted;
+};
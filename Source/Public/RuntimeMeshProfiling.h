@@ -10,6 +10,7 @@ DECLARE_STATS_GROUP(TEXT("RuntimeMesh"), STATGROUP_RuntimeMesh, STATCAT_Advanced
 DECLARE_CYCLE_STAT(TEXT("Create Section (RT)"), STAT_RuntimeMesh_CreateSection_RenderThread, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("Update Section (RT)"), STAT_RuntimeMesh_UpdateSection_RenderThread, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("Update Section - Position Only (RT)"), STAT_RuntimeMesh_UpdateSectionPositionOnly_RenderThread, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Update Section - Vertices Only (RT)"), STAT_RuntimeMesh_UpdateSectionVerticesOnly_RenderThread, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("Update Section Properties (RT)"), STAT_RuntimeMesh_UpdateSectionProperties_RenderThread, STATGROUP_RuntimeMesh);
 
 DECLARE_CYCLE_STAT(TEXT("Apply Batch Update (RT)"), STAT_RuntimeMesh_ApplyBatchUpdate_RenderThread, STATGROUP_RuntimeMesh);
@@ -47,8 +48,11 @@ DECLARE_CYCLE_STAT(TEXT("UpdateMeshSection (GT)"), STAT_RuntimeMesh_UpdateMeshSe
 
 
 
+DECLARE_CYCLE_STAT(TEXT("UpdateMeshSectionTriangles (GT)"), STAT_RuntimeMesh_UpdateMeshSectionTriangles, STATGROUP_RuntimeMesh);
+
 DECLARE_CYCLE_STAT(TEXT("UpdateMeshSectionPositionsImmediate (GT)"), STAT_RuntimeMesh_UpdateMeshSectionPositionsImmediate, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("UpdateMeshSectionPositionsImmediate (With Bounding Box) (GT)"), STAT_RuntimeMesh_UpdateMeshSectionPositionsImmediate_WithBoundinBox, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Recalculate Normals and Tangents (GT)"), STAT_RuntimeMesh_RecalculateNormalTangents, STATGROUP_RuntimeMesh);
 
 DECLARE_CYCLE_STAT(TEXT("Finish Create Section (GT)"), STAT_RuntimeMesh_FinishCreateSectionInternal, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("Finish Update Section (GT)"), STAT_RuntimeMesh_FinishUpdateSectionInternal, STATGROUP_RuntimeMesh);
@@ -66,6 +70,35 @@ DECLARE_CYCLE_STAT(TEXT("Get Physics TriMesh Data (GT)"), STAT_RuntimeMesh_GetPh
 DECLARE_CYCLE_STAT(TEXT("Update Collision (GT)"), STAT_RuntimeMesh_UpdateCollision, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("Update Local Bounds (GT)"), STAT_RuntimeMesh_UpdateLocalBounds, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("Serialize"), STAT_RuntimeMesh_Serialize, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Flush Coalesced Updates (GT)"), STAT_RuntimeMesh_FlushCoalescedUpdates, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Update Auto Section Paths (GT)"), STAT_RuntimeMesh_UpdateAutoSectionPaths, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Position Writer Commit (GT)"), STAT_RuntimeMesh_PositionWriterCommit, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Apply Morph Targets (GT)"), STAT_RuntimeMesh_ApplyMorphTargets, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Generate LODs (Worker)"), STAT_RuntimeMesh_GenerateLODs, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Build BVH (GT)"), STAT_RuntimeMesh_BuildBVH, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Build Topology (GT)"), STAT_RuntimeMesh_BuildTopology, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Slice Mesh Sections (GT)"), STAT_RuntimeMesh_SliceMeshSections, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Boolean Mesh Sections (GT)"), STAT_RuntimeMesh_BooleanMeshSections, STATGROUP_RuntimeMesh);
+
+// Update Buffer Pools
+DECLARE_DWORD_COUNTER_STAT(TEXT("Update Buffer Pool Hits"), STAT_RuntimeMesh_UpdateBufferPoolHits, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Update Buffer Pool Misses"), STAT_RuntimeMesh_UpdateBufferPoolMisses, STATGROUP_RuntimeMesh);
+DECLARE_MEMORY_STAT(TEXT("Update Buffer Pool Memory"), STAT_RuntimeMesh_UpdateBufferPoolMemory, STATGROUP_RuntimeMesh);
+
+// Component Pools
+DECLARE_CYCLE_STAT(TEXT("Acquire Pooled Component (GT)"), STAT_RuntimeMesh_AcquirePooledComponent, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Release Pooled Component (GT)"), STAT_RuntimeMesh_ReleasePooledComponent, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Component Pool Hits"), STAT_RuntimeMesh_ComponentPoolHits, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Component Pool Misses"), STAT_RuntimeMesh_ComponentPoolMisses, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Components"), STAT_RuntimeMesh_PooledComponents, STATGROUP_RuntimeMesh);
+
+// Terrain Profiling
+DECLARE_CYCLE_STAT(TEXT("Terrain Update Chunks (GT)"), STAT_RuntimeMesh_Terrain_UpdateChunks, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Terrain Update LODs (GT)"), STAT_RuntimeMesh_Terrain_UpdateLODs, STATGROUP_RuntimeMesh);
+
+// Voxel Profiling
+DECLARE_CYCLE_STAT(TEXT("Voxel Marching Cubes"), STAT_RuntimeMesh_Voxel_MarchingCubes, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Voxel Greedy Mesh"), STAT_RuntimeMesh_Voxel_GreedyMesh, STATGROUP_RuntimeMesh);
 
 
 
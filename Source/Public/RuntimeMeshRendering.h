@@ -66,16 +66,26 @@ public:
 		}
 	}
 
-	/* Set the data for the vertex buffer */
-	void SetData(const TArray<VertexType>& Data)
+	/* Set the data for the vertex buffer, starting at StartIndex. The data can be shorter than the buffer, leaving the rest unchanged. */
+	void SetData(const TArray<VertexType>& Data, int32 StartIndex = 0)
 	{
-		check(Data.Num() == VertexCount);
+		SetData(Data.GetData(), Data.Num(), StartIndex);
+	}
+
+	void SetData(const VertexType* Data, int32 NumVertices, int32 StartIndex = 0)
+	{
+		check(StartIndex >= 0 && StartIndex + NumVertices <= VertexCount);
+
+		if (NumVertices == 0)
+		{
+			return;
+		}
 
 		// Lock the vertex buffer
- 		void* Buffer = RHILockVertexBuffer(VertexBufferRHI, 0, Data.Num() * sizeof(VertexType), RLM_WriteOnly);
+ 		void* Buffer = RHILockVertexBuffer(VertexBufferRHI, StartIndex * sizeof(VertexType), NumVertices * sizeof(VertexType), RLM_WriteOnly);
  		 
  		// Write the vertices to the vertex buffer
- 		FMemory::Memcpy(Buffer, Data.GetData(), Data.Num() * sizeof(VertexType));
+ 		FMemory::Memcpy(Buffer, Data, NumVertices * sizeof(VertexType));
 
 		// Unlock the vertex buffer
  		RHIUnlockVertexBuffer(VertexBufferRHI);
@@ -125,16 +135,22 @@ public:
 		}
 	}
 
-	/* Set the data for the index buffer */
+	/* Set the data for the index buffer. If the data is shorter than the buffer the rest is filled with degenerate triangles. */
 	void SetData(const TArray<int32>& Data)
 	{
-		check(Data.Num() == IndexCount);
+		SetData(Data.GetData(), Data.Num());
+	}
+
+	void SetData(const int32* Data, int32 NumIndices)
+	{
+		check(NumIndices <= IndexCount);
 
 		// Lock the index buffer
 		void* Buffer = RHILockIndexBuffer(IndexBufferRHI, 0, IndexCount * sizeof(int32), RLM_WriteOnly);
 
 		// Write the indices to the vertex buffer	
-		FMemory::Memcpy(Buffer, Data.GetData(), Data.Num() * sizeof(int32));
+		FMemory::Memcpy(Buffer, Data, NumIndices * sizeof(int32));
+		FMemory::Memzero(static_cast<int32*>(Buffer) + NumIndices, (IndexCount - NumIndices) * sizeof(int32));
 
 		// Unlock the index buffer
 		RHIUnlockIndexBuffer(IndexBufferRHI);
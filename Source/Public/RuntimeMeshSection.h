@@ -7,6 +7,13 @@
 #include "RuntimeMeshProfiling.h"
 #include "RuntimeMeshVersion.h"
 #include "RuntimeMeshSectionProxy.h"
+#include "RuntimeMeshOptimization.h"
+#include "RuntimeMeshMorphTargets.h"
+#include "RuntimeMeshBVH.h"
+#include "RuntimeMeshSlicer.h"
+#include "RuntimeMeshBoolean.h"
+#include "RuntimeMeshTopology.h"
+#include "RuntimeMeshTangents.h"
 
 /** Interface class for a single mesh section */
 class FRuntimeMeshSectionInterface
@@ -36,12 +43,100 @@ public:
 	/** Update frequency of this section */
 	EUpdateFrequency UpdateFrequency;
 
+	/** Incremented every time the section's mesh data changes. Used to discard async work started on older data. */
+	uint32 UpdateRevision;
+
+	/** Set by the component when the section is added, never reused by that component. Async work finds its section again by index and id. */
+	uint32 SectionId;
+
+	/**
+	*	Vertex and index counts the render buffers of a static section were created with by the current scene proxy.
+	*	Updates that fit are applied in place instead of recreating the scene proxy.
+	*/
+	int32 RenderVertexCapacity;
+	int32 RenderIndexCapacity;
+
+	/** Last frame the section was updated, and how many updates in a row came at most AutoUpdateWindowFrames apart */
+	uint64 LastUpdateFrame;
+	int32 NumConsecutiveUpdates;
+
+	/** Path picked for an Auto section from its update history, Infrequent or Frequent */
+	EUpdateFrequency AutoUpdateFrequency;
+
+	/** Morph targets blended into the position buffer of a dual buffer section, if any were added */
+	TSharedPtr<FRuntimeMeshMorphTargetSet> MorphTargets;
+
+	/** Triangle ratios of the requested LODs. LODs are regenerated in the background whenever the section's geometry changes. */
+	TArray<float> LODTriangleRatios;
+
+	/** Simplified index buffers, one per ratio once generated. They index the section's own vertices. */
+	TArray<TArray<int32>> LODIndexBuffers;
+
+	/** LOD drawn by the render thread. 0 is the full index buffer, LOD N is LODIndexBuffers[N - 1]. */
+	int32 CurrentLOD;
+
+	/** Vertex count the LOD index buffers were generated for */
+	int32 LODNumVertices;
+
+	/** Incremented every time the LODs need regenerating. Generations started before the latest request are discarded. */
+	uint32 LODRevision;
+
+	/** Is a LOD generation running on a worker thread */
+	bool bLODGenerationInFlight;
+
+	/** Snapshot of the section for CPU queries, built on demand. Dropped when the triangles change, refit when only positions change. */
+	FRuntimeMeshBVHPtr BVH;
+
+	/** UpdateRevision the BVH was built or refit at */
+	uint32 BVHRevision;
+
+	/** IndexRevision the BVH was built at. It's only refit while this matches. */
+	uint32 BVHIndexRevision;
+
+	/** Incremented every time the index buffer changes or the vertices are reordered */
+	uint32 IndexRevision;
+
+	/** Half-edge topology of the triangles, built on first use. Kept while only positions or vertex attributes change. */
+	FRuntimeMeshTopologyPtr Topology;
+
+	/** IndexRevision the topology was built at */
+	uint32 TopologyRevision;
+
+	/** Arrays given back by the render thread after uploading this section's large updates, reused for the next ones */
+	FRuntimeMeshBufferPoolPtr BufferPool;
+
+	enum
+	{
+		/* Updates at most this many frames apart count as consecutive */
+		AutoUpdateWindowFrames = 30,
+		/* Consecutive updates that move an Auto section to the dynamic path */
+		AutoDynamicUpdates = 4,
+		/* Frames without updates before an Auto section goes back to the static path */
+		AutoStaticIdleFrames = 300,
+	};
+
 	FRuntimeMeshSectionInterface(bool bInNeedsPositionOnlyBuffer) : 
 		bNeedsPositionOnlyBuffer(bInNeedsPositionOnlyBuffer),
 		LocalBoundingBox(0),
 		CollisionEnabled(false),
 		bIsVisible(true),
 		bCastsShadow(true),
+		UpdateRevision(0),
+		SectionId(0),
+		RenderVertexCapacity(0),
+		RenderIndexCapacity(0),
+		LastUpdateFrame(0),
+		NumConsecutiveUpdates(0),
+		AutoUpdateFrequency(EUpdateFrequency::Infrequent),
+		CurrentLOD(0),
+		LODNumVertices(0),
+		LODRevision(0),
+		bLODGenerationInFlight(false),
+		BVHRevision(0),
+		BVHIndexRevision(0),
+		IndexRevision(0),
+		TopologyRevision(0),
+		BufferPool(MakeShareable(new FRuntimeMeshBufferPool())),
 		bIsInternalSectionType(false)
 	{}
 
@@ -54,6 +149,107 @@ protected:
 
 	bool IsDualBufferSection() const { return bNeedsPositionOnlyBuffer; }
 
+	/* The update frequency the render thread uses, with Auto resolved to the path picked from the update history */
+	EUpdateFrequency GetRenderUpdateFrequency() const
+	{
+		return UpdateFrequency == EUpdateFrequency::Auto ? AutoUpdateFrequency : UpdateFrequency;
+	}
+
+	/* Adds an update to the history. Returns true if this moved an Auto section to the dynamic path. */
+	bool RecordUpdate()
+	{
+		const uint64 Frame = GFrameCounter;
+		if (Frame != LastUpdateFrame || NumConsecutiveUpdates == 0)
+		{
+			NumConsecutiveUpdates = (NumConsecutiveUpdates > 0 && Frame - LastUpdateFrame <= AutoUpdateWindowFrames) ? NumConsecutiveUpdates + 1 : 1;
+			LastUpdateFrame = Frame;
+		}
+
+		if (UpdateFrequency == EUpdateFrequency::Auto && AutoUpdateFrequency == EUpdateFrequency::Infrequent && NumConsecutiveUpdates >= AutoDynamicUpdates)
+		{
+			AutoUpdateFrequency = EUpdateFrequency::Frequent;
+			return true;
+		}
+		return false;
+	}
+
+	/* Moves an idle Auto section back to the static path. Returns true if it moved. */
+	bool UpdateAutoPath()
+	{
+		if (UpdateFrequency == EUpdateFrequency::Auto && AutoUpdateFrequency == EUpdateFrequency::Frequent && GFrameCounter - LastUpdateFrame >= AutoStaticIdleFrames)
+		{
+			AutoUpdateFrequency = EUpdateFrequency::Infrequent;
+			NumConsecutiveUpdates = 0;
+			return true;
+		}
+		return false;
+	}
+
+	/* Keeps the update history of the section this one replaces */
+	void CopyUpdateHistory(const FRuntimeMeshSectionInterface& Other)
+	{
+		LastUpdateFrame = Other.LastUpdateFrame;
+		NumConsecutiveUpdates = Other.NumConsecutiveUpdates;
+		AutoUpdateFrequency = Other.AutoUpdateFrequency;
+	}
+
+	/* Keeps the LOD settings of the section this one replaces. The LODs themselves are regenerated for the new geometry. */
+	void CopyLODSettings(const FRuntimeMeshSectionInterface& Other)
+	{
+		LODTriangleRatios = Other.LODTriangleRatios;
+		CurrentLOD = Other.CurrentLOD;
+	}
+
+	/* Index buffer the render thread draws, the current LOD if it has been generated */
+	const TArray<int32>& GetRenderIndexBuffer() const
+	{
+		return CurrentLOD > 0 && LODIndexBuffers.IsValidIndex(CurrentLOD - 1) ? LODIndexBuffers[CurrentLOD - 1] : IndexBuffer;
+	}
+
+	/* Drops LODs that no longer match the geometry. Returns true if the render thread was drawing one of them. */
+	bool InvalidateLODs(bool bIndicesChanged)
+	{
+		if (LODIndexBuffers.Num() == 0 || (!bIndicesChanged && LODNumVertices == GetNumVertices()))
+		{
+			return false;
+		}
+
+		const bool bWasDrawingLOD = CurrentLOD > 0 && LODIndexBuffers.IsValidIndex(CurrentLOD - 1);
+		LODIndexBuffers.Empty();
+		return bWasDrawingLOD;
+	}
+
+	/* Chooses the render buffer sizes of a static section. Called when the scene proxy is created. */
+	void UpdateRenderCapacity()
+	{
+		if (GetRenderUpdateFrequency() != EUpdateFrequency::Infrequent)
+		{
+			RenderVertexCapacity = 0;
+			RenderIndexCapacity = 0;
+			return;
+		}
+
+		RenderVertexCapacity = GetRenderCapacity(GetNumVertices(), RenderVertexCapacity);
+		RenderIndexCapacity = GetRenderCapacity(IndexBuffer.Num() / 3, RenderIndexCapacity / 3) * 3;
+	}
+
+	/* Can the current data be sent to the existing render buffers, without recreating the scene proxy? */
+	bool CanUpdateRenderBuffersInPlace() const
+	{
+		return GetRenderUpdateFrequency() != EUpdateFrequency::Infrequent ||
+			(GetNumVertices() <= RenderVertexCapacity && IndexBuffer.Num() <= RenderIndexCapacity);
+	}
+
+	static int32 GetRenderCapacity(int32 Needed, int32 CurrentCapacity)
+	{
+		// Leave room to grow once a section has outgrown its buffers, and give it back if the section shrinks a lot
+		if (Needed > CurrentCapacity)
+		{
+			return CurrentCapacity > 0 ? Needed + Needed / 4 : Needed;
+		}
+		return Needed < CurrentCapacity / 2 ? Needed : CurrentCapacity;
+	}
+
 	/* Updates the vertex position buffer,   returns whether we have a new bounding box */
 	bool UpdateVertexPositionBuffer(TArray<FVector>& Positions, const FBox* BoundingBox, bool bShouldMoveArray)
 	{
@@ -94,8 +290,9 @@ protected:
 			}
 			else
 			{
-				// Copy the buffer
-				PositionVertexBuffer = Positions;
+				// Copy the buffer, reusing the allocation if it's big enough
+				PositionVertexBuffer.Reset(Positions.Num());
+				PositionVertexBuffer.Append(Positions);
 
 				// Copy the supplied bounding box instead of calculating it.
 				NewBoundingBox = *BoundingBox;
@@ -114,27 +311,110 @@ protected:
 
 	void UpdateIndexBuffer(TArray<int32>& Triangles, bool bShouldMoveArray)
 	{
+		IndexRevision++;
+
 		if (bShouldMoveArray)
 		{
 			IndexBuffer = MoveTemp(Triangles);
 		}
 		else
 		{
-			IndexBuffer = Triangles;
+			IndexBuffer.Reset(Triangles.Num());
+			IndexBuffer.Append(Triangles);
 		}
 	}
 
-	virtual FRuntimeMeshSectionCreateDataInterface* GetSectionCreationData(UMaterialInterface* InMaterial) const = 0;
+	/* Creates a render thread proxy for this section. Call on the game thread, it's handed over through WriteCreateCommand(). */
+	virtual FRuntimeMeshSectionProxyInterface* CreateProxy(UMaterialInterface* InMaterial) const = 0;
 
-	virtual FRuntimeMeshRenderThreadCommandInterface* GetSectionUpdateData(bool bIncludePositionVertices, bool bIncludeVertices, bool bIncludeIndices) const = 0;
+	/* Writes the command giving a proxy from CreateProxy() this section's buffers */
+	virtual void WriteCreateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex, FRuntimeMeshSectionProxyInterface* NewProxy) const = 0;
 
-	virtual FRuntimeMeshRenderThreadCommandInterface* GetSectionPositionUpdateData() const = 0;
+	/* Writes the command replacing the chosen render thread buffers */
+	virtual void WriteUpdateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex, bool bIncludePositionVertices, bool bIncludeVertices, bool bIncludeIndices) const = 0;
+
+	/* Writes the command updating Count positions starting at StartIndex */
+	void WritePositionUpdateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex, int32 StartIndex, int32 Count) const
+	{
+		check(StartIndex >= 0 && Count >= 0 && StartIndex + Count <= PositionVertexBuffer.Num());
+
+		FRuntimeMeshUpdatePositionsCommand Command;
+		const int32 CommandOffset = Commands.BeginCommand<FRuntimeMeshUpdatePositionsCommand>(ERuntimeMeshCommandType::UpdatePositions, SectionIndex);
+		Command.PositionVertexBuffer = Commands.WriteArray(PositionVertexBuffer.GetData() + StartIndex, Count, BufferPool);
+		Command.StartIndex = StartIndex;
+		Commands.EndCommand(CommandOffset, Command);
+	}
+
+	/* Writes the command updating Count vertices starting at StartIndex */
+	virtual void WriteVertexUpdateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex, int32 StartIndex, int32 Count) const = 0;
+
+	/* Writes the command updating visibility and shadow casting */
+	void WritePropertyUpdateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex) const
+	{
+		FRuntimeMeshUpdatePropertiesCommand Command;
+		Command.bIsVisible = bIsVisible;
+		Command.bCastsShadow = bCastsShadow;
+		Commands.AddCommand(ERuntimeMeshCommandType::UpdateProperties, SectionIndex, Command);
+	}
 
 
 
 
 	virtual int32 GetAllVertexPositions(TArray<FVector>& Positions) = 0;
 
+	/* Appends the first UV channel of every vertex, or zeros if the vertex type has none */
+	virtual int32 GetAllVertexUVs(TArray<FVector2D>& UVs) = 0;
+
+	virtual int32 GetNumVertices() const = 0;
+
+	/* Moves every vertex to a new index. Remap holds the new index of each vertex. The index buffer is left to the caller. */
+	virtual void RemapVertices(const TArray<int32>& Remap)
+	{
+		IndexRevision++;
+
+		if (IsDualBufferSection())
+		{
+			FRuntimeMeshOptimizer::RemapVertexBuffer(PositionVertexBuffer, Remap);
+		}
+
+		if (MorphTargets.IsValid())
+		{
+			MorphTargets->RemapVertices(Remap);
+		}
+	}
+
+	/* Takes the buffer allocations of an unused section of the same vertex type, so filling this section can reuse them */
+	virtual void TakeBufferAllocations(FRuntimeMeshSectionInterface& Other)
+	{
+		PositionVertexBuffer = MoveTemp(Other.PositionVertexBuffer);
+		PositionVertexBuffer.Reset();
+
+		IndexBuffer = MoveTemp(Other.IndexBuffer);
+		IndexBuffer.Reset();
+
+		BufferPool = Other.BufferPool;
+	}
+
+	/* Half-edge topology of the triangles, rebuilt if the triangles changed since it was last used */
+	FRuntimeMeshTopologyPtr GetTopology()
+	{
+		if (!Topology.IsValid() || TopologyRevision != IndexRevision || Topology->GetNumVertices() != GetNumVertices())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_BuildTopology);
+
+			Topology = MakeShareable(new FRuntimeMeshTopology(IndexBuffer, GetNumVertices()));
+			TopologyRevision = IndexRevision;
+		}
+		return Topology;
+	}
+
+	/**
+	*	Recalculates the normals and tangents around vertices of a dual buffer section that were moved, from the current positions.
+	*	@out	OutStartIndex, OutCount		Range of vertices that changed
+	*	Returns false if nothing changed, as for vertex types without tangents or single buffer sections.
+	*/
+	virtual bool RecalculateNormalTangents(const TArray<int32>& MovedVertices, int32& OutStartIndex, int32& OutCount) = 0;
+
 	virtual void GetInternalVertexComponents(int32& NumUVChannels, bool& WantsHalfPrecisionUVs) { }
 
 	// This is only meant for internal use for supporting the old style create/update sections
@@ -143,6 +423,19 @@ protected:
 
 	virtual const FRuntimeMeshVertexTypeInfo* GetVertexType() const = 0;
 
+	/**
+	*	Slices the section with a plane into new sections of the same type, with the same properties. A half without
+	*	triangles is left null. Returns false without creating anything if the whole section is on the positive side.
+	*	Only reads this section, so sections can be sliced in parallel.
+	*/
+	virtual bool Slice(const FPlane& Plane, bool bCreateCap, TSharedPtr<FRuntimeMeshSectionInterface>& OutPositive, TSharedPtr<FRuntimeMeshSectionInterface>& OutNegative) const = 0;
+
+	/**
+	*	Combines this section with another section of the same vertex type into a new section with this one's properties.
+	*	The snapshots must be current for both sections. Returns null if nothing is left.
+	*/
+	virtual TSharedPtr<FRuntimeMeshSectionInterface> Boolean(const FRuntimeMeshSectionInterface& Other, const FRuntimeMeshBVH& ThisBVH, const FRuntimeMeshBVH& OtherBVH, ERuntimeMeshBooleanOperation Operation) const = 0;
+
 
 	virtual void Serialize(FArchive& Ar)
 	{
@@ -168,6 +461,7 @@ protected:
 
 	friend class FRuntimeMeshSceneProxy;
 	friend class URuntimeMeshComponent;
+	friend class FRuntimeMeshPositionWriter;
 };
 
 namespace RuntimeMeshSectionInternal
@@ -192,6 +486,43 @@ namespace RuntimeMeshSectionInternal
 		return PositionVertexBuffer.Num();
 	}
 
+	template<typename Type>
+	static typename TEnableIf<FVertexHasPositionComponent<Type>::Value>::Type
+		SetAllVertexPositions(TArray<Type>& VertexBuffer, const TArray<FVector>& Positions)
+	{
+		check(VertexBuffer.Num() == Positions.Num());
+		for (int32 VertIdx = 0; VertIdx < VertexBuffer.Num(); VertIdx++)
+		{
+			VertexBuffer[VertIdx].Position = Positions[VertIdx];
+		}
+	}
+
+	template<typename Type>
+	static typename TEnableIf<!FVertexHasPositionComponent<Type>::Value>::Type
+		SetAllVertexPositions(TArray<Type>& VertexBuffer, const TArray<FVector>& Positions)
+	{
+	}
+
+	template<typename Type>
+	static typename TEnableIf<FVertexHasUV0Component<Type>::Value, int32>::Type
+		GetAllVertexUVs(const TArray<Type>& VertexBuffer, TArray<FVector2D>& UVs)
+	{
+		int32 VertexCount = VertexBuffer.Num();
+		for (int32 VertIdx = 0; VertIdx < VertexCount; VertIdx++)
+		{
+			UVs.Add(FVector2D(VertexBuffer[VertIdx].UV0));
+		}
+		return VertexCount;
+	}
+
+	template<typename Type>
+	static typename TEnableIf<!FVertexHasUV0Component<Type>::Value, int32>::Type
+		GetAllVertexUVs(const TArray<Type>& VertexBuffer, TArray<FVector2D>& UVs)
+	{
+		UVs.AddZeroed(VertexBuffer.Num());
+		return VertexBuffer.Num();
+	}
+
 
 
 	template<typename Type>
@@ -235,8 +566,9 @@ namespace RuntimeMeshSectionInternal
 			}
 			else
 			{
-				// Copy the buffer
-				VertexBuffer = Vertices;
+				// Copy the buffer, reusing the allocation if it's big enough
+				VertexBuffer.Reset(Vertices.Num());
+				VertexBuffer.Append(Vertices);
 
 				// Copy the supplied bounding box instead of calculating it.
 				NewBoundingBox = *BoundingBox;
@@ -263,7 +595,8 @@ namespace RuntimeMeshSectionInternal
 		}
 		else
 		{
-			VertexBuffer = Vertices;
+			VertexBuffer.Reset(Vertices.Num());
+			VertexBuffer.Append(Vertices);
 		}
 		return false;
 	}
@@ -288,68 +621,231 @@ protected:
 		return RuntimeMeshSectionInternal::UpdateVertexBufferInternal<VertexType>(VertexBuffer, LocalBoundingBox, Vertices, BoundingBox, bShouldMoveArray);
 	}
 
-	virtual FRuntimeMeshSectionCreateDataInterface* GetSectionCreationData(UMaterialInterface* InMaterial) const override
+	virtual FRuntimeMeshSectionProxyInterface* CreateProxy(UMaterialInterface* InMaterial) const override
 	{
-		auto UpdateData = new FRuntimeMeshSectionCreateData<VertexType>();
-
 		// Create new section proxy based on whether we need separate position buffer
 		if (IsDualBufferSection())
 		{
-			UpdateData->NewProxy = new FRuntimeMeshSectionProxy<VertexType, true>(UpdateFrequency, bIsVisible, bCastsShadow, InMaterial);
-			UpdateData->PositionVertexBuffer = PositionVertexBuffer;
+			return new FRuntimeMeshSectionProxy<VertexType, true>(GetRenderUpdateFrequency(), bIsVisible, bCastsShadow, InMaterial);
 		}
 		else
 		{
-			UpdateData->NewProxy = new FRuntimeMeshSectionProxy<VertexType, false>(UpdateFrequency, bIsVisible, bCastsShadow, InMaterial);
+			return new FRuntimeMeshSectionProxy<VertexType, false>(GetRenderUpdateFrequency(), bIsVisible, bCastsShadow, InMaterial);
 		}
+	}
+
+	virtual void WriteCreateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex, FRuntimeMeshSectionProxyInterface* NewProxy) const override
+	{
+		check(NewProxy);
+
+		FRuntimeMeshCreateSectionCommand Command;
+		const int32 CommandOffset = Commands.BeginCommand<FRuntimeMeshCreateSectionCommand>(ERuntimeMeshCommandType::CreateSection, SectionIndex);
+		Command.NewProxy = NewProxy;
 
-		UpdateData->VertexBuffer = VertexBuffer;
-		UpdateData->IndexBuffer = IndexBuffer;
+		if (IsDualBufferSection())
+		{
+			Command.PositionVertexBuffer = Commands.WriteArray(PositionVertexBuffer, BufferPool);
+		}
 
-		return UpdateData;
+		Command.VertexBuffer = Commands.WriteArray(VertexBuffer, BufferPool);
+		Command.IndexBuffer = Commands.WriteArray(GetRenderIndexBuffer(), BufferPool);
+		Command.VertexCapacity = RenderVertexCapacity;
+		Command.IndexCapacity = RenderIndexCapacity;
+
+		Commands.EndCommand(CommandOffset, Command);
+	}
+
+	virtual void WriteVertexUpdateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex, int32 StartIndex, int32 Count) const override
+	{
+		check(StartIndex >= 0 && Count >= 0 && StartIndex + Count <= VertexBuffer.Num());
+
+		FRuntimeMeshUpdateVerticesCommand Command;
+		const int32 CommandOffset = Commands.BeginCommand<FRuntimeMeshUpdateVerticesCommand>(ERuntimeMeshCommandType::UpdateVertices, SectionIndex);
+		Command.VertexBuffer = Commands.WriteArray(VertexBuffer.GetData() + StartIndex, Count, BufferPool);
+		Command.StartIndex = StartIndex;
+		Commands.EndCommand(CommandOffset, Command);
 	}
 
-	virtual FRuntimeMeshRenderThreadCommandInterface* GetSectionUpdateData(bool bIncludePositionVertices, bool bIncludeVertices, bool bIncludeIndices) const override
+	virtual void WriteUpdateCommand(FRuntimeMeshCommandBuffer& Commands, int32 SectionIndex, bool bIncludePositionVertices, bool bIncludeVertices, bool bIncludeIndices) const override
 	{
-		auto UpdateData = new FRuntimeMeshSectionUpdateData<VertexType>();
-		UpdateData->bIncludeVertexBuffer = bIncludeVertices;
-		UpdateData->bIncludePositionBuffer = bIncludePositionVertices;
-		UpdateData->bIncludeIndices = bIncludeIndices;
+		FRuntimeMeshUpdateSectionCommand Command;
+		const int32 CommandOffset = Commands.BeginCommand<FRuntimeMeshUpdateSectionCommand>(ERuntimeMeshCommandType::UpdateSection, SectionIndex);
+		Command.bIncludeVertexBuffer = bIncludeVertices;
+		Command.bIncludePositionBuffer = bIncludePositionVertices;
+		Command.bIncludeIndices = bIncludeIndices;
 
 		if (bIncludePositionVertices)
 		{
-			UpdateData->PositionVertexBuffer = PositionVertexBuffer;
+			Command.PositionVertexBuffer = Commands.WriteArray(PositionVertexBuffer, BufferPool);
 		}
 
 		if (bIncludeVertices)
 		{
-			UpdateData->VertexBuffer = VertexBuffer;
+			Command.VertexBuffer = Commands.WriteArray(VertexBuffer, BufferPool);
 		}
 
 		if (bIncludeIndices)
 		{
-			UpdateData->IndexBuffer = IndexBuffer;
+			Command.IndexBuffer = Commands.WriteArray(GetRenderIndexBuffer(), BufferPool);
 		}
 
-		return UpdateData;
+		Commands.EndCommand(CommandOffset, Command);
 	}
 
-	virtual FRuntimeMeshRenderThreadCommandInterface* GetSectionPositionUpdateData() const override
+	virtual int32 GetAllVertexPositions(TArray<FVector>& Positions) override
 	{
-		auto UpdateData = new FRuntimeMeshSectionPositionOnlyUpdateData<VertexType>();
+		return RuntimeMeshSectionInternal::GetAllVertexPositions<VertexType>(VertexBuffer, PositionVertexBuffer, Positions);
+	}
 
-		UpdateData->PositionVertexBuffer = PositionVertexBuffer;
+	virtual int32 GetAllVertexUVs(TArray<FVector2D>& UVs) override
+	{
+		return RuntimeMeshSectionInternal::GetAllVertexUVs<VertexType>(VertexBuffer, UVs);
+	}
 
-		return UpdateData;
+	virtual int32 GetNumVertices() const override
+	{
+		return VertexBuffer.Num();
 	}
 
-	virtual int32 GetAllVertexPositions(TArray<FVector>& Positions) override
+	virtual void RemapVertices(const TArray<int32>& Remap) override
 	{
-		return RuntimeMeshSectionInternal::GetAllVertexPositions<VertexType>(VertexBuffer, PositionVertexBuffer, Positions);
+		FRuntimeMeshSectionInterface::RemapVertices(Remap);
+		FRuntimeMeshOptimizer::RemapVertexBuffer(VertexBuffer, Remap);
+	}
+
+	virtual void TakeBufferAllocations(FRuntimeMeshSectionInterface& Other) override
+	{
+		check(GetVertexType()->Equals(Other.GetVertexType()));
+
+		FRuntimeMeshSectionInterface::TakeBufferAllocations(Other);
+
+		VertexBuffer = MoveTemp(static_cast<FRuntimeMeshSection<VertexType>&>(Other).VertexBuffer);
+		VertexBuffer.Reset();
 	}
 
 	virtual const FRuntimeMeshVertexTypeInfo* GetVertexType() const { return &VertexType::TypeInfo; }
 
+	virtual bool RecalculateNormalTangents(const TArray<int32>& MovedVertices, int32& OutStartIndex, int32& OutCount) override
+	{
+		typedef TRuntimeMeshTangents<VertexType> FTangents;
+
+		OutStartIndex = 0;
+		OutCount = 0;
+
+		if (!FTangents::Interpolator::bHasTangents || !IsDualBufferSection() || MovedVertices.Num() == 0)
+		{
+			return false;
+		}
+
+		const FRuntimeMeshTopologyPtr SectionTopology = GetTopology();
+
+		TArray<int32> Affected;
+		SectionTopology->GetOneRingNeighborhood(MovedVertices, Affected);
+		if (Affected.Num() == 0)
+		{
+			return false;
+		}
+
+		FTangents::Recalculate(PositionVertexBuffer, VertexBuffer, IndexBuffer, *SectionTopology, Affected);
+
+		OutStartIndex = Affected[0];
+		OutCount = Affected.Last() - Affected[0] + 1;
+		return true;
+	}
+
+	/* Creates an empty section of the same type, for sections built from this one */
+	virtual TSharedPtr<FRuntimeMeshSection<VertexType>> CreateEmptySection() const
+	{
+		return MakeShareable(new FRuntimeMeshSection<VertexType>(IsDualBufferSection()));
+	}
+
+	virtual bool Slice(const FPlane& Plane, bool bCreateCap, TSharedPtr<FRuntimeMeshSectionInterface>& OutPositive, TSharedPtr<FRuntimeMeshSectionInterface>& OutNegative) const override
+	{
+		typedef TRuntimeMeshSlicer<VertexType> FSlicer;
+
+		TArray<FVector> Positions;
+		if (!IsDualBufferSection())
+		{
+			RuntimeMeshSectionInternal::GetAllVertexPositions<VertexType>(VertexBuffer, PositionVertexBuffer, Positions);
+		}
+
+		typename FSlicer::FHalf Halves[2];
+		if (!FSlicer::Slice(IsDualBufferSection() ? PositionVertexBuffer : Positions, VertexBuffer, IndexBuffer, Plane, bCreateCap, Halves[0], Halves[1]))
+		{
+			return false;
+		}
+
+		TSharedPtr<FRuntimeMeshSectionInterface>* Outputs[2] = { &OutPositive, &OutNegative };
+		for (int32 Side = 0; Side < 2; Side++)
+		{
+			typename FSlicer::FHalf& Half = Halves[Side];
+			if (Half.Triangles.Num() == 0)
+			{
+				Outputs[Side]->Reset();
+				continue;
+			}
+
+			*Outputs[Side] = CreateDerivedSection(MoveTemp(Half.Positions), MoveTemp(Half.Vertices), MoveTemp(Half.Triangles), Half.BoundingBox);
+		}
+		return true;
+	}
+
+	virtual TSharedPtr<FRuntimeMeshSectionInterface> Boolean(const FRuntimeMeshSectionInterface& Other, const FRuntimeMeshBVH& ThisBVH, const FRuntimeMeshBVH& OtherBVH, ERuntimeMeshBooleanOperation Operation) const override
+	{
+		typedef TRuntimeMeshBoolean<VertexType> FBoolean;
+
+		check(Other.GetVertexType()->Equals(GetVertexType()));
+		const FRuntimeMeshSection<VertexType>& OtherSection = static_cast<const FRuntimeMeshSection<VertexType>&>(Other);
+
+		FRuntimeMeshBooleanCut Cuts[2];
+		ParallelFor(2, [&](int32 Operand)
+		{
+			FRuntimeMeshBoolean::Cut(Operand == 0 ? ThisBVH : OtherBVH, Operand == 0 ? OtherBVH : ThisBVH, Operation, Operand == 0, Cuts[Operand]);
+		});
+
+		TArray<FVector> Positions;
+		TArray<VertexType> Vertices;
+		TArray<int32> Triangles;
+		FBox BoundingBox(0);
+		FBoolean::Append(VertexBuffer, ThisBVH, Cuts[0], Positions, Vertices, Triangles, BoundingBox);
+		const int32 FirstOtherTriangle = Triangles.Num() / 3;
+		FBoolean::Append(OtherSection.VertexBuffer, OtherBVH, Cuts[1], Positions, Vertices, Triangles, BoundingBox);
+		FBoolean::WeldSeam(FirstOtherTriangle, Positions, Vertices, Triangles);
+
+		if (Triangles.Num() == 0)
+		{
+			return nullptr;
+		}
+		return CreateDerivedSection(MoveTemp(Positions), MoveTemp(Vertices), MoveTemp(Triangles), BoundingBox);
+	}
+
+private:
+	/* Creates a section of the same type and with the same properties as this one, holding new geometry */
+	TSharedPtr<FRuntimeMeshSection<VertexType>> CreateDerivedSection(TArray<FVector>&& InPositions, TArray<VertexType>&& InVertices, TArray<int32>&& InTriangles, const FBox& InBoundingBox) const
+	{
+		TSharedPtr<FRuntimeMeshSection<VertexType>> NewSection = CreateEmptySection();
+		NewSection->bIsInternalSectionType = bIsInternalSectionType;
+
+		if (IsDualBufferSection())
+		{
+			NewSection->PositionVertexBuffer = MoveTemp(InPositions);
+		}
+		else
+		{
+			RuntimeMeshSectionInternal::SetAllVertexPositions<VertexType>(InVertices, InPositions);
+		}
+		NewSection->VertexBuffer = MoveTemp(InVertices);
+		NewSection->IndexBuffer = MoveTemp(InTriangles);
+		NewSection->LocalBoundingBox = InBoundingBox;
+
+		NewSection->CollisionEnabled = CollisionEnabled;
+		NewSection->bIsVisible = bIsVisible;
+		NewSection->bCastsShadow = bCastsShadow;
+		NewSection->UpdateFrequency = UpdateFrequency;
+
+		return NewSection;
+	}
+
 	friend class URuntimeMeshComponent;
 };
 
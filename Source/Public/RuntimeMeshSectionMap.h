@@ -0,0 +1,161 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+/**
+*	Sparse container keyed by section index.
+*
+*	Values are kept packed in a dense array, so iterating only visits sections that exist no matter how large
+*	or scattered the indices are (sections keyed by chunk coordinates for example). Removing a section moves
+*	the last value into its slot, so iteration order is not the order of the section indices.
+*	Range based for loops iterate the values.
+*/
+template<typename ValueType>
+class TRuntimeMeshSectionMap
+{
+public:
+	/* Number of sections in the map */
+	int32 Num() const { return Values.Num(); }
+
+	bool Contains(int32 SectionIndex) const { return KeyToDenseIndex.Contains(SectionIndex); }
+
+	ValueType* Find(int32 SectionIndex)
+	{
+		const int32* DenseIndex = KeyToDenseIndex.Find(SectionIndex);
+		return DenseIndex ? &Values[*DenseIndex] : nullptr;
+	}
+
+	const ValueType* Find(int32 SectionIndex) const
+	{
+		const int32* DenseIndex = KeyToDenseIndex.Find(SectionIndex);
+		return DenseIndex ? &Values[*DenseIndex] : nullptr;
+	}
+
+	/* Gets the value for a section, adding a value initialized one if it doesn't exist */
+	ValueType& FindOrAdd(int32 SectionIndex)
+	{
+		check(SectionIndex >= 0);
+		if (const int32* DenseIndex = KeyToDenseIndex.Find(SectionIndex))
+		{
+			return Values[*DenseIndex];
+		}
+
+		KeyToDenseIndex.Add(SectionIndex, Values.Num());
+		Keys.Add(SectionIndex);
+		return Values[Values.Add(ValueType())];
+	}
+
+	/* Gets the value for a section that must exist */
+	ValueType& operator[](int32 SectionIndex)
+	{
+		ValueType* Value = Find(SectionIndex);
+		check(Value && "Invalid SectionIndex.");
+		return *Value;
+	}
+
+	const ValueType& operator[](int32 SectionIndex) const
+	{
+		const ValueType* Value = Find(SectionIndex);
+		check(Value && "Invalid SectionIndex.");
+		return *Value;
+	}
+
+	/* Removes a section, optionally returning its value. Returns false if the section didn't exist. */
+	bool Remove(int32 SectionIndex, ValueType* OutRemovedValue = nullptr)
+	{
+		int32 DenseIndex;
+		if (!KeyToDenseIndex.RemoveAndCopyValue(SectionIndex, DenseIndex))
+		{
+			return false;
+		}
+
+		if (OutRemovedValue)
+		{
+			*OutRemovedValue = MoveTemp(Values[DenseIndex]);
+		}
+
+		// Move the last section into the hole
+		const int32 LastIndex = Values.Num() - 1;
+		if (DenseIndex != LastIndex)
+		{
+			Values[DenseIndex] = MoveTemp(Values[LastIndex]);
+			Keys[DenseIndex] = Keys[LastIndex];
+			KeyToDenseIndex[Keys[DenseIndex]] = DenseIndex;
+		}
+		Values.RemoveAt(LastIndex, 1, false);
+		Keys.RemoveAt(LastIndex, 1, false);
+		return true;
+	}
+
+	void Empty()
+	{
+		Keys.Empty();
+		Values.Empty();
+		KeyToDenseIndex.Empty();
+	}
+
+	/* Removes all sections, keeping the allocations */
+	void Reset()
+	{
+		Keys.Reset();
+		Values.Reset();
+		KeyToDenseIndex.Reset();
+	}
+
+	void Reserve(int32 Number)
+	{
+		Keys.Reserve(Number);
+		Values.Reserve(Number);
+		KeyToDenseIndex.Reserve(Number);
+	}
+
+	/* Section index of the value at a position in the dense array, for iterating with indices */
+	int32 GetKeyAt(int32 DenseIndex) const { return Keys[DenseIndex]; }
+
+	ValueType& GetValueAt(int32 DenseIndex) { return Values[DenseIndex]; }
+	const ValueType& GetValueAt(int32 DenseIndex) const { return Values[DenseIndex]; }
+
+	/* Largest section index in the map, or -1 if it's empty */
+	int32 GetMaxKey() const
+	{
+		int32 MaxKey = -1;
+		for (int32 Key : Keys)
+		{
+			MaxKey = FMath::Max(MaxKey, Key);
+		}
+		return MaxKey;
+	}
+
+	/* Smallest section index not in the map */
+	int32 GetFirstUnusedKey() const
+	{
+		// With N sections one of the indices 0 to N is always free, so larger indices can be ignored
+		TBitArray<> UsedKeys(false, Keys.Num() + 1);
+		for (int32 Key : Keys)
+		{
+			if (Key < UsedKeys.Num())
+			{
+				UsedKeys[Key] = true;
+			}
+		}
+		const int32 FirstUnused = UsedKeys.Find(false);
+		return FirstUnused != INDEX_NONE ? FirstUnused : Keys.Num();
+	}
+
+	ValueType* begin() { return Values.GetData(); }
+	ValueType* end() { return Values.GetData() + Values.Num(); }
+	const ValueType* begin() const { return Values.GetData(); }
+	const ValueType* end() const { return Values.GetData() + Values.Num(); }
+
+private:
+	/* Section index of each value */
+	TArray<int32> Keys;
+
+	/* Packed values */
+	TArray<ValueType> Values;
+
+	/* Position of each section in the packed arrays */
+	TMap<int32, int32> KeyToDenseIndex;
+};
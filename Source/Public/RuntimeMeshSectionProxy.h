@@ -22,14 +22,18 @@ public:
 	virtual bool ShouldRender() = 0;
 	virtual bool WantsToRenderInStaticPath() const = 0;
 
+	/* Does this section have render buffers to draw? Hidden sections still have them. */
+	virtual bool HasRenderBuffers() = 0;
+
 
 	virtual void CreateMeshBatch(FMeshBatch& MeshBatch, FMaterialRenderProxy* WireframeMaterial, bool bIsSelected) = 0;
 
 
-	virtual void FinishCreate_RenderThread(FRuntimeMeshSectionCreateDataInterface* UpdateData) = 0;
-	virtual void FinishUpdate_RenderThread(FRuntimeMeshRenderThreadCommandInterface* UpdateData) = 0;
-	virtual void FinishPositionUpdate_RenderThread(FRuntimeMeshRenderThreadCommandInterface* UpdateData) = 0;
-	virtual void FinishPropertyUpdate_RenderThread(FRuntimeMeshRenderThreadCommandInterface* UpdateData) = 0;
+	virtual void FinishCreate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshCreateSectionCommand& Command) = 0;
+	virtual void FinishUpdate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdateSectionCommand& Command) = 0;
+	virtual void FinishPositionUpdate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdatePositionsCommand& Command) = 0;
+	virtual void FinishVertexUpdate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdateVerticesCommand& Command) = 0;
+	virtual void FinishPropertyUpdate_RenderThread(const FRuntimeMeshUpdatePropertiesCommand& Command) = 0;
 
 };
 
@@ -61,10 +65,21 @@ protected:
 	/** Vertex factory for this section */
 	FRuntimeMeshVertexFactory VertexFactory;
 
+	/**
+	*	Minimum size of the vertex and index buffers. Static sections are drawn through mesh batches cached when the
+	*	scene proxy is created, so their buffers keep this size to let updates be applied in place.
+	*/
+	int32 VertexCapacity;
+	int32 IndexCapacity;
+
+	/** Number of indices in use, the rest of the index buffer is degenerate triangles */
+	int32 NumIndices;
+
 public:
 	FRuntimeMeshSectionProxy(EUpdateFrequency InUpdateFrequency, bool bInIsVisible, bool bInCastsShadow, UMaterialInterface* InMaterial) :
 		bIsVisible(bInIsVisible), bCastsShadow(bInCastsShadow), UpdateFrequency(InUpdateFrequency), Material(InMaterial), 
-		PositionVertexBuffer(nullptr), VertexBuffer(InUpdateFrequency), IndexBuffer(InUpdateFrequency), VertexFactory(this) { }
+		PositionVertexBuffer(nullptr), VertexBuffer(InUpdateFrequency), IndexBuffer(InUpdateFrequency), VertexFactory(this),
+		VertexCapacity(0), IndexCapacity(0), NumIndices(0) { }
 	virtual ~FRuntimeMeshSectionProxy() override
 	{
 		VertexBuffer.ReleaseResource();
@@ -79,10 +94,12 @@ public:
 	}
 
 
-	virtual bool ShouldRender() override { return bIsVisible && VertexBuffer.Num() > 0 && IndexBuffer.Num() > 0; }
+	virtual bool ShouldRender() override { return bIsVisible && VertexBuffer.Num() > 0 && NumIndices > 0; }
 
 	virtual bool WantsToRenderInStaticPath() const override { return UpdateFrequency == EUpdateFrequency::Infrequent; }
 
+	virtual bool HasRenderBuffers() override { return VertexBuffer.Num() > 0 && IndexBuffer.Num() > 0; }
+
 
 	virtual void CreateMeshBatch(FMeshBatch& MeshBatch, FMaterialRenderProxy* WireframeMaterial, bool bIsSelected) override
 	{
@@ -102,13 +119,10 @@ public:
 	}
 
 
-	virtual void FinishCreate_RenderThread(FRuntimeMeshSectionCreateDataInterface* UpdateData) override
+	virtual void FinishCreate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshCreateSectionCommand& Command) override
 	{
  		check(IsInRenderingThread());
 
-		auto* SectionUpdateData = UpdateData->As<FRuntimeMeshSectionCreateData<VertexType>>();
-		check(SectionUpdateData);
-		
 		if (NeedsPositionOnlyBuffer)
 		{
 			// Initialize the position buffer
@@ -129,71 +143,73 @@ public:
 		// Initialize the vertex factory
 		VertexFactory.InitResource();
 
-		auto& Vertices = SectionUpdateData->VertexBuffer;
-		VertexBuffer.SetNum(Vertices.Num());
-		VertexBuffer.SetData(Vertices);
+		VertexCapacity = Command.VertexCapacity;
+		IndexCapacity = Command.IndexCapacity;
+
+		const int32 NumVertices = Command.VertexBuffer.Num;
+		VertexBuffer.SetNum(FMath::Max(NumVertices, VertexCapacity));
+		VertexBuffer.SetData(Commands.GetArrayData<VertexType>(Command.VertexBuffer), NumVertices);
 
 		if (NeedsPositionOnlyBuffer)
 		{
-			auto& PositionVertices = SectionUpdateData->PositionVertexBuffer;
-			PositionVertexBuffer->SetNum(PositionVertices.Num());
-			PositionVertexBuffer->SetData(PositionVertices);
+			const int32 NumPositions = Command.PositionVertexBuffer.Num;
+			PositionVertexBuffer->SetNum(FMath::Max(NumPositions, VertexCapacity));
+			PositionVertexBuffer->SetData(Commands.GetArrayData<FVector>(Command.PositionVertexBuffer), NumPositions);
 		}
 
-		auto& Indices = SectionUpdateData->IndexBuffer;
-		IndexBuffer.SetNum(Indices.Num());
-		IndexBuffer.SetData(Indices);
+		NumIndices = Command.IndexBuffer.Num;
+		IndexBuffer.SetNum(FMath::Max(NumIndices, IndexCapacity));
+		IndexBuffer.SetData(Commands.GetArrayData<int32>(Command.IndexBuffer), NumIndices);
 	}
 	
-	virtual void FinishUpdate_RenderThread(FRuntimeMeshRenderThreadCommandInterface* UpdateData) override
+	virtual void FinishUpdate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdateSectionCommand& Command) override
 	{
 		check(IsInRenderingThread());
 
-		auto* SectionUpdateData = UpdateData->As<FRuntimeMeshSectionUpdateData<VertexType>>();
-		check(SectionUpdateData);
-
-		if (SectionUpdateData->bIncludeVertexBuffer)
+		// Buffers within capacity are written in place, so cached static mesh batches stay valid
+		if (Command.bIncludeVertexBuffer)
 		{
-			auto& VertexBufferData = SectionUpdateData->VertexBuffer;
-			VertexBuffer.SetNum(VertexBufferData.Num());
-			VertexBuffer.SetData(VertexBufferData);
+			const int32 NumVertices = Command.VertexBuffer.Num;
+			VertexBuffer.SetNum(FMath::Max(NumVertices, VertexCapacity));
+			VertexBuffer.SetData(Commands.GetArrayData<VertexType>(Command.VertexBuffer), NumVertices);
 		}
 
-		if (NeedsPositionOnlyBuffer && SectionUpdateData->bIncludePositionBuffer)
+		if (NeedsPositionOnlyBuffer && Command.bIncludePositionBuffer)
 		{
-			auto& PositionVertices = SectionUpdateData->PositionVertexBuffer;
-			PositionVertexBuffer->SetNum(PositionVertices.Num());
-			PositionVertexBuffer->SetData(PositionVertices);
+			const int32 NumPositions = Command.PositionVertexBuffer.Num;
+			PositionVertexBuffer->SetNum(FMath::Max(NumPositions, VertexCapacity));
+			PositionVertexBuffer->SetData(Commands.GetArrayData<FVector>(Command.PositionVertexBuffer), NumPositions);
 		}
 
-		if (SectionUpdateData->bIncludeIndices)
+		if (Command.bIncludeIndices)
 		{
-			auto& IndexBufferData = SectionUpdateData->IndexBuffer;
-			IndexBuffer.SetNum(IndexBufferData.Num());
-			IndexBuffer.SetData(IndexBufferData);
+			NumIndices = Command.IndexBuffer.Num;
+			IndexBuffer.SetNum(FMath::Max(NumIndices, IndexCapacity));
+			IndexBuffer.SetData(Commands.GetArrayData<int32>(Command.IndexBuffer), NumIndices);
 		}
 	}
 
-	virtual void FinishPositionUpdate_RenderThread(FRuntimeMeshRenderThreadCommandInterface* UpdateData) override 
+	virtual void FinishPositionUpdate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdatePositionsCommand& Command) override 
 	{
 		check(IsInRenderingThread());
 
-		// Get the Position Only update data
-		auto* SectionUpdateData = UpdateData->As<FRuntimeMeshSectionPositionOnlyUpdateData<VertexType>>();
-		check(SectionUpdateData);
-		
 		// Copy the new data to the gpu
-		PositionVertexBuffer->SetData(SectionUpdateData->PositionVertexBuffer);
+		PositionVertexBuffer->SetData(Commands.GetArrayData<FVector>(Command.PositionVertexBuffer), Command.PositionVertexBuffer.Num, Command.StartIndex);
 	}
 
-	virtual void FinishPropertyUpdate_RenderThread(FRuntimeMeshRenderThreadCommandInterface* UpdateData) override
+	virtual void FinishVertexUpdate_RenderThread(const FRuntimeMeshCommandBuffer& Commands, const FRuntimeMeshUpdateVerticesCommand& Command) override
 	{
-		auto* SectionUpdateData = UpdateData->As<FRuntimeMeshSectionPropertyUpdateData>();
-		check(SectionUpdateData);
+		check(IsInRenderingThread());
+
+		// Copy the new data to the gpu
+		VertexBuffer.SetData(Commands.GetArrayData<VertexType>(Command.VertexBuffer), Command.VertexBuffer.Num, Command.StartIndex);
+	}
 
+	virtual void FinishPropertyUpdate_RenderThread(const FRuntimeMeshUpdatePropertiesCommand& Command) override
+	{
 		// Copy visibility/shadow
-		bIsVisible = SectionUpdateData->bIsVisible;
-		bCastsShadow = SectionUpdateData->bCastsShadow;
+		bIsVisible = Command.bIsVisible;
+		bCastsShadow = Command.bCastsShadow;
 	}
 
 };
@@ -0,0 +1,101 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+/**
+*	Quadric error edge collapse simplification (Garland and Heckbert).
+*
+*	Vertices are only ever collapsed onto other existing vertices, so the simplified meshes are index buffers
+*	into the original vertex buffer. That makes it work with every vertex type, and lets LODs share the
+*	section's vertices instead of duplicating them.
+*
+*	Vertices with the same position are treated as one point for topology. Points with more than one vertex
+*	(UV seams, hard edges) and points on open or non manifold edges are never moved, so seams and borders keep
+*	their shape. Collapses that would flip a triangle or make the mesh non manifold are skipped.
+*
+*	None of this touches the engine and it is safe to run off the game thread.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshSimplifier
+{
+public:
+	FRuntimeMeshSimplifier(const TArray<FVector>& Positions, const TArray<int32>& Indices);
+
+	/* Collapses edges until at most TargetTriangles remain, or nothing more can collapse. Can be called again with a lower target. */
+	void Simplify(int32 TargetTriangles);
+
+	int32 GetNumTriangles() const { return NumAliveTriangles; }
+
+	/* Index buffer of the remaining triangles, referencing the original vertices */
+	void GetIndices(TArray<int32>& OutIndices) const;
+
+	/**
+	*	Builds one simplified index buffer per ratio of the source triangle count. Each LOD is simplified
+	*	further from the previous one, so the whole chain costs about as much as the smallest LOD alone.
+	*	@out	OutLODIndices	One index buffer per ratio, in the order of TriangleRatios
+	*/
+	static void GenerateLODs(const TArray<FVector>& Positions, const TArray<int32>& Indices, const TArray<float>& TriangleRatios, TArray<TArray<int32>>& OutLODIndices);
+
+private:
+	/* Symmetric 4x4 error quadric, upper triangle only */
+	struct FQuadric
+	{
+		double A[10];
+
+		FQuadric() { FMemory::Memzero(A); }
+		FQuadric(const FVector& Normal, float Distance, float Weight);
+
+		FQuadric& operator+=(const FQuadric& Other)
+		{
+			for (int32 Index = 0; Index < 10; Index++)
+			{
+				A[Index] += Other.A[Index];
+			}
+			return *this;
+		}
+
+		double Evaluate(const FVector& Position) const;
+	};
+
+	/* Moving point From onto point To */
+	struct FCollapse
+	{
+		double Cost;
+		int32 From;
+		int32 To;
+		/* Revisions of both points when this was queued. The cost is stale once either changes. */
+		uint32 FromRevision;
+		uint32 ToRevision;
+
+		bool operator<(const FCollapse& Other) const { return Cost < Other.Cost; }
+	};
+
+	/* Vertex index of each triangle corner */
+	TArray<int32> Corners;
+	TArray<bool> TriangleRemoved;
+	int32 NumAliveTriangles;
+
+	/* Welded point of each vertex */
+	TArray<int32> VertexPoints;
+
+	TArray<FVector> PointPositions;
+	TArray<FQuadric> PointQuadrics;
+	TArray<uint32> PointRevisions;
+	TArray<bool> PointRemoved;
+	/* Seam and border points, which can be collapsed onto but never moved */
+	TArray<bool> PointLocked;
+	/* Triangles using each point. Can hold removed triangles until the point is next collapsed onto. */
+	TArray<TArray<int32>> PointTriangles;
+
+	/* Min heap of candidate collapses, lazily invalidated */
+	TArray<FCollapse> Heap;
+
+	int32 GetCornerPoint(int32 Triangle, int32 Corner) const { return VertexPoints[Corners[Triangle * 3 + Corner]]; }
+	bool TriangleHasPoint(int32 Triangle, int32 Point) const;
+
+	void GetNeighborPoints(int32 Point, TArray<int32>& OutNeighbors) const;
+	void QueueCollapse(int32 From, int32 To);
+	bool CanCollapse(int32 From, int32 To) const;
+	void Collapse(int32 From, int32 To);
+};
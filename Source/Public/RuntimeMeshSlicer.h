@@ -0,0 +1,334 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshCore.h"
+#include "Async/ParallelFor.h"
+
+/* Edge where the slicing plane crossed a triangle, pointing the way the positive half's cap winds */
+struct FRuntimeMeshSliceCapEdge
+{
+	FVector Start;
+	FVector End;
+};
+
+/* Builds the flat caps closing the cut of a slice */
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshSliceCap
+{
+public:
+	/* Cut edge endpoints closer than this are joined when chaining edges into loops */
+	static const float WeldTolerance;
+
+	/**
+	*	Chains cut edges into closed loops and triangulates them, including loops inside other loops as holes.
+	*	Chains that don't close are skipped.
+	*	@out	OutPositions	Points of every loop
+	*	@out	OutTriangles	Triangles over OutPositions, wound like the edges for the positive half's cap
+	*/
+	static void Triangulate(const TArray<FRuntimeMeshSliceCapEdge>& Edges, const FVector& PlaneNormal, TArray<FVector>& OutPositions, TArray<int32>& OutTriangles);
+
+	/* Plane axes the caps are triangulated and mapped in */
+	static void GetPlaneAxes(const FVector& PlaneNormal, FVector& OutAxisX, FVector& OutAxisY);
+
+private:
+	static bool TriangulateLoop(const TArray<FVector2D>& Points, const TArray<int32>& Loop, TArray<int32>& OutTriangles);
+};
+
+/**
+*	Clips a vertex and index buffer against a plane, producing both halves.
+*
+*	Vertex distances and triangles are processed in parallel chunks. Each triangle crossing the plane gets its own
+*	new vertices along the cut, interpolated with FRuntimeMeshVertexInterpolator, which are then shared by the
+*	pieces of that triangle on both sides. Vertices exactly on the plane go to the positive half.
+*/
+template<typename VertexType>
+class TRuntimeMeshSlicer
+{
+public:
+	typedef FRuntimeMeshVertexInterpolator<VertexType> Interpolator;
+
+	/* Triangles and vertices handled by each parallel task */
+	static const int32 ElementsPerTask = 4096;
+
+	/* One half of a slice. Positions are kept apart from the vertices, and written wherever the section keeps them. */
+	struct FHalf
+	{
+		TArray<FVector> Positions;
+		TArray<VertexType> Vertices;
+		TArray<int32> Triangles;
+		FBox BoundingBox;
+
+		FHalf() : BoundingBox(0) { }
+	};
+
+	/**
+	*	Slices a mesh with a plane.
+	*	@param	Positions		Position of every vertex
+	*	@param	Vertices		Every vertex, same length as Positions
+	*	@param	Triangles		Index buffer of the mesh
+	*	@param	Plane			The plane, the positive half is on the side its normal points to
+	*	@param	bCreateCap		Should both halves get a cap closing the cut
+	*	@return					False if every vertex is on the positive side, in which case the halves are left empty
+	*/
+	static bool Slice(const TArray<FVector>& Positions, const TArray<VertexType>& Vertices, const TArray<int32>& Triangles, const FPlane& Plane, bool bCreateCap,
+		FHalf& OutPositive, FHalf& OutNegative)
+	{
+		check(Positions.Num() == Vertices.Num());
+
+		const int32 NumVertices = Vertices.Num();
+		const int32 NumTriangles = Triangles.Num() / 3;
+
+		// Signed distance of every vertex to the plane
+		TArray<float> Distances;
+		Distances.SetNumUninitialized(NumVertices);
+		ParallelFor(FMath::DivideAndRoundUp<int32>(NumVertices, ElementsPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(NumVertices, (TaskIndex + 1) * ElementsPerTask);
+			for (int32 Index = TaskIndex * ElementsPerTask; Index < End; Index++)
+			{
+				Distances[Index] = Plane.PlaneDot(Positions[Index]);
+			}
+		});
+
+		// Existing vertices keep their relative order in the half they're on
+		TArray<int32> Remap;
+		Remap.SetNumUninitialized(NumVertices);
+		int32 NumPositiveVertices = 0;
+		int32 NumNegativeVertices = 0;
+		for (int32 Index = 0; Index < NumVertices; Index++)
+		{
+			Remap[Index] = Distances[Index] >= 0.0f ? NumPositiveVertices++ : NumNegativeVertices++;
+		}
+
+		if (NumNegativeVertices == 0)
+		{
+			return false;
+		}
+
+		// Clip every chunk of triangles on its own. New vertices are referenced as ~Index into the chunk's vertices.
+		const int32 NumTasks = FMath::DivideAndRoundUp<int32>(NumTriangles, ElementsPerTask);
+		TArray<FClipTask> Tasks;
+		Tasks.SetNum(NumTasks);
+		ParallelFor(NumTasks, [&](int32 TaskIndex)
+		{
+			FClipTask& Task = Tasks[TaskIndex];
+			const int32 End = FMath::Min<int32>(NumTriangles, (TaskIndex + 1) * ElementsPerTask);
+			for (int32 Triangle = TaskIndex * ElementsPerTask; Triangle < End; Triangle++)
+			{
+				ClipTriangle(Task, Positions, Vertices, Distances, &Triangles[Triangle * 3]);
+			}
+		});
+
+		// Lay out the new vertices and triangles of every chunk after the previous ones
+		int32 NumNewVertices = 0;
+		int32 NumPositiveIndices = 0;
+		int32 NumNegativeIndices = 0;
+		int32 NumCapEdges = 0;
+		for (FClipTask& Task : Tasks)
+		{
+			Task.NewVertexStart = NumNewVertices;
+			Task.PositiveIndexStart = NumPositiveIndices;
+			Task.NegativeIndexStart = NumNegativeIndices;
+			NumNewVertices += Task.NewVertices.Num();
+			NumPositiveIndices += Task.PositiveTriangles.Num();
+			NumNegativeIndices += Task.NegativeTriangles.Num();
+			NumCapEdges += Task.CapEdges.Num();
+		}
+
+		InitHalf(OutPositive, NumPositiveVertices + NumNewVertices, NumPositiveIndices);
+		InitHalf(OutNegative, NumNegativeVertices + NumNewVertices, NumNegativeIndices);
+
+		// Copy the existing vertices into their half
+		ParallelFor(FMath::DivideAndRoundUp<int32>(NumVertices, ElementsPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(NumVertices, (TaskIndex + 1) * ElementsPerTask);
+			for (int32 Index = TaskIndex * ElementsPerTask; Index < End; Index++)
+			{
+				FHalf& Half = Distances[Index] >= 0.0f ? OutPositive : OutNegative;
+				Half.Positions[Remap[Index]] = Positions[Index];
+				Half.Vertices[Remap[Index]] = Vertices[Index];
+			}
+		});
+
+		// Copy the new vertices into both halves and resolve the triangles
+		ParallelFor(NumTasks, [&](int32 TaskIndex)
+		{
+			const FClipTask& Task = Tasks[TaskIndex];
+			for (int32 Index = 0; Index < Task.NewVertices.Num(); Index++)
+			{
+				OutPositive.Positions[NumPositiveVertices + Task.NewVertexStart + Index] = Task.NewPositions[Index];
+				OutPositive.Vertices[NumPositiveVertices + Task.NewVertexStart + Index] = Task.NewVertices[Index];
+				OutNegative.Positions[NumNegativeVertices + Task.NewVertexStart + Index] = Task.NewPositions[Index];
+				OutNegative.Vertices[NumNegativeVertices + Task.NewVertexStart + Index] = Task.NewVertices[Index];
+			}
+
+			for (int32 Index = 0; Index < Task.PositiveTriangles.Num(); Index++)
+			{
+				const int32 Vertex = Task.PositiveTriangles[Index];
+				OutPositive.Triangles[Task.PositiveIndexStart + Index] = Vertex >= 0 ? Remap[Vertex] : NumPositiveVertices + Task.NewVertexStart + ~Vertex;
+			}
+
+			for (int32 Index = 0; Index < Task.NegativeTriangles.Num(); Index++)
+			{
+				const int32 Vertex = Task.NegativeTriangles[Index];
+				OutNegative.Triangles[Task.NegativeIndexStart + Index] = Vertex >= 0 ? Remap[Vertex] : NumNegativeVertices + Task.NewVertexStart + ~Vertex;
+			}
+		});
+
+		if (bCreateCap && NumCapEdges > 0)
+		{
+			TArray<FRuntimeMeshSliceCapEdge> CapEdges;
+			CapEdges.Reserve(NumCapEdges);
+			for (const FClipTask& Task : Tasks)
+			{
+				CapEdges.Append(Task.CapEdges);
+			}
+
+			// Any vertex along the cut provides the attributes the cap doesn't set, like color
+			const VertexType Template = OutPositive.Vertices[NumPositiveVertices];
+			AddCaps(CapEdges, Plane, Template, OutPositive, OutNegative);
+		}
+
+		UpdateBounds(OutPositive);
+		UpdateBounds(OutNegative);
+		return true;
+	}
+
+private:
+	/* Output of one chunk of triangles */
+	struct FClipTask
+	{
+		TArray<FVector> NewPositions;
+		TArray<VertexType> NewVertices;
+		TArray<int32> PositiveTriangles;
+		TArray<int32> NegativeTriangles;
+		TArray<FRuntimeMeshSliceCapEdge> CapEdges;
+
+		int32 NewVertexStart;
+		int32 PositiveIndexStart;
+		int32 NegativeIndexStart;
+	};
+
+	static void InitHalf(FHalf& Half, int32 NumVertices, int32 NumIndices)
+	{
+		Half.Positions.SetNumUninitialized(NumVertices);
+		Half.Vertices.SetNumUninitialized(NumVertices);
+		Half.Triangles.SetNumUninitialized(NumIndices);
+		Half.BoundingBox = FBox(0);
+	}
+
+	static void UpdateBounds(FHalf& Half)
+	{
+		for (const FVector& Position : Half.Positions)
+		{
+			Half.BoundingBox += Position;
+		}
+	}
+
+	static void AddPolygon(TArray<int32>& Triangles, const int32* Polygon, int32 NumPoints)
+	{
+		// Clipping a triangle gives a convex polygon of 3 or 4 points
+		for (int32 Point = 2; Point < NumPoints; Point++)
+		{
+			Triangles.Add(Polygon[0]);
+			Triangles.Add(Polygon[Point - 1]);
+			Triangles.Add(Polygon[Point]);
+		}
+	}
+
+	static void ClipTriangle(FClipTask& Task, const TArray<FVector>& Positions, const TArray<VertexType>& Vertices, const TArray<float>& Distances, const int32* Corners)
+	{
+		const bool bPositive[3] = { Distances[Corners[0]] >= 0.0f, Distances[Corners[1]] >= 0.0f, Distances[Corners[2]] >= 0.0f };
+
+		if (bPositive[0] == bPositive[1] && bPositive[1] == bPositive[2])
+		{
+			AddPolygon(bPositive[0] ? Task.PositiveTriangles : Task.NegativeTriangles, Corners, 3);
+			return;
+		}
+
+		// Walk the edges, adding a new vertex where each crosses the plane
+		int32 PositivePolygon[4];
+		int32 NegativePolygon[4];
+		int32 NumPositive = 0;
+		int32 NumNegative = 0;
+		int32 CutPoints[2];
+		int32 CutPositivePoints[2];
+		int32 NumCuts = 0;
+
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			const int32 Next = (Corner + 1) % 3;
+			const int32 A = Corners[Corner];
+			const int32 B = Corners[Next];
+
+			if (bPositive[Corner])
+			{
+				PositivePolygon[NumPositive++] = A;
+			}
+			else
+			{
+				NegativePolygon[NumNegative++] = A;
+			}
+
+			if (bPositive[Corner] != bPositive[Next])
+			{
+				const float Alpha = FMath::Clamp(Distances[A] / (Distances[A] - Distances[B]), 0.0f, 1.0f);
+				const int32 NewVertex = ~Task.NewVertices.Num();
+				Task.NewPositions.Add(FMath::Lerp(Positions[A], Positions[B], Alpha));
+				Task.NewVertices.Add(Interpolator::Lerp(Vertices[A], Vertices[B], Alpha));
+
+				CutPoints[NumCuts] = Task.NewPositions.Num() - 1;
+				CutPositivePoints[NumCuts++] = NumPositive;
+				PositivePolygon[NumPositive++] = NewVertex;
+				NegativePolygon[NumNegative++] = NewVertex;
+			}
+		}
+
+		AddPolygon(Task.PositiveTriangles, PositivePolygon, NumPositive);
+		AddPolygon(Task.NegativeTriangles, NegativePolygon, NumNegative);
+
+		// The cut is the edge of the positive polygon between its two new vertices. The cap closing
+		// the positive half runs along it the other way.
+		const bool bFirstToSecond = (CutPositivePoints[0] + 1) % NumPositive == CutPositivePoints[1];
+		FRuntimeMeshSliceCapEdge& Edge = Task.CapEdges[Task.CapEdges.AddUninitialized()];
+		Edge.Start = Task.NewPositions[CutPoints[bFirstToSecond ? 1 : 0]];
+		Edge.End = Task.NewPositions[CutPoints[bFirstToSecond ? 0 : 1]];
+	}
+
+	static void AddCaps(const TArray<FRuntimeMeshSliceCapEdge>& CapEdges, const FPlane& Plane, const VertexType& Template, FHalf& OutPositive, FHalf& OutNegative)
+	{
+		TArray<FVector> CapPositions;
+		TArray<int32> CapTriangles;
+		FRuntimeMeshSliceCap::Triangulate(CapEdges, FVector(Plane), CapPositions, CapTriangles);
+		if (CapTriangles.Num() == 0)
+		{
+			return;
+		}
+
+		FVector AxisX, AxisY;
+		FRuntimeMeshSliceCap::GetPlaneAxes(FVector(Plane), AxisX, AxisY);
+
+		// The positive half's cap faces against the plane normal, the negative half's along it
+		for (int32 Side = 0; Side < 2; Side++)
+		{
+			FHalf& Half = Side == 0 ? OutPositive : OutNegative;
+			const FVector Normal = Side == 0 ? -FVector(Plane) : FVector(Plane);
+
+			const int32 FirstVertex = Half.Vertices.Num();
+			for (const FVector& Position : CapPositions)
+			{
+				const FVector2D UV(Position | AxisX, Position | AxisY);
+				Half.Positions.Add(Position);
+				Half.Vertices.Add(Interpolator::MakeCapVertex(Template, Normal, AxisX, AxisY, UV));
+			}
+
+			for (int32 Index = 0; Index < CapTriangles.Num(); Index += 3)
+			{
+				Half.Triangles.Add(FirstVertex + CapTriangles[Index]);
+				Half.Triangles.Add(FirstVertex + CapTriangles[Index + (Side == 0 ? 1 : 2)]);
+				Half.Triangles.Add(FirstVertex + CapTriangles[Index + (Side == 0 ? 2 : 1)]);
+			}
+		}
+	}
+};
@@ -0,0 +1,100 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshCore.h"
+#include "RuntimeMeshTopology.h"
+#include "Async/ParallelFor.h"
+
+/* Recalculates smooth normals and tangents of some of a section's vertices from the triangles around them */
+template<typename VertexType>
+class TRuntimeMeshTangents
+{
+public:
+	typedef FRuntimeMeshVertexInterpolator<VertexType> Interpolator;
+
+	/* Vertices handled by each parallel task */
+	static const int32 VerticesPerTask = 1024;
+
+	/**
+	*	Recalculates the normal and tangent of each vertex in Affected. Face normals are weighted by area, and tangents
+	*	follow the first UV channel. Vertices without usable triangles are left alone.
+	*/
+	static void Recalculate(const TArray<FVector>& Positions, TArray<VertexType>& Vertices, const TArray<int32>& Indices,
+		const FRuntimeMeshTopology& Topology, const TArray<int32>& Affected)
+	{
+		check(Positions.Num() == Vertices.Num() && Topology.GetNumVertices() == Vertices.Num());
+
+		// Each vertex only reads the triangles around it, so vertices can be done in any order
+		ParallelFor(FMath::DivideAndRoundUp<int32>(Affected.Num(), VerticesPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(Affected.Num(), (TaskIndex + 1) * VerticesPerTask);
+			for (int32 Index = TaskIndex * VerticesPerTask; Index < End; Index++)
+			{
+				RecalculateVertex(Positions, Vertices, Indices, Topology, Affected[Index]);
+			}
+		});
+	}
+
+private:
+	static void RecalculateVertex(const TArray<FVector>& Positions, TArray<VertexType>& Vertices, const TArray<int32>& Indices,
+		const FRuntimeMeshTopology& Topology, int32 Vertex)
+	{
+		FVector NormalSum(0, 0, 0);
+		FVector TangentSum(0, 0, 0);
+		FVector BitangentSum(0, 0, 0);
+
+		int32 Start, Num;
+		Topology.GetOutgoingHalfEdges(Vertex, Start, Num);
+		for (int32 Index = Start; Index < Start + Num; Index++)
+		{
+			const int32 Triangle = FRuntimeMeshTopology::GetTriangle(Topology.GetOutgoingHalfEdge(Index));
+			const int32 A = Indices[Triangle * 3 + 0];
+			const int32 B = Indices[Triangle * 3 + 1];
+			const int32 C = Indices[Triangle * 3 + 2];
+
+			const FVector EdgeB = Positions[B] - Positions[A];
+			const FVector EdgeC = Positions[C] - Positions[A];
+
+			// Same winding the engine uses for its own generated normals. The length is twice the area, so bigger faces count for more.
+			const FVector FaceNormal = EdgeC ^ EdgeB;
+			NormalSum += FaceNormal;
+
+			const FVector2D UVA = Interpolator::GetUV(Vertices[A]);
+			const FVector2D DeltaB = Interpolator::GetUV(Vertices[B]) - UVA;
+			const FVector2D DeltaC = Interpolator::GetUV(Vertices[C]) - UVA;
+			const float Determinant = DeltaB.X * DeltaC.Y - DeltaC.X * DeltaB.Y;
+			if (FMath::Abs(Determinant) > SMALL_NUMBER)
+			{
+				const float Area = FaceNormal.Size();
+				TangentSum += ((EdgeB * DeltaC.Y - EdgeC * DeltaB.Y) / Determinant).GetSafeNormal() * Area;
+				BitangentSum += ((EdgeC * DeltaB.X - EdgeB * DeltaC.X) / Determinant).GetSafeNormal() * Area;
+			}
+		}
+
+		const FVector TangentZ = NormalSum.GetSafeNormal();
+		if (TangentZ.IsZero())
+		{
+			return;
+		}
+
+		// Make the tangent perpendicular to the normal, or pick any tangent if the UVs didn't give one
+		FVector TangentX = (TangentSum - TangentZ * (TangentSum | TangentZ)).GetSafeNormal();
+		FVector TangentY;
+		if (TangentX.IsZero())
+		{
+			TangentZ.FindBestAxisVectors(TangentX, TangentY);
+		}
+		else
+		{
+			TangentY = TangentZ ^ TangentX;
+			if ((TangentY | BitangentSum) < 0.0f)
+			{
+				TangentY = -TangentY;
+			}
+		}
+
+		Interpolator::SetTangents(Vertices[Vertex], TangentX, TangentY, TangentZ);
+	}
+};
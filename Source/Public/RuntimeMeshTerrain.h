@@ -0,0 +1,163 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "RuntimeMeshComponent.h"
+
+/**
+*	Index buffers for every LOD and seam stitching combination of a square terrain chunk.
+*	A chunk always holds its full resolution vertices, laid out like URuntimeMeshLibrary::CreateGridMesh(), so changing LOD
+*	only swaps the index buffer. Each LOD keeps one interior index list and a plain and stitched strip for each side, which are
+*	joined on request. These are built once per chunk size, shared by every terrain using that size and freed with the last one.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshTerrainLODIndices
+{
+public:
+	/* Sides of a chunk whose neighbor is one LOD coarser. The edge on that side only uses the neighbor's vertices so there are no cracks. */
+	enum EStitchFlags
+	{
+		StitchNegX = 0x1,
+		StitchPosX = 0x2,
+		StitchNegY = 0x4,
+		StitchPosY = 0x8,
+
+		NumStitchCombinations = 16
+	};
+
+	FRuntimeMeshTerrainLODIndices(int32 InChunkSize);
+
+	/* Gets the shared index sets for a chunk size, building them if no terrain is using them */
+	static TSharedRef<const FRuntimeMeshTerrainLODIndices, ESPMode::ThreadSafe> Get(int32 ChunkSize);
+
+	int32 GetChunkSize() const { return ChunkSize; }
+
+	/* LOD 0 is full resolution, each following LOD halves the resolution down to 2x2 quads */
+	int32 GetNumLODs() const { return NumLODs; }
+
+	/* Builds the index buffer for a LOD and combination of stitched sides */
+	void GetIndices(int32 LOD, int32 StitchFlags, TArray<int32>& OutIndices) const;
+
+private:
+	enum { NumSides = 4 };
+
+	/* Quads per chunk side */
+	int32 ChunkSize;
+
+	int32 NumLODs;
+
+	/* Everything inside the outer ring of quads, one per LOD */
+	TArray<TArray<int32>> Interiors;
+
+	/* Outer ring of quads on one side, plain and stitched for each side of each LOD */
+	TArray<TArray<int32>> EdgeStrips;
+
+	int32 GetEdgeStripIndex(int32 LOD, int32 Side, bool bStitch) const { return (LOD * NumSides + Side) * 2 + (bStitch ? 1 : 0); }
+
+	void BuildInterior(int32 LOD, TArray<int32>& OutIndices) const;
+	void BuildEdgeStrip(int32 LOD, int32 Side, bool bStitch, TArray<int32>& OutIndices) const;
+};
+
+
+/**
+*	Heightmap terrain built from a grid of RMC sections, one per chunk.
+*
+*	Heights are indexed [X * GetHeightmapSizeY() + Y], one more than the chunk size times the chunk count in each direction so
+*	neighboring chunks share their edge heights. Normals are central differences over the whole heightmap so they're seamless too.
+*	Only chunks whose heights (or neighborhood used for normals) changed are regenerated, and chunks that only changed LOD
+*	just swap index buffers. All changes are applied in a single batch update by Update().
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshHeightmapTerrain
+{
+public:
+	/**
+	*	@param	InComponent				Component the chunk sections are created on.
+	*	@param	InNumChunksX			Number of chunks in X.
+	*	@param	InNumChunksY			Number of chunks in Y.
+	*	@param	InChunkSize				Quads per chunk side. Must be a power of two, at least 2.
+	*	@param	InScale					Spacing between height samples in X and Y, and scale applied to heights in Z.
+	*	@param	InFirstSectionIndex		Section index of the first chunk. Chunks use NumChunksX * NumChunksY sections from here.
+	*/
+	FRuntimeMeshHeightmapTerrain(URuntimeMeshComponent* InComponent, int32 InNumChunksX, int32 InNumChunksY, int32 InChunkSize,
+		const FVector& InScale, int32 InFirstSectionIndex = 0);
+
+	/* Should the chunks create collision. Applies to chunks created after this is set. */
+	bool bCreateCollision;
+
+	/* Update frequency used for the chunk sections. Applies to chunks created after this is set. */
+	EUpdateFrequency UpdateFrequency;
+
+	int32 GetHeightmapSizeX() const { return NumChunksX * ChunkSize + 1; }
+	int32 GetHeightmapSizeY() const { return NumChunksY * ChunkSize + 1; }
+	int32 GetNumLODs() const { return LODIndices->GetNumLODs(); }
+	int32 GetChunkSectionIndex(int32 ChunkX, int32 ChunkY) const { return FirstSectionIndex + ChunkX * NumChunksY + ChunkY; }
+
+	/* Replaces the whole heightmap. Must be GetHeightmapSizeX() * GetHeightmapSizeY() long. */
+	void SetHeights(const TArray<float>& InHeights);
+
+	/* Sets a single height sample */
+	void SetHeight(int32 X, int32 Y, float Height);
+
+	/* Copies a rectangle of heights into the heightmap. RegionHeights is indexed [X * RegionSizeY + Y]. */
+	void SetHeightRegion(int32 MinX, int32 MinY, int32 RegionSizeX, int32 RegionSizeY, const TArray<float>& RegionHeights);
+
+	float GetHeight(int32 X, int32 Y) const { return Heights[X * GetHeightmapSizeY() + Y]; }
+
+	/* Sets the LOD of a chunk. Neighboring chunks are kept within one LOD of each other when updated. */
+	void SetChunkLOD(int32 ChunkX, int32 ChunkY, int32 LOD);
+
+	int32 GetChunkLOD(int32 ChunkX, int32 ChunkY) const { return Chunks[ChunkX * NumChunksY + ChunkY].LOD; }
+
+	/**
+	*	Picks the LOD of every chunk by distance, doubling the distance for every LOD.
+	*	@param	LocalViewPosition	View position in the component's local space.
+	*	@param	LOD0Distance		Chunks closer than this use full resolution.
+	*/
+	void UpdateLODs(const FVector& LocalViewPosition, float LOD0Distance);
+
+	/* Regenerates every dirty chunk and applies all changes to the component in a single batch, or in the batch already pending on it */
+	void Update();
+
+private:
+	struct FChunk
+	{
+		/* Requested LOD */
+		int32 LOD;
+
+		/* LOD and stitching of the index buffer in the section */
+		int32 AppliedLOD;
+		int32 AppliedStitchFlags;
+
+		/* Do the vertices need regenerating */
+		bool bHeightsDirty;
+
+		/* Has the section been created */
+		bool bCreated;
+
+		FChunk() : LOD(0), AppliedLOD(INDEX_NONE), AppliedStitchFlags(INDEX_NONE), bHeightsDirty(true), bCreated(false) { }
+	};
+
+	TWeakObjectPtr<URuntimeMeshComponent> Component;
+
+	int32 NumChunksX;
+	int32 NumChunksY;
+	int32 ChunkSize;
+	FVector Scale;
+	int32 FirstSectionIndex;
+
+	TArray<float> Heights;
+	TArray<FChunk> Chunks;
+
+	TSharedRef<const FRuntimeMeshTerrainLODIndices, ESPMode::ThreadSafe> LODIndices;
+
+	/* Flags every chunk whose vertices depend on heights in the inclusive range */
+	void MarkHeightsDirty(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY);
+
+	/* Keeps neighboring chunks within one LOD of each other by lowering the LOD of coarser chunks */
+	void EnforceLODConstraints();
+
+	/* Sides of the chunk that need to stitch to a coarser neighbor */
+	int32 GetStitchFlags(int32 ChunkX, int32 ChunkY) const;
+
+	/* Builds the full resolution vertices of a chunk. Safe to call from any thread. */
+	void BuildChunkVertices(int32 ChunkX, int32 ChunkY, TArray<FRuntimeMeshVertexSimple>& OutVertices, FBox& OutBounds) const;
+};
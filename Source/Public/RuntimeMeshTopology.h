@@ -0,0 +1,122 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+/**
+*	Half-edge connectivity of a snapshot of one section's triangles, for geometry algorithms that walk the mesh.
+*
+*	Half-edge 3 * T + C runs from corner C of triangle T to the next corner, so triangles, next and previous half-edges
+*	need no storage. Twins, the half-edges leaving each vertex, the ring of neighbors around each vertex and the
+*	boundary loops are kept in flat arrays, built in parallel. Connectivity follows vertex indices, so vertices split
+*	along UV or normal seams leave a boundary there. A snapshot never changes once built, so any number of threads
+*	can read it, and it stays valid while only positions or vertex attributes change.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshTopology
+{
+public:
+	/* Half-edges or vertices handled by each parallel task */
+	static const int32 ElementsPerTask = 4096;
+
+	FRuntimeMeshTopology(const TArray<int32>& InIndices, int32 NumVertices);
+
+	int32 GetNumVertices() const { return OutgoingOffsets.Num() - 1; }
+	int32 GetNumTriangles() const { return Indices.Num() / 3; }
+	int32 GetNumHalfEdges() const { return Indices.Num(); }
+
+	static int32 GetTriangle(int32 HalfEdge) { return HalfEdge / 3; }
+	static int32 GetNext(int32 HalfEdge) { return HalfEdge % 3 == 2 ? HalfEdge - 2 : HalfEdge + 1; }
+	static int32 GetPrevious(int32 HalfEdge) { return HalfEdge % 3 == 0 ? HalfEdge + 2 : HalfEdge - 1; }
+
+	int32 GetStartVertex(int32 HalfEdge) const { return Indices[HalfEdge]; }
+	int32 GetEndVertex(int32 HalfEdge) const { return Indices[GetNext(HalfEdge)]; }
+
+	/* Half-edge running the other way along the same edge. INDEX_NONE on boundaries and on edges shared by more than two triangles. */
+	int32 GetTwin(int32 HalfEdge) const { return Twins[HalfEdge]; }
+
+	/* Is the half-edge on a boundary loop. Edges shared by more than two triangles aren't. */
+	bool IsBoundaryHalfEdge(int32 HalfEdge) const { return BoundaryLoopOf[HalfEdge] != INDEX_NONE; }
+
+	/* Half-edges leaving Vertex are GetOutgoingHalfEdge(Start) to GetOutgoingHalfEdge(Start + Num - 1), one per triangle using it */
+	void GetOutgoingHalfEdges(int32 Vertex, int32& OutStart, int32& OutNum) const
+	{
+		OutStart = OutgoingOffsets[Vertex];
+		OutNum = OutgoingOffsets[Vertex + 1] - OutStart;
+	}
+	int32 GetOutgoingHalfEdge(int32 Index) const { return OutgoingHalfEdges[Index]; }
+
+	/* Vertices sharing a triangle with Vertex, in ascending order, are GetRingVertex(Start) to GetRingVertex(Start + Num - 1) */
+	void GetVertexRing(int32 Vertex, int32& OutStart, int32& OutNum) const
+	{
+		OutStart = RingOffsets[Vertex];
+		OutNum = RingOffsets[Vertex + 1] - OutStart;
+	}
+	int32 GetRingVertex(int32 Index) const { return RingVertices[Index]; }
+
+	/* Is Vertex on a boundary loop */
+	bool IsBoundaryVertex(int32 Vertex) const;
+
+	/* Boundary half-edges of a loop, in order around the hole, are GetBoundaryHalfEdge(Start) to GetBoundaryHalfEdge(Start + Num - 1) */
+	int32 GetNumBoundaryLoops() const { return BoundaryLoopOffsets.Num() - 1; }
+	void GetBoundaryLoop(int32 Loop, int32& OutStart, int32& OutNum) const
+	{
+		OutStart = BoundaryLoopOffsets[Loop];
+		OutNum = BoundaryLoopOffsets[Loop + 1] - OutStart;
+	}
+	int32 GetBoundaryHalfEdge(int32 Index) const { return BoundaryHalfEdges[Index]; }
+
+	/* Number of half-edges on edges shared by more than two triangles, or by triangles that disagree on winding */
+	int32 GetNumNonManifoldHalfEdges() const { return NumNonManifoldHalfEdges; }
+
+	/* Does every edge have exactly one twin, as for a closed, consistently wound mesh */
+	bool IsClosed() const { return GetNumBoundaryLoops() == 0 && NumNonManifoldHalfEdges == 0; }
+
+	/**
+	*	Appends the vertices of every triangle using one of Vertices, including those of Vertices any triangle uses, in ascending order.
+	*	These are the vertices whose smooth normals depend on Vertices.
+	*/
+	void GetOneRingNeighborhood(const TArray<int32>& Vertices, TArray<int32>& OutNeighborhood) const;
+
+private:
+	TArray<int32> Indices;
+	TArray<int32> Twins;
+
+	/* Start of each vertex's outgoing half-edges, with one extra entry holding the total */
+	TArray<int32> OutgoingOffsets;
+	TArray<int32> OutgoingHalfEdges;
+
+	/* Start of each vertex's ring, with one extra entry holding the total */
+	TArray<int32> RingOffsets;
+	TArray<int32> RingVertices;
+
+	/* Start of each boundary loop, with one extra entry holding the total */
+	TArray<int32> BoundaryLoopOffsets;
+	TArray<int32> BoundaryHalfEdges;
+
+	/* Loop each half-edge is on, or INDEX_NONE */
+	TArray<int32> BoundaryLoopOf;
+
+	int32 NumNonManifoldHalfEdges;
+
+	void BuildOutgoingHalfEdges(int32 NumVertices);
+	/* Finds twins, flagging the half-edges with no twin that belong on a boundary loop */
+	void BuildTwins(TArray<bool>& OutIsBoundary);
+	void BuildRings();
+	void BuildBoundaryLoops(const TArray<bool>& IsBoundary);
+
+	/* Gathers the neighbors of a vertex, unsorted and possibly with duplicates */
+	template<typename AllocatorType>
+	void GatherNeighbors(int32 Vertex, TArray<int32, AllocatorType>& OutNeighbors) const
+	{
+		for (int32 Index = OutgoingOffsets[Vertex]; Index < OutgoingOffsets[Vertex + 1]; Index++)
+		{
+			const int32 HalfEdge = OutgoingHalfEdges[Index];
+			OutNeighbors.Add(GetEndVertex(HalfEdge));
+			OutNeighbors.Add(GetStartVertex(GetPrevious(HalfEdge)));
+		}
+	}
+};
+
+/* Shared pointer to an immutable topology snapshot, safe to pass to other threads */
+using FRuntimeMeshTopologyPtr = TSharedPtr<const FRuntimeMeshTopology, ESPMode::ThreadSafe>;
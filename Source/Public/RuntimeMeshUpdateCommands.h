@@ -6,79 +6,73 @@
 #include "Components/MeshComponent.h"
 #include "RuntimeMeshProfiling.h"
 #include "RuntimeMeshVersion.h"
+#include "RuntimeMeshSectionMap.h"
+#include "RuntimeMeshBufferPool.h"
 
 
 
 
-/* Base class for all render thread command information */
-class FRuntimeMeshRenderThreadCommandInterface
+/* Type of a command in a FRuntimeMeshCommandBuffer */
+enum class ERuntimeMeshCommandType : uint8
 {
-public:
+	CreateSection,
+	DestroySection,
+	UpdateSection,
+	UpdatePositions,
+	UpdateVertices,
+	UpdateProperties,
+};
 
-	FRuntimeMeshRenderThreadCommandInterface() { }
-	virtual ~FRuntimeMeshRenderThreadCommandInterface() { }
-	
-	virtual void SetTargetSection(int32 InTargetSection) { TargetSection = InTargetSection; }
-	virtual int32 GetTargetSection() { return TargetSection; }
-	
-	/* Cast the update data to the specific type of update data */
-	template <typename Type>
-	Type* As()
-	{
-		return static_cast<Type*>(this);
-	}
+/* Start of every command in a FRuntimeMeshCommandBuffer. The payload follows it, then any inline arrays. */
+struct FRuntimeMeshCommandHeader
+{
+	/* Section the command applies to */
+	int32 SectionIndex;
 
-private:
-	/* Section index that this creation data applies to */
-	int32 TargetSection;
+	/* Bytes from the start of this header to the next command */
+	int32 Size;
+
+	ERuntimeMeshCommandType Type;
 };
 
-/* Base class for section creation data. Allows the non templated SceneProxy to get the section proxy;*/
-class FRuntimeMeshSectionCreateDataInterface : public FRuntimeMeshRenderThreadCommandInterface
+/* Reference to an array written to a FRuntimeMeshCommandBuffer */
+struct FRuntimeMeshCommandArray
 {
-public:
-	/* The new proxy to be used for section creation */
-	class FRuntimeMeshSectionProxyInterface* NewProxy;
+	/* Byte offset in the command buffer, or index of the external array when ExternalIndex is set */
+	int32 Offset;
 
+	/* Number of elements */
+	int32 Num;
 
-	FRuntimeMeshSectionCreateDataInterface() { }
-	virtual ~FRuntimeMeshSectionCreateDataInterface() override { }
+	/* Index of the separate allocation holding a large array, or INDEX_NONE if it's inline */
+	int32 ExternalIndex;
 
+	FRuntimeMeshCommandArray() : Offset(0), Num(0), ExternalIndex(INDEX_NONE) { }
 };
 
-/** Templated class for update data sent to the RT for updating a single mesh section */
-template<typename VertexType>
-class FRuntimeMeshSectionCreateData : public FRuntimeMeshSectionCreateDataInterface
+/* Creates a section from a new section proxy */
+struct FRuntimeMeshCreateSectionCommand
 {
-public:
-	/* Updated position vertex buffer for the section */
-	TArray<FVector> PositionVertexBuffer;
-
-	/* Updated vertex buffer for the section */
-	TArray<VertexType> VertexBuffer;
-
-	/* Updated index buffer for the section */
-	TArray<int32> IndexBuffer;
+	/* The new proxy to be used for section creation */
+	class FRuntimeMeshSectionProxyInterface* NewProxy;
 
+	FRuntimeMeshCommandArray PositionVertexBuffer;
+	FRuntimeMeshCommandArray VertexBuffer;
+	FRuntimeMeshCommandArray IndexBuffer;
 
-	FRuntimeMeshSectionCreateData() {}
-	virtual ~FRuntimeMeshSectionCreateData() override { }
+	/* Number of vertices to allocate the render buffers for, so later updates can be applied in place. 0 to allocate exactly what's needed. */
+	int32 VertexCapacity;
 
+	/* Number of indices to allocate the render buffer for. Unused indices are filled with degenerate triangles. */
+	int32 IndexCapacity;
 };
 
-/** Templated class for update data sent to the RT for updating a single mesh section */
-template<typename VertexType>
-class FRuntimeMeshSectionUpdateData : public FRuntimeMeshRenderThreadCommandInterface
+/* Replaces some or all of the buffers of a section */
+struct FRuntimeMeshUpdateSectionCommand
 {
-public:
-	/* Updated position vertex buffer for the section */
-	TArray<FVector> PositionVertexBuffer;
-
-	/* Updated vertex buffer for the section */
-	TArray<VertexType> VertexBuffer;
-
-	/* Updated index buffer for the section */
-	TArray<int32> IndexBuffer;
+	FRuntimeMeshCommandArray PositionVertexBuffer;
+	FRuntimeMeshCommandArray VertexBuffer;
+	FRuntimeMeshCommandArray IndexBuffer;
 
 	/* Should we apply the position buffer */
 	bool bIncludePositionBuffer;
@@ -88,35 +82,181 @@ public:
 
 	/* Should we apply the indices as an update */
 	bool bIncludeIndices;
+};
 
-	FRuntimeMeshSectionUpdateData() {}
-	virtual ~FRuntimeMeshSectionUpdateData() override { }
+/* Replaces a range of positions of a dual buffer section */
+struct FRuntimeMeshUpdatePositionsCommand
+{
+	/* Updated positions, starting at StartIndex in the section's position buffer */
+	FRuntimeMeshCommandArray PositionVertexBuffer;
+
+	/* First vertex to update */
+	int32 StartIndex;
 };
 
-/** Templated class for update data sent to the RT for updating a single mesh section */
-template<typename VertexType>
-class FRuntimeMeshSectionPositionOnlyUpdateData : public FRuntimeMeshRenderThreadCommandInterface
+/* Replaces a range of vertices of a section */
+struct FRuntimeMeshUpdateVerticesCommand
 {
-public:
-	/* Updated position vertex buffer for the section */
-	TArray<FVector> PositionVertexBuffer;
+	/* Updated vertices, starting at StartIndex in the section's vertex buffer */
+	FRuntimeMeshCommandArray VertexBuffer;
 
-	FRuntimeMeshSectionPositionOnlyUpdateData() {}
-	virtual ~FRuntimeMeshSectionPositionOnlyUpdateData() override { }
+	/* First vertex to update */
+	int32 StartIndex;
 };
 
-/** Property update for a single section */
-class FRuntimeMeshSectionPropertyUpdateData : public FRuntimeMeshRenderThreadCommandInterface
+/* Property update for a single section */
+struct FRuntimeMeshUpdatePropertiesCommand
 {
-public:
 	/* Is this section visible */
 	bool bIsVisible;
 
 	/* Is this section casting shadows */
 	bool bCastsShadow;
+};
+
+/**
+*	Packed stream of section commands sent to the render thread.
+*
+*	Commands are written back to back into one allocation as a header, a payload struct and any arrays the payload
+*	references. Arrays too large to be worth copying again when the stream grows get their own allocation instead.
+*	The render thread walks the stream once, switching on the command type. The stream comes from the pool of the
+*	component writing it and each large array from the pool of its section. They're returned there when the buffer is
+*	deleted, so steady updates don't allocate and components prepared in parallel don't share a pool.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshCommandBuffer
+{
+public:
+	enum
+	{
+		/* Alignment of every header, payload and inline array */
+		Alignment = 16,
+		/* Size the stream starts with */
+		InitialSize = 4 * 1024,
+		/* Arrays at least this large are stored in their own allocation */
+		MinExternalArrayBytes = 16 * 1024,
+	};
+
+	FRuntimeMeshCommandBuffer(const FRuntimeMeshBufferPoolPtr& InStoragePool);
+	~FRuntimeMeshCommandBuffer();
+
+	bool IsEmpty() const { return Storage.Num() == 0; }
+
+	/* Size of the stream in bytes. Commands run from offset 0 to here. */
+	int32 GetSize() const { return Storage.Num(); }
+
+	/* Starts a command, leaving room for its payload. Write its arrays, then finish it with EndCommand(). Returns the command offset. */
+	template<typename PayloadType>
+	int32 BeginCommand(ERuntimeMeshCommandType Type, int32 SectionIndex)
+	{
+		AlignStorage();
+		const int32 CommandOffset = Storage.Num();
+		Storage.AddUninitialized(GetPayloadOffset() + Align((int32)sizeof(PayloadType), (int32)Alignment));
+
+		FRuntimeMeshCommandHeader& Header = *reinterpret_cast<FRuntimeMeshCommandHeader*>(Storage.GetData() + CommandOffset);
+		Header.SectionIndex = SectionIndex;
+		Header.Size = 0;
+		Header.Type = Type;
+		return CommandOffset;
+	}
+
+	/* Fills in the payload of a command started with BeginCommand() */
+	template<typename PayloadType>
+	void EndCommand(int32 CommandOffset, const PayloadType& Payload)
+	{
+		AlignStorage();
+		FMemory::Memcpy(Storage.GetData() + CommandOffset + GetPayloadOffset(), &Payload, sizeof(PayloadType));
+		reinterpret_cast<FRuntimeMeshCommandHeader*>(Storage.GetData() + CommandOffset)->Size = Storage.Num() - CommandOffset;
+	}
+
+	/* Adds a command that doesn't reference any arrays */
+	template<typename PayloadType>
+	void AddCommand(ERuntimeMeshCommandType Type, int32 SectionIndex, const PayloadType& Payload)
+	{
+		EndCommand(BeginCommand<PayloadType>(Type, SectionIndex), Payload);
+	}
+
+	/* Adds a command without a payload */
+	void AddCommand(ERuntimeMeshCommandType Type, int32 SectionIndex)
+	{
+		AlignStorage();
+		const int32 CommandOffset = Storage.Num();
+		Storage.AddUninitialized(GetPayloadOffset());
+
+		FRuntimeMeshCommandHeader& Header = *reinterpret_cast<FRuntimeMeshCommandHeader*>(Storage.GetData() + CommandOffset);
+		Header.SectionIndex = SectionIndex;
+		Header.Size = GetPayloadOffset();
+		Header.Type = Type;
+	}
+
+	/* Copies an array into the buffer. Large arrays are taken from Pool and returned to it. Only call between BeginCommand() and EndCommand(). */
+	template<typename ElementType>
+	FRuntimeMeshCommandArray WriteArray(const ElementType* Data, int32 Num, const FRuntimeMeshBufferPoolPtr& Pool)
+	{
+		FRuntimeMeshCommandArray Array;
+		Array.Num = Num;
 
-	FRuntimeMeshSectionPropertyUpdateData() {}
-	virtual ~FRuntimeMeshSectionPropertyUpdateData() override { }
+		const int32 NumBytes = Num * sizeof(ElementType);
+		if (NumBytes >= MinExternalArrayBytes)
+		{
+			Array.ExternalIndex = ExternalArrays.AddDefaulted();
+			ExternalArrayPools.Add(Pool);
+			Pool->CopyToPooledArray(ExternalArrays[Array.ExternalIndex], reinterpret_cast<const uint8*>(Data), NumBytes);
+		}
+		else
+		{
+			AlignStorage();
+			Array.Offset = Storage.Num();
+			Storage.Append(reinterpret_cast<const uint8*>(Data), NumBytes);
+		}
+		return Array;
+	}
+
+	template<typename ElementType>
+	FRuntimeMeshCommandArray WriteArray(const TArray<ElementType>& Data, const FRuntimeMeshBufferPoolPtr& Pool)
+	{
+		return WriteArray(Data.GetData(), Data.Num(), Pool);
+	}
+
+	const FRuntimeMeshCommandHeader& GetHeader(int32 CommandOffset) const
+	{
+		return *reinterpret_cast<const FRuntimeMeshCommandHeader*>(Storage.GetData() + CommandOffset);
+	}
+
+	template<typename PayloadType>
+	const PayloadType& GetPayload(int32 CommandOffset) const
+	{
+		return *reinterpret_cast<const PayloadType*>(Storage.GetData() + CommandOffset + GetPayloadOffset());
+	}
+
+	template<typename ElementType>
+	const ElementType* GetArrayData(const FRuntimeMeshCommandArray& Array) const
+	{
+		const uint8* Data = Array.ExternalIndex != INDEX_NONE ? ExternalArrays[Array.ExternalIndex].GetData() : Storage.GetData() + Array.Offset;
+		return reinterpret_cast<const ElementType*>(Data);
+	}
+
+private:
+	/* The command stream */
+	TArray<uint8> Storage;
+
+	/* Pool the stream is returned to */
+	FRuntimeMeshBufferPoolPtr StoragePool;
+
+	/* Separate allocations for large arrays */
+	TArray<TArray<uint8>, TInlineAllocator<4>> ExternalArrays;
+
+	/* Pool each external array is returned to */
+	TArray<FRuntimeMeshBufferPoolPtr, TInlineAllocator<4>> ExternalArrayPools;
+
+	static int32 GetPayloadOffset() { return Align((int32)sizeof(FRuntimeMeshCommandHeader), (int32)Alignment); }
+
+	void AlignStorage()
+	{
+		Storage.AddUninitialized(Align(Storage.Num(), (int32)Alignment) - Storage.Num());
+	}
+
+	FRuntimeMeshCommandBuffer(const FRuntimeMeshCommandBuffer&) = delete;
+	FRuntimeMeshCommandBuffer& operator=(const FRuntimeMeshCommandBuffer&) = delete;
 };
 
 enum class ERuntimeMeshSectionBatchUpdateType
@@ -133,24 +273,38 @@ enum class ERuntimeMeshSectionBatchUpdateType
 ENUM_CLASS_FLAGS(ERuntimeMeshSectionBatchUpdateType)
 
 
-/* Struct carrying all update data for a batch update sent to the render thread */
-struct FRuntimeMeshBatchUpdateData
+/* A component's command buffer paired with the proxy it applies to, for sending many batches in one render command */
+struct FRuntimeMeshProxyCommands
 {
-	TArray<FRuntimeMeshSectionCreateDataInterface*> CreateSections;
-	TArray<int32> DestroySections;
-	TArray<FRuntimeMeshRenderThreadCommandInterface*> UpdateSections;
-	TArray<FRuntimeMeshSectionPropertyUpdateData*> PropertyUpdateSections;
+	class FPrimitiveSceneProxy* SceneProxy;
+	FRuntimeMeshCommandBuffer* Commands;
 };
 
 
 
 struct FRuntimeMeshBatchUpdateState
 {
-	void StartBatch() { bIsPending = true; }
+	/* Starts a batch for the caller. Takes over a pending coalesced batch, so it's only sent when the caller ends it. */
+	void StartBatch()
+	{
+		bIsPending = true;
+		bIsCoalesced = false;
+	}
+
+	/* Starts the end of frame batch of a coalescing component, unless a batch is already pending */
+	void StartCoalescedBatch()
+	{
+		if (!bIsPending)
+		{
+			bIsPending = true;
+			bIsCoalesced = true;
+		}
+	}
 
 	void ResetBatch() 
 	{
 		bIsPending = false;
+		bIsCoalesced = false;
 		bRequiresSceneProxyReCreate = false;
 		bRequiresBoundsUpdate = false;
 		bRequiresCollisionUpdate = false;
@@ -161,7 +315,10 @@ struct FRuntimeMeshBatchUpdateState
 	
 
 
-	bool IsBatchPending() { return bIsPending; }
+	bool IsBatchPending() const { return bIsPending; }
+
+	/* Is the pending batch the end of frame one started by coalescing, rather than one a caller began */
+	bool IsCoalescedBatchPending() const { return bIsPending && bIsCoalesced; }
 
 	void MarkSectionCreated(int32 SectionIndex, bool bPromoteToProxyRecreate)
 	{
@@ -172,19 +329,17 @@ struct FRuntimeMeshBatchUpdateState
 			return;
 		}
 
-		EnsureUpdateLength(SectionIndex);
+		ERuntimeMeshSectionBatchUpdateType& SectionUpdate = SectionUpdates.FindOrAdd(SectionIndex);
 
 		// Clear destroyed flag and set created
-		SectionUpdates[SectionIndex] &= ~ERuntimeMeshSectionBatchUpdateType::Destroy;
-		SectionUpdates[SectionIndex] |= ERuntimeMeshSectionBatchUpdateType::Create;
+		SectionUpdate &= ~ERuntimeMeshSectionBatchUpdateType::Destroy;
+		SectionUpdate |= ERuntimeMeshSectionBatchUpdateType::Create;
 	}
 
 	void MarkUpdateForSection(int32 SectionIndex, ERuntimeMeshSectionBatchUpdateType UpdateType)
 	{
-		EnsureUpdateLength(SectionIndex);
-		
 		// Add update type
-		SectionUpdates[SectionIndex] |= UpdateType;
+		SectionUpdates.FindOrAdd(SectionIndex) |= UpdateType;
 	}
 
 	void MarkSectionDestroyed(int32 SectionIndex, bool bPromoteToProxyRecreate)
@@ -196,11 +351,11 @@ struct FRuntimeMeshBatchUpdateState
 			return;
 		}
 
-		EnsureUpdateLength(SectionIndex);
+		ERuntimeMeshSectionBatchUpdateType& SectionUpdate = SectionUpdates.FindOrAdd(SectionIndex);
 
-		// Clear destroyed flag and set created
-		SectionUpdates[SectionIndex] &= ~ERuntimeMeshSectionBatchUpdateType::Create;
-		SectionUpdates[SectionIndex] |= ERuntimeMeshSectionBatchUpdateType::Destroy;
+		// Clear created flag and set destroyed
+		SectionUpdate &= ~ERuntimeMeshSectionBatchUpdateType::Create;
+		SectionUpdate |= ERuntimeMeshSectionBatchUpdateType::Destroy;
 	}
 
 	void MarkRenderStateDirty() { bRequiresSceneProxyReCreate = true; }
@@ -211,39 +366,38 @@ struct FRuntimeMeshBatchUpdateState
 
 
 
-	bool HasAnyFlagSet(int32 SectionIndex) { return SectionUpdates[SectionIndex] != ERuntimeMeshSectionBatchUpdateType::None; }
+	bool HasAnyFlagSet(int32 SectionIndex) const
+	{
+		const ERuntimeMeshSectionBatchUpdateType* SectionUpdate = SectionUpdates.Find(SectionIndex);
+		return SectionUpdate && *SectionUpdate != ERuntimeMeshSectionBatchUpdateType::None;
+	}
 
-	bool HasFlagSet(int32 SectionIndex, ERuntimeMeshSectionBatchUpdateType UpdateType)
+	bool HasFlagSet(int32 SectionIndex, ERuntimeMeshSectionBatchUpdateType UpdateType) const
 	{
-		return (SectionUpdates[SectionIndex] & UpdateType) == UpdateType;
+		const ERuntimeMeshSectionBatchUpdateType* SectionUpdate = SectionUpdates.Find(SectionIndex);
+		return SectionUpdate && (*SectionUpdate & UpdateType) == UpdateType;
 	}
 
-	bool RequiresSceneProxyRecreate() { return bRequiresSceneProxyReCreate; }
+	bool RequiresSceneProxyRecreate() const { return bRequiresSceneProxyReCreate; }
 
-	bool RequiresBoundsUpdate() { return bRequiresBoundsUpdate; }
+	bool RequiresBoundsUpdate() const { return bRequiresBoundsUpdate; }
 
-	bool RequiresCollisionUpdate() { return bRequiresCollisionUpdate; }
+	bool RequiresCollisionUpdate() const { return bRequiresCollisionUpdate; }
 
-	int32 GetMaxSection() { return SectionUpdates.Num() - 1; }
+	/* Number of sections with updates. Use GetUpdatedSectionAt to iterate them. */
+	int32 GetNumUpdatedSections() const { return SectionUpdates.Num(); }
 
-private:
-
-	void EnsureUpdateLength(int32 SectionIndex)
-	{
-		if (SectionIndex < SectionUpdates.Num())
-		{
-			return;
-		}
-
-		SectionUpdates.AddZeroed((SectionIndex + 1) - SectionUpdates.Num());
-	}
+	/* Section index of the Nth section with updates */
+	int32 GetUpdatedSectionAt(int32 Index) const { return SectionUpdates.GetKeyAt(Index); }
 
+private:
 
 	bool bIsPending;
+	bool bIsCoalesced;
 	bool bRequiresSceneProxyReCreate;
 	bool bRequiresBoundsUpdate;
 	bool bRequiresCollisionUpdate;
-	TArray<ERuntimeMeshSectionBatchUpdateType> SectionUpdates;
+	TRuntimeMeshSectionMap<ERuntimeMeshSectionBatchUpdateType> SectionUpdates;
 	
 
 
@@ -0,0 +1,51 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+class URuntimeMeshComponent;
+
+/**
+*	Per world manager that sends the coalesced updates of every URuntimeMeshComponent using bCoalesceUpdates.
+*	Components add themselves when they start accumulating a batch. After all actors in the world have ticked,
+*	the render thread payloads of all pending components are built in parallel and applied by a single render command,
+*	so render thread overhead scales with the amount of data updated instead of the number of components.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshUpdateManager
+{
+public:
+	/* Hooks the world delegates that drive the managers. Called on module startup. */
+	static void Initialize();
+
+	/* Unhooks the world delegates and releases all managers. Called on module shutdown. */
+	static void Shutdown();
+
+	/* Gets the manager for a world, creating it the first time. Returns null if there's no world. */
+	static FRuntimeMeshUpdateManager* Get(UWorld* World);
+
+	/* Queues a component with a pending batch to be sent at the end of the world tick */
+	void AddPendingComponent(URuntimeMeshComponent* Component);
+
+	/* Queues a component whose morph target weights changed, to be blended at the end of the world tick */
+	void AddPendingMorphComponent(URuntimeMeshComponent* Component);
+
+	/* Blends pending morph targets, then sends the batches of all pending components now */
+	void Flush();
+
+	int32 GetNumPendingComponents() const { return PendingComponents.Num(); }
+
+private:
+	/* Components that started a batch since the last flush */
+	TArray<TWeakObjectPtr<URuntimeMeshComponent>> PendingComponents;
+
+	/* Components with morph target weights changed since the last flush */
+	TArray<TWeakObjectPtr<URuntimeMeshComponent>> PendingMorphComponents;
+
+	static TMap<UWorld*, TSharedPtr<FRuntimeMeshUpdateManager>> Managers;
+	static FDelegateHandle WorldPostActorTickHandle;
+	static FDelegateHandle WorldCleanupHandle;
+
+	static void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+};
@@ -14,6 +14,8 @@ namespace FRuntimeMeshVersion
 		TemplatedVertexFix = 1,
 		SerializationOptional = 2,
 		DualVertexBuffer = 3,
+		SparseSections = 4,
+		ParallelSectionBlocks = 5,
 
 
 		// -----<new versions can be added above this line>-------------------------------------------------
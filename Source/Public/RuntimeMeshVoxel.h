@@ -0,0 +1,124 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "RuntimeMeshComponent.h"
+
+/**
+*	Voxel data for a single chunk. Voxel (X, Y, Z) is stored at index (X * Size.Y + Y) * Size.Z + Z.
+*	Only the array used by the mesher needs filling, Densities for marching cubes or Materials for greedy meshing.
+*/
+struct FRuntimeMeshVoxelChunk
+{
+	/* Number of voxels in each direction */
+	FIntVector Size;
+
+	/* Local position of voxel (0, 0, 0) */
+	FVector Origin;
+
+	/* Size of a single voxel */
+	FVector VoxelSize;
+
+	/**
+	*	Density of each sample for marching cubes. Samples at or above the iso level are solid.
+	*	Neighboring chunks should share their border samples so the surfaces line up.
+	*/
+	TArray<float> Densities;
+
+	/* Palette index of each voxel for greedy meshing. 0 is empty. */
+	TArray<uint8> Materials;
+
+	/* Vertex color for each palette index. Indices past the end of the palette are white. */
+	TArray<FColor> Palette;
+
+	/**
+	*	Greedy meshing only. Is the outer layer of voxels a copy of the neighboring chunks?
+	*	If so it's only used to cull faces against and isn't meshed itself, so there are no faces between chunks.
+	*/
+	bool bHasBorder;
+
+	FRuntimeMeshVoxelChunk() : Size(0, 0, 0), Origin(0, 0, 0), VoxelSize(100.0f, 100.0f, 100.0f), bHasBorder(false) { }
+
+	int32 GetIndex(int32 X, int32 Y, int32 Z) const { return (X * Size.Y + Y) * Size.Z + Z; }
+	int32 GetNumVoxels() const { return Size.X * Size.Y * Size.Z; }
+};
+
+/* Generated mesh for a single chunk, ready to be moved into a section */
+struct FRuntimeMeshVoxelMeshData
+{
+	TArray<FRuntimeMeshVertexSimple> Vertices;
+	TArray<int32> Triangles;
+	FBox BoundingBox;
+
+	FRuntimeMeshVoxelMeshData() : BoundingBox(0) { }
+};
+
+/**
+*	Multithreaded voxel mesher.
+*
+*	Every chunk is split into slabs along one axis and all slabs of all chunks are meshed in parallel,
+*	then stitched together per chunk. The per slab scratch buffers are kept by the mesher and reused
+*	by every call, so keep one mesher around instead of creating one per chunk.
+*	A mesher must only be used by one thread at a time.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshVoxelMesher
+{
+public:
+	FRuntimeMeshVoxelMesher();
+
+	/* Density at which the marching cubes surface is generated */
+	float IsoLevel;
+
+	/* Number of voxel slices each parallel task handles */
+	int32 SlicesPerSlab;
+
+	/**
+	*	Generates smooth surfaces from chunk densities using marching cubes.
+	*	Normals come from the density gradient. UVs are projected along the dominant normal axis in voxel units.
+	*/
+	void MarchingCubes(const TArray<const FRuntimeMeshVoxelChunk*>& Chunks, TArray<FRuntimeMeshVoxelMeshData>& OutMeshes);
+
+	/**
+	*	Generates blocky surfaces from chunk materials, merging coplanar faces of the same material into as few quads as possible.
+	*	Vertex colors come from the chunk palette, UVs are in voxel units so textures tile once per voxel.
+	*/
+	void GreedyMesh(const TArray<const FRuntimeMeshVoxelChunk*>& Chunks, TArray<FRuntimeMeshVoxelMeshData>& OutMeshes);
+
+	/**
+	*	Moves generated meshes into sections in a single batch update, or in the batch already pending on the component, creating sections as needed and clearing them if the mesh is empty.
+	*	The mesh arrays are left empty.
+	*/
+	static void ApplyToComponent(URuntimeMeshComponent* Component, const TArray<int32>& SectionIndices, TArray<FRuntimeMeshVoxelMeshData>& Meshes,
+		bool bCreateCollision = false, EUpdateFrequency UpdateFrequency = EUpdateFrequency::Average);
+
+private:
+	/* A range of slices of one chunk along one axis */
+	struct FSlabTask
+	{
+		int32 ChunkIndex;
+		int32 Axis;
+		int32 SliceBegin;
+		int32 SliceEnd;
+	};
+
+	/* Scratch buffers for a single task, reused across calls */
+	struct FSlabScratch
+	{
+		TArray<FRuntimeMeshVertexSimple> Vertices;
+		TArray<int32> Triangles;
+		TArray<int32> EdgeVertices;
+		TArray<int32> Mask;
+		FBox BoundingBox;
+	};
+
+	TArray<FSlabTask> Tasks;
+	TArray<FSlabScratch> Scratch;
+
+	void AddSlabTasks(int32 ChunkIndex, int32 Axis, int32 SliceBegin, int32 SliceEnd);
+
+	/* Runs every task in parallel, then joins the slabs of each chunk into OutMeshes */
+	void RunTasks(int32 NumChunks, TArray<FRuntimeMeshVoxelMeshData>& OutMeshes, TFunctionRef<void(const FSlabTask&, FSlabScratch&)> MeshSlab);
+
+	void MarchingCubesSlab(const FRuntimeMeshVoxelChunk& Chunk, const FSlabTask& Task, FSlabScratch& OutScratch) const;
+	void GreedyMeshSlab(const FRuntimeMeshVoxelChunk& Chunk, const FSlabTask& Task, FSlabScratch& OutScratch) const;
+};
@@ -0,0 +1,390 @@
+// Copyright 2016 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "RuntimeMeshCore.h"
+#include "RuntimeMeshGenericVertex.h"
+#include "Async/ParallelFor.h"
+#include "RuntimeMeshWelding.generated.h"
+
+/* Tolerances used when welding vertices */
+USTRUCT(BlueprintType)
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshWeldSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Vertices closer than this are candidates for welding */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RuntimeMesh|Welding")
+	float PositionTolerance;
+
+	/* Max angle in degrees between normals (and tangents) of welded vertices. Negative disables the check. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RuntimeMesh|Welding")
+	float NormalAngleTolerance;
+
+	/* Max distance between UVs of welded vertices, checked for every UV channel */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RuntimeMesh|Welding")
+	float UVTolerance;
+
+	/* Max difference of any color channel of welded vertices */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RuntimeMesh|Welding")
+	int32 ColorTolerance;
+
+	/* Ignore everything but position. Used for collision where attributes don't matter. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RuntimeMesh|Welding")
+	bool bPositionsOnly;
+
+	/* Remove triangles that collapse to a line or point after welding */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RuntimeMesh|Welding")
+	bool bRemoveDegenerateTriangles;
+
+	FRuntimeMeshWeldSettings()
+		: PositionTolerance(0.01f), NormalAngleTolerance(1.0f), UVTolerance(0.0001f), ColorTolerance(0)
+		, bPositionsOnly(false), bRemoveDegenerateTriangles(true)
+	{}
+
+	/* Cosine of NormalAngleTolerance, the minimum dot product between matching normals */
+	float GetNormalThreshold() const
+	{
+		return NormalAngleTolerance < 0.0f ? -2.0f : FMath::Cos(FMath::DegreesToRadians(NormalAngleTolerance));
+	}
+};
+
+/* Default attribute comparison used when welding vertices. Works for FRuntimeMeshVertex and any vertex type with the same members, reading as many UV channels as its traits give. */
+template<typename VertexType>
+struct FRuntimeMeshWeldAttributeMatch
+{
+	float NormalThreshold;
+	float UVToleranceSquared;
+	int32 ColorTolerance;
+
+	FRuntimeMeshWeldAttributeMatch(const FRuntimeMeshWeldSettings& Settings)
+		: NormalThreshold(Settings.GetNormalThreshold())
+		, UVToleranceSquared(FMath::Square(Settings.UVTolerance))
+		, ColorTolerance(Settings.ColorTolerance)
+	{}
+
+	bool operator()(const VertexType& A, const VertexType& B) const
+	{
+		// Tangent basis sign lives in the W of the normal
+		if (A.Normal.Vector.W != B.Normal.Vector.W)
+		{
+			return false;
+		}
+
+		if ((FVector(A.Normal) | FVector(B.Normal)) < NormalThreshold || (FVector(A.Tangent) | FVector(B.Tangent)) < NormalThreshold)
+		{
+			return false;
+		}
+
+		if (FMath::Abs(A.Color.R - B.Color.R) > ColorTolerance || FMath::Abs(A.Color.G - B.Color.G) > ColorTolerance ||
+			FMath::Abs(A.Color.B - B.Color.B) > ColorTolerance || FMath::Abs(A.Color.A - B.Color.A) > ColorTolerance)
+		{
+			return false;
+		}
+
+		for (int32 Channel = 0; Channel < FRuntimeMeshVertexTraits<VertexType>::NumUVChannels; Channel++)
+		{
+			if (FVector2D::DistSquared(RuntimeMeshVertexInternal::GetUV(A, Channel), RuntimeMeshVertexInternal::GetUV(B, Channel)) > UVToleranceSquared)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+};
+
+/* Attribute comparison that accepts everything, used for position only welding */
+struct FRuntimeMeshWeldAlwaysMatch
+{
+	template<typename VertexType>
+	bool operator()(const VertexType& A, const VertexType& B) const { return true; }
+};
+
+/**
+*	Hash based vertex welding.
+*
+*	Positions are bucketed into a spatial hash with cells the size of the position tolerance, split into partitions by
+*	hash so each partition can be built in parallel. Every vertex is then matched in parallel against the 27 neighboring
+*	cells, welding to the lowest index vertex within tolerance whose attributes also match. The vertex buffer is then
+*	compacted and the index buffer remapped in place.
+*/
+class FRuntimeMeshWelding
+{
+public:
+	/* Welds a single buffer section. Returns the number of vertices removed. */
+	template<typename VertexType>
+	static int32 WeldVertices(TArray<VertexType>& Vertices, TArray<int32>& Triangles, const FRuntimeMeshWeldSettings& Settings = FRuntimeMeshWeldSettings())
+	{
+		static_assert(FRuntimeMeshVertexTraits<VertexType>::HasPositionComponent, "Vertex type has no position. Use the overload taking separate positions.");
+
+		auto GetPosition = [&Vertices](int32 Index) -> const FVector& { return Vertices[Index].Position; };
+		auto Matches = CreateMatch<VertexType>(Settings);
+
+		TArray<int32> Remap;
+		int32 NumUnique = BuildRemap(Vertices.Num(), GetPosition,
+			[&Vertices, &Matches](int32 A, int32 B) { return Matches(Vertices[A], Vertices[B]); }, Settings.PositionTolerance, Remap);
+
+		return ApplyRemap(Remap, NumUnique, Triangles, Settings.bRemoveDegenerateTriangles, Vertices);
+	}
+
+	/* Welds a dual buffer section. Returns the number of vertices removed. */
+	template<typename VertexType>
+	static int32 WeldVertices(TArray<FVector>& Positions, TArray<VertexType>& Vertices, TArray<int32>& Triangles, const FRuntimeMeshWeldSettings& Settings = FRuntimeMeshWeldSettings())
+	{
+		check(Positions.Num() == Vertices.Num());
+
+		auto GetPosition = [&Positions](int32 Index) -> const FVector& { return Positions[Index]; };
+		auto Matches = CreateMatch<VertexType>(Settings);
+
+		TArray<int32> Remap;
+		int32 NumUnique = BuildRemap(Vertices.Num(), GetPosition,
+			[&Vertices, &Matches](int32 A, int32 B) { return Matches(Vertices[A], Vertices[B]); }, Settings.PositionTolerance, Remap);
+
+		return ApplyRemap(Remap, NumUnique, Triangles, Settings.bRemoveDegenerateTriangles, Positions, Vertices);
+	}
+
+	/* Welds positions only, ignoring all other attributes. Returns the number of vertices removed. */
+	static int32 WeldPositions(TArray<FVector>& Positions, TArray<int32>& Triangles, float PositionTolerance, bool bRemoveDegenerateTriangles = true)
+	{
+		auto GetPosition = [&Positions](int32 Index) -> const FVector& { return Positions[Index]; };
+
+		TArray<int32> Remap;
+		int32 NumUnique = BuildRemap(Positions.Num(), GetPosition, [](int32 A, int32 B) { return true; }, PositionTolerance, Remap);
+
+		return ApplyRemap(Remap, NumUnique, Triangles, bRemoveDegenerateTriangles, Positions);
+	}
+
+
+	/**
+	*	Computes the welded index of every vertex.
+	*	@param	NumVertices			Number of vertices to weld
+	*	@param	GetPosition			Callable returning the position of a vertex, (int32) -> const FVector&
+	*	@param	Matches				Callable comparing the attributes of two vertices, (int32, int32) -> bool
+	*	@param	PositionTolerance	Max distance between welded vertices
+	*	@out	OutRemap			New index for each vertex. Unique vertices keep their relative order.
+	*	@return						Number of unique vertices
+	*/
+	template<typename PositionAccessor, typename MatchFunc>
+	static int32 BuildRemap(int32 NumVertices, const PositionAccessor& GetPosition, const MatchFunc& Matches, float PositionTolerance, TArray<int32>& OutRemap)
+	{
+		OutRemap.SetNumUninitialized(NumVertices);
+		if (NumVertices == 0)
+		{
+			return 0;
+		}
+
+		// Clamp the cell size so exact welding doesn't produce huge cell coordinates
+		const float CellSize = FMath::Max(PositionTolerance, 0.001f);
+		const float ToleranceSquared = FMath::Square(FMath::Max(PositionTolerance, 0.0f));
+		const int32 NumPartitions = FMath::Clamp<int32>(NumVertices / VerticesPerPartition, 1, MaxPartitions);
+
+		// Hash every vertex into its cell
+		TArray<uint32> CellHashes;
+		CellHashes.SetNumUninitialized(NumVertices);
+		ParallelFor(FMath::DivideAndRoundUp<int32>(NumVertices, VerticesPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(NumVertices, (TaskIndex + 1) * VerticesPerTask);
+			for (int32 Index = TaskIndex * VerticesPerTask; Index < End; Index++)
+			{
+				int64 X, Y, Z;
+				GetCell(GetPosition(Index), CellSize, X, Y, Z);
+				CellHashes[Index] = HashCell(X, Y, Z);
+			}
+		});
+
+		// Bucket vertices by partition
+		TArray<int32> PartitionStart;
+		PartitionStart.SetNumZeroed(NumPartitions + 1);
+		for (int32 Index = 0; Index < NumVertices; Index++)
+		{
+			PartitionStart[CellHashes[Index] % NumPartitions + 1]++;
+		}
+		for (int32 Partition = 0; Partition < NumPartitions; Partition++)
+		{
+			PartitionStart[Partition + 1] += PartitionStart[Partition];
+		}
+
+		TArray<int32> PartitionVertices;
+		PartitionVertices.SetNumUninitialized(NumVertices);
+		{
+			TArray<int32> PartitionFill(PartitionStart.GetData(), NumPartitions);
+			for (int32 Index = 0; Index < NumVertices; Index++)
+			{
+				PartitionVertices[PartitionFill[CellHashes[Index] % NumPartitions]++] = Index;
+			}
+		}
+
+		// Build the cell lists of each partition in parallel. Each cell is a linked list through NextInCell.
+		TArray<TMap<uint32, int32>> PartitionCells;
+		PartitionCells.SetNum(NumPartitions);
+		TArray<int32> NextInCell;
+		NextInCell.SetNumUninitialized(NumVertices);
+		ParallelFor(NumPartitions, [&](int32 Partition)
+		{
+			TMap<uint32, int32>& Cells = PartitionCells[Partition];
+			Cells.Reserve(PartitionStart[Partition + 1] - PartitionStart[Partition]);
+
+			for (int32 Entry = PartitionStart[Partition]; Entry < PartitionStart[Partition + 1]; Entry++)
+			{
+				const int32 Index = PartitionVertices[Entry];
+
+				// Heads are stored offset by one so a newly added cell (zero) reads as an empty list
+				int32& Head = Cells.FindOrAdd(CellHashes[Index]);
+				NextInCell[Index] = Head - 1;
+				Head = Index + 1;
+			}
+		});
+
+		// Match every vertex against its neighborhood, recording the lowest matching index
+		ParallelFor(FMath::DivideAndRoundUp<int32>(NumVertices, VerticesPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(NumVertices, (TaskIndex + 1) * VerticesPerTask);
+			for (int32 Index = TaskIndex * VerticesPerTask; Index < End; Index++)
+			{
+				const FVector& Position = GetPosition(Index);
+				int64 X, Y, Z;
+				GetCell(Position, CellSize, X, Y, Z);
+
+				int32 Best = Index;
+				for (int32 Neighbor = 0; Neighbor < 27; Neighbor++)
+				{
+					const uint32 Hash = HashCell(X + (Neighbor % 3) - 1, Y + ((Neighbor / 3) % 3) - 1, Z + (Neighbor / 9) - 1);
+					const int32* Head = PartitionCells[Hash % NumPartitions].Find(Hash);
+					if (Head == nullptr)
+					{
+						continue;
+					}
+
+					for (int32 Other = *Head - 1; Other != INDEX_NONE; Other = NextInCell[Other])
+					{
+						if (Other < Best && FVector::DistSquared(Position, GetPosition(Other)) <= ToleranceSquared && Matches(Index, Other))
+						{
+							Best = Other;
+						}
+					}
+				}
+				OutRemap[Index] = Best;
+			}
+		});
+
+		// Assign new indices in order. Every match points at a lower index which has already been resolved.
+		int32 NumUnique = 0;
+		for (int32 Index = 0; Index < NumVertices; Index++)
+		{
+			const int32 Match = OutRemap[Index];
+			OutRemap[Index] = Match == Index ? NumUnique++ : OutRemap[Match];
+		}
+		return NumUnique;
+	}
+
+	/* Compacts a per vertex buffer in place using a remap from BuildRemap() */
+	template<typename ElementType>
+	static void CompactVertexBuffer(TArray<ElementType>& Buffer, const TArray<int32>& Remap, int32 NumUnique)
+	{
+		check(Buffer.Num() == Remap.Num());
+
+		// Unique vertices are the first to map to each new index, and always move down
+		int32 NextUnique = 0;
+		for (int32 Index = 0; Index < Remap.Num(); Index++)
+		{
+			if (Remap[Index] == NextUnique)
+			{
+				if (NextUnique != Index)
+				{
+					Buffer[NextUnique] = Buffer[Index];
+				}
+				NextUnique++;
+			}
+		}
+		check(NextUnique == NumUnique);
+		Buffer.SetNum(NumUnique, false);
+	}
+
+	/* Remaps an index buffer in place using a remap from BuildRemap() */
+	template<typename IndexType>
+	static void RemapIndexBuffer(TArray<IndexType>& Indices, const TArray<int32>& Remap)
+	{
+		const int32 NumIndices = Indices.Num();
+		ParallelFor(FMath::DivideAndRoundUp<int32>(NumIndices, VerticesPerTask), [&](int32 TaskIndex)
+		{
+			const int32 End = FMath::Min<int32>(NumIndices, (TaskIndex + 1) * VerticesPerTask);
+			for (int32 Index = TaskIndex * VerticesPerTask; Index < End; Index++)
+			{
+				Indices[Index] = Remap[Indices[Index]];
+			}
+		});
+	}
+
+	/* Removes triangles that reference the same vertex more than once */
+	static void RemoveDegenerateTriangles(TArray<int32>& Triangles)
+	{
+		int32 NumKept = 0;
+		for (int32 Index = 0; Index + 2 < Triangles.Num(); Index += 3)
+		{
+			const int32 V0 = Triangles[Index + 0];
+			const int32 V1 = Triangles[Index + 1];
+			const int32 V2 = Triangles[Index + 2];
+			if (V0 != V1 && V1 != V2 && V2 != V0)
+			{
+				Triangles[NumKept++] = V0;
+				Triangles[NumKept++] = V1;
+				Triangles[NumKept++] = V2;
+			}
+		}
+		Triangles.SetNum(NumKept, false);
+	}
+
+private:
+	enum
+	{
+		/* Target number of vertices per hash partition */
+		VerticesPerPartition = 4096,
+
+		MaxPartitions = 64,
+
+		/* Number of vertices handled by each parallel task */
+		VerticesPerTask = 2048,
+	};
+
+	static void GetCell(const FVector& Position, float CellSize, int64& X, int64& Y, int64& Z)
+	{
+		X = (int64)FMath::FloorToDouble(Position.X / CellSize);
+		Y = (int64)FMath::FloorToDouble(Position.Y / CellSize);
+		Z = (int64)FMath::FloorToDouble(Position.Z / CellSize);
+	}
+
+	static uint32 HashCell(int64 X, int64 Y, int64 Z)
+	{
+		const uint64 Hash = (uint64)X * 73856093ull ^ (uint64)Y * 19349663ull ^ (uint64)Z * 83492791ull;
+		return (uint32)(Hash ^ (Hash >> 32));
+	}
+
+	template<typename VertexType>
+	static TFunction<bool(const VertexType&, const VertexType&)> CreateMatch(const FRuntimeMeshWeldSettings& Settings)
+	{
+		if (Settings.bPositionsOnly)
+		{
+			return FRuntimeMeshWeldAlwaysMatch();
+		}
+		return FRuntimeMeshWeldAttributeMatch<VertexType>(Settings);
+	}
+
+	static int32 ApplyRemap(const TArray<int32>& Remap, int32 NumUnique, TArray<int32>& Triangles, bool bRemoveDegenerates)
+	{
+		RemapIndexBuffer(Triangles, Remap);
+		if (bRemoveDegenerates)
+		{
+			RemoveDegenerateTriangles(Triangles);
+		}
+		return Remap.Num() - NumUnique;
+	}
+
+	template<typename BufferType, typename... OtherBufferTypes>
+	static int32 ApplyRemap(const TArray<int32>& Remap, int32 NumUnique, TArray<int32>& Triangles, bool bRemoveDegenerates,
+		TArray<BufferType>& Buffer, TArray<OtherBufferTypes>&... OtherBuffers)
+	{
+		CompactVertexBuffer(Buffer, Remap, NumUnique);
+		return ApplyRemap(Remap, NumUnique, Triangles, bRemoveDegenerates, OtherBuffers...);
+	}
+};
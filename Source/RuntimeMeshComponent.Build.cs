@@ -4,6 +4,10 @@ using UnrealBuildTool;
 
 public class RuntimeMeshComponent : ModuleRules
 {
+    // Set to true to build the benchmark with the UProceduralMeshComponent comparison.
+    // Requires the ProceduralMeshComponent plugin to be enabled in the project.
+    private bool bBenchmarkAgainstProceduralMesh = false;
+
 	public RuntimeMeshComponent(TargetInfo Target)
 	{
         PrivateIncludePaths.Add("RuntimeMeshComponent/Private");
@@ -20,5 +24,15 @@ public class RuntimeMeshComponent : ModuleRules
                         "RHI"
                 }
             );
+
+        if (bBenchmarkAgainstProceduralMesh)
+        {
+            PrivateDependencyModuleNames.Add("ProceduralMeshComponent");
+            Definitions.Add("WITH_RUNTIMEMESH_PMC_BENCHMARK=1");
+        }
+        else
+        {
+            Definitions.Add("WITH_RUNTIMEMESH_PMC_BENCHMARK=0");
+        }
     }
 }